@@ -174,7 +174,7 @@ main(int argc, char* argv[])
         "pmSearchMethod",
         "Precoding matrix search method, currently implemented only exhaustive search method"
         "[ns3::NrPmSearchFull, ns3::NrPmSearchFast, ns3::NrPmSearchIdeal, ns3::NrPmSearchSasaoka, "
-        "ns3::NrPmSearchMaleki (requires extra dependencies)]",
+        "ns3::NrPmSearchMaleki]",
         mimoPmiParams.pmSearchMethod);
     cmd.AddValue("fullSearchCb",
                  "The codebook to be used for the full search. Available codebooks are "
@@ -0,0 +1,703 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+/**
+ * @ingroup examples
+ * @file cttc-nr-scheduler-benchmark.cc
+ * @brief Benchmark of the MAC schedulers, without PHY, channel or upper layers
+ *
+ * This example measures the processing cost of the schedulers derived from
+ * NrMacSchedulerNs3 on their own. Each scheduler is created through an ObjectFactory
+ * and driven through its SAP interfaces, as NrGnbMac would do, by a harness that
+ * emulates a gNB with synthetic UEs:
+ *
+ * - every UE has a full buffer in DL (RLC buffer reports) and UL (BSRs);
+ * - every UE reports a DL CQI (wideband and, optionally, per RBG) periodically,
+ *   around a mean CQI drawn at random for each UE;
+ * - every UL data allocation is answered with a UL CQI, and every DL and UL data
+ *   allocation with HARQ feedback, that is negative with probability `bler`.
+ *
+ * For every slot, the harness triggers the UL scheduling of the slot N2 slots
+ * ahead and the DL scheduling of the slot L1L2 slots ahead, with all the slots
+ * being flexible (F). After a warm-up, it measures the time spent in the calls to
+ * the scheduler (all of them, and the DL/UL triggers only) and counts the data
+ * allocations (DCIs) and bytes. The peak resident memory of the process is printed
+ * after each configuration; since it never decreases, run one configuration per
+ * process to measure it in isolation.
+ *
+ * All the combinations of the schedulers, number of UEs and number of RBs given in
+ * the command line are measured. For example, to compare the OFDMA PF and QoS
+ * schedulers with 100 and 1000 UEs in 52 and 273 RBs:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-scheduler-benchmark --schedulers=OfdmaPF|OfdmaQos --ueCounts=100|1000
+    --rbCounts=52|273"
+    \endcode
+ *
+ * The schedulers can be given with their full TypeId name or without the
+ * "ns3::NrMacScheduler" prefix. The symbols of the OFDMA schedulers are
+ * distributed among the beams as indicated by `symPerBeamType`. Build ns-3 in
+ * optimized mode to measure: in debug builds, the scheduler checks every allocation.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/parse-string-to-vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("CttcNrSchedulerBenchmark");
+
+/**
+ * @brief CSCHED SAP user of the benchmark, which ignores the confirmations
+ */
+class BenchmarkCschedSapUser : public NrMacCschedSapUser
+{
+  public:
+    void CschedCellConfigCnf(
+        [[maybe_unused]] const struct CschedCellConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigCnf(
+        [[maybe_unused]] const struct CschedUeConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcConfigCnf(
+        [[maybe_unused]] const struct CschedLcConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcReleaseCnf(
+        [[maybe_unused]] const struct CschedLcReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeReleaseCnf(
+        [[maybe_unused]] const struct CschedUeReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigUpdateInd(
+        [[maybe_unused]] const struct CschedUeConfigUpdateIndParameters& params) override
+    {
+    }
+
+    void CschedCellConfigUpdateInd(
+        [[maybe_unused]] const struct CschedCellConfigUpdateIndParameters& params) override
+    {
+    }
+};
+
+/**
+ * @brief SCHED SAP user of the benchmark, which plays the role of NrGnbMac
+ */
+class BenchmarkSchedSapUser : public NrMacSchedSapUser
+{
+  public:
+    /**
+     * @brief Create the SAP user
+     * @param schedConfigInd the callback for the scheduling decisions
+     * @param sm the spectrum model of the cell
+     * @param rbPerRbg the number of RBs per RBG
+     * @param numerology the numerology of the cell
+     */
+    BenchmarkSchedSapUser(std::function<void(const SchedConfigIndParameters&)> schedConfigInd,
+                          Ptr<const SpectrumModel> sm,
+                          uint32_t rbPerRbg,
+                          uint16_t numerology)
+        : m_schedConfigInd(schedConfigInd),
+          m_sm(sm),
+          m_rbPerRbg(rbPerRbg),
+          m_numerology(numerology)
+    {
+    }
+
+    void SchedConfigInd(const struct SchedConfigIndParameters& params) override
+    {
+        m_schedConfigInd(params);
+    }
+
+    Ptr<const SpectrumModel> GetSpectrumModel() const override
+    {
+        return m_sm;
+    }
+
+    uint32_t GetNumRbPerRbg() const override
+    {
+        return m_rbPerRbg;
+    }
+
+    uint8_t GetNumHarqProcess() const override
+    {
+        return 16;
+    }
+
+    uint16_t GetBwpId() const override
+    {
+        return 0;
+    }
+
+    uint16_t GetCellId() const override
+    {
+        return 1;
+    }
+
+    uint32_t GetSymbolsPerSlot() const override
+    {
+        return 14;
+    }
+
+    Time GetSlotPeriod() const override
+    {
+        return MicroSeconds(1000 >> m_numerology);
+    }
+
+    void BuildRarList([[maybe_unused]] SlotAllocInfo& slotAllocInfo) override
+    {
+    }
+
+  private:
+    /// Callback for the scheduling decisions
+    std::function<void(const SchedConfigIndParameters&)> m_schedConfigInd;
+    Ptr<const SpectrumModel> m_sm; //!< Spectrum model of the cell
+    uint32_t m_rbPerRbg;           //!< Number of RBs per RBG
+    uint16_t m_numerology;         //!< Numerology of the cell
+};
+
+/**
+ * @brief Parameters of the benchmark that are common to all the configurations
+ */
+struct BenchmarkParams
+{
+    uint32_t numSlots{500};       //!< Number of measured slots
+    uint32_t warmupSlots{20};     //!< Number of slots before the measurement
+    uint16_t numerology{1};       //!< Numerology of the cell
+    uint32_t rbPerRbg{1};         //!< Number of RBs per RBG
+    uint16_t numBeams{4};         //!< Number of beams among which the UEs are spread
+    std::string symPerBeamType;   //!< Symbol allocation per beam of OFDMA schedulers
+    uint32_t cqiPeriod{10};       //!< DL CQI period of each UE, in slots
+    bool subbandCqi{true};        //!< Whether the DL CQI has one value per RBG
+    double bler{0.1};             //!< Probability of a negative HARQ feedback
+    uint32_t bufferBytes{100000}; //!< Buffer of each UE in DL and UL
+    uint32_t l1l2CtrlLatency{2};  //!< Slots between DL scheduling and transmission
+    uint32_t n2Delay{2};          //!< Additional slots for the UL scheduling
+    uint32_t k1Delay{2};          //!< Slots between DL data and its HARQ feedback
+    int64_t stream{1};            //!< First random stream
+};
+
+/**
+ * @brief Results of a configuration of the benchmark
+ */
+struct BenchmarkResults
+{
+    std::chrono::nanoseconds schedTime{0};   //!< Time spent in all the calls to the scheduler
+    std::chrono::nanoseconds triggerTime{0}; //!< Time spent in the DL and UL triggers
+    uint64_t dlAllocs{0};                    //!< Number of DL data DCIs
+    uint64_t ulAllocs{0};                    //!< Number of UL data DCIs
+    uint64_t dlBytes{0};                     //!< Sum of the DL TB sizes
+    uint64_t ulBytes{0};                     //!< Sum of the UL TB sizes
+};
+
+/**
+ * @brief Emulation of a gNB with synthetic UEs that drives a scheduler
+ */
+class SchedulerBenchmark
+{
+  public:
+    /**
+     * @brief Create the benchmark of a configuration
+     * @param schedulerType the TypeId name of the scheduler
+     * @param numUes the number of UEs
+     * @param numRbs the number of RBs of the cell
+     * @param params the common parameters
+     */
+    SchedulerBenchmark(const std::string& schedulerType,
+                       uint32_t numUes,
+                       uint32_t numRbs,
+                       const BenchmarkParams& params);
+
+    /**
+     * @brief Run the warm-up and the measured slots
+     * @return the results of the measured slots
+     */
+    BenchmarkResults Run();
+
+  private:
+    /**
+     * @brief The events that reach the scheduler at the beginning of a slot
+     */
+    struct SlotEvents
+    {
+        std::vector<DlHarqInfo> dlHarq;      //!< DL HARQ feedback
+        std::vector<UlHarqInfo> ulHarq;      //!< UL HARQ feedback
+        std::vector<uint16_t> dlBufferRntis; //!< UEs that report their DL buffer
+        std::vector<uint16_t> bsrRntis;      //!< UEs that report their UL buffer
+        /// UL CQIs of the UL data allocations
+        std::vector<NrMacSchedSapProvider::SchedUlCqiInfoReqParameters> ulCqi;
+    };
+
+    /**
+     * @brief Register the UEs, their LCs and their initial buffers and CQIs
+     */
+    void AddUes();
+
+    /**
+     * @brief Process a slot
+     * @param slot the index of the current slot
+     * @param measure whether to add the slot to the results
+     */
+    void ProcessSlot(uint64_t slot, bool measure);
+
+    /**
+     * @brief Create the events caused by the allocations of the last trigger
+     */
+    void ProcessAllocations();
+
+    /**
+     * @brief Create the DL CQI of a UE
+     * @param rnti the RNTI of the UE
+     * @return the DL CQI
+     */
+    DlCqiInfo CreateDlCqi(uint16_t rnti) const;
+
+    /**
+     * @brief Call a function of the scheduler and measure its duration
+     * @param fn the function
+     * @param isTrigger whether the function is a DL or UL trigger
+     */
+    void Call(const std::function<void()>& fn, bool isTrigger);
+
+    /**
+     * @brief Get the SfnSf of a slot
+     * @param slot the index of the slot
+     * @return the SfnSf
+     */
+    SfnSf GetSfnSf(uint64_t slot) const;
+
+    BenchmarkParams m_params;                              //!< Common parameters
+    uint32_t m_numUes;                                     //!< Number of UEs
+    uint32_t m_numRbgs;                                    //!< Number of RBGs of the cell
+    Ptr<NrMacSchedulerNs3> m_scheduler;                    //!< Scheduler under test
+    BenchmarkCschedSapUser m_cschedSapUser;                //!< CSCHED SAP user
+    std::unique_ptr<BenchmarkSchedSapUser> m_schedSapUser; //!< SCHED SAP user
+    Ptr<UniformRandomVariable> m_random;                   //!< Random CQIs and HARQ feedback
+    std::vector<uint8_t> m_meanCqi;                        //!< Mean DL CQI, per RNTI - 1
+    std::vector<double> m_ulSinr;                          //!< Linear UL SINR, per RNTI - 1
+    std::map<uint64_t, SlotEvents> m_events;               //!< Pending events, per slot index
+    std::vector<SlotAllocInfo> m_allocations;              //!< Decisions of the last trigger
+    bool m_measure{false};                                 //!< Whether the slot is measured
+    BenchmarkResults m_results;                            //!< Results of the measured slots
+};
+
+SchedulerBenchmark::SchedulerBenchmark(const std::string& schedulerType,
+                                       uint32_t numUes,
+                                       uint32_t numRbs,
+                                       const BenchmarkParams& params)
+    : m_params(params),
+      m_numUes(numUes),
+      m_numRbgs(numRbs / params.rbPerRbg)
+{
+    NS_ABORT_MSG_IF(m_numRbgs == 0, "Less RBs than RBs per RBG");
+    NS_ABORT_MSG_IF(numUes == 0 || numUes >= UINT16_MAX, "Invalid number of UEs " << numUes);
+
+    auto tid = TypeId::LookupByName(schedulerType);
+    ObjectFactory factory;
+    factory.SetTypeId(tid);
+    if (tid.IsChildOf(NrMacSchedulerOfdma::GetTypeId()) && !m_params.symPerBeamType.empty())
+    {
+        factory.Set("SymPerBeamType", StringValue(m_params.symPerBeamType));
+    }
+    m_scheduler = DynamicCast<NrMacSchedulerNs3>(factory.Create());
+    NS_ABORT_MSG_IF(!m_scheduler, schedulerType << " is not a NrMacSchedulerNs3");
+
+    auto sm = NrSpectrumValueHelper::GetSpectrumModel(m_numRbgs * m_params.rbPerRbg,
+                                                      3.5e9,
+                                                      15e3 * (1 << m_params.numerology));
+    m_schedSapUser = std::make_unique<BenchmarkSchedSapUser>(
+        [this](const NrMacSchedSapUser::SchedConfigIndParameters& params) {
+            m_allocations.push_back(params.m_slotAllocInfo);
+        },
+        sm,
+        m_params.rbPerRbg,
+        m_params.numerology);
+    m_scheduler->SetMacSchedSapUser(m_schedSapUser.get());
+    m_scheduler->SetMacCschedSapUser(&m_cschedSapUser);
+
+    auto dlAmc = CreateObject<NrAmc>();
+    dlAmc->SetDlMode();
+    m_scheduler->InstallDlAmc(dlAmc);
+    auto ulAmc = CreateObject<NrAmc>();
+    ulAmc->SetUlMode();
+    m_scheduler->InstallUlAmc(ulAmc);
+
+    m_random = CreateObject<UniformRandomVariable>();
+    m_random->SetStream(m_params.stream);
+    m_scheduler->AssignStreams(m_params.stream + 1);
+
+    NrMacCschedSapProvider::CschedCellConfigReqParameters cellConfig{};
+    cellConfig.m_dlBandwidth = m_numRbgs;
+    cellConfig.m_ulBandwidth = m_numRbgs;
+    m_scheduler->GetMacCschedSapProvider()->CschedCellConfigReq(cellConfig);
+
+    AddUes();
+}
+
+void
+SchedulerBenchmark::AddUes()
+{
+    auto cschedSap = m_scheduler->GetMacCschedSapProvider();
+    auto schedSap = m_scheduler->GetMacSchedSapProvider();
+
+    for (uint16_t rnti = 1; rnti <= m_numUes; ++rnti)
+    {
+        m_meanCqi.push_back(m_random->GetInteger(3, 15));
+        m_ulSinr.push_back(std::pow(10.0, m_random->GetValue(-5.0, 25.0) / 10.0));
+
+        NrMacCschedSapProvider::CschedUeConfigReqParameters ueConfig{};
+        ueConfig.m_rnti = rnti;
+        ueConfig.m_beamId = BeamId((rnti - 1) % m_params.numBeams, 0.0);
+        cschedSap->CschedUeConfigReq(ueConfig);
+
+        // Create standard LCGs and LCs, the data goes through the LC 3
+        NrMacCschedSapProvider::CschedLcConfigReqParameters lcConfig{};
+        lcConfig.m_rnti = rnti;
+        lcConfig.m_reconfigureFlag = false;
+        nr::LogicalChannelConfigListElement_s lc;
+        lc.m_direction = nr::LogicalChannelConfigListElement_s::Direction_e::DIR_BOTH;
+        lc.m_qosBearerType = nr::LogicalChannelConfigListElement_s::QosBearerType_e::QBT_NON_GBR;
+        lc.m_fiveQi = 9;
+        for (uint8_t i = 0; i < 4; ++i)
+        {
+            lc.m_logicalChannelGroup = i;
+            lc.m_logicalChannelIdentity = i;
+            lcConfig.m_logicalChannelConfigList.emplace_back(lc);
+        }
+        cschedSap->CschedLcConfigReq(lcConfig);
+
+        NrMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiParams{};
+        cqiParams.m_cqiList.push_back(CreateDlCqi(rnti));
+        schedSap->SchedDlCqiInfoReq(cqiParams);
+
+        m_events[0].dlBufferRntis.push_back(rnti);
+        m_events[0].bsrRntis.push_back(rnti);
+    }
+}
+
+DlCqiInfo
+SchedulerBenchmark::CreateDlCqi(uint16_t rnti) const
+{
+    auto meanCqi = static_cast<int>(m_meanCqi[rnti - 1]);
+    auto drawCqi = [this, meanCqi]() {
+        auto cqi = meanCqi + static_cast<int>(m_random->GetInteger(0, 4)) - 2;
+        return static_cast<uint8_t>(std::clamp(cqi, 1, 15));
+    };
+
+    DlCqiInfo cqi;
+    cqi.m_rnti = rnti;
+    cqi.m_ri = 1;
+    cqi.m_wbCqi = drawCqi();
+    if (m_params.subbandCqi)
+    {
+        cqi.m_cqiType = DlCqiInfo::SB;
+        cqi.m_sbCqis.resize(m_numRbgs);
+        std::generate(cqi.m_sbCqis.begin(), cqi.m_sbCqis.end(), drawCqi);
+    }
+    return cqi;
+}
+
+SfnSf
+SchedulerBenchmark::GetSfnSf(uint64_t slot) const
+{
+    auto sfnSf = SfnSf(0, 0, 0, m_params.numerology);
+    sfnSf.Add(slot);
+    return sfnSf;
+}
+
+void
+SchedulerBenchmark::Call(const std::function<void()>& fn, bool isTrigger)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                             start);
+    if (m_measure)
+    {
+        m_results.schedTime += duration;
+        m_results.triggerTime += isTrigger ? duration : std::chrono::nanoseconds{0};
+    }
+}
+
+void
+SchedulerBenchmark::ProcessSlot(uint64_t slot, bool measure)
+{
+    m_measure = measure;
+    auto schedSap = m_scheduler->GetMacSchedSapProvider();
+    SlotEvents events;
+    if (auto it = m_events.find(slot); it != m_events.end())
+    {
+        events = std::move(it->second);
+        m_events.erase(it);
+    }
+
+    // UL indication: UL CQIs, BSRs and UL trigger for the slot N2 slots after the DL one
+    for (const auto& ulCqi : events.ulCqi)
+    {
+        Call([&]() { schedSap->SchedUlCqiInfoReq(ulCqi); }, false);
+    }
+    if (!events.bsrRntis.empty())
+    {
+        NrMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters bsrParams;
+        bsrParams.m_sfnSf = GetSfnSf(slot);
+        for (auto rnti : events.bsrRntis)
+        {
+            MacCeElement bsr;
+            bsr.m_rnti = rnti;
+            bsr.m_macCeType = MacCeElement::BSR;
+            bsr.m_macCeValue.m_bufferStatus = {0, 0, 0, 0};
+            bsr.m_macCeValue.m_bufferStatus[3] =
+                NrMacShortBsrCe::FromBytesToLevel(m_params.bufferBytes);
+            bsrParams.m_macCeList.push_back(bsr);
+        }
+        Call([&]() { schedSap->SchedUlMacCtrlInfoReq(bsrParams); }, false);
+    }
+
+    NrMacSchedSapProvider::SchedUlTriggerReqParameters ulParams;
+    ulParams.m_snfSf = GetSfnSf(slot + m_params.l1l2CtrlLatency + m_params.n2Delay);
+    ulParams.m_slotType = LteNrTddSlotType::F;
+    ulParams.m_ulHarqInfoList = std::move(events.ulHarq);
+    Call([&]() { schedSap->SchedUlTriggerReq(ulParams); }, true);
+    ProcessAllocations();
+
+    // DL indication: DL CQIs, RLC buffers and DL trigger for the slot L1L2 slots ahead
+    NrMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiParams{};
+    cqiParams.m_sfnsf = GetSfnSf(slot);
+    for (uint32_t rnti = 1 + slot % m_params.cqiPeriod; rnti <= m_numUes;
+         rnti += m_params.cqiPeriod)
+    {
+        cqiParams.m_cqiList.push_back(CreateDlCqi(rnti));
+    }
+    if (!cqiParams.m_cqiList.empty())
+    {
+        Call([&]() { schedSap->SchedDlCqiInfoReq(cqiParams); }, false);
+    }
+    for (auto rnti : events.dlBufferRntis)
+    {
+        NrMacSchedSapProvider::SchedDlRlcBufferReqParameters bufferParams{};
+        bufferParams.m_rnti = rnti;
+        bufferParams.m_logicalChannelIdentity = 3;
+        bufferParams.m_rlcTransmissionQueueSize = m_params.bufferBytes;
+        Call([&]() { schedSap->SchedDlRlcBufferReq(bufferParams); }, false);
+    }
+
+    NrMacSchedSapProvider::SchedDlTriggerReqParameters dlParams;
+    dlParams.m_snfSf = GetSfnSf(slot + m_params.l1l2CtrlLatency);
+    dlParams.m_slotType = LteNrTddSlotType::F;
+    dlParams.m_dlHarqInfoList = std::move(events.dlHarq);
+    Call([&]() { schedSap->SchedDlTriggerReq(dlParams); }, true);
+    ProcessAllocations();
+}
+
+void
+SchedulerBenchmark::ProcessAllocations()
+{
+    for (const auto& slotAlloc : m_allocations)
+    {
+        auto slot = slotAlloc.m_sfnSf.Normalize();
+        std::set<uint8_t> ulSymStarts;
+        for (const auto& varTti : slotAlloc.m_varTtiAllocInfo)
+        {
+            const auto& dci = varTti.m_dci;
+            if (dci->m_type != DciInfoElementTdma::DATA)
+            {
+                continue;
+            }
+            bool ack = m_random->GetValue() >= m_params.bler;
+            if (dci->m_format == DciInfoElementTdma::DL)
+            {
+                DlHarqInfo harq;
+                harq.m_rnti = dci->m_rnti;
+                harq.m_harqProcessId = dci->m_harqProcess;
+                harq.m_bwpIndex = 0;
+                harq.m_numRetx = dci->m_rv;
+                harq.m_harqStatus = ack ? DlHarqInfo::ACK : DlHarqInfo::NACK;
+                m_events[slot + m_params.k1Delay].dlHarq.push_back(harq);
+                m_events[slot].dlBufferRntis.push_back(dci->m_rnti);
+                m_results.dlAllocs += m_measure ? 1 : 0;
+                m_results.dlBytes += m_measure ? dci->m_tbSize : 0;
+            }
+            else
+            {
+                UlHarqInfo harq;
+                harq.m_rnti = dci->m_rnti;
+                harq.m_harqProcessId = dci->m_harqProcess;
+                harq.m_bwpIndex = 0;
+                harq.m_numRetx = dci->m_rv;
+                harq.m_receptionStatus = ack ? UlHarqInfo::Ok : UlHarqInfo::NotOk;
+                m_events[slot + 1].ulHarq.push_back(harq);
+                m_events[slot + 1].bsrRntis.push_back(dci->m_rnti);
+                m_results.ulAllocs += m_measure ? 1 : 0;
+                m_results.ulBytes += m_measure ? dci->m_tbSize : 0;
+
+                // The scheduler expects one UL CQI for each starting symbol
+                if (ulSymStarts.insert(dci->m_symStart).second)
+                {
+                    NrMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi;
+                    ulCqi.m_sfnSf = slotAlloc.m_sfnSf;
+                    ulCqi.m_symStart = dci->m_symStart;
+                    ulCqi.m_ulCqi.m_type = UlCqiInfo::PUSCH;
+                    ulCqi.m_ulCqi.m_sinr.assign(m_numRbgs * m_params.rbPerRbg,
+                                                m_ulSinr[dci->m_rnti - 1]);
+                    m_events[slot + 1].ulCqi.push_back(std::move(ulCqi));
+                }
+            }
+        }
+    }
+    m_allocations.clear();
+}
+
+BenchmarkResults
+SchedulerBenchmark::Run()
+{
+    for (uint64_t slot = 0; slot < m_params.warmupSlots + m_params.numSlots; ++slot)
+    {
+        ProcessSlot(slot, slot >= m_params.warmupSlots);
+    }
+    m_scheduler->Dispose();
+    return m_results;
+}
+
+/**
+ * @brief Get the peak resident memory of the process
+ * @return the peak resident memory, in MB, or a negative value if it is not available
+ */
+static double
+GetPeakMemoryMb()
+{
+#if defined(__APPLE__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / (1024.0 * 1024.0); // bytes
+#elif defined(__unix__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0; // kilobytes
+#else
+    return -1.0;
+#endif
+}
+
+/**
+ * @brief Split a list of values separated by vertical bars
+ * @param values the values, e.g., "OfdmaRR|OfdmaPF"
+ * @return the values
+ */
+static std::vector<std::string>
+SplitVBarSeparatedValues(const std::string& values)
+{
+    std::vector<std::string> result;
+    std::stringstream ss(values);
+    std::string value;
+    while (std::getline(ss, value, '|'))
+    {
+        if (!value.empty())
+        {
+            result.push_back(value);
+        }
+    }
+    return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string schedulers = "OfdmaRR|OfdmaPF|OfdmaMR|OfdmaQos|OfdmaRandom|"
+                             "TdmaRR|TdmaPF|TdmaMR|TdmaQos|TdmaRandom";
+    std::string ueCounts = "10|100|500|2000";
+    std::string rbCounts = "25|52|106|273";
+    BenchmarkParams params;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("schedulers",
+                 "Schedulers to measure, separated by |, with or without the "
+                 "ns3::NrMacScheduler prefix",
+                 schedulers);
+    cmd.AddValue("ueCounts", "Numbers of UEs, separated by |", ueCounts);
+    cmd.AddValue("rbCounts", "Numbers of RBs of the cell, separated by |", rbCounts);
+    cmd.AddValue("numSlots", "Number of measured slots", params.numSlots);
+    cmd.AddValue("warmupSlots", "Number of slots before the measurement", params.warmupSlots);
+    cmd.AddValue("numerology", "The numerology of the cell", params.numerology);
+    cmd.AddValue("rbPerRbg", "Number of RBs per RBG", params.rbPerRbg);
+    cmd.AddValue("numBeams", "Number of beams among which the UEs are spread", params.numBeams);
+    cmd.AddValue("symPerBeamType",
+                 "Symbol allocation per beam of the OFDMA schedulers (LOAD_BASED, "
+                 "ROUND_ROBIN or PROPORTIONAL_FAIR), empty for the default",
+                 params.symPerBeamType);
+    cmd.AddValue("cqiPeriod", "DL CQI period of each UE, in slots", params.cqiPeriod);
+    cmd.AddValue("subbandCqi", "Report one DL CQI per RBG", params.subbandCqi);
+    cmd.AddValue("bler", "Probability of a negative HARQ feedback", params.bler);
+    cmd.AddValue("bufferBytes", "Buffer of each UE, in DL and UL", params.bufferBytes);
+    cmd.AddValue("stream", "First random stream", params.stream);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(params.numSlots == 0, "No slot to measure");
+    NS_ABORT_MSG_IF(params.cqiPeriod == 0, "The CQI period must be positive");
+    NS_ABORT_MSG_IF(params.numBeams == 0, "At least one beam is needed");
+
+    std::cout << std::left << std::setw(34) << "scheduler" << std::right << std::setw(6) << "UEs"
+              << std::setw(6) << "RBs" << std::setw(12) << "ns/slot" << std::setw(12)
+              << "trig ns/slot" << std::setw(10) << "DL DCIs" << std::setw(10) << "UL DCIs"
+              << std::setw(12) << "DL B/slot" << std::setw(12) << "UL B/slot" << std::setw(10)
+              << "peak MB" << std::endl;
+    std::cout << std::fixed;
+
+    for (auto scheduler : SplitVBarSeparatedValues(schedulers))
+    {
+        if (scheduler.rfind("ns3::", 0) != 0)
+        {
+            scheduler = "ns3::NrMacScheduler" + scheduler;
+        }
+        for (auto ueCount : ParseVBarSeparatedValuesStringToVector(ueCounts))
+        {
+            for (auto rbCount : ParseVBarSeparatedValuesStringToVector(rbCounts))
+            {
+                auto numUes = static_cast<uint32_t>(ueCount);
+                auto numRbs = static_cast<uint32_t>(rbCount);
+                SchedulerBenchmark benchmark(scheduler, numUes, numRbs, params);
+                auto results = benchmark.Run();
+                double slots = params.numSlots;
+
+                std::cout << std::left << std::setw(34) << scheduler << std::right
+                          << std::setw(6) << numUes << std::setw(6) << numRbs
+                          << std::setprecision(0) << std::setw(12)
+                          << results.schedTime.count() / slots << std::setw(12)
+                          << results.triggerTime.count() / slots << std::setprecision(2)
+                          << std::setw(10) << results.dlAllocs / slots << std::setw(10)
+                          << results.ulAllocs / slots << std::setprecision(0) << std::setw(12)
+                          << results.dlBytes / slots << std::setw(12)
+                          << results.ulBytes / slots << std::setprecision(1) << std::setw(10)
+                          << GetPeakMemoryMb() << std::endl;
+            }
+        }
+    }
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -418,25 +418,26 @@ NrHelper::CreateUePhy(const Ptr<Node>& n,
     if (phasedChannel)
     {
         pDataMimo = Create<NrMimoChunkProcessor>();
-        pDataMimo->AddCallback(MakeCallback(&NrSpectrumPhy::UpdateMimoSinrPerceived, channelPhy));
+        pDataMimo->AddSinrCallback(
+            MakeCallback(&NrSpectrumPhy::UpdateMimoSinrPerceived, channelPhy));
         channelPhy->AddDataMimoChunkProcessor(pDataMimo);
 
         if (m_csiFeedbackFlags & CQI_PDSCH_MIMO)
         {
             // Report DL CQI, PMI, RI (channel quality, MIMO precoding matrix and rank indicators)
-            pDataMimo->AddCallback(MakeCallback(&NrUePhy::PdschMimoReceived, phy));
+            pDataMimo->AddSignalCallback(MakeCallback(&NrUePhy::PdschMimoReceived, phy));
         }
 
         if (m_csiFeedbackFlags & CQI_CSI_RS)
         {
             Ptr<NrMimoChunkProcessor> pCsiRs = Create<NrMimoChunkProcessor>();
-            pCsiRs->AddCallback(MakeCallback(&NrUePhy::CsiRsReceived, phy));
+            pCsiRs->AddSignalCallback(MakeCallback(&NrUePhy::CsiRsReceived, phy));
             channelPhy->AddCsiRsMimoChunkProcessor(pCsiRs);
             // currently, CSI_IM can be enabled only if CSI-RS is enabled
             if (m_csiFeedbackFlags & CQI_CSI_IM)
             {
                 Ptr<NrMimoChunkProcessor> pCsiIm = Create<NrMimoChunkProcessor>();
-                pCsiIm->AddCallback(MakeCallback(&NrUePhy::CsiImEnded, phy));
+                pCsiIm->AddSignalCallback(MakeCallback(&NrUePhy::CsiImEnded, phy));
                 channelPhy->AddCsiImMimoChunkProcessor(pCsiIm);
             }
         }
@@ -664,7 +665,7 @@ NrHelper::CreateGnbPhy(const Ptr<Node>& n,
         if (phasedChannel)
         {
             auto pDataMimo = Create<NrMimoChunkProcessor>();
-            pDataMimo->AddCallback(
+            pDataMimo->AddSinrCallback(
                 MakeCallback(&NrSpectrumPhy::UpdateMimoSinrPerceived, channelPhy));
             channelPhy->AddDataMimoChunkProcessor(pDataMimo);
         }
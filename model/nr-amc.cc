@@ -16,12 +16,99 @@
 #include "ns3/object-factory.h"
 #include "ns3/uinteger.h"
 
+#include <array>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("NrAmc");
 NS_OBJECT_ENSURE_REGISTERED(NrAmc);
 
+/**
+ * @brief Payload and TB sizes indexed by (mcs, rank, nprb)
+ *
+ * Each entry is computed the first time that it is read, because the error model
+ * may not support all the combinations (e.g., the LENA error model with a large nprb).
+ * The rows are allocated on first use, and the entries are atomic, so that the
+ * table can be read and filled from several threads.
+ */
+class NrAmc::TbSizeTable
+{
+  public:
+    /**
+     * @brief Get the table of a configuration, creating it if it does not exist yet
+     * @param type the TypeId of the error model
+     * @param numRefScPerRb the number of reference subcarriers per RB
+     * @param mode the error model mode
+     * @return the table shared by all the NrAmc with this configuration
+     */
+    static std::shared_ptr<TbSizeTable> Get(const TypeId& type,
+                                            uint8_t numRefScPerRb,
+                                            NrErrorModel::Mode mode)
+    {
+        using Key = std::tuple<uint16_t, uint8_t, int>;
+        static std::mutex mutex;
+        static std::map<Key, std::shared_ptr<TbSizeTable>> tables;
+
+        std::lock_guard lock(mutex);
+        auto& table = tables[Key{type.GetUid(), numRefScPerRb, static_cast<int>(mode)}];
+        if (!table)
+        {
+            table = std::make_shared<TbSizeTable>();
+        }
+        return table;
+    }
+
+    /**
+     * @brief Get the entry of an allocation
+     * @param mcs the MCS index
+     * @param rank the MIMO rank
+     * @param nprb RBs (for per-symbol) or RBs * symbols (for full block)
+     * @return the entry, or nullptr if the allocation is outside the table
+     */
+    std::atomic<uint64_t>* GetEntry(uint8_t mcs, uint8_t rank, uint32_t nprb)
+    {
+        if (mcs >= MAX_MCS || rank == 0 || rank > MAX_RANK || nprb >= MAX_NPRB)
+        {
+            return nullptr;
+        }
+        auto& rowPtr = m_rows[mcs * MAX_RANK + rank - 1];
+        auto row = rowPtr.load(std::memory_order_acquire);
+        if (row == nullptr)
+        {
+            std::lock_guard lock(m_mutex);
+            row = rowPtr.load(std::memory_order_relaxed);
+            if (row == nullptr)
+            {
+                auto& newRow = m_storage.emplace_back(new std::atomic<uint64_t>[MAX_NPRB]);
+                for (uint32_t i = 0; i < MAX_NPRB; ++i)
+                {
+                    newRow[i].store(EMPTY, std::memory_order_relaxed);
+                }
+                row = newRow.get();
+                rowPtr.store(row, std::memory_order_release);
+            }
+        }
+        return &row[nprb];
+    }
+
+    static constexpr uint64_t EMPTY = std::numeric_limits<uint64_t>::max(); //!< Not computed
+
+  private:
+    static constexpr uint32_t MAX_MCS = 32;   //!< Number of MCS indexes in the table
+    static constexpr uint32_t MAX_RANK = 8;   //!< Maximum rank in the table
+    static constexpr uint32_t MAX_NPRB = 4096; //!< Number of nprb values in the table
+
+    std::array<std::atomic<std::atomic<uint64_t>*>, MAX_MCS * MAX_RANK> m_rows{}; //!< Rows
+    std::mutex m_mutex; //!< Protects the allocation of the rows
+    std::vector<std::unique_ptr<std::atomic<uint64_t>[]>> m_storage; //!< Owns the rows
+};
+
 NrAmc::NrAmc()
 {
     NS_LOG_INFO("Initialize AMC module");
@@ -36,6 +123,7 @@ NrAmc::SetDlMode()
 {
     NS_LOG_FUNCTION(this);
     m_emMode = NrErrorModel::DL;
+    UpdateTbSizeTable();
 }
 
 void
@@ -43,6 +131,7 @@ NrAmc::SetUlMode()
 {
     NS_LOG_FUNCTION(this);
     m_emMode = NrErrorModel::UL;
+    UpdateTbSizeTable();
 }
 
 TypeId
@@ -71,6 +160,18 @@ NrAmc::GetTypeId()
                           TypeIdValue(NrLteMiErrorModel::GetTypeId()),
                           MakeTypeIdAccessor(&NrAmc::SetErrorModelType, &NrAmc::GetErrorModelType),
                           MakeTypeIdChecker())
+            .AddAttribute("McsSearch",
+                          "Algorithm used to find the maximum MCS that satisfies the target "
+                          "TBLER when AmcModel is set to ErrorModel. Linear evaluates the MCSs "
+                          "from 0 upwards; Bisection needs a logarithmic number of evaluations, "
+                          "starting from the previous MCS of the link when it is known, and "
+                          "gives the same result whenever the TBLER is monotone in the MCS",
+                          EnumValue(NrAmc::LinearSearch),
+                          MakeEnumAccessor<McsSearch>(&NrAmc::SetMcsSearch, &NrAmc::GetMcsSearch),
+                          MakeEnumChecker(NrAmc::LinearSearch,
+                                          "Linear",
+                                          NrAmc::BisectionSearch,
+                                          "Bisection"))
             .AddConstructor<NrAmc>();
     return tid;
 }
@@ -110,6 +211,7 @@ NrAmc::SetNumRefScPerRb(uint8_t nref)
 {
     NS_LOG_FUNCTION(this);
     m_numRefScPerRb = nref;
+    UpdateTbSizeTable();
 }
 
 uint32_t
@@ -121,7 +223,48 @@ NrAmc::CalculateTbSize(uint8_t mcs, uint8_t rank, uint32_t nprb) const
                   "MCS=" << static_cast<uint32_t>(mcs) << " while maximum MCS is "
                          << static_cast<uint32_t>(m_errorModel->GetMaxMcs()));
 
-    uint32_t payloadSize = GetPayloadSize(mcs, rank, nprb);
+    uint32_t tbSize = GetPayloadAndTbSize(mcs, rank, nprb).second;
+
+    NS_LOG_INFO(" mcs:" << (unsigned)mcs << " TB size:" << tbSize);
+
+    return tbSize;
+}
+
+uint32_t
+NrAmc::GetPayloadSize(uint8_t mcs, uint8_t rank, uint32_t nprb) const
+{
+    return GetPayloadAndTbSize(mcs, rank, nprb).first;
+}
+
+std::pair<uint32_t, uint32_t>
+NrAmc::GetPayloadAndTbSize(uint8_t mcs, uint8_t rank, uint32_t nprb) const
+{
+    auto entry = m_tbSizeTable ? m_tbSizeTable->GetEntry(mcs, rank, nprb) : nullptr;
+    if (entry == nullptr)
+    {
+        return ComputePayloadAndTbSize(mcs, rank, nprb);
+    }
+
+    auto value = entry->load(std::memory_order_relaxed);
+    if (value == TbSizeTable::EMPTY)
+    {
+        auto [payloadSize, tbSize] = ComputePayloadAndTbSize(mcs, rank, nprb);
+        value = (static_cast<uint64_t>(payloadSize) << 32) | tbSize;
+        entry->store(value, std::memory_order_relaxed);
+    }
+    return {static_cast<uint32_t>(value >> 32), static_cast<uint32_t>(value)};
+}
+
+std::pair<uint32_t, uint32_t>
+NrAmc::ComputePayloadAndTbSize(uint8_t mcs, uint8_t rank, uint32_t nprb) const
+{
+    uint32_t payloadSize =
+        m_errorModel->GetPayloadSize(NrSpectrumValueHelper::SUBCARRIERS_PER_RB -
+                                         GetNumRefScPerRb(),
+                                     mcs,
+                                     rank,
+                                     nprb,
+                                     m_emMode);
     uint32_t tbSize = payloadSize;
 
     if (m_errorModelType != LenaErrorModel::GetTypeId())
@@ -143,24 +286,22 @@ NrAmc::CalculateTbSize(uint8_t mcs, uint8_t rank, uint32_t nprb) const
         }
     }
 
-    NS_LOG_INFO(" mcs:" << (unsigned)mcs << " TB size:" << tbSize);
-
-    return tbSize;
+    return {payloadSize, tbSize};
 }
 
-uint32_t
-NrAmc::GetPayloadSize(uint8_t mcs, uint8_t rank, uint32_t nprb) const
+void
+NrAmc::UpdateTbSizeTable()
 {
-    return m_errorModel->GetPayloadSize(NrSpectrumValueHelper::SUBCARRIERS_PER_RB -
-                                            GetNumRefScPerRb(),
-                                        mcs,
-                                        rank,
-                                        nprb,
-                                        m_emMode);
+    NS_LOG_FUNCTION(this);
+    m_tbSizeTable = m_errorModel
+                        ? TbSizeTable::Get(m_errorModelType, m_numRefScPerRb, m_emMode)
+                        : nullptr;
 }
 
 uint8_t
-NrAmc::CreateCqiFeedbackSiso(const SpectrumValue& sinr, uint8_t& mcs) const
+NrAmc::CreateCqiFeedbackSiso(const SpectrumValue& sinr,
+                             uint8_t& mcs,
+                             std::optional<uint8_t> seedMcs) const
 {
     NS_LOG_FUNCTION(this);
 
@@ -218,46 +359,15 @@ NrAmc::CreateCqiFeedbackSiso(const SpectrumValue& sinr, uint8_t& mcs) const
             rbId += 1;
         }
 
-        mcs = 0;
-        Ptr<NrErrorModelOutput> output;
-        while (mcs <= m_errorModel->GetMaxMcs())
-        {
+        // The SINR and the RB map are the same for all the MCSs
+        auto tblerEvaluator = m_errorModel->GetTblerEvaluator(sinr, rbMap);
+        auto isValid = [&](uint8_t m) {
             uint8_t rank = 1; // This function is SISO only
-            auto tbSize = CalculateTbSize(mcs, rank, rbMap.size());
-            output = m_errorModel->GetTbDecodificationStats(sinr,
-                                                            rbMap,
-                                                            tbSize,
-                                                            mcs,
-                                                            NrErrorModel::NrErrorModelHistory());
-            if (output->m_tbler > 0.1)
-            {
-                break;
-            }
-            mcs++;
-        }
-
-        if (mcs > 0)
-        {
-            mcs--;
-        }
-
-        if ((output->m_tbler > 0.1) && (mcs == 0))
-        {
-            cqi = 0;
-        }
-        else if (mcs == m_errorModel->GetMaxMcs())
-        {
-            cqi = 15; // all MCSs can guarantee the 10 % of BER
-        }
-        else
-        {
-            double s = m_errorModel->GetSpectralEfficiencyForMcs(mcs);
-            cqi = 0;
-            while ((cqi < 15) && (m_errorModel->GetSpectralEfficiencyForCqi(cqi + 1) <= s))
-            {
-                ++cqi;
-            }
-        }
+            auto tbSize = CalculateTbSize(m, rank, rbMap.size());
+            return !(tblerEvaluator(tbSize, m) > 0.1);
+        };
+        mcs = SearchMaxMcs(isValid, seedMcs);
+        cqi = GetWbCqiFromMcs(mcs);
         NS_LOG_DEBUG(this << "\t MCS " << (uint16_t)mcs << "-> CQI " << cqi);
     }
     return cqi;
@@ -313,6 +423,20 @@ NrAmc::GetAmcModel() const
     return m_amcModel;
 }
 
+void
+NrAmc::SetMcsSearch(NrAmc::McsSearch s)
+{
+    NS_LOG_FUNCTION(this);
+    m_mcsSearch = s;
+}
+
+NrAmc::McsSearch
+NrAmc::GetMcsSearch() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_mcsSearch;
+}
+
 void
 NrAmc::SetErrorModelType(const TypeId& type)
 {
@@ -324,6 +448,7 @@ NrAmc::SetErrorModelType(const TypeId& type)
     m_errorModel = DynamicCast<NrErrorModel>(factory.Create());
     NS_ASSERT(m_errorModel != nullptr);
     m_cachedCqiToMcsMap.clear(); // clear stale cache
+    UpdateTbSizeTable();
 }
 
 TypeId
@@ -349,11 +474,14 @@ NrAmc::GetBer() const
 }
 
 NrAmc::McsParams
-NrAmc::GetMaxMcsParams(const NrSinrMatrix& sinrMat, size_t subbandSize) const
+NrAmc::GetMaxMcsParams(const NrSinrMatrix& sinrMat,
+                       size_t subbandSize,
+                       std::optional<uint8_t> seedMcs) const
 {
-    auto wbMcs = GetMcs(sinrMat);
+    auto wbMcs = GetMcs(sinrMat, seedMcs);
     auto wbCqi = GetWbCqiFromMcs(wbMcs);
-    auto sbMcs = GetSbMcs(subbandSize, sinrMat);
+    // The subband MCSs are usually close to the wideband one
+    auto sbMcs = GetSbMcs(subbandSize, sinrMat, wbMcs);
 
     std::vector<uint8_t> sbCqis;
     sbCqis.resize(sbMcs.size());
@@ -367,7 +495,9 @@ NrAmc::GetMaxMcsParams(const NrSinrMatrix& sinrMat, size_t subbandSize) const
 }
 
 std::vector<uint8_t>
-NrAmc::GetSbMcs(const size_t subbandSize, const NrSinrMatrix& sinrMat) const
+NrAmc::GetSbMcs(const size_t subbandSize,
+                const NrSinrMatrix& sinrMat,
+                std::optional<uint8_t> seedMcs) const
 {
     auto nRbs = sinrMat.GetNumRbs();
     auto nSbs = (nRbs + subbandSize - 1) / subbandSize;
@@ -377,7 +507,7 @@ NrAmc::GetSbMcs(const size_t subbandSize, const NrSinrMatrix& sinrMat) const
     for (size_t i = 0; i < sbMcs.size(); i++)
     {
         auto sinrSb = ExtractSbFromMat(i, i != (nSbs - 1) ? subbandSize : lastSubbandSize, sinrMat);
-        sbMcs[i] = GetMcs(sinrSb);
+        sbMcs[i] = GetMcs(sinrSb, seedMcs);
     }
     return sbMcs;
 }
@@ -415,7 +545,7 @@ NrAmc::CreateSinrMatForSb(const NrSinrMatrix& avgSinrSb, const NrSinrMatrix& sin
 }
 
 uint8_t
-NrAmc::GetMcs(const NrSinrMatrix& sinrMat) const
+NrAmc::GetMcs(const NrSinrMatrix& sinrMat, std::optional<uint8_t> seedMcs) const
 {
     auto mcs = uint8_t{0};
     switch (m_amcModel)
@@ -424,7 +554,7 @@ NrAmc::GetMcs(const NrSinrMatrix& sinrMat) const
         NS_ABORT_MSG("ShannonModel is not yet supported");
         break;
     case ErrorModel:
-        mcs = GetMaxMcsForErrorModel(sinrMat);
+        mcs = GetMaxMcsForErrorModel(sinrMat, seedMcs);
         break;
     default:
         NS_ABORT_MSG("AMC model not supported");
@@ -434,27 +564,85 @@ NrAmc::GetMcs(const NrSinrMatrix& sinrMat) const
 }
 
 uint8_t
-NrAmc::GetMaxMcsForErrorModel(const NrSinrMatrix& sinrMat) const
+NrAmc::GetMaxMcsForErrorModel(const NrSinrMatrix& sinrMat, std::optional<uint8_t> seedMcs) const
 {
-    auto mcs = uint8_t{0};
-    while (mcs <= m_errorModel->GetMaxMcs())
-    {
-        auto tbler = CalcTblerForMimoMatrix(mcs, sinrMat);
+    // The SINR matrix is the same for all the MCSs
+    auto tblerEvaluator = CreateTblerEvaluatorForMimoMatrix(sinrMat);
+    auto isValid = [&](uint8_t mcs) {
+        auto tbler = tblerEvaluator(CalcTbSizeForMimoMatrix(mcs, sinrMat), mcs);
         // TODO: Change target TBLER from default 0.1 when using MCS table 3
-        if (tbler > 0.1)
+        return !(tbler > 0.1);
+    };
+    return SearchMaxMcs(isValid, seedMcs);
+}
+
+uint8_t
+NrAmc::SearchMaxMcs(const std::function<bool(uint8_t)>& isValid,
+                    std::optional<uint8_t> seedMcs) const
+{
+    const auto maxMcs = static_cast<int>(m_errorModel->GetMaxMcs());
+
+    if (m_mcsSearch == LinearSearch)
+    {
+        auto mcs = 0;
+        while (mcs <= maxMcs && isValid(mcs))
         {
-            break;
+            // The current configuration produces a sufficiently low TBLER, try next value
+            mcs++;
         }
-        // The current configuration produces a sufficiently low TBLER, try next value
-        mcs++;
+        // The loop exited because the MCS exceeded max MCS or because of high TBLER. Reduce MCS
+        return static_cast<uint8_t>(std::max(mcs - 1, 0));
     }
-    if (mcs > 0)
+
+    // Invariant: lo is valid (or -1, below MCS 0), hi is not valid (or maxMcs + 1)
+    auto lo = -1;
+    auto hi = maxMcs + 1;
+    if (seedMcs.has_value())
     {
-        // The loop exited because the MCS exceeded max MCS or because of high TBLER. Reduce MCS
-        mcs--;
+        // Widen the interval around the seed until it contains the boundary
+        auto seed = std::min(static_cast<int>(seedMcs.value()), maxMcs);
+        if (isValid(seed))
+        {
+            lo = seed;
+            for (auto step = 1; lo + step <= maxMcs; step *= 2)
+            {
+                if (!isValid(lo + step))
+                {
+                    hi = lo + step;
+                    break;
+                }
+                lo += step;
+            }
+        }
+        else
+        {
+            hi = seed;
+            for (auto step = 1; hi - step >= 0; step *= 2)
+            {
+                if (isValid(hi - step))
+                {
+                    lo = hi - step;
+                    break;
+                }
+                hi -= step;
+            }
+        }
     }
 
-    return mcs;
+    while (hi - lo > 1)
+    {
+        auto mid = lo + (hi - lo) / 2;
+        if (isValid(mid))
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    NS_LOG_LOGIC("Bisection found MCS " << std::max(lo, 0));
+    return static_cast<uint8_t>(std::max(lo, 0));
 }
 
 uint8_t
@@ -487,10 +675,6 @@ NrAmc::GetWbCqiFromMcs(uint8_t mcs) const
 double
 NrAmc::CalcTblerForMimoMatrix(uint8_t mcs, const NrSinrMatrix& sinrMat) const
 {
-    auto dummyRnti = uint16_t{0};
-    auto duration = Time{1.0}; // Use an arbitrary non-zero time as the chunk duration
-    auto mimoChunk = MimoSinrChunk{sinrMat, dummyRnti, duration};
-    auto mimoChunks = std::vector<MimoSinrChunk>{mimoChunk};
     auto rank = sinrMat.GetRank();
 
     // Create the RB map (indices of used RBs, i.e., indices of RBs where SINR is non-zero)
@@ -511,15 +695,37 @@ NrAmc::CalcTblerForMimoMatrix(uint8_t mcs, const NrSinrMatrix& sinrMat) const
 
     auto tbSize = CalcTbSizeForMimoMatrix(mcs, sinrMat);
     auto dummyHistory = NrErrorModel::NrErrorModelHistory{}; // Create empty HARQ history
-    auto outputOfEm = m_errorModel->GetTbDecodificationStatsMimo(mimoChunks,
-                                                                 rbMap,
-                                                                 tbSize,
-                                                                 mcs,
-                                                                 rank,
-                                                                 dummyHistory);
+    // The SINR matrix is read in place, without building SINR chunks or a SpectrumValue
+    auto outputOfEm = m_errorModel->GetTbDecodificationStatsMimoSpan(sinrMat.GetVectorizedValues(),
+                                                                     rank,
+                                                                     rbMap,
+                                                                     tbSize,
+                                                                     mcs,
+                                                                     dummyHistory);
     return outputOfEm->m_tbler;
 }
 
+NrErrorModel::TblerEvaluator
+NrAmc::CreateTblerEvaluatorForMimoMatrix(const NrSinrMatrix& sinrMat) const
+{
+    // Create the RB map (indices of used RBs, i.e., indices of RBs where SINR is non-zero)
+    std::vector<int> rbMap{};
+    int nRbs = static_cast<int>(sinrMat.GetNumRbs());
+    for (int rbIdx = 0; rbIdx < nRbs; rbIdx++)
+    {
+        if (sinrMat(0, rbIdx) != 0.0)
+        {
+            rbMap.push_back(rbIdx);
+        }
+    }
+
+    if (rbMap.empty())
+    {
+        return [](uint32_t, uint8_t) { return 1.0; };
+    }
+    return m_errorModel->GetTblerEvaluatorMimo(sinrMat, rbMap);
+}
+
 uint32_t
 NrAmc::CalcTbSizeForMimoMatrix(uint8_t mcs, const NrSinrMatrix& sinrMat) const
 {
@@ -8,6 +8,11 @@
 #include "nr-error-model.h"
 #include "nr-phy-mac-common.h"
 
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
 namespace ns3
 {
 
@@ -81,6 +86,18 @@ class NrAmc : public Object
         ErrorModel    //!< Error Model version (can use different error models, see NrErrorModel)
     };
 
+    /**
+     * @brief Algorithms used to find the maximum MCS that satisfies the target TBLER
+     *
+     * Both algorithms query the error model with the same SINR values; they only
+     * differ in the sequence of MCSs that are evaluated.
+     */
+    enum McsSearch
+    {
+        LinearSearch,   //!< Try all MCSs from 0 upwards, until the first one exceeding the TBLER
+        BisectionSearch //!< Bracket the boundary (around a seed MCS, if any) and bisect it
+    };
+
     /**
      * @brief Get the MCS value from a CQI value
      * @param cqi the CQI
@@ -119,9 +136,13 @@ class NrAmc : public Object
      *
      * @param sinr the sinr values
      * @param mcsWb The calculated MCS
+     * @param seedMcs a previous MCS for the same link, used as the starting point
+     * of the search when the McsSearch attribute is set to Bisection
      * @return The calculated CQI
      */
-    uint8_t CreateCqiFeedbackSiso(const SpectrumValue& sinr, uint8_t& mcsWb) const;
+    uint8_t CreateCqiFeedbackSiso(const SpectrumValue& sinr,
+                                  uint8_t& mcsWb,
+                                  std::optional<uint8_t> seedMcs = std::nullopt) const;
 
     /**
      * @brief Get CQI from a SpectralEfficiency value
@@ -154,6 +175,17 @@ class NrAmc : public Object
      */
     AmcModel GetAmcModel() const;
 
+    /**
+     * @brief Set the algorithm used to find the maximum MCS with the error model
+     * @param s the MCS search algorithm
+     */
+    void SetMcsSearch(McsSearch s);
+    /**
+     * @brief Get the algorithm used to find the maximum MCS with the error model
+     * @return the MCS search algorithm
+     */
+    McsSearch GetMcsSearch() const;
+
     /**
      * @brief Set Error model type
      * @param type the Error model type
@@ -228,19 +260,27 @@ class NrAmc : public Object
     /// @brief Find maximum MCS supported for this channel and obtain related parameters
     /// @param sinrMat the MIMO SINR matrix (rank * nRbs)
     /// @param subbandSize the size of each subband, used to create subband CQI values
+    /// @param seedMcs a previous MCS for the same link, used as the starting point of the search
     /// @return a struct with the optimal MCS and corresponding CQI and TB size
-    McsParams GetMaxMcsParams(const NrSinrMatrix& sinrMat, size_t subbandSize) const;
+    McsParams GetMaxMcsParams(const NrSinrMatrix& sinrMat,
+                              size_t subbandSize,
+                              std::optional<uint8_t> seedMcs = std::nullopt) const;
 
     /// @brief Find Sb MCS supported for this channel
     /// @param subbandSize the size of each subband, used to create subband CQI values
     /// @param sinrMat the MIMO SINR matrix (rank * nRbs)
+    /// @param seedMcs the MCS used as the starting point of the search in each subband
     /// @return the vector of MCS for subband
-    std::vector<uint8_t> GetSbMcs(const size_t subbandSize, const NrSinrMatrix& sinrMat) const;
+    std::vector<uint8_t> GetSbMcs(const size_t subbandSize,
+                                  const NrSinrMatrix& sinrMat,
+                                  std::optional<uint8_t> seedMcs = std::nullopt) const;
 
     /// @brief Find MCS supported for this channel
     /// @param sinrMat the MIMO SINR matrix (rank * nRbs)
+    /// @param seedMcs a previous MCS for the same link, used as the starting point of the search
     /// @return the MCS
-    uint8_t GetMcs(const NrSinrMatrix& sinrMat) const;
+    uint8_t GetMcs(const NrSinrMatrix& sinrMat,
+                   std::optional<uint8_t> seedMcs = std::nullopt) const;
 
     /// @brief Create wide-band matrix based on average sinr of particular sub-band
     /// @param avgSinrSb the average sinr of sub-band
@@ -284,8 +324,25 @@ class NrAmc : public Object
   private:
     /// @brief Find maximum MCS supported for this channel, using the NR error model
     /// @param sinrMat the MIMO SINR matrix (rank * nRbs)
+    /// @param seedMcs the MCS used as the starting point of the search, if any
     /// @return the maximum MCS
-    uint8_t GetMaxMcsForErrorModel(const NrSinrMatrix& sinrMat) const;
+    uint8_t GetMaxMcsForErrorModel(const NrSinrMatrix& sinrMat,
+                                   std::optional<uint8_t> seedMcs) const;
+
+    /// @brief Find the maximum MCS that satisfies the target TBLER, following m_mcsSearch
+    ///
+    /// With LinearSearch, the MCSs are tried from 0 upwards and the search stops at the
+    /// first one that is not valid. With BisectionSearch, an interval around the seed is
+    /// first widened exponentially (1, 2, 4, ... MCSs) until it contains the boundary between
+    /// valid and non-valid MCSs, and then bisected. Both return the same MCS when validity
+    /// is monotone in the MCS; otherwise the bisection returns a valid MCS whose successor
+    /// is not valid, which is not necessarily the lowest such boundary.
+    ///
+    /// @param isValid returns true if the given MCS satisfies the target TBLER
+    /// @param seedMcs the MCS used as the starting point of the bisection, if any
+    /// @return the maximum valid MCS, or 0 if no MCS is valid
+    uint8_t SearchMaxMcs(const std::function<bool(uint8_t)>& isValid,
+                         std::optional<uint8_t> seedMcs) const;
 
     /// @brief Compute the CQI value that corresponds to this MCS
     /// @param mcs the MCS
@@ -298,6 +355,13 @@ class NrAmc : public Object
     /// @return the TB size
     uint32_t CalcTbSizeForMimoMatrix(uint8_t mcs, const NrSinrMatrix& sinrMat) const;
 
+    /// @brief Create an evaluator of the TBLER for this channel, for any MCS and TB size,
+    /// using the NR error model
+    /// @param sinrMat the MIMO SINR matrix (rank * nRbs)
+    /// @return the TBLER evaluator (which always returns 1 if no RB has a non-zero SINR)
+    NrErrorModel::TblerEvaluator CreateTblerEvaluatorForMimoMatrix(
+        const NrSinrMatrix& sinrMat) const;
+
     /// @brief Compute the TBLER for this channel and MCS, using the NR error model
     /// @param mcs the MCS
     /// @param sinrMat the MIMO SINR matrix (rank * nRbs)
@@ -310,14 +374,53 @@ class NrAmc : public Object
      */
     double GetBer() const;
 
+    /**
+     * @brief Payload and TB sizes of an error model type, number of reference subcarriers
+     * per RB and error model mode, filled as they are used
+     *
+     * The sizes only depend on these parameters (the MCS table is given by the error model
+     * type), so the table is shared by all the NrAmc instances with the same ones.
+     */
+    class TbSizeTable;
+
+    /**
+     * @brief Get the payload and TB sizes of an allocation, from the table if possible
+     * @param mcs the MCS index of the transmission
+     * @param rank the MIMO rank (number of spatial layers)
+     * @param nprb RBs (for per-symbol) or RBs * symbols (for full block)
+     * @return the payload size and the TB size, in bytes
+     */
+    std::pair<uint32_t, uint32_t> GetPayloadAndTbSize(uint8_t mcs,
+                                                      uint8_t rank,
+                                                      uint32_t nprb) const;
+
+    /**
+     * @brief Compute the payload and TB sizes of an allocation with the error model
+     * @param mcs the MCS index of the transmission
+     * @param rank the MIMO rank (number of spatial layers)
+     * @param nprb RBs (for per-symbol) or RBs * symbols (for full block)
+     * @return the payload size and the TB size, in bytes
+     */
+    std::pair<uint32_t, uint32_t> ComputePayloadAndTbSize(uint8_t mcs,
+                                                          uint8_t rank,
+                                                          uint32_t nprb) const;
+
+    /**
+     * @brief Select the TB size table that matches the error model type, the number of
+     * reference subcarriers per RB and the error model mode
+     */
+    void UpdateTbSizeTable();
+
   private:
     AmcModel m_amcModel;                           //!< Type of the CQI feedback model
+    McsSearch m_mcsSearch{LinearSearch};           //!< Algorithm to find the maximum MCS
     Ptr<NrErrorModel> m_errorModel;                //!< Pointer to an instance of ErrorModel
     TypeId m_errorModelType;                       //!< Type of the error model
     uint8_t m_numRefScPerRb{1};                    //!< number of reference subcarriers per RB
     NrErrorModel::Mode m_emMode{NrErrorModel::DL}; //!< Error model mode
     static const unsigned int m_crcLen = 24 / 8;   //!< CRC length (in bytes)
     mutable std::unordered_map<uint8_t, uint8_t> m_cachedCqiToMcsMap; //!< Cached CQI to MCS
+    std::shared_ptr<TbSizeTable> m_tbSizeTable; //!< Payload and TB sizes of the configuration
 };
 
 } // end namespace ns3
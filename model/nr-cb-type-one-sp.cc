@@ -12,6 +12,7 @@
 #include "ns3/uinteger.h"
 
 #include <complex.h>
+#include <set>
 
 namespace ns3
 {
@@ -81,6 +82,28 @@ NrCbTypeOneSp::GetBasePrecMat(size_t i1, size_t i2) const
     return GetBasePrecMatFromIndex(i11, i12, i13, i2);
 }
 
+std::vector<size_t>
+NrCbTypeOneSp::GetNeighborI1s(size_t i1) const
+{
+    auto i11 = MapToI11(i1);
+    auto i12 = MapToI12(i1);
+    std::set<size_t> neighbors;
+    for (auto d11 : {m_numI11 - 1, size_t{0}, size_t{1}})
+    {
+        for (auto d12 : {m_numI12 - 1, size_t{0}, size_t{1}})
+        {
+            for (size_t i13 = 0; i13 < m_numI13; i13++)
+            {
+                auto n11 = (i11 + d11) % m_numI11;
+                auto n12 = (i12 + d12) % m_numI12;
+                neighbors.insert(n11 + m_numI11 * (n12 + m_numI12 * i13));
+            }
+        }
+    }
+    neighbors.erase(i1);
+    return {neighbors.begin(), neighbors.end()};
+}
+
 ComplexMatrixArray
 NrCbTypeOneSp::GetBasePrecMatFromIndex(size_t i11, size_t i12, size_t i13, size_t i2) const
 {
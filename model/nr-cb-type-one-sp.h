@@ -43,6 +43,13 @@ class NrCbTypeOneSp : public NrCbTypeOne
                                                        size_t i13,
                                                        size_t i2) const;
 
+    /// @brief Get the wideband indices whose beams are adjacent to those of a given i1.
+    /// The neighbors are the indices whose horizontal and vertical beam indices (i11, i12)
+    /// differ by at most one (cyclically, since the DFT beams wrap around), with any i13.
+    /// @param i1 the composite index of the wideband precoding
+    /// @return the neighboring i1 values, in ascending order and excluding i1
+    std::vector<size_t> GetNeighborI1s(size_t i1) const override;
+
     /// @brief Get num i11
     /// @return the number of i11 indices (horizontal beam directions)
     size_t GetNumI11() const;
@@ -7,6 +7,8 @@
 #include "ns3/boolean.h"
 #include "ns3/uinteger.h"
 
+#include <set>
+
 namespace ns3
 {
 
@@ -53,4 +55,13 @@ NrCbTypeOne::GetNumI2() const
     return m_numI2;
 }
 
+std::vector<size_t>
+NrCbTypeOne::GetNeighborI1s(size_t i1) const
+{
+    NS_ASSERT(i1 < m_numI1);
+    std::set<size_t> neighbors{(i1 + m_numI1 - 1) % m_numI1, (i1 + 1) % m_numI1};
+    neighbors.erase(i1);
+    return {neighbors.begin(), neighbors.end()};
+}
+
 } // namespace ns3
@@ -8,6 +8,8 @@
 #include "ns3/matrix-array.h"
 #include "ns3/object.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -46,6 +48,13 @@ class NrCbTypeOne : public Object
     /// @return the precoding matrix of size m_nPorts x m_rank
     virtual ComplexMatrixArray GetBasePrecMat(size_t i1, size_t i2) const = 0;
 
+    /// @brief Get the wideband indices whose beams are adjacent to those of a given i1.
+    /// These are evaluated first when tracking the wideband PMI of a slowly changing channel.
+    /// The default implementation returns the previous and the next i1 (cyclically).
+    /// @param i1 the index of the wideband precoding
+    /// @return the neighboring i1 values, in ascending order and excluding i1
+    virtual std::vector<size_t> GetNeighborI1s(size_t i1) const;
+
   protected:
     // Constituting attributes
     size_t m_n1{NR_CB_TYPE_ONE_INIT_N1};       /// 3GPP n1-n2 config (num horiz gNB ports)
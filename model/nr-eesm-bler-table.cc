@@ -0,0 +1,41 @@
+// Copyright (c) 2020 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-eesm-bler-table.h"
+
+#include "ns3/abort.h"
+
+#include <cmath>
+
+namespace ns3
+{
+
+NrEesmBlerGrid::NrEesmBlerGrid(const NrEesmBlerTable& table, double step)
+    : m_table(table),
+      m_step(step),
+      m_invStep(1.0 / step)
+{
+    NS_ABORT_MSG_IF(step <= 0.0, "The BLER grid step must be positive");
+
+    m_curves.reserve(table.m_curves.size());
+    for (const auto& curve : table.m_curves)
+    {
+        const auto sinrDb = table.GetSinrDb(curve);
+        Curve c;
+        c.m_sinrDbMin = sinrDb.front();
+        c.m_sinrDbMax = sinrDb.back();
+        c.m_offset = static_cast<uint32_t>(m_bler.size());
+        // At least one step, so that the interpolation always has two points
+        c.m_numSteps = std::max(
+            1U,
+            static_cast<uint32_t>(std::ceil((c.m_sinrDbMax - c.m_sinrDbMin) * m_invStep)));
+        for (uint32_t k = 0; k <= c.m_numSteps; ++k)
+        {
+            m_bler.push_back(table.MapSinrDb(curve, c.m_sinrDbMin + k * m_step));
+        }
+        m_curves.push_back(c);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,353 @@
+// Copyright (c) 2020 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_EESM_BLER_TABLE_H
+#define NR_EESM_BLER_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @brief Granularity (in bits) of the simulated code block sizes. All the
+ * simulated CBS are multiple of this value, which allows to resolve the CBS
+ * of a curve with a plain array access.
+ */
+constexpr uint32_t NR_EESM_CBS_GRANULARITY = 8;
+/**
+ * @brief Maximum code block size (in bits) in NR: 384 (max lifting size) * 22 (BG1)
+ */
+constexpr uint32_t NR_EESM_MAX_CBS = 8448;
+/**
+ * @brief Number of buckets of the CBS lookup table
+ */
+constexpr uint32_t NR_EESM_CBS_BUCKETS = NR_EESM_MAX_CBS / NR_EESM_CBS_GRANULARITY + 1;
+/**
+ * @brief Number of LDPC base graphs
+ */
+constexpr uint32_t NR_EESM_NUM_BG = 2;
+
+/**
+ * @ingroup error-models
+ * @brief A simulated BLER-SINR curve, stored as a slice of the packed SINR
+ * and BLER arrays of a NrEesmBlerTable
+ */
+struct NrEesmBlerCurve
+{
+    uint32_t m_cbSize{0}; //!< Code block size (in bits) of the simulation
+    uint32_t m_offset{0}; //!< Index of the first point inside the packed arrays
+    uint32_t m_length{0}; //!< Number of points of the curve
+};
+
+/**
+ * @ingroup error-models
+ * @brief The curves simulated for a (BG type, MCS) pair, as a range of the
+ * curve array of a NrEesmBlerTable
+ */
+struct NrEesmBlerCurveRange
+{
+    uint16_t m_first{0}; //!< Index of the first curve (lowest CBS)
+    uint16_t m_count{0}; //!< Number of curves (one per simulated CBS)
+};
+
+/**
+ * @ingroup error-models
+ * @brief Flat, read-only table of simulated BLER vs SINR curves
+ *
+ * The SINR (in dB) and BLER points of all the curves are packed into two
+ * contiguous arrays. Each curve is described by a NrEesmBlerCurve (CBS, offset
+ * and length into the packed arrays); curves are grouped by BG type and MCS,
+ * and sorted by CBS inside each group.
+ *
+ * The selection of the curve for a CBS (the highest simulated CBS that is lower
+ * or equal to the one requested, or the lowest simulated one if none) is
+ * resolved in O(1) with two precomputed indexes: the first maps the CBS
+ * (quantized to NR_EESM_CBS_GRANULARITY) to a column in the sorted set of all
+ * the CBS simulated in the table; the second maps the (BG, MCS, column)
+ * triplet to the curve to use.
+ *
+ * All the arrays are expected to be constexpr data, built at compile time with
+ * BuildNrEesmBlerCbsIndex.
+ */
+struct NrEesmBlerTable
+{
+    std::span<const double> m_sinrDb;          //!< Packed SINR points (dB) of all the curves
+    std::span<const double> m_bler;            //!< Packed BLER points of all the curves
+    std::span<const NrEesmBlerCurve> m_curves; //!< All the curves
+    std::span<const uint8_t> m_cbsColumn;      //!< CBS bucket -> column (NR_EESM_CBS_BUCKETS)
+    std::span<const uint16_t> m_curveIndex;    //!< [BG][MCS][column] -> curve
+    uint16_t m_numMcs{0};                      //!< Number of MCS of the table
+    uint16_t m_numColumns{0};                  //!< Number of distinct CBS in the table
+
+    /**
+     * @brief Get the curve to use for a code block
+     * @param bg the LDPC base graph (0 for BG1, 1 for BG2)
+     * @param mcs the MCS
+     * @param cbSizeBit the code block size in bits
+     * @return the curve simulated with the highest CBS lower or equal to cbSizeBit,
+     * or the one with the lowest CBS if none
+     */
+    const NrEesmBlerCurve& GetCurve(uint8_t bg, uint8_t mcs, uint32_t cbSizeBit) const
+    {
+        const uint32_t bucket =
+            std::min(cbSizeBit / NR_EESM_CBS_GRANULARITY, NR_EESM_CBS_BUCKETS - 1);
+        const uint32_t column = m_cbsColumn[bucket];
+        return m_curves[m_curveIndex[(bg * m_numMcs + mcs) * m_numColumns + column]];
+    }
+
+    /**
+     * @brief Get the SINR points (dB) of a curve
+     * @param curve the curve
+     * @return a view over the SINR points
+     */
+    std::span<const double> GetSinrDb(const NrEesmBlerCurve& curve) const
+    {
+        return m_sinrDb.subspan(curve.m_offset, curve.m_length);
+    }
+
+    /**
+     * @brief Get the BLER points of a curve
+     * @param curve the curve
+     * @return a view over the BLER points
+     */
+    std::span<const double> GetBler(const NrEesmBlerCurve& curve) const
+    {
+        return m_bler.subspan(curve.m_offset, curve.m_length);
+    }
+
+    /**
+     * @brief Map a SINR into the BLER of a curve
+     *
+     * The BLER is 1 below the first SINR point and 0 above the last one; in
+     * between, it is the BLER of the highest SINR point lower or equal to sinrDb.
+     *
+     * @param curve the curve
+     * @param sinrDb the SINR in dB
+     * @return the BLER
+     */
+    double MapSinrDb(const NrEesmBlerCurve& curve, double sinrDb) const
+    {
+        const auto sinrPoints = GetSinrDb(curve);
+        if (sinrDb < sinrPoints.front())
+        {
+            return 1.0;
+        }
+        if (sinrDb > sinrPoints.back())
+        {
+            return 0.0;
+        }
+        auto sinrIt = std::upper_bound(sinrPoints.begin(), sinrPoints.end(), sinrDb);
+        if (sinrIt != sinrPoints.begin())
+        {
+            sinrIt--;
+        }
+        return GetBler(curve)[std::distance(sinrPoints.begin(), sinrIt)];
+    }
+};
+
+/**
+ * @ingroup error-models
+ * @brief The curves of a NrEesmBlerTable resampled over a uniform SINR grid
+ *
+ * Each curve of the table is sampled (with NrEesmBlerTable::MapSinrDb) every
+ * m_step dB, from its first to its last simulated SINR point. A BLER lookup
+ * is then an index computation plus a linear interpolation between the two
+ * grid points around the SINR, instead of a search over the simulated points.
+ *
+ * Since the simulated curves are non-increasing, the interpolated BLER for a
+ * SINR s is always bounded by the exact BLER at s - m_step and s + m_step.
+ *
+ * The grid is built once, and it is meant to be shared among all the error
+ * models that use the same table.
+ */
+class NrEesmBlerGrid
+{
+  public:
+    /**
+     * @brief Resample a table
+     * @param table the table (it must outlive the grid)
+     * @param step the grid step in dB
+     */
+    NrEesmBlerGrid(const NrEesmBlerTable& table, double step);
+
+    /**
+     * @brief Get the BLER of a code block
+     * @param bg the LDPC base graph (0 for BG1, 1 for BG2)
+     * @param mcs the MCS
+     * @param cbSizeBit the code block size in bits
+     * @param sinrDb the SINR in dB
+     * @return the (interpolated) BLER
+     */
+    double GetBler(uint8_t bg, uint8_t mcs, uint32_t cbSizeBit, double sinrDb) const
+    {
+        const NrEesmBlerCurve& curve = m_table.GetCurve(bg, mcs, cbSizeBit);
+        const Curve& c = m_curves[&curve - m_table.m_curves.data()];
+        if (sinrDb < c.m_sinrDbMin)
+        {
+            return 1.0;
+        }
+        if (sinrDb > c.m_sinrDbMax)
+        {
+            return 0.0;
+        }
+        const double x = (sinrDb - c.m_sinrDbMin) * m_invStep;
+        const uint32_t k = std::min(static_cast<uint32_t>(x), c.m_numSteps - 1);
+        const double frac = x - k;
+        const double* bler = &m_bler[c.m_offset + k];
+        return bler[0] + (bler[1] - bler[0]) * frac;
+    }
+
+    /**
+     * @return the grid step in dB
+     */
+    double GetStep() const
+    {
+        return m_step;
+    }
+
+  private:
+    /**
+     * @brief A resampled curve
+     */
+    struct Curve
+    {
+        double m_sinrDbMin{0.0}; //!< First simulated SINR point (dB)
+        double m_sinrDbMax{0.0}; //!< Last simulated SINR point (dB)
+        uint32_t m_offset{0};    //!< Index of the first grid point inside m_bler
+        uint32_t m_numSteps{0};  //!< Number of grid steps (grid points - 1)
+    };
+
+    const NrEesmBlerTable& m_table; //!< The resampled table
+    double m_step{0.0};             //!< Grid step (dB)
+    double m_invStep{0.0};          //!< Inverse of the grid step (1/dB)
+    std::vector<Curve> m_curves;    //!< Resampled curves, indexed as the table curves
+    std::vector<double> m_bler;     //!< BLER at the grid points of all the curves
+};
+
+/**
+ * @ingroup error-models
+ * @brief The CBS indexes of a NrEesmBlerTable, see BuildNrEesmBlerCbsIndex
+ */
+template <size_t NumColumns, size_t NumRanges>
+struct NrEesmBlerCbsIndex
+{
+    std::array<uint32_t, NumColumns> m_cbSizes{};                //!< Sorted distinct CBS
+    std::array<uint8_t, NR_EESM_CBS_BUCKETS> m_cbsColumn{};      //!< CBS bucket -> column
+    std::array<uint16_t, NumRanges * NumColumns> m_curveIndex{}; //!< [range][column] -> curve
+};
+
+/**
+ * @brief Count the distinct code block sizes simulated in a curve array
+ * @param curves the curves
+ * @return the number of distinct CBS
+ */
+template <size_t NumCurves>
+constexpr size_t
+CountNrEesmBlerCbSizes(const NrEesmBlerCurve (&curves)[NumCurves])
+{
+    size_t count = 0;
+    for (size_t i = 0; i < NumCurves; ++i)
+    {
+        bool seen = false;
+        for (size_t j = 0; j < i && !seen; ++j)
+        {
+            seen = curves[j].m_cbSize == curves[i].m_cbSize;
+        }
+        count += seen ? 0 : 1;
+    }
+    return count;
+}
+
+/**
+ * @brief Build, at compile time, the CBS indexes of a table
+ *
+ * The call fails to be evaluated as a constant expression (and so the table
+ * fails to compile) if a CBS is not a multiple of NR_EESM_CBS_GRANULARITY, is
+ * above NR_EESM_MAX_CBS, or if a (BG, MCS) pair has no curves.
+ *
+ * @param curves the curves, grouped by BG type and MCS and sorted by CBS
+ * @param ranges the curves of each (BG, MCS) pair, BG-major
+ * @return the CBS indexes
+ */
+template <size_t NumColumns, size_t NumCurves, size_t NumRanges>
+constexpr NrEesmBlerCbsIndex<NumColumns, NumRanges>
+BuildNrEesmBlerCbsIndex(const NrEesmBlerCurve (&curves)[NumCurves],
+                        const NrEesmBlerCurveRange (&ranges)[NumRanges])
+{
+    static_assert(NumColumns > 0 && NumColumns <= UINT8_MAX + 1, "Too many distinct CBS");
+    static_assert(NumRanges % NR_EESM_NUM_BG == 0, "Ranges must cover all the BG types");
+    NrEesmBlerCbsIndex<NumColumns, NumRanges> index;
+
+    // Sorted set of all the CBS (insertion sort, the set is small)
+    size_t numCbs = 0;
+    for (size_t i = 0; i < NumCurves; ++i)
+    {
+        const uint32_t cbs = curves[i].m_cbSize;
+        if (cbs % NR_EESM_CBS_GRANULARITY != 0 || cbs > NR_EESM_MAX_CBS)
+        {
+            throw "CBS not representable in the lookup table";
+        }
+        size_t pos = 0;
+        while (pos < numCbs && index.m_cbSizes[pos] < cbs)
+        {
+            ++pos;
+        }
+        if (pos < numCbs && index.m_cbSizes[pos] == cbs)
+        {
+            continue;
+        }
+        for (size_t k = numCbs; k > pos; --k)
+        {
+            index.m_cbSizes[k] = index.m_cbSizes[k - 1];
+        }
+        index.m_cbSizes[pos] = cbs;
+        ++numCbs;
+    }
+
+    // For each bucket, the column of the highest CBS lower or equal to the bucket
+    size_t column = 0;
+    for (size_t bucket = 0; bucket < NR_EESM_CBS_BUCKETS; ++bucket)
+    {
+        while (column + 1 < NumColumns &&
+               index.m_cbSizes[column + 1] <= bucket * NR_EESM_CBS_GRANULARITY)
+        {
+            ++column;
+        }
+        index.m_cbsColumn[bucket] = static_cast<uint8_t>(column);
+    }
+
+    // For each (BG, MCS) and column, the curve of the highest CBS lower or equal
+    // to the one of the column, or the lowest one if none
+    for (size_t r = 0; r < NumRanges; ++r)
+    {
+        if (ranges[r].m_count == 0)
+        {
+            throw "(BG, MCS) pair without simulated curves";
+        }
+        for (size_t c = 0; c < NumColumns; ++c)
+        {
+            uint16_t curve = ranges[r].m_first;
+            for (uint16_t k = 1; k < ranges[r].m_count; ++k)
+            {
+                if (curves[ranges[r].m_first + k].m_cbSize <= index.m_cbSizes[c])
+                {
+                    curve = ranges[r].m_first + k;
+                }
+            }
+            index.m_curveIndex[r * NumColumns + c] = curve;
+        }
+    }
+
+    return index;
+}
+
+} // namespace ns3
+
+#endif // NR_EESM_BLER_TABLE_H
@@ -6,6 +6,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace ns3
 {
 
@@ -34,44 +37,17 @@ NrEesmCc::ComputeSINR(const SpectrumValue& sinr,
                       const std::vector<int>& map,
                       uint8_t mcs,
                       [[maybe_unused]] uint32_t sizeBit,
-                      const NrErrorModel::NrErrorModelHistory& sinrHistory) const
+                      const NrErrorModel::NrErrorModelHistory& sinrHistory,
+                      NrEesmErrorModelOutput& output) const
 {
     NS_LOG_FUNCTION(this);
 
     // HARQ CHASE COMBINING: update SINReff, but not ECR after retx
     // repetition of coded bits
 
-    // make a vector of history that contains the last tx (but without modifying
-    // sinrHistory, as it will be modified by the caller when it will be the time)
-    Ptr<NrEesmErrorModelOutput> last = Create<NrEesmErrorModelOutput>(0.0);
-    last->m_map = map;
-    last->m_sinr = sinr;
-
-    NrErrorModel::NrErrorModelHistory total = sinrHistory;
-    total.emplace_back(last);
-
-    // evaluate SINR_eff over "total", as per Chase Combining
-
+    NS_ASSERT(!sinrHistory.empty());
     NS_ASSERT(sinr.GetSpectrumModel()->GetNumBands() == sinr.GetValuesN());
 
-    SpectrumValue sinr_sum(sinr.GetSpectrumModel());
-    auto historySize = static_cast<uint32_t>(total.size());
-    uint32_t maxRBUsed = 0;
-    for (uint32_t i = 0; i < historySize; ++i)
-    {
-        Ptr<NrEesmErrorModelOutput> output = DynamicCast<NrEesmErrorModelOutput>(total.at(i));
-        maxRBUsed = std::max(maxRBUsed, static_cast<uint32_t>(output->m_map.size()));
-    }
-
-    std::vector<int> map_sum;
-    map_sum.reserve(maxRBUsed);
-
-    for (uint32_t i = 0; i < maxRBUsed; ++i)
-    {
-        sinr_sum[i] = 0;
-        map_sum.push_back(static_cast<int>(i));
-    }
-
     /* combine at the bit level. Example:
      * SINR{1}=[0 0 10 20 10 0 0];
      * SINR{2}=[1 2 1 2 1 0 3];
@@ -85,30 +61,62 @@ NrEesmCc::ComputeSINR(const SpectrumValue& sinr,
      * SINR_SUM = [16 27 16 17 26 18]
      *
      * (the value at SINR_SUM[0] is SINR{1}[2] + SINR{2}[0] + SINR{3}[0])
+     *
+     * The combined SINR up to the previous transmission is kept in the last
+     * element of the history, so only the current transmission has to be added.
      */
-    for (uint32_t i = 0; i < historySize; ++i)
+    Ptr<NrEesmErrorModelOutput> last = DynamicCast<NrEesmErrorModelOutput>(sinrHistory.back());
+    NS_ASSERT(last != nullptr);
+
+    const auto size = static_cast<uint32_t>(map.size());
+    const auto lastSize = static_cast<uint32_t>(
+        last->m_sinrSum.empty() ? last->m_map.size() : last->m_sinrSum.size());
+    auto& sinrSum = output.m_sinrSum;
+
+    if (size > lastSize)
+    {
+        // The combined vector gets longer. Each previous transmission wraps around its
+        // own RB map, so their contributions to the new positions are added one by one
+        sinrSum.assign(size, 0.0);
+        for (const auto& element : sinrHistory)
+        {
+            Ptr<NrEesmErrorModelOutput> previous = DynamicCast<NrEesmErrorModelOutput>(element);
+            auto previousSize = static_cast<uint32_t>(previous->m_map.size());
+            for (uint32_t j = 0; j < size; ++j)
+            {
+                sinrSum[j] += previous->m_sinr[previous->m_map[j % previousSize]];
+            }
+        }
+    }
+    else if (last->m_sinrSum.empty())
     {
-        Ptr<NrEesmErrorModelOutput> output = DynamicCast<NrEesmErrorModelOutput>(total.at(i));
-        uint32_t size = output->m_map.size();
-        for (uint32_t j = 0; j < maxRBUsed; ++j)
+        // The last element is the first transmission: its combined SINR is its own
+        sinrSum.resize(lastSize);
+        for (uint32_t j = 0; j < lastSize; ++j)
         {
-            sinr_sum[j] += output->m_sinr[output->m_map[j % size]];
+            sinrSum[j] = last->m_sinr[last->m_map[j]];
         }
     }
+    else
+    {
+        sinrSum = last->m_sinrSum;
+    }
 
-    NS_LOG_INFO("\tHISTORY:");
-    for (const auto& element : total)
+    for (uint32_t j = 0; j < sinrSum.size(); ++j)
     {
-        Ptr<NrEesmErrorModelOutput> output = DynamicCast<NrEesmErrorModelOutput>(element);
-        NS_LOG_INFO("\tMAP:" << PrintMap(output->m_map));
-        NS_LOG_INFO("\tSINR: " << output->m_sinr);
+        sinrSum[j] += sinr[map[j % size]];
     }
 
-    NS_LOG_INFO("MAP_SUM: " << PrintMap(map_sum));
-    NS_LOG_INFO("SINR_SUM: " << sinr_sum);
+    NS_LOG_INFO("\tMAP: " << PrintMap(map));
+    NS_LOG_INFO("\tSINR: " << sinr);
+    NS_LOG_INFO("Combined SINR over " << sinrHistory.size() + 1 << " transmissions, "
+                                      << sinrSum.size() << " RBs");
 
-    // compute effective SINR with the sinr_sum vector and map_sum RB map
-    return SinrEff(sinr_sum, map_sum, mcs, 0.0, map_sum.size());
+    // compute effective SINR with the combined SINR values, as SinrEff with a = 0.0
+    // and b = number of combined values
+    double beta = GetBetaTable()->at(mcs);
+    double SINR = -beta * log(SinrExp(sinrSum, mcs) / sinrSum.size());
+    return std::max(SINR, 0.0);
 }
 
 double
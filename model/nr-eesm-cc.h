@@ -21,9 +21,11 @@ namespace ns3
  * corresponding resources are summed across the retransmissions, and the combined
  * SINR values are used to get the effective SINR based on EESM.
  *
- * In HARQ-CC, the HARQ history contains the SINR per allocated RB. Given the current
- * SINR vector and RB map, and the HARQ history, the effective SINR is computed
- * according to EESM.
+ * In HARQ-CC, the HARQ history contains the SINR per allocated RB. Its last element
+ * also contains the SINR per RB combined over all the previous transmissions, so
+ * that the SINR of the current transmission is added to it without going through
+ * the whole history. Given the current SINR vector and RB map, and the combined
+ * SINR, the effective SINR is computed according to EESM.
  *
  * Please, don't use this class directly, but one between NrEesmCcT1 or NrEesmCcT2,
  * depending on what table you want to use.
@@ -54,13 +56,15 @@ class NrEesmCc : public NrEesmErrorModel
      * @param sizeBit the Transport block size in bits
      * @param mcs the MCS of the transmission
      * @param sinrHistory the History of the previous transmissions of the same block
+     * @param output the output of the current transmission, to store the combining state
      * @return The effective SINR
      */
     double ComputeSINR(const SpectrumValue& sinr,
                        const std::vector<int>& map,
                        uint8_t mcs,
                        uint32_t sizeBit,
-                       const NrErrorModel::NrErrorModelHistory& sinrHistory) const override;
+                       const NrErrorModel::NrErrorModelHistory& sinrHistory,
+                       NrEesmErrorModelOutput& output) const override;
 
     /**
      * @brief Returns the MCS corresponding to the ECR after retransmissions. As the ECR
@@ -8,11 +8,15 @@
 #include "fast-exp.h"
 #include "nr-phy-mac-common.h"
 
+#include "ns3/double.h"
 #include "ns3/enum.h"
 #include "ns3/log.h"
 
 #include <algorithm>
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
 
 namespace ns3
 {
@@ -44,7 +48,26 @@ NrEesmErrorModel::~NrEesmErrorModel()
 TypeId
 NrEesmErrorModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::NrEesmErrorModel").SetParent<NrErrorModel>();
+    static TypeId tid =
+        TypeId("ns3::NrEesmErrorModel")
+            .SetParent<NrErrorModel>()
+            .AddAttribute("BlerMapping",
+                          "How the effective SINR of a code block is mapped into a BLER: "
+                          "Exact searches over the simulated SINR points of the BLER curve, "
+                          "UniformGrid interpolates over the curve resampled every "
+                          "BlerGridStep dB (faster, with a deviation bounded by the BLER "
+                          "variation of the exact curve within one grid step)",
+                          EnumValue(NrEesmErrorModel::EXACT),
+                          MakeEnumAccessor<BlerMapping>(&NrEesmErrorModel::m_blerMapping),
+                          MakeEnumChecker(NrEesmErrorModel::EXACT,
+                                          "Exact",
+                                          NrEesmErrorModel::UNIFORM_GRID,
+                                          "UniformGrid"))
+            .AddAttribute("BlerGridStep",
+                          "Step (in dB) of the SINR grid used when BlerMapping is UniformGrid",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&NrEesmErrorModel::m_blerGridStep),
+                          MakeDoubleChecker<double>(1e-4, 1.0));
     return tid;
 }
 
@@ -89,20 +112,89 @@ NrEesmErrorModel::SinrExp(const SpectrumValue& sinr, const std::vector<int>& map
     return SINRsum;
 }
 
-const std::vector<double>&
-NrEesmErrorModel::GetSinrDbVectorFromSimulatedValues(NrEesmErrorModel::GraphType graphType,
-                                                     uint8_t mcs,
-                                                     uint32_t cbSizeIndex) const
+double
+NrEesmErrorModel::SinrExp(std::span<const double> sinr, uint8_t mcs) const
 {
-    return std::get<0>(GetSimulatedBlerFromSINR()->at(graphType).at(mcs).at(cbSizeIndex));
+    // it returns sum_n (exp (-SINR/beta))
+    NS_LOG_FUNCTION(this << (uint8_t)mcs);
+    NS_ABORT_MSG_IF(sinr.empty(),
+                    " Error: number of allocated RBs cannot be 0 - EESM method - SinrEff function");
+
+    double SINRsum = 0.0;
+    double beta = GetBetaTable()->at(mcs);
+    for (double sinrLin : sinr)
+    {
+        SINRsum += exp21d(-sinrLin / beta);
+    }
+    return SINRsum;
 }
 
-const std::vector<double>&
-NrEesmErrorModel::GetBLERVectorFromSimulatedValues(NrEesmErrorModel::GraphType graphType,
-                                                   uint8_t mcs,
-                                                   uint32_t cbSizeIndex) const
+void
+NrEesmErrorModel::SinrExpBatch(const SpectrumValue& sinr,
+                               const std::vector<int>& map,
+                               std::vector<double>& sinrExpSums) const
+{
+    NS_LOG_FUNCTION(sinr << &map);
+    NS_ABORT_MSG_IF(map.empty(),
+                    " Error: number of allocated RBs cannot be 0 - EESM method - SinrEff function");
+
+    const size_t numMcs = GetMaxMcs() + 1;
+    NS_ASSERT(GetBetaTable()->size() >= numMcs);
+    const double* beta = GetBetaTable()->data();
+    sinrExpSums.assign(numMcs, 0.0);
+    double* sums = sinrExpSums.data();
+
+    for (int i : map)
+    {
+        const double sinrLin = sinr[i];
+        for (size_t mcs = 0; mcs < numMcs; ++mcs)
+        {
+            sums[mcs] += exp21d(-sinrLin / beta[mcs]);
+        }
+    }
+}
+
+NrErrorModel::TblerEvaluator
+NrEesmErrorModel::GetTblerEvaluator(const SpectrumValue& sinr, const std::vector<int>& map)
 {
-    return std::get<1>(GetSimulatedBlerFromSINR()->at(graphType).at(mcs).at(cbSizeIndex));
+    NS_LOG_FUNCTION(this);
+    std::vector<double> sinrExpSums;
+    SinrExpBatch(sinr, map, sinrExpSums);
+    const double numRbs = map.size();
+
+    return [this, sinrExpSums = std::move(sinrExpSums), numRbs](uint32_t size, uint8_t mcs) {
+        NS_ABORT_IF(mcs > GetMaxMcs());
+        // Same as SinrEff, with a = 0 and b = map.size() (first transmission)
+        double beta = GetBetaTable()->at(mcs);
+        double sinrEff = std::max(-beta * log(sinrExpSums[mcs] / numRbs), 0.0);
+        return MappingSinrTbler(sinrEff, size * 8, mcs, mcs);
+    };
+}
+
+const NrEesmBlerGrid&
+NrEesmErrorModel::GetBlerGrid()
+{
+    if (!m_blerGrid || m_blerGrid->GetStep() != m_blerGridStep)
+    {
+        // The grids are pure functions of the (static) table and the step, so
+        // they are built only once per process. The error models may be used
+        // from several threads, hence the lock.
+        static std::mutex mutex;
+        static std::map<std::pair<const SimulatedBlerFromSINR*, double>,
+                        std::shared_ptr<const NrEesmBlerGrid>>
+            grids;
+
+        std::lock_guard lock(mutex);
+        auto& grid = grids[{GetSimulatedBlerFromSINR(), m_blerGridStep}];
+        if (!grid)
+        {
+            NS_LOG_INFO("Building the BLER grid with step " << m_blerGridStep << " dB");
+            grid = std::make_shared<const NrEesmBlerGrid>(*GetSimulatedBlerFromSINR(),
+                                                          m_blerGridStep);
+        }
+        m_blerGrid = grid;
+    }
+    return *m_blerGrid;
 }
 
 double
@@ -112,49 +204,24 @@ NrEesmErrorModel::MappingSinrBler(double sinr, uint8_t mcs, uint32_t cbSizeBit)
     NS_ABORT_MSG_IF(mcs > GetMaxMcs(),
                     "MCS out of range [0..27/28]: " << static_cast<uint8_t>(mcs));
 
-    // use cbSize to obtain the index of CBSIZE in the map, jointly with mcs and sinr. take the
-    // lowest CBSIZE simulated including this CB for removing CB size quatization
-    // errors. sinr is also lower-bounded.
+    // use cbSize to obtain the curve of the highest simulated CBSIZE including this CB,
+    // jointly with mcs and sinr, for removing CB size quantization errors (the lowest
+    // simulated one if none). sinr is also lower-bounded.
     double bler = 0.0;
     double sinr_db = 10 * log10(sinr);
     GraphType bg_type = GetBaseGraphType(cbSizeBit, mcs);
 
-    // Get the index of CBSIZE in the map
     NS_LOG_INFO("For sinr " << sinr << " and mcs " << +mcs << " CbSizebit " << cbSizeBit
                             << " we got bg type " << m_bgTypeName[bg_type]);
-    const auto& cbMap = GetSimulatedBlerFromSINR()->at(bg_type).at(mcs);
-    auto cbIt = cbMap.upper_bound(cbSizeBit);
 
-    if (cbIt != cbMap.begin())
+    if (m_blerMapping == UNIFORM_GRID)
     {
-        cbIt--;
-    }
-
-    if (sinr_db < GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).front())
-    {
-        bler = 1.0;
-    }
-    else if (sinr_db > GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).back())
-    {
-        bler = 0.0;
+        bler = GetBlerGrid().GetBler(bg_type, mcs, cbSizeBit, sinr_db);
     }
     else
     {
-        // Get the index of SINR in the vector
-        auto sinrIt =
-            std::upper_bound(GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).begin(),
-                             GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).end(),
-                             sinr_db);
-
-        if (sinrIt != GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).begin())
-        {
-            sinrIt--;
-        }
-
-        auto sinr_index =
-            std::distance(GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).begin(),
-                          sinrIt);
-        bler = GetBLERVectorFromSimulatedValues(bg_type, mcs, cbIt->first).at(sinr_index);
+        const auto* table = GetSimulatedBlerFromSINR();
+        bler = table->MapSinrDb(table->GetCurve(bg_type, mcs, cbSizeBit), sinr_db);
     }
 
     NS_LOG_LOGIC("SINR effective: " << sinr << " BLER:" << bler);
@@ -260,6 +327,102 @@ NrEesmErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
     return GetTbBitDecodificationStats(sinr, map, size * 8, mcs, sinrHistory);
 }
 
+Ptr<NrErrorModelOutput>
+NrEesmErrorModel::GetTbDecodificationStatsMimoSpan(std::span<const double> sinr,
+                                                   uint8_t rank,
+                                                   std::span<const int> map,
+                                                   uint32_t size,
+                                                   uint8_t mcs,
+                                                   const NrErrorModelHistory& sinrHistory)
+{
+    NS_LOG_FUNCTION(this);
+    if (!sinrHistory.empty())
+    {
+        // The HARQ combining works over the SpectrumValue of each transmission
+        return NrErrorModel::GetTbDecodificationStatsMimoSpan(sinr,
+                                                              rank,
+                                                              map,
+                                                              size,
+                                                              mcs,
+                                                              sinrHistory);
+    }
+
+    NS_ABORT_IF(mcs > GetMaxMcs());
+    NS_ABORT_MSG_IF(map.empty(),
+                    " Error: number of allocated RBs cannot be 0 - EESM method - SinrEff function");
+    NS_ASSERT(sinr.size() % rank == 0);
+
+    // Same sum as SinrExp over the vectorized SINR and RB map: RBs in map order, layers inner
+    const double beta = GetBetaTable()->at(mcs);
+    const size_t numValues = map.size() * rank;
+    double sinrExpSum = 0.0;
+    for (int iRb : map)
+    {
+        const double* rbSinr = sinr.data() + static_cast<size_t>(iRb) * rank;
+        for (uint8_t layer = 0; layer < rank; ++layer)
+        {
+            sinrExpSum += exp21d(-rbSinr[layer] / beta);
+        }
+    }
+    // effective SINR for this tx (as SinrEff with a = 0 and b = number of used values)
+    double tbSinr = std::max(-beta * log(sinrExpSum / numValues), 0.0);
+
+    const uint32_t sizeBit = size * 8;
+    double errorRate = MappingSinrTbler(tbSinr, sizeBit, mcs, mcs);
+    NS_LOG_DEBUG(" mcs " << +mcs << " TBSize in bit " << sizeBit << " rank " << +rank
+                         << " SINR of the tx: " << tbSinr << " Calculated Error rate "
+                         << errorRate);
+
+    Ptr<NrEesmErrorModelOutput> ret = Create<NrEesmErrorModelOutput>(errorRate);
+    ret->m_sinrEff = tbSinr;
+    ret->m_sinrExp = sinrExpSum; // it is first tx!
+    ret->m_infoBits = sizeBit;
+    ret->m_codeBits = sizeBit / GetMcsEcrTable()->at(mcs);
+    ret->m_codeBitsSum = ret->m_codeBits;
+    ret->m_mapSizeSum = numValues;
+
+    // Compact copy of the used SINR values, in the order of the vectorized RB map, so that
+    // m_sinr[m_map[j]] is the same value as with the full vectorized SpectrumValue
+    ret->m_sinr = SpectrumValue(NrSinrMatrix::GetVectorizedSpectrumModel(numValues));
+    ret->m_map.resize(numValues);
+    auto sinrIt = ret->m_sinr.ValuesBegin();
+    for (int iRb : map)
+    {
+        sinrIt = std::copy_n(sinr.begin() + static_cast<size_t>(iRb) * rank, rank, sinrIt);
+    }
+    std::iota(ret->m_map.begin(), ret->m_map.end(), 0);
+
+    return ret;
+}
+
+double
+NrEesmErrorModel::MappingSinrTbler(double sinrEff, uint32_t sizeBit, uint8_t mcs, uint8_t mcsEq)
+{
+    // LDPC base graph type selection (1 or 2), as per TS 38.212, using the payload (A)
+    GraphType bg_type = GetBaseGraphType(sizeBit, mcs);
+    NS_LOG_INFO("BG type selection: " << bg_type);
+
+    // code block segmentation, as per TS 38.212, using payload + TB CRC attachment (B)
+    uint32_t B = sizeBit + 24; // input to code block segmentation, in bits
+    std::pair<uint32_t, uint32_t> cbSeg = CodeBlockSegmentation(B, bg_type);
+    uint32_t K = cbSeg.first;
+    uint32_t C = cbSeg.second;
+    NS_LOG_INFO("EESMErrorModel: TBS of " << B << " bits distributed in " << C << " CBs of " << K
+                                          << " bits");
+
+    double errorRate = 1.0;
+    if (C != 1)
+    {
+        double cbler = MappingSinrBler(sinrEff, mcsEq, K);
+        errorRate = 1.0 - pow(1.0 - cbler, C);
+    }
+    else
+    {
+        errorRate = MappingSinrBler(sinrEff, mcsEq, K);
+    }
+    return errorRate;
+}
+
 std::string
 NrEesmErrorModel::PrintMap(const std::vector<int>& map) const
 {
@@ -283,34 +446,41 @@ NrEesmErrorModel::GetTbBitDecodificationStats(const SpectrumValue& sinr,
     NS_LOG_FUNCTION(this);
     NS_ABORT_IF(mcs > GetMaxMcs());
 
-    double tbSinr = SinrEff(sinr, map, mcs, 0, map.size()); // effective SINR for this tx
-    double SINR = tbSinr;
     double sinrExpSum = SinrExp(sinr, map, mcs); // exponential sum of SINRs for this tx
+    // effective SINR for this tx (as SinrEff with a = 0 and b = map.size())
+    double tbSinr = std::max(-GetBetaTable()->at(mcs) * log(sinrExpSum / map.size()), 0.0);
+    double SINR = tbSinr;
 
     NS_LOG_DEBUG(" mcs " << +mcs << " TBSize in bit " << sizeBit << " history elements: "
                          << sinrHistory.size() << " SINR of the tx: " << tbSinr << std::endl
                          << "MAP: " << PrintMap(map) << std::endl
                          << "SINR: " << sinr);
 
-    if (!sinrHistory.empty())
+    Ptr<NrEesmErrorModelOutput> ret = Create<NrEesmErrorModelOutput>(1.0);
+    ret->m_sinr = sinr;
+    ret->m_map = map;
+    ret->m_infoBits = sizeBit;
+    ret->m_codeBits = sizeBit / GetMcsEcrTable()->at(mcs);
+    if (sinrHistory.empty())
     {
-        SINR = ComputeSINR(sinr, map, mcs, sizeBit, sinrHistory);
+        ret->m_sinrExp = sinrExpSum; // it is first tx!
+        ret->m_codeBitsSum = ret->m_codeBits;
+        ret->m_mapSizeSum = map.size();
+    }
+    else
+    {
+        // Running sums over the previous tx (kept in the last one) and this one
+        Ptr<NrEesmErrorModelOutput> last = DynamicCast<NrEesmErrorModelOutput>(sinrHistory.back());
+        NS_ASSERT(last != nullptr);
+        ret->m_sinrExp = last->m_sinrExp + sinrExpSum;
+        ret->m_codeBitsSum = last->m_codeBitsSum + ret->m_codeBits;
+        ret->m_mapSizeSum = last->m_mapSizeSum + map.size();
+
+        SINR = ComputeSINR(sinr, map, mcs, sizeBit, sinrHistory, *ret);
     }
 
     NS_LOG_DEBUG(" SINR after processing all retx (if any): " << SINR << " SINR last tx" << tbSinr);
 
-    // LDPC base graph type selection (1 or 2), as per TS 38.212, using the payload (A)
-    GraphType bg_type = GetBaseGraphType(sizeBit, mcs);
-    NS_LOG_INFO("BG type selection: " << bg_type);
-
-    // code block segmentation, as per TS 38.212, using payload + TB CRC attachment (B)
-    uint32_t B = sizeBit + 24; // input to code block segmentation, in bits
-    std::pair<uint32_t, uint32_t> cbSeg = CodeBlockSegmentation(B, bg_type);
-    uint32_t K = cbSeg.first;
-    uint32_t C = cbSeg.second;
-    NS_LOG_INFO("EESMErrorModel: TBS of " << B << " bits distributed in " << C << " CBs of " << K
-                                          << " bits");
-
     uint8_t mcs_eq = mcs;
     if ((!sinrHistory.empty()) && (mcs > 0))
     {
@@ -320,36 +490,13 @@ NrEesmErrorModel::GetTbBitDecodificationStats(const SpectrumValue& sinr,
     NS_LOG_INFO(" MCS of tx " << +mcs << " Equivalent MCS for PHY abstraction (just for HARQ-IR) "
                               << +mcs_eq);
 
-    double errorRate = 1.0;
-    if (C != 1)
-    {
-        double cbler = MappingSinrBler(SINR, mcs_eq, K);
-        errorRate = 1.0 - pow(1.0 - cbler, C);
-    }
-    else
-    {
-        errorRate = MappingSinrBler(SINR, mcs_eq, K);
-    }
+    double errorRate = MappingSinrTbler(SINR, sizeBit, mcs, mcs_eq);
 
     NS_LOG_DEBUG("Calculated Error rate " << errorRate);
     NS_ASSERT(GetMcsEcrTable() != nullptr);
 
-    Ptr<NrEesmErrorModelOutput> ret = Create<NrEesmErrorModelOutput>(errorRate);
+    ret->m_tbler = errorRate;
     ret->m_sinrEff = SINR;
-    ret->m_sinr = sinr;
-    ret->m_map = map;
-    if (sinrHistory.empty())
-    {
-        ret->m_sinrExp = sinrExpSum; // it is first tx!
-    }
-    else
-    {
-        double m_sinrExpPrevious =
-            DynamicCast<NrEesmErrorModelOutput>(sinrHistory.back())->m_sinrExp;
-        ret->m_sinrExp = m_sinrExpPrevious + sinrExpSum; // it sums over previous tx (recursively)
-    }
-    ret->m_infoBits = sizeBit;
-    ret->m_codeBits = sizeBit / GetMcsEcrTable()->at(mcs);
 
     return ret;
 }
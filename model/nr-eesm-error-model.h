@@ -5,9 +5,10 @@
 #ifndef NR_EESM_ERROR_MODEL_H
 #define NR_EESM_ERROR_MODEL_H
 
+#include "nr-eesm-bler-table.h"
 #include "nr-error-model.h"
 
-#include <map>
+#include <memory>
 
 namespace ns3
 {
@@ -43,6 +44,12 @@ struct NrEesmErrorModelOutput : public NrErrorModelOutput
     std::vector<int> m_map; //!< map of the active RBs
     uint32_t m_infoBits{0}; //!< number of info bits
     uint32_t m_codeBits{0}; //!< number of code bits
+
+    // Running HARQ combining state, over this and all the previous transmissions of the
+    // TB, so that a retransmission only needs the last output of the history
+    std::vector<double> m_sinrSum; //!< Combined SINR per RB (HARQ-CC), empty for a first tx
+    uint32_t m_codeBitsSum{0};     //!< Sum of the code bits (HARQ-IR)
+    double m_mapSizeSum{0.0};      //!< Sum of the number of active RBs (HARQ-IR)
 };
 
 /**
@@ -84,6 +91,15 @@ class NrEesmErrorModel : public NrErrorModel
      */
     static TypeId GetTypeId();
 
+    /**
+     * @brief How the effective SINR of a code block is mapped into a BLER
+     */
+    enum BlerMapping
+    {
+        EXACT,       //!< Search over the simulated SINR points of the curve
+        UNIFORM_GRID //!< Interpolation over the curve resampled on a uniform SINR grid
+    };
+
     /**
      * @brief NrEesmErrorModel constructor
      */
@@ -113,6 +129,49 @@ class NrEesmErrorModel : public NrErrorModel
         uint8_t mcs,
         const NrErrorModelHistory& sinrHistory) override;
 
+    /**
+     * @brief Get an output for the decodification error probability of a given
+     * transport block, from the MIMO SINR matrix read in place.
+     *
+     * For first transmissions, the exponential SINR sum is accumulated directly
+     * over the used RBs and layers of the matrix, in the same order as with the
+     * vectorized SpectrumValue, so the results are identical to
+     * GetTbDecodificationStatsMimo. The output keeps a compact copy of the used
+     * SINR values (with an identity RB map) for HARQ combining. Retransmissions
+     * use the NrErrorModel implementation.
+     *
+     * @param sinr the vectorized SINR matrix (rank * nRbs values)
+     * @param rank the number of MIMO layers
+     * @param map RB map (the used columns of the SINR matrix)
+     * @param size Transport block size in Bytes
+     * @param mcs MCS
+     * @param sinrHistory History of the retransmission
+     * @return A pointer to an output, as in GetTbDecodificationStats
+     */
+    Ptr<NrErrorModelOutput> GetTbDecodificationStatsMimoSpan(
+        std::span<const double> sinr,
+        uint8_t rank,
+        std::span<const int> map,
+        uint32_t size,
+        uint8_t mcs,
+        const NrErrorModelHistory& sinrHistory) override;
+
+    /**
+     * @brief Get an evaluator of the TBLER of first transmissions over the same
+     * SINR and RB map.
+     *
+     * The exponential sums of the EESM are computed for all the MCSs (i.e., all
+     * the beta values) in a single pass over the SINR vector (see SinrExpBatch),
+     * so that each evaluation only maps the effective SINR into a TBLER.
+     *
+     * @param sinr SINR vector
+     * @param map RB map
+     * @return the TBLER evaluator, equivalent to GetTbDecodificationStats with an
+     * empty history
+     */
+    TblerEvaluator GetTblerEvaluator(const SpectrumValue& sinr,
+                                     const std::vector<int>& map) override;
+
     /**
      * @brief Get the SE for a given CQI, following the CQIs in NR Table1/Table2
      * in TS38.214
@@ -151,9 +210,7 @@ class NrEesmErrorModel : public NrErrorModel
      */
     uint8_t GetMaxMcs() const override;
 
-    typedef std::vector<double> DoubleVector;
-    typedef std::tuple<DoubleVector, DoubleVector> DoubleTuple;
-    typedef std::vector<std::vector<std::map<uint32_t, DoubleTuple>>> SimulatedBlerFromSINR;
+    typedef NrEesmBlerTable SimulatedBlerFromSINR; //!< Flat table of BLER vs SINR curves
 
   protected:
     /**
@@ -199,6 +256,33 @@ class NrEesmErrorModel : public NrErrorModel
      */
     double SinrExp(const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs) const;
 
+    /**
+     * @brief compute the sum of exponential SINRs for the specified MCS over all
+     * the given SINR values, according to the EESM method
+     *
+     * @param sinr the SINR values
+     * @param mcs the MCS of the TB
+     * @return the sum of exponential SINR
+     */
+    double SinrExp(std::span<const double> sinr, uint8_t mcs) const;
+
+    /**
+     * @brief compute the sum of exponential SINRs for all the MCSs of the table,
+     * in a single pass over the SINR vector
+     *
+     * For each RB, the exponentials for all the beta values are computed in an
+     * inner loop over contiguous arrays, that the compiler can vectorize. Each
+     * sum accumulates the RBs in the same order as SinrExp, so the results are
+     * identical to calling SinrExp for each MCS.
+     *
+     * @param sinr the perceived sinrs in the whole bandwidth (vector, per RB)
+     * @param map the actives RBs for the TB
+     * @param sinrExpSums output: the sum of exponential SINR, indexed by MCS
+     */
+    void SinrExpBatch(const SpectrumValue& sinr,
+                      const std::vector<int>& map,
+                      std::vector<double>& sinrExpSums) const;
+
     /**
      * @brief Compute the effective SINR after retransmission combining
      * @param sinr SINR of the new transmission
@@ -206,11 +290,16 @@ class NrEesmErrorModel : public NrErrorModel
      * @param mcs MCS of the transmission
      * @param sizeBit size (in bit) of the transmission
      * @param sinrHistory history of the SINR of the previous transmission
+     * @param output the output of the new transmission, where the running
+     * combining state is stored
      * @return the single SINR value
      *
-     * Called in GetTbBitDecodificationStats(). Please implement this function
-     * in a way that calculating the SINR of the new transmission
-     * takes in consideration the sinr history.
+     * Called in GetTbBitDecodificationStats(), only for retransmissions. The
+     * running combining state of the previous transmissions is found in the
+     * last element of the history (see NrEesmErrorModelOutput), so that this
+     * function does not need to go through the whole history. Before calling
+     * it, the output already contains the sums of the exponential SINRs, the
+     * code bits and the RB map sizes over the transmissions up to this one.
      *
      * @see NrEesmIr
      * @see NrEesmCc
@@ -219,7 +308,8 @@ class NrEesmErrorModel : public NrErrorModel
                                const std::vector<int>& map,
                                uint8_t mcs,
                                uint32_t sizeBit,
-                               const NrErrorModel::NrErrorModelHistory& sinrHistory) const = 0;
+                               const NrErrorModel::NrErrorModelHistory& sinrHistory,
+                               NrEesmErrorModelOutput& output) const = 0;
 
     /**
      * @brief Get the "Equivalent MCS" after retransmission combining
@@ -290,6 +380,18 @@ class NrEesmErrorModel : public NrErrorModel
                                                         uint8_t mcs,
                                                         const NrErrorModelHistory& sinrHistory);
 
+    /**
+     * @brief Map the effective SINR of a TB into its TBLER, following the LDPC
+     * base graph selection and code block segmentation of NR
+     *
+     * @param sinrEff the effective SINR
+     * @param sizeBit Transport block size in BITS
+     * @param mcs MCS of the transmission (used for the base graph selection)
+     * @param mcsEq equivalent MCS after retransmission combining (used for the BLER curves)
+     * @return the TBLER
+     */
+    double MappingSinrTbler(double sinrEff, uint32_t sizeBit, uint8_t mcs, uint8_t mcsEq);
+
     /**
      * @brief Type of base graph for LDPC coding
      */
@@ -322,25 +424,15 @@ class NrEesmErrorModel : public NrErrorModel
     std::pair<uint32_t, uint32_t> CodeBlockSegmentation(uint32_t B, GraphType bg_type) const;
 
     /**
-     * @brief Get SinrDb Vector From Simulated Values
-     * @param graphType
-     * @param mcs
-     * @param cbSizeIndex
-     * @return
+     * @brief Get the uniform-grid version of the BLER table, shared among all
+     * the error models that use the same table and grid step
+     * @return the grid
      */
-    const std::vector<double>& GetSinrDbVectorFromSimulatedValues(GraphType graphType,
-                                                                  uint8_t mcs,
-                                                                  uint32_t cbSizeIndex) const;
-    /**
-     * @brief Get BLER Vector From Simulated Values
-     * @param graphType
-     * @param mcs
-     * @param cbSizeIndex
-     * @return
-     */
-    const std::vector<double>& GetBLERVectorFromSimulatedValues(GraphType graphType,
-                                                                uint8_t mcs,
-                                                                uint32_t cbSizeIndex) const;
+    const NrEesmBlerGrid& GetBlerGrid();
+
+    BlerMapping m_blerMapping{EXACT};                 //!< SINR to BLER mapping method
+    double m_blerGridStep{0.01};                      //!< Step (dB) of the uniform BLER grid
+    std::shared_ptr<const NrEesmBlerGrid> m_blerGrid; //!< Uniform BLER grid, built on first use
 };
 
 } // namespace ns3
@@ -6,6 +6,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace ns3
 {
 
@@ -30,44 +33,32 @@ NrEesmIr::GetTypeId()
 }
 
 double
-NrEesmIr::ComputeSINR(const SpectrumValue& sinr,
-                      const std::vector<int>& map,
+NrEesmIr::ComputeSINR([[maybe_unused]] const SpectrumValue& sinr,
+                      [[maybe_unused]] const std::vector<int>& map,
                       uint8_t mcs,
-                      uint32_t sizeBit,
-                      const NrErrorModel::NrErrorModelHistory& sinrHistory) const
+                      [[maybe_unused]] uint32_t sizeBit,
+                      const NrErrorModel::NrErrorModelHistory& sinrHistory,
+                      NrEesmErrorModelOutput& output) const
 {
     NS_LOG_FUNCTION(this);
     // HARQ INCREMENTAL REDUNDANCY: update SINReff and ECR after retx, assuming
     // no repetition of coded bits.
 
-    // compute equivalent effective code rate after retransmissions and total map size
-    uint32_t codeBitsSum = 0;
+    // equivalent effective code rate after retransmissions, from the sums over all
+    // the transmissions (previous ones and this one) kept in the output
     uint32_t infoBits = DynamicCast<NrEesmErrorModelOutput>(sinrHistory.front())
                             ->m_infoBits; // information bits of the first TB
-    double mapSumSize = 0.0;
-
-    for (const Ptr<NrErrorModelOutput>& output : sinrHistory)
-    {
-        Ptr<NrEesmErrorModelOutput> sinrHistorytemp = DynamicCast<NrEesmErrorModelOutput>(output);
-        NS_ASSERT(sinrHistorytemp != nullptr);
-
-        NS_LOG_DEBUG(" Exponential SINR sum " << sinrHistorytemp->m_sinrExp << " codeBits "
-                                              << sinrHistorytemp->m_codeBits
-                                              << " infoBits: " << sinrHistorytemp->m_infoBits);
-
-        codeBitsSum += sinrHistorytemp->m_codeBits;
-        mapSumSize += sinrHistorytemp->m_map.size();
-    }
-    mapSumSize += map.size();
-    codeBitsSum += sizeBit / GetMcsEcrTable()->at(mcs);
-    ;
-    const_cast<NrEesmIr*>(this)->m_Reff = infoBits / static_cast<double>(codeBitsSum);
+    const_cast<NrEesmIr*>(this)->m_Reff = infoBits / static_cast<double>(output.m_codeBitsSum);
 
-    NS_LOG_INFO(" Reff " << m_Reff << " HARQ history (previous) " << sinrHistory.size());
+    NS_LOG_INFO(" Reff " << m_Reff << " HARQ history (previous) " << sinrHistory.size()
+                         << " exponential SINR sum " << output.m_sinrExp << " code bits "
+                         << output.m_codeBitsSum << " RBs " << output.m_mapSizeSum);
 
-    // compute effective SINR with expSINR_previousTx and mapSumSize
-    double expSINR_previousTx = DynamicCast<NrEesmErrorModelOutput>(sinrHistory.back())->m_sinrExp;
-    return SinrEff(sinr, map, mcs, expSINR_previousTx, mapSumSize);
+    // compute effective SINR with the exponential SINR sum and RBs of all transmissions,
+    // as SinrEff with a = expSINR_previousTx and b = mapSumSize
+    double beta = GetBetaTable()->at(mcs);
+    double SINR = -beta * log(output.m_sinrExp / output.m_mapSizeSum);
+    return std::max(SINR, 0.0);
 }
 
 double
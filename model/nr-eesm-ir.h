@@ -20,8 +20,10 @@ namespace ns3
  * after each retransmission.
  *
  * In HARQ-IR, the HARQ history contains the last computed effective SINR and
- * number of coded bits of each of the previous retransmissions. Given the current
- * SINR vector and the HARQ history, the effective SINR is computed according to EESM.
+ * number of coded bits of each of the previous retransmissions. Its last element
+ * also contains the sums of the exponential SINRs, coded bits, and allocated RBs
+ * over all of them. Given the current SINR vector and these sums, the effective
+ * SINR is computed according to EESM.
  *
  * NOTE: The method GetMcsEq() must be called after ComputeSINR(), as it uses
  * the value m_Reff.
@@ -58,13 +60,15 @@ class NrEesmIr : public NrEesmErrorModel
      * @param sizeBit the Transport block size in bits
      * @param mcs the MCS
      * @param sinrHistory the History of the previous transmissions of the same block
+     * @param output the output of the current transmission, to store the combining state
      * @return The effective SINR
      */
     double ComputeSINR(const SpectrumValue& sinr,
                        const std::vector<int>& map,
                        uint8_t mcs,
                        uint32_t sizeBit,
-                       const NrErrorModel::NrErrorModelHistory& sinrHistory) const override;
+                       const NrErrorModel::NrErrorModelHistory& sinrHistory,
+                       NrEesmErrorModelOutput& output) const override;
 
     /**
      * @brief Returns the MCS corresponding to the ECR after retransmissions. In case of
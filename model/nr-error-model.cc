@@ -6,6 +6,8 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -43,12 +45,28 @@ NrErrorModel::GetTbDecodificationStatsMimo(const std::vector<MimoSinrChunk>& sin
     auto avgSinrMat = ComputeAvgSinrMimo(sinrChunks);
     NS_ASSERT(avgSinrMat.GetNumRows() == rank);
 
+    return GetTbDecodificationStatsMimoSpan(avgSinrMat.GetVectorizedValues(),
+                                            rank,
+                                            map,
+                                            size,
+                                            mcs,
+                                            history);
+}
+
+Ptr<NrErrorModelOutput>
+NrErrorModel::GetTbDecodificationStatsMimoSpan(std::span<const double> sinr,
+                                               uint8_t rank,
+                                               std::span<const int> map,
+                                               uint32_t size,
+                                               uint8_t mcs,
+                                               const NrErrorModelHistory& history)
+{
     // Vectorize SINR matrix and convert to SpectrumValue
     /// Linearize a 2D matrix into a vector, and convert that vector to a SpectrumValue
     /// Matches layer-to-codeword mapping in TR 38.211, Table 7.3.1.3-1
-    /// avgSinrMat(NrSinrMatrix) is A 2D matrix of average SINR values, dimensions nMimoLayers x
-    /// nRbs vectorizedSinr(SpectrumValue) contains the (nRB * nMimoLayers) SINR values
-    auto vectorizedSinr = avgSinrMat.GetVectorizedSpecVal();
+    /// vectorizedSinr(SpectrumValue) contains the (nRB * nMimoLayers) SINR values
+    auto vectorizedSinr = SpectrumValue{NrSinrMatrix::GetVectorizedSpectrumModel(sinr.size())};
+    std::copy(sinr.begin(), sinr.end(), vectorizedSinr.ValuesBegin());
 
     // Create a new RB map that fits the vectorized SINR values
     auto vectorizedMap = CreateVectorizedRbMap(map, rank);
@@ -56,6 +74,21 @@ NrErrorModel::GetTbDecodificationStatsMimo(const std::vector<MimoSinrChunk>& sin
     return GetTbDecodificationStats(vectorizedSinr, vectorizedMap, size, mcs, history);
 }
 
+NrErrorModel::TblerEvaluator
+NrErrorModel::GetTblerEvaluator(const SpectrumValue& sinr, const std::vector<int>& map)
+{
+    return [this, sinr, map](uint32_t size, uint8_t mcs) {
+        return GetTbDecodificationStats(sinr, map, size, mcs, NrErrorModelHistory())->m_tbler;
+    };
+}
+
+NrErrorModel::TblerEvaluator
+NrErrorModel::GetTblerEvaluatorMimo(const NrSinrMatrix& sinrMat, const std::vector<int>& map)
+{
+    auto rank = static_cast<uint8_t>(sinrMat.GetNumRows());
+    return GetTblerEvaluator(sinrMat.GetVectorizedSpecVal(), CreateVectorizedRbMap(map, rank));
+}
+
 NrSinrMatrix
 NrErrorModel::ComputeAvgSinrMimo(const std::vector<MimoSinrChunk>& sinrChunks)
 {
@@ -80,9 +113,10 @@ NrErrorModel::ComputeAvgSinrMimo(const std::vector<MimoSinrChunk>& sinrChunks)
 }
 
 std::vector<int>
-NrErrorModel::CreateVectorizedRbMap(std::vector<int> map, uint8_t rank)
+NrErrorModel::CreateVectorizedRbMap(std::span<const int> map, uint8_t rank)
 {
     auto vectorizedMap = std::vector<int>{};
+    vectorizedMap.reserve(map.size() * rank);
     for (int iRb : map)
     {
         for (size_t layer = 0; layer < rank; layer++)
@@ -10,6 +10,8 @@
 #include "ns3/object.h"
 #include "ns3/spectrum-value.h"
 
+#include <functional>
+#include <span>
 #include <vector>
 
 namespace ns3
@@ -108,6 +110,17 @@ class NrErrorModel : public Object
      */
     typedef std::vector<Ptr<NrErrorModelOutput>> NrErrorModelHistory;
 
+    /**
+     * @brief Evaluator of the TBLER of a first transmission (i.e., with an empty
+     * HARQ history) over a fixed SINR and RB map
+     *
+     * It is called with the transport block size (in bytes) and the MCS, and it
+     * returns the TBLER. It must not outlive the error model that created it.
+     *
+     * @see GetTblerEvaluator
+     */
+    typedef std::function<double(uint32_t size, uint8_t mcs)> TblerEvaluator;
+
     /**
      * @brief Get an output for the decodification error probability of a given
      * transport block.
@@ -134,6 +147,22 @@ class NrErrorModel : public Object
         uint8_t mcs,
         const NrErrorModelHistory& history) = 0;
 
+    /**
+     * @brief Get an evaluator of the TBLER of first transmissions over the same
+     * SINR and RB map, with different sizes and MCSs
+     *
+     * It is meant for the AMC, which tries many MCSs over the same SINR. Error
+     * models can override it to precompute, in one pass over the SINR, what
+     * does not depend on the MCS. The default implementation copies the SINR
+     * and the map, and calls GetTbDecodificationStats with an empty history.
+     *
+     * @param sinr SINR vector
+     * @param map RB map
+     * @return the TBLER evaluator
+     */
+    virtual TblerEvaluator GetTblerEvaluator(const SpectrumValue& sinr,
+                                             const std::vector<int>& map);
+
     /**
      * @brief Get the SpectralEfficiency for a given CQI
      * @param cqi CQI to take into consideration
@@ -196,6 +225,35 @@ class NrErrorModel : public Object
         uint8_t rank,
         const NrErrorModelHistory& history);
 
+    /// @brief Get an output for the decoding error probability of a given transport block,
+    /// from the (time-averaged) MIMO SINR matrix, read in place.
+    /// The SINR values follow the layer-to-codeword mapping of GetTbDecodificationStatsMimo
+    /// (TR 38.211, Table 7.3.1.3-1): the value of layer l in RB j is sinr[j * rank + l], as
+    /// returned by NrSinrMatrix::GetVectorizedValues. If derived ErrorModel does not override,
+    /// the values are copied into a SpectrumValue, and the non-MIMO method is called.
+    /// @param sinr the vectorized SINR matrix (rank * nRbs values)
+    /// @param rank the number of MIMO layers
+    /// @param map RB map (the used columns of the SINR matrix)
+    /// @param size Transport block size
+    /// @param mcs MCS
+    /// @param history History of the retransmission
+    /// @return A pointer to an output, with the tbler and other customized values
+    virtual Ptr<NrErrorModelOutput> GetTbDecodificationStatsMimoSpan(
+        std::span<const double> sinr,
+        uint8_t rank,
+        std::span<const int> map,
+        uint32_t size,
+        uint8_t mcs,
+        const NrErrorModelHistory& history);
+
+    /// @brief Get an evaluator of the TBLER of first transmissions over the same MIMO SINR
+    /// matrix and RB map, with different sizes and MCSs. The matrix is vectorized once, and
+    /// passed to GetTblerEvaluator.
+    /// @param sinrMat the MIMO SINR matrix (rank x nRbs)
+    /// @param map RB map (the used columns of the SINR matrix)
+    /// @return the TBLER evaluator
+    TblerEvaluator GetTblerEvaluatorMimo(const NrSinrMatrix& sinrMat, const std::vector<int>& map);
+
     /// @brief Compute an average SINR matrix
     /// @param mimoChunks vector of SINR chunks containing MIMO SINR matrices
     /// @return A 2D matrix of the average SINR for this TB reception, dimensions nMimoLayers x nRbs
@@ -211,7 +269,7 @@ class NrErrorModel : public Object
     /// @param rank The number of MIMO layers
     /// @return the indices corresponding to "map" when the SINR matrix is vectorized
     /// Note: result will be used in OSS function which require vector<int> type
-    std::vector<int> CreateVectorizedRbMap(std::vector<int> map, uint8_t rank);
+    std::vector<int> CreateVectorizedRbMap(std::span<const int> map, uint8_t rank);
 };
 
 } // namespace ns3
@@ -303,8 +303,7 @@ NrFhControl::DoUpdateActiveUesMap(
         uint16_t rnti = alloc.m_dci->m_rnti;
         uint32_t c1 = Cantor(bwpId, rnti);
         uint32_t numRbs =
-            static_cast<uint32_t>(
-                std::count(alloc.m_dci->m_rbgBitmask.begin(), alloc.m_dci->m_rbgBitmask.end(), 1)) *
+            static_cast<uint32_t>(alloc.m_dci->m_rbgBitmask.Count()) *
             static_cast<uint32_t>(m_fhSchedSapUser.at(bwpId)->GetNumRbPerRbgFromSched());
 
         NS_LOG_INFO("Cell: " << m_physicalCellId << " We got called for Update for bwpId: " << bwpId
@@ -13,16 +13,20 @@
 #include "beam-id.h"
 #include "nr-common.h"
 #include "nr-control-messages.h"
+#include "nr-mac-harq-vector.h"
 #include "nr-mac-header-fs-ul.h"
 #include "nr-mac-header-vs.h"
 #include "nr-mac-pdu-info.h"
 #include "nr-mac-sched-sap.h"
 #include "nr-mac-scheduler.h"
 #include "nr-mac-short-bsr-ce.h"
+#include "nr-mimo-thread-pool.h"
 #include "nr-phy-mac-common.h"
 #include "nr-radio-bearer-tag.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/simulator.h"
 #include "ns3/spectrum-model.h"
 #include "ns3/uinteger.h"
 
@@ -34,6 +38,26 @@ NS_LOG_COMPONENT_DEFINE("NrGnbMac");
 
 NS_OBJECT_ENSURE_REGISTERED(NrGnbMac);
 
+/// MACs with scheduler calls queued in the current time instant, in order of indication
+static std::vector<NrGnbMac*> g_parallelSchedulingBatch;
+
+/**
+ * @brief Check whether any log component is enabled
+ * @return true if a log component is enabled, in which case the triggers run serially
+ */
+static bool
+IsAnyLogEnabled()
+{
+    for (const auto& [name, component] : *LogComponent::GetComponentList())
+    {
+        if (!component->IsNoneEnabled())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 // //////////////////////////////////////
 // member SAP forwarders
 // //////////////////////////////////////
@@ -121,6 +145,7 @@ NrGnbMacMemberGnbCmacSapProvider::AllocateNcRaPreamble(uint16_t rnti)
 bool
 NrGnbMacMemberGnbCmacSapProvider::IsMaxSrsReached() const
 {
+    m_mac->FlushQueuedSchedCalls();
     return m_mac->m_macSchedSapProvider->IsMaxSrsReached();
 }
 
@@ -417,7 +442,7 @@ NrGnbMac::GetTypeId()
                 "Number of concurrent stop-and-wait Hybrid ARQ processes per user",
                 UintegerValue(16),
                 MakeUintegerAccessor(&NrGnbMac::SetNumHarqProcess, &NrGnbMac::GetNumHarqProcess),
-                MakeUintegerChecker<uint8_t>())
+                MakeUintegerChecker<uint8_t>(1, NrMacHarqVector::MAX_SIZE))
             .AddTraceSource("DlScheduling",
                             "Information regarding DL scheduling.",
                             MakeTraceSourceAccessor(&NrGnbMac::m_dlScheduling),
@@ -464,7 +489,20 @@ NrGnbMac::GetTypeId()
                           "How many time T300 timer can expire on the same cell",
                           UintegerValue(1),
                           MakeUintegerAccessor(&NrGnbMac::SetConnEstFailCount),
-                          MakeUintegerChecker<uint8_t>(1, 4));
+                          MakeUintegerChecker<uint8_t>(1, 4))
+            .AddAttribute("ParallelScheduling",
+                          "If true, the scheduler triggers of this MAC run together with the ones "
+                          "of the other MACs indicated at the same time instant, in parallel on "
+                          "the threads of the global value NrSchedulingThreads. The scheduler "
+                          "gets its inputs in the same order as with the serial execution, but "
+                          "its decisions are applied (RLC transmission opportunities, MAC PDUs, "
+                          "PHY slot allocation) after the other events of the same time instant, "
+                          "so the contents of the TBs, and then the next allocations, can differ "
+                          "from the serial execution. Schedulers that do not support it always "
+                          "run serially.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NrGnbMac::m_parallelScheduling),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -487,6 +525,8 @@ NrGnbMac::~NrGnbMac()
 void
 NrGnbMac::DoDispose()
 {
+    RemoveFromParallelScheduling();
+    m_queuedSchedCalls.clear();
     m_dlCqiReceived.clear();
     m_ulCqiReceived.clear();
     m_ulCeReceived.clear();
@@ -636,7 +676,9 @@ NrGnbMac::DoSlotDlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
                                       m_dlCqiReceived.end());
         m_dlCqiReceived.erase(m_dlCqiReceived.begin(), m_dlCqiReceived.end());
 
-        m_macSchedSapProvider->SchedDlCqiInfoReq(dlCqiInfoReq);
+        CallScheduler(m_macSchedSapProvider,
+                      &NrMacSchedSapProvider::SchedDlCqiInfoReq,
+                      dlCqiInfoReq);
 
         for (const auto& v : dlCqiInfoReq.m_cqiList)
         {
@@ -674,11 +716,141 @@ NrGnbMac::DoSlotDlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
             params.m_beamId = m_phySapProvider->GetBeamId(ue.first);
             params.m_transmissionMode = 0; // set to default value (SISO) for avoiding random
                                            // initialization (valgrind error)
-            m_macCschedSapProvider->CschedUeConfigReq(params);
+            CallScheduler(m_macCschedSapProvider,
+                          &NrMacCschedSapProvider::CschedUeConfigReq,
+                          params);
+        }
+    }
+
+    CallScheduler(m_macSchedSapProvider, &NrMacSchedSapProvider::SchedDlTriggerReq, dlParams, true);
+}
+
+bool
+NrGnbMac::MustQueueSchedCall(bool isTrigger) const
+{
+    if (m_runningSchedCalls)
+    {
+        // Made by a queued call, or by the MAC while processing its result
+        return false;
+    }
+    if (!m_queuedSchedCalls.empty())
+    {
+        return true;
+    }
+    return isTrigger && m_parallelScheduling &&
+           m_macSchedSapProvider->IsParallelSchedulingSupported();
+}
+
+void
+NrGnbMac::QueueSchedCall(std::function<void()> call, bool isTrigger)
+{
+    if (m_queuedSchedCalls.empty())
+    {
+        if (g_parallelSchedulingBatch.empty())
+        {
+            // Runs after all the MACs indicated at this time instant
+            Simulator::ScheduleNow(&NrGnbMac::RunParallelScheduling);
+        }
+        g_parallelSchedulingBatch.push_back(this);
+    }
+    m_queuedSchedCalls.emplace_back(isTrigger, std::move(call));
+}
+
+void
+NrGnbMac::RunParallelScheduling()
+{
+    auto batch = std::move(g_parallelSchedulingBatch);
+    g_parallelSchedulingBatch.clear();
+
+    if (IsAnyLogEnabled())
+    {
+        // The schedulers would log from the worker threads
+        for (NrGnbMac* mac : batch)
+        {
+            mac->FlushQueuedSchedCalls();
         }
+        return;
     }
 
-    m_macSchedSapProvider->SchedDlTriggerReq(dlParams);
+    std::vector<NrGnbMac*> triggered;
+    std::vector<std::function<void()>> triggers;
+    do
+    {
+        triggered.clear();
+        triggers.clear();
+        for (NrGnbMac* mac : batch)
+        {
+            if (mac->RunQueuedSchedCalls())
+            {
+                triggered.push_back(mac);
+                triggers.emplace_back(std::move(mac->m_queuedSchedCalls.front().second));
+                mac->m_queuedSchedCalls.pop_front();
+                mac->m_macSchedSapProvider->PrepareParallelTrigger();
+            }
+        }
+
+        NrMimoThreadPool::ParallelFor(
+            triggers.size(),
+            [&triggers](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    triggers[i]();
+                }
+            },
+            1,
+            NrMimoThreadPool::SCHEDULING);
+
+        for (NrGnbMac* mac : triggered)
+        {
+            mac->m_runningSchedCalls = true;
+            mac->m_macSchedSapProvider->CompleteParallelTrigger();
+            mac->m_runningSchedCalls = false;
+        }
+    } while (!triggered.empty());
+}
+
+bool
+NrGnbMac::RunQueuedSchedCalls()
+{
+    m_runningSchedCalls = true;
+    while (!m_queuedSchedCalls.empty() && !m_queuedSchedCalls.front().first)
+    {
+        auto call = std::move(m_queuedSchedCalls.front().second);
+        m_queuedSchedCalls.pop_front();
+        call();
+    }
+    m_runningSchedCalls = false;
+    return !m_queuedSchedCalls.empty();
+}
+
+void
+NrGnbMac::FlushQueuedSchedCalls()
+{
+    if (m_runningSchedCalls || m_queuedSchedCalls.empty())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    RemoveFromParallelScheduling();
+    m_runningSchedCalls = true;
+    while (!m_queuedSchedCalls.empty())
+    {
+        auto call = std::move(m_queuedSchedCalls.front().second);
+        m_queuedSchedCalls.pop_front();
+        call();
+    }
+    m_runningSchedCalls = false;
+}
+
+void
+NrGnbMac::RemoveFromParallelScheduling()
+{
+    NS_LOG_FUNCTION(this);
+    auto it = std::find(g_parallelSchedulingBatch.begin(), g_parallelSchedulingBatch.end(), this);
+    if (it != g_parallelSchedulingBatch.end())
+    {
+        g_parallelSchedulingBatch.erase(it);
+    }
 }
 
 void
@@ -733,7 +905,9 @@ NrGnbMac::ProcessRaPreambles(const SfnSf& sfnSf)
     }
 
     m_receivedRachPreambleCount.clear();
-    m_macSchedSapProvider->SchedDlRachInfoReq(rachInfoReqParams);
+    CallScheduler(m_macSchedSapProvider,
+                  &NrMacSchedSapProvider::SchedDlRachInfoReq,
+                  rachInfoReqParams);
 }
 
 void
@@ -753,7 +927,7 @@ NrGnbMac::DoSlotUlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
     {
         // m_ulCqiReceived.at (i).m_sfnSf = ((0x3FF & frameNum) << 16) | ((0xFF & subframeNum) << 8)
         // | (0xFF & varTtiNum);
-        m_macSchedSapProvider->SchedUlCqiInfoReq(i);
+        CallScheduler(m_macSchedSapProvider, &NrMacSchedSapProvider::SchedUlCqiInfoReq, i);
     }
     m_ulCqiReceived.clear();
 
@@ -764,7 +938,7 @@ NrGnbMac::DoSlotUlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
         params.m_srList.insert(params.m_srList.begin(), m_srRntiList.begin(), m_srRntiList.end());
         m_srRntiList.clear();
 
-        m_macSchedSapProvider->SchedUlSrInfoReq(params);
+        CallScheduler(m_macSchedSapProvider, &NrMacSchedSapProvider::SchedUlSrInfoReq, params);
 
         for (const auto& v : params.m_srList)
         {
@@ -783,7 +957,9 @@ NrGnbMac::DoSlotUlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
                                     m_ulCeReceived.begin(),
                                     m_ulCeReceived.end());
         m_ulCeReceived.erase(m_ulCeReceived.begin(), m_ulCeReceived.end());
-        m_macSchedSapProvider->SchedUlMacCtrlInfoReq(ulMacReq);
+        CallScheduler(m_macSchedSapProvider,
+                      &NrMacSchedSapProvider::SchedUlMacCtrlInfoReq,
+                      ulMacReq);
 
         for (const auto& v : ulMacReq.m_macCeList)
         {
@@ -806,7 +982,7 @@ NrGnbMac::DoSlotUlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
         m_ulHarqInfoReceived.clear();
     }
 
-    m_macSchedSapProvider->SchedUlTriggerReq(ulParams);
+    CallScheduler(m_macSchedSapProvider, &NrMacSchedSapProvider::SchedUlTriggerReq, ulParams, true);
 }
 
 void
@@ -1100,7 +1276,7 @@ NrGnbMac::DoTransmitBufferStatusReport(NrMacSapProvider::BufferStatusReportParam
                 << ", Retransmission Queue HOL delay=" << params.retxQueueHolDelay
                 << ", PDU Size=" << params.statusPduSize);
 
-    m_macSchedSapProvider->SchedDlRlcBufferReq(schedParams);
+    CallScheduler(m_macSchedSapProvider, &NrMacSchedSapProvider::SchedDlRlcBufferReq, schedParams);
 }
 
 // forwarded from NrMacSapProvider
@@ -1368,18 +1544,19 @@ NrGnbMac::DoConfigureMac(uint16_t ulBandwidth, uint16_t dlBandwidth)
     params.m_ulBandwidth = m_bandwidthInRbg;
     params.m_dlBandwidth = m_bandwidthInRbg;
 
-    m_macCschedSapProvider->CschedCellConfigReq(params);
+    CallScheduler(m_macCschedSapProvider, &NrMacCschedSapProvider::CschedCellConfigReq, params);
 }
 
 void
 NrGnbMac::BeamChangeReport(BeamId beamId, uint8_t rnti)
 {
+    FlushQueuedSchedCalls();
     NrMacCschedSapProvider::CschedUeConfigReqParameters params;
     params.m_rnti = rnti;
     params.m_beamId = beamId;
     params.m_transmissionMode =
         0; // set to default value (SISO) for avoiding random initialization (valgrind error)
-    m_macCschedSapProvider->CschedUeConfigReq(params);
+    CallScheduler(m_macCschedSapProvider, &NrMacCschedSapProvider::CschedUeConfigReq, params);
 }
 
 uint16_t
@@ -1415,7 +1592,7 @@ NrGnbMac::GetDlCtrlDci() const
 
     auto bwInRbg = m_phySapProvider->GetRbNum() / GetNumRbPerRbg();
     NS_ASSERT(bwInRbg > 0);
-    std::vector<bool> rbgBitmask(bwInRbg, true);
+    NrRbgMask rbgBitmask(bwInRbg, true);
 
     return std::make_shared<DciInfoElementTdma>(0,
                                                 m_macSchedSapProvider->GetDlCtrlSyms(),
@@ -1430,7 +1607,7 @@ NrGnbMac::GetUlCtrlDci() const
     NS_LOG_FUNCTION(this);
 
     NS_ASSERT(m_bandwidthInRbg > 0);
-    std::vector<bool> rbgBitmask(m_bandwidthInRbg, true);
+    NrRbgMask rbgBitmask(m_bandwidthInRbg, true);
 
     return std::make_shared<DciInfoElementTdma>(0,
                                                 m_macSchedSapProvider->GetUlCtrlSyms(),
@@ -1443,6 +1620,7 @@ void
 NrGnbMac::DoAddUe(uint16_t rnti)
 {
     NS_LOG_FUNCTION(this << " rnti=" << rnti);
+    FlushQueuedSchedCalls();
     std::unordered_map<uint8_t, NrMacSapUser*> empty;
     std::pair<std::unordered_map<uint16_t, std::unordered_map<uint8_t, NrMacSapUser*>>::iterator,
               bool>
@@ -1455,7 +1633,7 @@ NrGnbMac::DoAddUe(uint16_t rnti)
     params.m_beamId = m_phySapProvider->GetBeamId(rnti);
     params.m_transmissionMode =
         0; // set to default value (SISO) for avoiding random initialization (valgrind error)
-    m_macCschedSapProvider->CschedUeConfigReq(params);
+    CallScheduler(m_macCschedSapProvider, &NrMacCschedSapProvider::CschedUeConfigReq, params);
 
     // Create DL transmission HARQ buffers
     NrDlHarqProcessesBuffer_t buf;
@@ -1473,9 +1651,11 @@ void
 NrGnbMac::DoRemoveUe(uint16_t rnti)
 {
     NS_LOG_FUNCTION(this << " rnti=" << rnti);
+    // The queued scheduler calls, and their results, still refer to the UE
+    FlushQueuedSchedCalls();
     NrMacCschedSapProvider::CschedUeReleaseReqParameters params;
     params.m_rnti = rnti;
-    m_macCschedSapProvider->CschedUeReleaseReq(params);
+    CallScheduler(m_macCschedSapProvider, &NrMacCschedSapProvider::CschedUeReleaseReq, params);
     m_miDlHarqProcessesPackets.erase(rnti);
     m_rlcAttached.erase(rnti);
 
@@ -1504,6 +1684,7 @@ NrGnbMac::DoAddLc(NrGnbCmacSapProvider::LcInfo lcinfo, NrMacSapUser* msu)
 {
     NS_LOG_FUNCTION(this);
     NS_LOG_FUNCTION(this);
+    FlushQueuedSchedCalls();
 
     auto rntiIt = m_rlcAttached.find(lcinfo.rnti);
     NS_ASSERT_MSG(rntiIt != m_rlcAttached.end(), "RNTI not found");
@@ -1542,7 +1723,7 @@ NrGnbMac::DoAddLc(NrGnbCmacSapProvider::LcInfo lcinfo, NrMacSapUser* msu)
 
         params.m_logicalChannelConfigList.push_back(lccle);
 
-        m_macCschedSapProvider->CschedLcConfigReq(params);
+        CallScheduler(m_macCschedSapProvider, &NrMacCschedSapProvider::CschedLcConfigReq, params);
     }
 }
 
@@ -1555,6 +1736,9 @@ NrGnbMac::DoReconfigureLc(NrGnbCmacSapProvider::LcInfo lcinfo)
 void
 NrGnbMac::DoReleaseLc(uint16_t rnti, uint8_t lcid)
 {
+    // The queued scheduler calls, and their results, still refer to the LC
+    FlushQueuedSchedCalls();
+
     // Find user based on rnti and then erase lcid stored against the same
     auto rntiIt = m_rlcAttached.find(rnti);
     rntiIt->second.erase(lcid);
@@ -1562,20 +1746,21 @@ NrGnbMac::DoReleaseLc(uint16_t rnti, uint8_t lcid)
     struct NrMacCschedSapProvider::CschedLcReleaseReqParameters params;
     params.m_rnti = rnti;
     params.m_logicalChannelIdentity.push_back(lcid);
-    m_macCschedSapProvider->CschedLcReleaseReq(params);
+    CallScheduler(m_macCschedSapProvider, &NrMacCschedSapProvider::CschedLcReleaseReq, params);
 }
 
 void
 NrGnbMac::UeUpdateConfigurationReq(NrGnbCmacSapProvider::UeConfig params)
 {
     NS_LOG_FUNCTION(this);
+    FlushQueuedSchedCalls();
     // propagates to scheduler
     NrMacCschedSapProvider::CschedUeConfigReqParameters req;
     req.m_rnti = params.m_rnti;
     req.m_transmissionMode = params.m_transmissionMode;
     req.m_beamId = m_phySapProvider->GetBeamId(params.m_rnti);
     req.m_reconfigureFlag = true;
-    m_macCschedSapProvider->CschedUeConfigReq(req);
+    CallScheduler(m_macCschedSapProvider, &NrMacCschedSapProvider::CschedUeConfigReq, req);
 }
 
 NrGnbCmacSapProvider::RachConfig
@@ -16,6 +16,9 @@
 
 #include "ns3/traced-callback.h"
 
+#include <deque>
+#include <functional>
+
 namespace ns3
 {
 
@@ -43,6 +46,39 @@ class BeamId;
  * transmission or the reception of CTRL messages. One is GnbMacRxedCtrlMsgsTrace,
  * and the other is GnbMacTxedCtrlMsgsTrace. For what regards the UE, you will
  * find more information in the NrUePhy class documentation.
+ *
+ * @section gnb_mac_parallel Parallel scheduling
+ *
+ * The scheduling of different cells is independent until the PHY transmits the
+ * allocations, which happens at least L1L2CtrlLatency slots later. With the
+ * attribute ParallelScheduling, the calls of this MAC to the scheduler are not
+ * made when the PHY indicates the slot; they are queued, in order, and all the
+ * MACs indicated at the same time instant process their queues in a single
+ * event at that time. The calls other than the triggers (CQI, BSR, SR, RACH, RLC
+ * buffer status, CSCHED) are made in the simulation thread. The triggers of the
+ * MACs run in parallel, one trigger per MAC at a time, on the threads of the
+ * SCHEDULING pool of NrMimoThreadPool (global value "NrSchedulingThreads").
+ *
+ * A trigger that runs outside of the simulation thread only computes the
+ * allocations (see NrMacSchedSapProvider::PrepareParallelTrigger): the scheduler
+ * records the SchedConfigInd and BuildRarList calls and the trace sources that it
+ * fires, and makes them in the simulation thread after the trigger. Hence, the
+ * results do not depend on the number of threads.
+ *
+ * They can, however, differ from the serial execution. The scheduler gets its
+ * inputs in the same order, but the recorded SchedConfigInd is made after all the
+ * triggers of the time instant: DoSchedConfigIndication (the RLC transmission
+ * opportunities, the MAC PDUs and the slot allocation of the PHY) runs after the
+ * other events of the same time instant, e.g., the arrival of RLC or PDCP packets,
+ * the reception of UL PDUs or the RRC calls. The contents of the TBs, and through
+ * the buffer status reports the next allocations, can then change.
+ *
+ * The configuration calls of the RRC (e.g., adding or removing a UE or an LC)
+ * first make the queued calls of the MAC serially, as does IsMaxSrsReached.
+ *
+ * The triggers run serially, in the same event, if any log component is enabled,
+ * or if the scheduler does not support it (e.g., the AI schedulers, or any scheduler
+ * with fronthaul control, see NrMacSchedSapProvider::IsParallelSchedulingSupported).
  */
 class NrGnbMac : public Object
 {
@@ -285,6 +321,75 @@ class NrGnbMac : public Object
     void DoReceivePhyPdu(Ptr<Packet> p);
     void DoReceiveControlMessage(Ptr<NrControlMessage> msg);
     virtual void DoSchedConfigIndication(NrMacSchedSapUser::SchedConfigIndParameters ind);
+
+    /**
+     * @brief Make a call to the scheduler, now or in the parallel scheduling of the time instant
+     * @param sap the SAP provider of the scheduler
+     * @param req the request of the SAP provider
+     * @param params the parameters of the request
+     * @param isTrigger whether the call is SchedDlTriggerReq or SchedUlTriggerReq
+     *
+     * With ParallelScheduling, and if the scheduler supports it, a trigger is queued, and
+     * this MAC is added to the batch of the current time instant, which runs in
+     * RunParallelScheduling. The calls that follow a queued trigger are queued as well, to
+     * keep their order. The parameters are copied only when the call is queued; otherwise,
+     * the request is made directly.
+     */
+    template <class Sap, class Params>
+    void CallScheduler(Sap* sap,
+                       void (Sap::*req)(const Params&),
+                       const Params& params,
+                       bool isTrigger = false)
+    {
+        if (!MustQueueSchedCall(isTrigger))
+        {
+            (sap->*req)(params);
+            return;
+        }
+        QueueSchedCall([sap, req, params]() { (sap->*req)(params); }, isTrigger);
+    }
+
+    /**
+     * @brief Check whether a scheduler call has to be queued
+     * @param isTrigger whether the call is SchedDlTriggerReq or SchedUlTriggerReq
+     * @return true if other calls are queued, or if the call is a trigger that can run in
+     * parallel; false if the queued calls are being made
+     */
+    bool MustQueueSchedCall(bool isTrigger) const;
+
+    /**
+     * @brief Queue a scheduler call, and add this MAC to the batch of the current time instant
+     * if it is its first queued call
+     * @param call the function that calls the scheduler
+     * @param isTrigger whether the call is SchedDlTriggerReq or SchedUlTriggerReq
+     */
+    void QueueSchedCall(std::function<void()> call, bool isTrigger);
+
+    /**
+     * @brief Run the queued scheduler calls of all the MACs of the batch
+     *
+     * The calls run in rounds. In each round, each MAC makes the calls queued before its
+     * next trigger, in the simulation thread, then the triggers of the MACs run in
+     * parallel, and the calls recorded by the schedulers are made in the simulation thread.
+     */
+    static void RunParallelScheduling();
+
+    /**
+     * @brief Make the queued scheduler calls of this MAC up to the next trigger
+     * @return true if the next queued call is a trigger
+     */
+    bool RunQueuedSchedCalls();
+
+    /**
+     * @brief Make all the queued scheduler calls of this MAC serially, and leave the batch
+     */
+    void FlushQueuedSchedCalls();
+
+    /**
+     * @brief Remove this MAC from the batch of the parallel scheduling, if present
+     */
+    void RemoveFromParallelScheduling();
+
     // forwarded from NrMacSapProvider
     void DoTransmitPdu(NrMacSapProvider::TransmitPduParameters);
     void DoTransmitBufferStatusReport(NrMacSapProvider::BufferStatusReportParameters);
@@ -437,6 +542,11 @@ class NrGnbMac : public Object
      */
     TracedCallback<const DlHarqInfo&> m_dlHarqFeedback;
 
+    bool m_parallelScheduling{false}; //!< Whether the scheduler triggers can run in parallel
+    /// Scheduler calls queued for the batch, with whether each one is a trigger
+    std::deque<std::pair<bool, std::function<void()>>> m_queuedSchedCalls;
+    bool m_runningSchedCalls{false}; //!< Whether the queued scheduler calls are being made
+
     void ProcessRaPreambles(const SfnSf& sfnSf);
     void SetNumberOfRaPreambles(uint8_t numberOfRaPreambles);
     void SetPreambleTransMax(uint8_t preambleTransMax);
@@ -966,9 +966,7 @@ NrGnbPhy::GenerateAllocationStatistics(const SlotAllocInfo& allocInfo) const
 
     for (const auto& allocation : allocInfo.m_varTtiAllocInfo)
     {
-        uint32_t rbg = std::count(allocation.m_dci->m_rbgBitmask.begin(),
-                                  allocation.m_dci->m_rbgBitmask.end(),
-                                  1);
+        uint32_t rbg = allocation.m_dci->m_rbgBitmask.Count();
 
         // First: Store the RNTI of the UE in the active list
         if (allocation.m_dci->m_rnti != 0)
@@ -1126,7 +1124,7 @@ NrGnbPhy::HandleFhDropping()
             // Check if the DCI allocation fits in the FH BW
             // If it does not fit, mark it for deletion
             // If it fits, update traces based on dropped data
-            long rbgAssigned = std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), 1);
+            long rbgAssigned = dci->m_rbgBitmask.Count();
 
             if (DoesFhAllocationFit(GetBwpId(),
                                     dci->m_mcs,
@@ -1184,7 +1182,7 @@ NrGnbPhy::FillTheEvent()
 }
 
 void
-NrGnbPhy::StoreRBGAllocation(std::unordered_map<uint8_t, std::vector<bool>>* map,
+NrGnbPhy::StoreRBGAllocation(std::unordered_map<uint8_t, NrRbgMask>* map,
                              const std::shared_ptr<DciInfoElementTdma>& dci) const
 {
     NS_LOG_FUNCTION(this);
@@ -1198,10 +1196,7 @@ NrGnbPhy::StoreRBGAllocation(std::unordered_map<uint8_t, std::vector<bool>>* map
     {
         auto& existingRBGBitmask = itAlloc->second;
         NS_ASSERT(existingRBGBitmask.size() == dci->m_rbgBitmask.size());
-        for (uint32_t i = 0; i < existingRBGBitmask.size(); ++i)
-        {
-            existingRBGBitmask.at(i) = existingRBGBitmask.at(i) || dci->m_rbgBitmask.at(i);
-        }
+        existingRBGBitmask |= dci->m_rbgBitmask;
     }
 }
 
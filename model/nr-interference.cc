@@ -11,6 +11,7 @@
 #include "ns3/simulator.h"
 
 #include <algorithm>
+#include <limits>
 
 NS_LOG_COMPONENT_DEFINE("NrInterference");
 
@@ -37,6 +38,8 @@ NrInterference::DoDispose()
     m_mimoChunkProcessors.clear();
     m_rxSignalsMimo.clear();
     m_allSignalsMimo.clear();
+    m_outOfCellSignalsMimo.clear();
+    m_outOfCellInterfCov = NrCovMat{};
 
     NrInterferenceBase::DoDispose();
 }
@@ -151,8 +154,18 @@ NrInterference::ConditionallyEvaluateChunk()
             it->EvaluateChunk(sinr, duration);
         }
 
-        for (auto& cp : m_mimoChunkProcessors)
+        if (!m_mimoChunkProcessors.empty())
         {
+            // The matrices are computed once per received signal, and the resulting chunk is
+            // shared by all the MIMO chunk processors. The SINR and the signal information are
+            // only computed if some processor reports them.
+            auto needSinr = std::any_of(m_mimoChunkProcessors.begin(),
+                                        m_mimoChunkProcessors.end(),
+                                        [](const auto& cp) { return cp->HasSinrCallbacks(); });
+            auto needSignal = std::any_of(m_mimoChunkProcessors.begin(),
+                                          m_mimoChunkProcessors.end(),
+                                          [](const auto& cp) { return cp->HasSignalCallbacks(); });
+
             // Covariance matrix of noise plus out-of-cell interference
             auto outOfCellInterfCov = CalcOutOfCellInterfCov();
 
@@ -164,14 +177,26 @@ NrInterference::ConditionallyEvaluateChunk()
                 uint16_t rnti = nrRxSignal ? nrRxSignal->rnti : 0;
 
                 // MimoSinrChunk is used to store SINR and compute TBLER of the data transmission
-                auto sinrMatrix = ComputeSinr(outOfCellInterfCov, rxSignal);
-                MimoSinrChunk mimoSinr{sinrMatrix, rnti, duration};
-                cp->EvaluateChunk(mimoSinr);
+                MimoSinrChunk mimoSinr{NrSinrMatrix{}, rnti, duration};
+                if (needSinr)
+                {
+                    mimoSinr.mimoSinr = ComputeSinr(outOfCellInterfCov, rxSignal);
+                }
 
                 // MimoSignalChunk is used to compute PMI feedback.
-                auto& chanSpct = *(rxSignal->spectrumChannelMatrix);
-                MimoSignalChunk mimoSignal{chanSpct, outOfCellInterfCov, rnti, duration};
-                cp->EvaluateChunk(mimoSignal);
+                MimoSignalChunk mimoSignal{ComplexMatrixArray{}, NrCovMat{}, rnti, duration};
+                if (needSignal)
+                {
+                    mimoSignal.chanSpct = *(rxSignal->spectrumChannelMatrix);
+                    mimoSignal.interfNoiseCov = outOfCellInterfCov;
+                }
+
+                Ptr<const NrMimoChunk> chunk =
+                    Create<NrMimoChunk>(std::move(mimoSinr), std::move(mimoSignal));
+                for (auto& cp : m_mimoChunkProcessors)
+                {
+                    cp->EvaluateChunk(chunk);
+                }
             }
         }
         m_lastChangeTime = Now();
@@ -183,28 +208,182 @@ NrInterference::ConditionallyEvaluateChunk()
  *       short period of time.
  ****************************************************************/
 
-NrInterference::NiChange::NiChange(Time time, double delta)
-    : m_time(time),
-      m_delta(delta)
+void
+NrInterference::NiChanges::Insert(Time time, double delta)
 {
+    int32_t n;
+    if (m_free.empty())
+    {
+        n = static_cast<int32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+    else
+    {
+        n = m_free.back();
+        m_free.pop_back();
+    }
+    // xorshift32, the priorities only need to be well spread
+    m_rngState ^= m_rngState << 13;
+    m_rngState ^= m_rngState >> 17;
+    m_rngState ^= m_rngState << 5;
+    m_nodes[n] = Node{time, m_nextSeq++, delta, delta, delta, m_rngState};
+
+    // The new node has the highest sequence number, so it goes after the events at the same time
+    auto [before, after] = Split(m_root, time, m_nextSeq);
+    m_root = Merge(Merge(before, n), after);
 }
 
-Time
-NrInterference::NiChange::GetTime() const
+double
+NrInterference::NiChanges::Prune(Time moment, bool inclusive)
 {
-    return m_time;
+    auto [past, future] = Split(m_root, moment, inclusive ? m_nextSeq : 0);
+    m_root = future;
+    if (past < 0)
+    {
+        return 0.0;
+    }
+    auto sum = m_nodes[past].sum;
+    Free(past);
+    return sum;
 }
 
-double
-NrInterference::NiChange::GetDelta() const
+std::optional<Time>
+NrInterference::NiChanges::FindFirstBelow(double firstPower, double energyW) const
 {
-    return m_delta;
+    // Descend towards the first node whose running power is below the threshold. The minimum
+    // running power of a subtree tells whether such a node is in it.
+    auto n = m_root;
+    auto offset = firstPower;
+    while (n >= 0 && offset + m_nodes[n].minPrefix < energyW)
+    {
+        const auto& node = m_nodes[n];
+        if (node.left >= 0 && offset + m_nodes[node.left].minPrefix < energyW)
+        {
+            n = node.left;
+            continue;
+        }
+        if (node.left >= 0)
+        {
+            offset += m_nodes[node.left].sum;
+        }
+        offset += node.delta;
+        if (offset < energyW)
+        {
+            return node.time;
+        }
+        n = node.right;
+    }
+    return std::nullopt;
 }
 
-bool
-NrInterference::NiChange::operator<(const NrInterference::NiChange& o) const
+std::optional<Time>
+NrInterference::NiChanges::GetLastTime() const
 {
-    return (m_time < o.m_time);
+    if (m_root < 0)
+    {
+        return std::nullopt;
+    }
+    auto n = m_root;
+    while (m_nodes[n].right >= 0)
+    {
+        n = m_nodes[n].right;
+    }
+    return m_nodes[n].time;
+}
+
+void
+NrInterference::NiChanges::Clear()
+{
+    m_nodes.clear();
+    m_free.clear();
+    m_root = -1;
+}
+
+void
+NrInterference::NiChanges::Update(int32_t n)
+{
+    auto& node = m_nodes[n];
+    double sum = 0.0;
+    double minPrefix = std::numeric_limits<double>::infinity();
+    if (node.left >= 0)
+    {
+        const auto& left = m_nodes[node.left];
+        minPrefix = left.minPrefix;
+        sum = left.sum;
+    }
+    sum += node.delta;
+    minPrefix = std::min(minPrefix, sum);
+    if (node.right >= 0)
+    {
+        const auto& right = m_nodes[node.right];
+        minPrefix = std::min(minPrefix, sum + right.minPrefix);
+        sum += right.sum;
+    }
+    node.sum = sum;
+    node.minPrefix = minPrefix;
+}
+
+std::pair<int32_t, int32_t>
+NrInterference::NiChanges::Split(int32_t n, Time time, uint64_t seq)
+{
+    if (n < 0)
+    {
+        return {-1, -1};
+    }
+    auto& node = m_nodes[n];
+    if (node.time < time || (node.time == time && node.seq < seq))
+    {
+        auto [before, after] = Split(node.right, time, seq);
+        m_nodes[n].right = before;
+        Update(n);
+        return {n, after};
+    }
+    auto [before, after] = Split(node.left, time, seq);
+    m_nodes[n].left = after;
+    Update(n);
+    return {before, n};
+}
+
+int32_t
+NrInterference::NiChanges::Merge(int32_t a, int32_t b)
+{
+    if (a < 0)
+    {
+        return b;
+    }
+    if (b < 0)
+    {
+        return a;
+    }
+    if (m_nodes[a].priority > m_nodes[b].priority)
+    {
+        m_nodes[a].right = Merge(m_nodes[a].right, b);
+        Update(a);
+        return a;
+    }
+    m_nodes[b].left = Merge(a, m_nodes[b].left);
+    Update(b);
+    return b;
+}
+
+void
+NrInterference::NiChanges::Free(int32_t n)
+{
+    std::vector<int32_t> stack{n};
+    while (!stack.empty())
+    {
+        auto i = stack.back();
+        stack.pop_back();
+        if (m_nodes[i].left >= 0)
+        {
+            stack.push_back(m_nodes[i].left);
+        }
+        if (m_nodes[i].right >= 0)
+        {
+            stack.push_back(m_nodes[i].right);
+        }
+        m_free.push_back(i);
+    }
 }
 
 bool
@@ -238,30 +417,16 @@ NrInterference::GetEnergyDuration(double energyW)
     }
 
     Time now = Simulator::Now();
-    double noiseInterferenceW = 0.0;
-    Time end = now;
-    noiseInterferenceW = m_firstPower;
+    // Past events only contribute to the current power, so they can be dropped
+    m_firstPower += m_niChanges.Prune(now, false);
 
     NS_LOG_INFO("First power: " << m_firstPower);
 
-    for (const auto& i : m_niChanges)
-    {
-        noiseInterferenceW += i.GetDelta();
-        end = i.GetTime();
-        NS_LOG_INFO("Delta: " << i.GetDelta() << "time: " << i.GetTime());
-        if (end < now)
-        {
-            continue;
-        }
-        if (noiseInterferenceW < energyW)
-        {
-            break;
-        }
-    }
+    // The channel is busy until the power drops below the threshold, or until the last event
+    auto end = m_niChanges.FindFirstBelow(m_firstPower, energyW)
+                   .value_or(m_niChanges.GetLastTime().value_or(now));
 
-    NS_LOG_INFO("Future power dBm:" << 10 * log10(noiseInterferenceW * 1000)
-                                    << " W:" << noiseInterferenceW
-                                    << " and energy threshold in W is: " << energyW);
+    NS_LOG_INFO("Energy threshold in W is: " << energyW);
 
     if (end > now)
     {
@@ -278,22 +443,10 @@ NrInterference::GetEnergyDuration(double energyW)
 void
 NrInterference::EraseEvents()
 {
-    m_niChanges.clear();
+    m_niChanges.Clear();
     m_firstPower = 0.0;
 }
 
-NrInterference::NiChanges::iterator
-NrInterference::GetPosition(Time moment)
-{
-    return std::upper_bound(m_niChanges.begin(), m_niChanges.end(), NiChange(moment, 0));
-}
-
-void
-NrInterference::AddNiChangeEvent(NiChange change)
-{
-    m_niChanges.insert(GetPosition(change.GetTime()), change);
-}
-
 void
 NrInterference::AppendEvent(Time startTime, Time endTime, double rxPowerW)
 {
@@ -301,27 +454,15 @@ NrInterference::AppendEvent(Time startTime, Time endTime, double rxPowerW)
 
     if (!m_receiving)
     {
-        auto nowIterator = GetPosition(now);
-        // We empty the list until the current moment. To do so we
-        // first we sum all the energies until the current moment
-        // and save it in m_firstPower.
-        for (auto i = m_niChanges.begin(); i != nowIterator; i++)
-        {
-            m_firstPower += i->GetDelta();
-        }
-        // then we remove all the events up to the current moment
-        m_niChanges.erase(m_niChanges.begin(), nowIterator);
-        // we create an event that represents the new energy
-        m_niChanges.insert(m_niChanges.begin(), NiChange(startTime, rxPowerW));
-    }
-    else
-    {
-        // for the startTime create the event that adds the energy
-        AddNiChangeEvent(NiChange(startTime, rxPowerW));
+        // We empty the list until the current moment, accumulating
+        // the energies of the removed events in m_firstPower.
+        m_firstPower += m_niChanges.Prune(now, true);
     }
 
+    // for the startTime create the event that adds the energy
+    m_niChanges.Insert(startTime, rxPowerW);
     // for the endTime create event that will subtract energy
-    AddNiChangeEvent(NiChange(endTime, -rxPowerW));
+    m_niChanges.Insert(endTime, -rxPowerW);
 }
 
 void
@@ -332,7 +473,10 @@ NrInterference::AddSignalMimo(Ptr<const SpectrumSignalParameters> params, const
 
     NS_LOG_FUNCTION(this << *params->psd << duration);
     NrInterferenceBase::DoAddSignal(params->psd);
-    m_allSignalsMimo.push_back(params);
+    [[maybe_unused]] auto inserted = m_allSignalsMimo.insert(params).second;
+    NS_ASSERT_MSG(inserted, "MIMO signal was already added");
+    // The signal is an interferer until StartRxMimo is called for it
+    AddOutOfCellInterference(params);
     // Update signal ID to match signal ID in NrInterferenceBase
     if (++m_lastSignalId == m_lastSignalIdBeforeReset)
     {
@@ -353,10 +497,19 @@ NrInterference::StartRxMimo(Ptr<const SpectrumSignalParameters> params)
     auto rxPsd = params->psd;
     if (!m_receiving)
     {
-        // This must be the first receive signal, clear any lingering previous signals
+        // This must be the first receive signal, clear any lingering previous signals. The ones
+        // that are still being transmitted become interferers of the new reception.
+        for (const auto& prevRxSignal : m_rxSignalsMimo)
+        {
+            if (m_allSignalsMimo.contains(prevRxSignal))
+            {
+                AddOutOfCellInterference(prevRxSignal);
+            }
+        }
         m_rxSignalsMimo.clear();
     }
     m_rxSignalsMimo.push_back(params);
+    SubtractOutOfCellInterference(params);
     for (auto& cp : m_mimoChunkProcessors)
     {
         // Clear the list of stored chunks
@@ -369,22 +522,56 @@ void
 NrInterference::DoSubtractSignalMimo(Ptr<const SpectrumSignalParameters> params, uint32_t signalId)
 {
     DoSubtractSignal(params->psd, signalId);
-    auto numSignals = m_allSignalsMimo.size();
-    // In many instances the signal subtracted is the last signal. Check first for speedup.
-    if (m_allSignalsMimo.back() == params)
+    [[maybe_unused]] auto numErased = m_allSignalsMimo.erase(params);
+    NS_ASSERT_MSG(numErased == 1, "MIMO signal was not found for removal");
+    SubtractOutOfCellInterference(params);
+}
+
+void
+NrInterference::AddOutOfCellInterference(Ptr<const SpectrumSignalParameters> signal)
+{
+    if (m_mimoChunkProcessors.empty() || !signal->spectrumChannelMatrix)
+    {
+        // The covariance is only needed for MIMO chunk processing
+        return;
+    }
+    if (m_outOfCellSignalsMimo.empty())
+    {
+        auto nRbs = signal->spectrumChannelMatrix->GetNumPages();
+        auto nRxPorts = signal->spectrumChannelMatrix->GetNumRows();
+        m_outOfCellInterfCov = NrCovMat{ComplexMatrixArray(nRxPorts, nRxPorts, nRbs)};
+    }
+    NS_ASSERT_MSG(signal->spectrumChannelMatrix->GetNumPages() ==
+                          m_outOfCellInterfCov.GetNumPages() &&
+                      signal->spectrumChannelMatrix->GetNumRows() ==
+                          m_outOfCellInterfCov.GetNumRows(),
+                  "Interference signals must have equal dimensions");
+    m_outOfCellSignalsMimo.insert(signal);
+    AddInterference(m_outOfCellInterfCov, signal);
+}
+
+void
+NrInterference::SubtractOutOfCellInterference(Ptr<const SpectrumSignalParameters> signal)
+{
+    if (m_outOfCellSignalsMimo.erase(signal) == 0)
+    {
+        return;
+    }
+    if (m_outOfCellSignalsMimo.empty())
+    {
+        // Drop the residue of the additions and subtractions instead of keeping it around
+        m_outOfCellInterfCov = NrCovMat{};
+        return;
+    }
+    const auto& chanSpct = *(signal->spectrumChannelMatrix);
+    if (signal->precodingMatrix)
     {
-        m_allSignalsMimo.pop_back();
+        m_outOfCellInterfCov.SubtractInterferenceSignal(chanSpct * (*signal->precodingMatrix));
     }
     else
     {
-        m_allSignalsMimo.erase(
-            std::remove_if(m_allSignalsMimo.begin(),
-                           m_allSignalsMimo.end(),
-                           [params](Ptr<const SpectrumSignalParameters> p) { return p == params; }),
-            m_allSignalsMimo.end());
+        m_outOfCellInterfCov.SubtractInterferenceSignal(chanSpct);
     }
-    NS_ASSERT_MSG(m_allSignalsMimo.size() == (numSignals - 1),
-                  "MIMO signal was not found for removal");
 }
 
 void
@@ -410,28 +597,20 @@ NrInterference::CalcOutOfCellInterfCov() const
     auto nRbs = firstSignal->spectrumChannelMatrix->GetNumPages();
     auto nRxPorts = firstSignal->spectrumChannelMatrix->GetNumRows();
 
-    // Create white noise covariance matrix
-    auto allSignalsNoiseCov = NrCovMat{ComplexMatrixArray(nRxPorts, nRxPorts, nRbs)};
+    // Start from the external interference signals, if any, and add white noise
+    auto allSignalsNoiseCov = m_outOfCellSignalsMimo.empty()
+                                  ? NrCovMat{ComplexMatrixArray(nRxPorts, nRxPorts, nRbs)}
+                                  : m_outOfCellInterfCov;
+    NS_ASSERT_MSG(allSignalsNoiseCov.GetNumPages() == nRbs &&
+                      allSignalsNoiseCov.GetNumRows() == nRxPorts,
+                  "Interference and receive signals must have equal dimensions");
     for (size_t iRb = 0; iRb < nRbs; iRb++)
     {
         for (size_t iRxPort = 0; iRxPort < nRxPorts; iRxPort++)
         {
-            allSignalsNoiseCov(iRxPort, iRxPort, iRb) = m_noise->ValuesAt(iRb);
+            allSignalsNoiseCov(iRxPort, iRxPort, iRb) += m_noise->ValuesAt(iRb);
         }
     }
-
-    // Add all external interference signals to the covariance matrix
-    for (const auto& intfSignal : m_allSignalsMimo)
-    {
-        if (std::find(m_rxSignalsMimo.begin(), m_rxSignalsMimo.end(), intfSignal) !=
-            m_rxSignalsMimo.end())
-        {
-            // This is one of the signals in the current cell
-            continue;
-        }
-
-        AddInterference(allSignalsNoiseCov, intfSignal);
-    }
     return allSignalsNoiseCov;
 }
 
@@ -448,8 +627,7 @@ NrInterference::CalcCurrInterfCov(Ptr<const SpectrumSignalParameters> rxSignal,
         {
             continue; // this is the current receive signal of interest, do not add to interference
         }
-        NS_ASSERT_MSG((std::find(m_allSignalsMimo.begin(), m_allSignalsMimo.end(), otherSignal) !=
-                       m_allSignalsMimo.end()),
+        NS_ASSERT_MSG(m_allSignalsMimo.contains(otherSignal),
                       "RX signal already deleted from m_allSignalsMimo");
 
         AddInterference(interfNoiseCov, otherSignal);
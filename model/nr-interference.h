@@ -7,6 +7,7 @@
 
 #include "nr-chunk-processor.h"
 #include "nr-interference-base.h"
+#include "nr-mimo-matrices.h"
 
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -15,14 +16,15 @@
 #include "ns3/traced-callback.h"
 #include "ns3/vector.h"
 
+#include <optional>
+#include <set>
+
 namespace ns3
 {
 
 // Signal ID increment used in LteInterference
 static constexpr uint32_t NR_LTE_SIGNALID_INCR = 0x10000000;
 
-class NrCovMat;
-class NrSinrMatrix;
 class NrErrorModel;
 class NrMimoChunkProcessor;
 
@@ -128,11 +130,20 @@ class NrInterference : public NrInterferenceBase
 
   private:
     /// @brief Calculate interference-plus-noise covariance matrix for signals not in m_rxSignals
-    /// This function computes the interference signals from all out-of-cell interferers. The
-    /// intra-cell interference signals that are part of m_rxSignals are skipped.
+    /// The covariance of the out-of-cell interferers is maintained incrementally as signals
+    /// start and end (see m_outOfCellInterfCov), so this function only adds the noise.
     /// @return the interference+noise covariance matrix for out-of-cell interference
     NrCovMat CalcOutOfCellInterfCov() const;
 
+    /// @brief Add a signal to the aggregate out-of-cell interference covariance matrix
+    /// @param signal the interfering signal
+    void AddOutOfCellInterference(Ptr<const SpectrumSignalParameters> signal);
+
+    /// @brief Remove a signal from the aggregate out-of-cell interference covariance matrix,
+    /// if it is part of it
+    /// @param signal the signal that is no longer an out-of-cell interferer
+    void SubtractOutOfCellInterference(Ptr<const SpectrumSignalParameters> signal);
+
     /// @brief Add the remaining interference to the interference-and-noise covariance matrix
     /// This function is required for MU-MIMO UL, where the signal from a different UE within the
     /// same cell can act as interference towards the current signal.
@@ -155,78 +166,120 @@ class NrInterference : public NrInterferenceBase
                              Ptr<const SpectrumSignalParameters> rxSignal) const;
 
     /// Stores the params of all incoming signals, including the interference signals
-    std::vector<Ptr<const SpectrumSignalParameters>> m_allSignalsMimo;
+    std::set<Ptr<const SpectrumSignalParameters>> m_allSignalsMimo;
 
     /// Stores the params of all incoming signals intended for this receiver
     std::vector<Ptr<const SpectrumSignalParameters>> m_rxSignalsMimo;
 
+    /// Stores the params of the signals whose covariance is part of m_outOfCellInterfCov
+    std::set<Ptr<const SpectrumSignalParameters>> m_outOfCellSignalsMimo;
+
+    /// Sum of the covariance matrices of the signals in m_outOfCellSignalsMimo, without noise.
+    /// Only maintained when a MIMO chunk processor is set, and reset to empty when the last
+    /// interferer ends, so that rounding errors of additions and subtractions do not accumulate.
+    NrCovMat m_outOfCellInterfCov;
+
     /// The processor instances that are notified whenever a new interference chunk is calculated
     std::list<Ptr<NrMimoChunkProcessor>> m_mimoChunkProcessors;
 
     /**
-     * Noise and Interference (thus Ni) event.
+     * @brief Time-ordered list of Noise and Interference (thus Ni) change events.
+     *
+     * Each event adds (signal start) or subtracts (signal end) the power of a signal. Events
+     * are kept in a treap ordered by time and, for equal times, by insertion order. Every node
+     * stores the sum of the power deltas of its subtree and the minimum running power within
+     * it, so that inserting an event, pruning the past events and finding the first event after
+     * which the power drops below a threshold take O(log n) operations.
      */
-    class NiChange
+    class NiChanges
     {
       public:
         /**
-         * Create a NiChange at the given time and the amount of NI change.
-         *
+         * @brief Insert an event, after any other event at the same time
          * @param time time of the event
-         * @param delta the power
+         * @param delta the power change
+         */
+        void Insert(Time time, double delta);
+
+        /**
+         * @brief Remove the events before a given moment
+         * @param moment the moment
+         * @param inclusive whether the events at the moment are also removed
+         * @return the sum of the power changes of the removed events
          */
-        NiChange(Time time, double delta);
+        double Prune(Time moment, bool inclusive);
+
         /**
-         * Return the event time.
-         *
-         * @return the event time.
+         * @brief Find the first event after which the running power is below a threshold
+         * @param firstPower the power before the first event
+         * @param energyW the threshold
+         * @return the time of the event, or std::nullopt if there is no such event
          */
-        Time GetTime() const;
+        std::optional<Time> FindFirstBelow(double firstPower, double energyW) const;
+
         /**
-         * Return the power
-         *
-         * @return the power
+         * @return the time of the last event, or std::nullopt if there are no events
          */
-        double GetDelta() const;
+        std::optional<Time> GetLastTime() const;
+
         /**
-         * Compare the event time of two NiChange objects (a < o).
-         *
-         * @param o
-         * @return true if a < o.time, false otherwise
+         * @brief Remove all the events
          */
-        bool operator<(const NiChange& o) const;
+        void Clear();
 
       private:
-        Time m_time;
-        double m_delta;
-    };
+        /// A node of the treap
+        struct Node
+        {
+            Time time;         //!< Time of the event
+            uint64_t seq;      //!< Insertion order, to keep events at the same time in order
+            double delta;      //!< Power change of the event
+            double sum;        //!< Sum of the power changes of the subtree
+            double minPrefix; //!< Minimum running power in the subtree, relative to its start
+            uint32_t priority; //!< Heap priority of the treap
+            int32_t left{-1};  //!< Index of the left child, or -1
+            int32_t right{-1}; //!< Index of the right child, or -1
+        };
 
-    /**
-     * typedef for a vector of NiChanges
-     */
-    typedef std::vector<NiChange> NiChanges;
+        /**
+         * @brief Recompute the aggregates of a node from its children
+         * @param n the node index
+         */
+        void Update(int32_t n);
 
-    /**
-     * @brief Find a position in event list that corresponds to a given
-     * moment. Note that all events are saved when they start and when
-     * they end. When they start, the energy the signal brings is saved as
-     * the positive value, and the event when the energy finish is
-     * saved with a negative prefix. By using this position, one
-     * can know which signals have finished, and can be removed from
-     * the list because after the given moment they do not contribute
-     * anymore to the total energy received.
-     */
-    NrInterference::NiChanges::iterator GetPosition(Time moment);
+        /**
+         * @brief Split a subtree into the nodes ordered before (time, seq) and the rest
+         * @param n the subtree root
+         * @param time the time of the split key
+         * @param seq the sequence number of the split key
+         * @return the roots of the two subtrees
+         */
+        std::pair<int32_t, int32_t> Split(int32_t n, Time time, uint64_t seq);
+
+        /**
+         * @brief Merge two subtrees, all the nodes of the first ordered before the second
+         * @param a the root of the first subtree
+         * @param b the root of the second subtree
+         * @return the root of the merged subtree
+         */
+        int32_t Merge(int32_t a, int32_t b);
+
+        /**
+         * @brief Free all the nodes of a subtree
+         * @param n the subtree root
+         */
+        void Free(int32_t n);
+
+        std::vector<Node> m_nodes;   //!< Node storage
+        std::vector<int32_t> m_free; //!< Indexes of the unused entries of m_nodes
+        int32_t m_root{-1};          //!< Index of the root node, or -1
+        uint64_t m_nextSeq{0};       //!< Sequence number of the next event
+        uint32_t m_rngState{1};      //!< State of the generator of treap priorities
+    };
 
     // inherited from LteInterference
     void ConditionallyEvaluateChunk() override;
 
-    /**
-     * Add NiChange to the list at the appropriate position.
-     * @param change
-     */
-    void AddNiChangeEvent(NiChange change);
-
   protected:
     /**
      * @brief DoDispose method inherited from Object
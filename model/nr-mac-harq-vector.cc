@@ -7,56 +7,59 @@
 namespace ns3
 {
 
-bool
-NrMacHarqVector::Erase(uint8_t id)
+void
+NrMacHarqVector::SetMaxSize(uint8_t size)
 {
-    at(id).Erase();
-    --m_usedSize;
-
-    uint32_t count = 0;
-    for (const auto& v : *this)
+    NS_ABORT_MSG_IF(size > MAX_SIZE,
+                    "The maximum number of HARQ processes is " << +MAX_SIZE << ", requested "
+                                                               << +size);
+    m_maxSize = size;
+    m_activeMask = 0;
+    for (uint8_t i = 0; i < MAX_SIZE; ++i)
     {
-        if (v.second.m_active)
-        {
-            ++count;
-        }
+        m_processes[i].first = i;
+        m_processes[i].second.Erase();
     }
-    NS_ASSERT(count == m_usedSize);
+}
+
+bool
+NrMacHarqVector::Erase(uint8_t id)
+{
+    NS_ASSERT(Exist(id));
+    m_processes[id].second.Erase();
+    NS_ASSERT(m_activeMask & (1U << id));
+    m_activeMask &= ~(1U << id);
     return true;
 }
 
 bool
 NrMacHarqVector::Insert(uint8_t* id, const HarqProcess& element)
 {
-    if (m_usedSize >= m_maxSize)
-    {
-        return false;
-    }
-
     NS_ABORT_IF(element.m_active == false);
 
     *id = FirstAvailableId();
-    if (*id == 255)
+    if (*id == NO_ID)
     {
         return false;
     }
 
-    NS_ABORT_IF(at(*id).m_active == true);
-    at(*id) = element;
-
-    NS_ABORT_IF(at(*id).m_active == false);
-    NS_ABORT_IF(this->FirstAvailableId() == *id);
+    HarqProcess& process = m_processes[*id].second;
+    NS_ABORT_IF(process.m_active == true);
+    process = element;
+    m_activeMask |= 1U << *id;
 
-    ++m_usedSize;
+    NS_ABORT_IF(process.m_active == false);
+    NS_ABORT_IF(FirstAvailableId() == *id);
     return true;
 }
 
 std::ostream&
 operator<<(std::ostream& os, const NrMacHarqVector& item)
 {
-    for (const auto& p : item)
+    for (auto it = item.CBegin(); it != item.CEnd(); ++it)
     {
-        os << "Process ID " << static_cast<uint32_t>(p.first) << ": " << p.second << std::endl;
+        os << "Process ID " << static_cast<uint32_t>(it->first) << ": " << it->second
+           << std::endl;
     }
     return os;
 }
@@ -6,7 +6,9 @@
 
 #include "nr-mac-harq-process.h"
 
-#include <unordered_map>
+#include <array>
+#include <bit>
+#include <utility>
 
 namespace ns3
 {
@@ -15,29 +17,44 @@ namespace ns3
  * @ingroup scheduler
  * @brief Data structure to save all the HARQ process of an UE
  *
- * The data is stored as an unordered_map between the process ID and the
- * real data, saved in the structure HarqProcess. The vector (yes, it is an
- * improper name) is always full (i.e., it always contains almost 20 HARQ processes)
- * but they can be inactive (i.e., no data is stored there). The duty of finding
- * an empty spot is split between Insert and FirstAvailableId.
+ * The data is stored in a fixed-size array of pairs between the process ID and
+ * the real data, saved in the structure HarqProcess, indexed by the process ID.
+ * The vector is always full (i.e., it always contains the number of HARQ processes
+ * set with SetMaxSize, up to MAX_SIZE) but they can be inactive (i.e., no data is
+ * stored there). The active processes are also tracked in a bitmask, so that
+ * finding an empty spot (FirstAvailableId) or visiting the active processes
+ * (FindFirstActive, FindNextActive) does not need to look at every process.
+ *
+ * The iterators visit all the processes, active or not, in increasing order of ID.
  *
  * The class does not support going "out of space", or in other words, if all
  * the spots are filled with active processes, the next insert will fail.
  *
  * @see HarqProcess
  */
-class NrMacHarqVector : private std::unordered_map<uint8_t, HarqProcess>
+class NrMacHarqVector
 {
   public:
     friend std::ostream& operator<<(std::ostream& os, const NrMacHarqVector& item);
+
+    /// Maximum number of HARQ processes of a vector
+    static constexpr uint8_t MAX_SIZE = 32;
+
+    /// Value returned when there is no process ID to return
+    static constexpr uint8_t NO_ID = 255;
+
+    /**
+     * @brief Storage of the processes, as pairs of process ID and process
+     */
+    typedef std::array<std::pair<uint8_t, HarqProcess>, MAX_SIZE> Storage;
     /**
-     * @brief iterator of the map
+     * @brief iterator of the vector
      */
-    typedef typename std::unordered_map<uint8_t, HarqProcess>::iterator iterator;
+    typedef Storage::iterator iterator;
     /**
-     * @brief const_iterator of the map
+     * @brief const_iterator of the vector
      */
-    typedef typename std::unordered_map<uint8_t, HarqProcess>::const_iterator const_iterator;
+    typedef Storage::const_iterator const_iterator;
 
     /**
      * @brief Default constructor
@@ -45,20 +62,12 @@ class NrMacHarqVector : private std::unordered_map<uint8_t, HarqProcess>
     NrMacHarqVector() = default;
 
     /**
-     * @brief Set and reserve the size of the vector
+     * @brief Set the size of the vector
      * @param size the vector size
      *
-     * The method will reserve and create the necessary processes.
+     * The method will create the necessary processes, all inactive.
      */
-    void SetMaxSize(uint8_t size)
-    {
-        m_maxSize = size;
-        reserve(size);
-        for (auto i = 0; i < size; ++i)
-        {
-            emplace(i, HarqProcess());
-        }
-    }
+    void SetMaxSize(uint8_t size);
 
     /**
      * @brief Erase the selected process
@@ -78,59 +87,58 @@ class NrMacHarqVector : private std::unordered_map<uint8_t, HarqProcess>
     /**
      * @brief Find a process
      * @param key ID of the process to find
-     * @return an iterator to the process
+     * @return an iterator to the process, or End() if the ID does not exist
      */
-    const iterator Find(uint8_t key)
+    iterator Find(uint8_t key)
     {
-        return this->find(key);
+        return Exist(key) ? m_processes.begin() + key : End();
     }
 
     /**
      * @brief Begin of the vector
      * @return an iterator to the first element
      */
-    const iterator Begin()
+    iterator Begin()
     {
-        return this->begin();
+        return m_processes.begin();
     }
 
     /**
      * @brief End of the vector
      * @return an iterator to the end() element
      */
-    const iterator End()
+    iterator End()
     {
-        return this->end();
+        return m_processes.begin() + m_maxSize;
     }
 
     /**
      * @brief Const begin of the vector
      * @return a const iterator to the first element
      */
-    const_iterator CBegin()
+    const_iterator CBegin() const
     {
-        return this->cbegin();
+        return m_processes.cbegin();
     }
 
     /**
      * @brief Const end of the vector
      * @return a const iterator to the end() element
      */
-    const_iterator CEnd()
+    const_iterator CEnd() const
     {
-        return this->cend();
+        return m_processes.cbegin() + m_maxSize;
     }
 
     /**
-     * @brief Check if the ID exists in the map
+     * @brief Check if the ID exists in the vector
      * @param id ID to check
      * @return true if the ID exists, false if the ID is outside the maximum number
      * of stored elements
      */
     bool Exist(uint8_t id) const
     {
-        // could be id > max_size?
-        return find(id) != end();
+        return id < m_maxSize;
     }
 
     /**
@@ -141,7 +149,7 @@ class NrMacHarqVector : private std::unordered_map<uint8_t, HarqProcess>
     HarqProcess& Get(uint8_t id)
     {
         NS_ASSERT(Exist(id));
-        return find(id)->second;
+        return m_processes[id].second;
     }
 
     /**
@@ -152,23 +160,38 @@ class NrMacHarqVector : private std::unordered_map<uint8_t, HarqProcess>
     const HarqProcess& Get(uint8_t id) const
     {
         NS_ASSERT(Exist(id));
-        return find(id)->second;
+        return m_processes[id].second;
     }
 
     /**
      * @brief Find the first (INACTIVE) ID
-     * @return an usable ID, or 255 in case no ID are available
+     * @return an usable ID, or NO_ID (255) in case no ID are available
      */
     uint8_t FirstAvailableId() const
     {
-        for (const auto& it : *this)
-        {
-            if (!it.second.m_active)
-            {
-                return it.first;
-            }
-        }
-        return 255;
+        const uint32_t freeMask = ~m_activeMask & GetValidMask();
+        return freeMask == 0 ? NO_ID : static_cast<uint8_t>(std::countr_zero(freeMask));
+    }
+
+    /**
+     * @brief Find the first ACTIVE process
+     * @return the ID of the first active process, or NO_ID if no process is active
+     */
+    uint8_t FindFirstActive() const
+    {
+        return m_activeMask == 0 ? NO_ID : static_cast<uint8_t>(std::countr_zero(m_activeMask));
+    }
+
+    /**
+     * @brief Find the next ACTIVE process
+     * @param id the ID of an active process
+     * @return the ID of the next active process after id, or NO_ID if there is none
+     */
+    uint8_t FindNextActive(uint8_t id) const
+    {
+        NS_ASSERT(id < MAX_SIZE);
+        const uint32_t nextMask = id + 1 < MAX_SIZE ? m_activeMask >> (id + 1) << (id + 1) : 0;
+        return nextMask == 0 ? NO_ID : static_cast<uint8_t>(std::countr_zero(nextMask));
     }
 
     /**
@@ -186,12 +209,24 @@ class NrMacHarqVector : private std::unordered_map<uint8_t, HarqProcess>
      */
     uint32_t Size() const
     {
-        return m_usedSize;
+        return std::popcount(m_activeMask);
     }
 
   private:
-    uint8_t m_maxSize{0};  //!< Maximum size (or the number of processes stored)
-    uint8_t m_usedSize{0}; //!< Number of ACTIVE processes
+    /**
+     * @brief Get the mask of the existing process IDs
+     * @return a mask with the m_maxSize least significant bits set
+     */
+    uint32_t GetValidMask() const
+    {
+        return m_maxSize == MAX_SIZE ? ~0U : (1U << m_maxSize) - 1;
+    }
+
+    Storage m_processes{};    //!< Processes, indexed by ID
+    uint32_t m_activeMask{0}; //!< Bit i is set if the process i is ACTIVE
+    uint8_t m_maxSize{0};     //!< Maximum size (or the number of processes stored)
+
+    static_assert(MAX_SIZE <= 32, "The active mask does not fit all the processes");
 };
 
 /**
@@ -176,6 +176,33 @@ class NrMacSchedSapProvider
 
     virtual bool IsMaxSrsReached() const = 0;
 
+    /**
+     * @brief Check whether the triggers can run in parallel with the ones of other cells
+     *
+     * If true, SchedDlTriggerReq and SchedUlTriggerReq can run outside of the simulation
+     * thread, concurrently with the triggers of the schedulers of other cells, between
+     * PrepareParallelTrigger and CompleteParallelTrigger.
+     * @return true if the triggers can run in parallel with other cells
+     */
+    virtual bool IsParallelSchedulingSupported() const = 0;
+
+    /**
+     * @brief Prepare the next trigger to run outside of the simulation thread
+     *
+     * Called in the simulation thread, with logging disabled. During the trigger, the
+     * scheduler does not call the NrMacSchedSapUser nor fire trace sources; it records
+     * these calls instead.
+     */
+    virtual void PrepareParallelTrigger() = 0;
+
+    /**
+     * @brief Complete a trigger prepared with PrepareParallelTrigger
+     *
+     * Called in the simulation thread after the trigger. The scheduler makes the calls
+     * recorded during the trigger, in order.
+     */
+    virtual void CompleteParallelTrigger() = 0;
+
   private:
 };
 
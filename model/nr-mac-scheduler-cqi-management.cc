@@ -25,7 +25,7 @@ NrMacSchedulerCQIManagement::UlSBCQIReported(
     [[maybe_unused]] uint32_t tbs,
     const NrMacSchedSapProvider::SchedUlCqiInfoReqParameters& params,
     const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
-    const std::vector<bool>& rbgMask,
+    const NrRbgMask& rbgMask,
     uint32_t numRbPerRbg,
     const Ptr<const SpectrumModel>& model) const
 {
@@ -75,8 +75,10 @@ NrMacSchedulerCQIManagement::UlSBCQIReported(
 
     NS_LOG_INFO("Values of SINR to pass to the AMC: " << out.str());
 
-    // MCS updated inside the function; crappy API... but we can't fix everything
-    ueInfo->m_ulCqi.m_wbCqi = GetAmcUl()->CreateCqiFeedbackSiso(specVals, ueInfo->m_ulMcs);
+    // MCS updated inside the function; crappy API... but we can't fix everything.
+    // The previous UL MCS is the starting point of the search, if the AMC bisects it.
+    ueInfo->m_ulCqi.m_wbCqi =
+        GetAmcUl()->CreateCqiFeedbackSiso(specVals, ueInfo->m_ulMcs, ueInfo->m_ulMcs);
     NS_LOG_DEBUG("Calculated MCS for RNTI " << ueInfo->m_rnti << " is " << ueInfo->m_ulMcs);
 }
 
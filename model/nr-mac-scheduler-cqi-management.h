@@ -107,7 +107,7 @@ class NrMacSchedulerCQIManagement
                          uint32_t tbs,
                          const NrMacSchedSapProvider::SchedUlCqiInfoReqParameters& params,
                          const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
-                         const std::vector<bool>& rbgMask,
+                         const NrRbgMask& rbgMask,
                          uint32_t numRbPerRbg,
                          const Ptr<const SpectrumModel>& model) const;
 
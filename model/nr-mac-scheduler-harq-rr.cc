@@ -77,7 +77,7 @@ NrMacSchedulerHarqRr::InstallReshapeAllocation(
         const std::vector<DciInfoElementTdma>(const std::vector<DciInfoElementTdma>& dcis,
                                               uint8_t& startingSymbol,
                                               uint8_t& numSymbols,
-                                              std::vector<bool>& bitmask,
+                                              NrRbgMask& bitmask,
                                               const bool isDl)>& fn)
 {
     m_getReshapeAllocation = fn;
@@ -114,16 +114,6 @@ NrMacSchedulerHarqRr::GetBeamOrderRR(NrMacSchedulerNs3::ActiveHarqMap activeHarq
     return ret;
 }
 
-std::ostream&
-operator<<(std::ostream& os, const std::vector<bool>& h)
-{
-    for (auto hb : h)
-    {
-        os << (int)hb;
-    }
-    return os;
-}
-
 /**
  * @brief Schedule DL HARQ in RR fashion
  * @param startingPoint starting point of the first retransmission.
@@ -179,9 +169,7 @@ NrMacSchedulerHarqRr::ScheduleDlHarq(
 
             auto& dciInfoReTx = harqProcess.m_dciElement;
 
-            uint32_t rbgAssigned =
-                std::count(dciInfoReTx->m_rbgBitmask.begin(), dciInfoReTx->m_rbgBitmask.end(), 1) *
-                dciInfoReTx->m_numSym;
+            uint32_t rbgAssigned = dciInfoReTx->m_rbgBitmask.Count() * dciInfoReTx->m_numSym;
             uint32_t rbgAvail = (GetBandwidthInRbg() - startingPoint->m_rbg) * symAvail;
 
             NS_LOG_INFO("Evaluating space to retransmit HARQ PID="
@@ -249,21 +237,9 @@ NrMacSchedulerHarqRr::ScheduleDlHarq(
                 // If not reshaping, we just change at most the starting symbol.
                 // But first we check if there are collisions.
                 symAvailBackup -= harqProcess.m_dciElement->m_numSym;
-                bool collision = false;
-                for (std::size_t i = 0; i < dlBitmaskBackup.size(); i++)
-                {
-                    if (harqProcess.m_dciElement->m_rbgBitmask.at(i))
-                    {
-                        if (!dlBitmaskBackup.at(i))
-                        {
-                            collision = true;
-                            break;
-                        }
-                        dlBitmaskBackup.at(i) = false;
-                    }
-                }
-                if (!collision)
+                if (harqProcess.m_dciElement->m_rbgBitmask.IsSubsetOf(dlBitmaskBackup))
                 {
+                    dlBitmaskBackup.AndNot(harqProcess.m_dciElement->m_rbgBitmask);
                     reshapedDcis.emplace_back(currStartingSymbolBackup,
                                               harqProcess.m_dciElement->m_numSym,
                                               harqProcess.m_dciElement->m_rbgBitmask,
@@ -577,13 +553,13 @@ NrMacSchedulerHarqRr::GetDoesFhAllocationFit(uint16_t bwpId,
 }
 
 void
-NrMacSchedulerHarqRr::InstallGetDlBitmask(const std::function<std::vector<bool>()>& fn)
+NrMacSchedulerHarqRr::InstallGetDlBitmask(const std::function<NrRbgMask()>& fn)
 {
     m_getDlBitmask = fn;
 }
 
 void
-NrMacSchedulerHarqRr::InstallGetUlBitmask(const std::function<std::vector<bool>()>& fn)
+NrMacSchedulerHarqRr::InstallGetUlBitmask(const std::function<NrRbgMask()>& fn)
 {
     m_getUlBitmask = fn;
 }
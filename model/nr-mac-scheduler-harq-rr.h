@@ -75,19 +75,19 @@ class NrMacSchedulerHarqRr : public Object
                                       const std::vector<DciInfoElementTdma>& dcis,
                                       uint8_t& startingSymbol,
                                       uint8_t& numSymbols,
-                                      std::vector<bool>& bitmask,
+                                      NrRbgMask& bitmask,
                                       const bool isDl)>& fn);
 
     /**
      * @brief Install a function to the downlink bitmask from the scheduler
      * @param fn the function
      */
-    void InstallGetDlBitmask(const std::function<std::vector<bool>()>& fn);
+    void InstallGetDlBitmask(const std::function<NrRbgMask()>& fn);
     /**
      * @brief Install a function to the uplink bitmask from the scheduler
      * @param fn the function
      */
-    void InstallGetUlBitmask(const std::function<std::vector<bool>()>& fn);
+    void InstallGetUlBitmask(const std::function<NrRbgMask()>& fn);
 
     virtual uint8_t ScheduleDlHarq(
         NrMacSchedulerNs3::PointInFTPlane* startingPoint,
@@ -158,12 +158,12 @@ class NrMacSchedulerHarqRr : public Object
     std::function<std::vector<DciInfoElementTdma>(const std::vector<DciInfoElementTdma>& dcis,
                                                   uint8_t& startingSymbol,
                                                   uint8_t& numSymbols,
-                                                  std::vector<bool>& bitmask,
+                                                  NrRbgMask& bitmask,
                                                   const bool isDl)>
         m_getReshapeAllocation; //!< Function to reshape allocation to maximize MCS and reduce
                                 //!< number of symbols
-    std::function<std::vector<bool>()> m_getDlBitmask; //!< Retrieve DL bitmask from scheduler
-    std::function<std::vector<bool>()> m_getUlBitmask; //!< Retrieve UL bitmask from scheduler
+    std::function<NrRbgMask()> m_getDlBitmask; //!< Retrieve DL bitmask from scheduler
+    std::function<NrRbgMask()> m_getUlBitmask; //!< Retrieve UL bitmask from scheduler
 
     mutable std::deque<BeamId> m_rrBeams; //!< Queue of order of beams to transmit
     mutable std::unordered_set<BeamId, BeamIdHash> m_rrBeamsSet; //!< Set of known beams
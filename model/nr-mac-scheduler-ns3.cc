@@ -35,6 +35,136 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("NrMacSchedulerNs3");
 NS_OBJECT_ENSURE_REGISTERED(NrMacSchedulerNs3);
 
+/**
+ * @brief SAP user of the scheduler during a trigger that runs outside of the simulation thread
+ *
+ * The getters return the values of the MAC SAP user taken by Prepare. The calls to the MAC,
+ * and the trace sources fired by the scheduler, are recorded, and made by Complete in the
+ * simulation thread, in the same order.
+ */
+class NrMacSchedulerNs3::DeferredSchedSapUser : public NrMacSchedSapUser
+{
+  public:
+    /**
+     * @brief Take the values of the getters from the MAC SAP user, and clear the recorded calls
+     * @param user the MAC SAP user
+     */
+    void Prepare(NrMacSchedSapUser* user)
+    {
+        m_user = user;
+        m_numRbPerRbg = user->GetNumRbPerRbg();
+        m_numHarqProcess = user->GetNumHarqProcess();
+        m_bwpId = user->GetBwpId();
+        m_cellId = user->GetCellId();
+        m_symbolsPerSlot = user->GetSymbolsPerSlot();
+        m_slotPeriod = user->GetSlotPeriod();
+        m_buildRarList = false;
+        m_calls.clear();
+    }
+
+    /**
+     * @brief Get the MAC SAP user passed to Prepare
+     * @return the MAC SAP user
+     */
+    NrMacSchedSapUser* GetMacSapUser() const
+    {
+        return m_user;
+    }
+
+    /**
+     * @brief Make the recorded calls, in order
+     */
+    void Replay()
+    {
+        auto calls = std::move(m_calls);
+        m_calls.clear();
+        for (const auto& call : calls)
+        {
+            call();
+        }
+    }
+
+    /**
+     * @brief Record a call
+     * @param call the call
+     */
+    void Record(std::function<void()> call)
+    {
+        m_calls.emplace_back(std::move(call));
+    }
+
+    void SchedConfigInd(const struct SchedConfigIndParameters& params) override
+    {
+        Record([user = m_user, params, buildRarList = m_buildRarList]() {
+            if (buildRarList)
+            {
+                // The RAR list is built on the allocations passed to SchedConfigInd
+                auto withRarList = params;
+                user->BuildRarList(withRarList.m_slotAllocInfo);
+                user->SchedConfigInd(withRarList);
+            }
+            else
+            {
+                user->SchedConfigInd(params);
+            }
+        });
+        m_buildRarList = false;
+    }
+
+    Ptr<const SpectrumModel> GetSpectrumModel() const override
+    {
+        NS_ABORT_MSG("The spectrum model cannot be used during a parallel trigger");
+        return nullptr;
+    }
+
+    uint32_t GetNumRbPerRbg() const override
+    {
+        return m_numRbPerRbg;
+    }
+
+    uint8_t GetNumHarqProcess() const override
+    {
+        return m_numHarqProcess;
+    }
+
+    uint16_t GetBwpId() const override
+    {
+        return m_bwpId;
+    }
+
+    uint16_t GetCellId() const override
+    {
+        return m_cellId;
+    }
+
+    uint32_t GetSymbolsPerSlot() const override
+    {
+        return m_symbolsPerSlot;
+    }
+
+    Time GetSlotPeriod() const override
+    {
+        return m_slotPeriod;
+    }
+
+    void BuildRarList(SlotAllocInfo& slotAllocInfo) override
+    {
+        // The RAR list is only added to the allocations passed to the next SchedConfigInd
+        m_buildRarList = true;
+    }
+
+  private:
+    NrMacSchedSapUser* m_user{nullptr};         //!< The MAC SAP user
+    uint32_t m_numRbPerRbg{0};                  //!< Number of RB per RBG
+    uint8_t m_numHarqProcess{0};                //!< Number of HARQ processes
+    uint16_t m_bwpId{0};                        //!< BWP ID
+    uint16_t m_cellId{0};                       //!< Cell ID
+    uint32_t m_symbolsPerSlot{0};               //!< Symbols per slot
+    Time m_slotPeriod;                          //!< Slot period
+    bool m_buildRarList{false};                 //!< Whether BuildRarList was called
+    std::vector<std::function<void()>> m_calls; //!< The recorded calls
+};
+
 NrMacSchedulerNs3::NrMacSchedulerNs3()
     : NrMacScheduler()
 {
@@ -396,7 +526,7 @@ NrMacSchedulerNs3::SetDlNotchedRbgMask(const std::vector<bool>& dlNotchedRbgsMas
     NS_LOG_INFO("Set DL notched mask: " << ss.str());
 }
 
-std::vector<bool>
+const NrRbgMask&
 NrMacSchedulerNs3::GetDlNotchedRbgMask() const
 {
     return m_dlNotchedRbgsMask;
@@ -417,7 +547,7 @@ NrMacSchedulerNs3::SetUlNotchedRbgMask(const std::vector<bool>& ulNotchedRbgsMas
     NS_LOG_INFO("Set UL notched mask: " << ss.str());
 }
 
-std::vector<bool>
+const NrRbgMask&
 NrMacSchedulerNs3::GetUlNotchedRbgMask() const
 {
     return m_ulNotchedRbgsMask;
@@ -1118,7 +1248,7 @@ NrMacSchedulerNs3::ProcessHARQFeedbacks(
  * @param rnti RNTI of the user
  * @param harq HARQ process list
  *
- * For each process, check its timer. If it is expired, reset the
+ * For each active process, check its timer. If it is expired, reset the
  * process.
  *
  * @see NrMacHarqVector
@@ -1129,10 +1259,10 @@ NrMacSchedulerNs3::ResetExpiredHARQ(uint16_t rnti, NrMacHarqVector* harq)
 {
     NS_LOG_FUNCTION(this << harq);
 
-    for (auto harqIt = harq->Begin(); harqIt != harq->End(); ++harqIt)
+    for (auto processId = harq->FindFirstActive(); processId != NrMacHarqVector::NO_ID;
+         processId = harq->FindNextActive(processId))
     {
-        HarqProcess& process = harqIt->second;
-        uint8_t processId = harqIt->first;
+        HarqProcess& process = harq->Get(processId);
 
         if (process.m_status == HarqProcess::INACTIVE)
         {
@@ -1170,7 +1300,7 @@ NrMacSchedulerNs3::PrependCtrlSym(uint8_t symStart,
                                   DciInfoElementTdma::DciFormat mode,
                                   std::deque<VarTtiAllocInfo>* allocations) const
 {
-    std::vector<bool> rbgBitmask(GetBandwidthInRbg(), true);
+    NrRbgMask rbgBitmask(GetBandwidthInRbg(), true);
 
     NS_ASSERT_MSG(rbgBitmask.size() == GetBandwidthInRbg(),
                   "bitmask size " << rbgBitmask.size() << " conf " << GetBandwidthInRbg());
@@ -1208,7 +1338,7 @@ NrMacSchedulerNs3::AppendCtrlSym(uint8_t symStart,
                                  DciInfoElementTdma::DciFormat mode,
                                  std::deque<VarTtiAllocInfo>* allocations) const
 {
-    std::vector<bool> rbgBitmask(GetBandwidthInRbg(), true);
+    NrRbgMask rbgBitmask(GetBandwidthInRbg(), true);
 
     NS_ASSERT(rbgBitmask.size() == GetBandwidthInRbg());
     if (mode == DciInfoElementTdma::DL)
@@ -2648,7 +2778,7 @@ NrMacSchedulerNs3::DoScheduleUlMsg3(PointInFTPlane* sPoint,
 
     uint8_t symAvailBeforeRach = symAvail;
     auto rbgBitmask = GetUlBitmask();
-    uint16_t usableRbgs = std::count(rbgBitmask.begin(), rbgBitmask.end(), true);
+    uint16_t usableRbgs = rbgBitmask.Count();
 
     for (const auto& rachReq : m_rachList)
     {
@@ -2716,29 +2846,69 @@ NrMacSchedulerNs3::IsMaxSrsReached() const
     return m_schedulerSrs->IsMaxSrsReached();
 }
 
-std::vector<bool>
+bool
+NrMacSchedulerNs3::IsParallelSchedulingSupported() const
+{
+    return m_nrFhSchedSapProvider == nullptr;
+}
+
+void
+NrMacSchedulerNs3::PrepareParallelTrigger()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_deferring && m_macSchedSapUser != nullptr);
+    if (!m_deferredSapUser)
+    {
+        m_deferredSapUser = std::make_unique<DeferredSchedSapUser>();
+    }
+    m_deferredSapUser->Prepare(m_macSchedSapUser);
+    m_macSchedSapUser = m_deferredSapUser.get();
+    m_deferring = true;
+}
+
+void
+NrMacSchedulerNs3::CompleteParallelTrigger()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_deferring);
+    // The calls made back to the scheduler during the replay are not deferred
+    m_deferring = false;
+    m_macSchedSapUser = m_deferredSapUser->GetMacSapUser();
+    m_deferredSapUser->Replay();
+}
+
+void
+NrMacSchedulerNs3::FireTrace(std::function<void()> fire) const
+{
+    if (m_deferring)
+    {
+        m_deferredSapUser->Record(std::move(fire));
+    }
+    else
+    {
+        fire();
+    }
+}
+
+NrRbgMask
 NrMacSchedulerNs3::GetDlBitmask() const
 {
-    auto dlNotchedRBGsMask = GetDlNotchedRbgMask();
-    dlNotchedRBGsMask = dlNotchedRBGsMask.empty() ? std::vector<bool>(GetBandwidthInRbg(), true)
-                                                  : dlNotchedRBGsMask;
-    return dlNotchedRBGsMask;
+    return m_dlNotchedRbgsMask.empty() ? NrRbgMask(GetBandwidthInRbg(), true)
+                                       : m_dlNotchedRbgsMask;
 }
 
-std::vector<bool>
+NrRbgMask
 NrMacSchedulerNs3::GetUlBitmask() const
 {
-    auto ulNotchedRBGsMask = GetUlNotchedRbgMask();
-    ulNotchedRBGsMask = ulNotchedRBGsMask.empty() ? std::vector<bool>(GetBandwidthInRbg(), true)
-                                                  : ulNotchedRBGsMask;
-    return ulNotchedRBGsMask;
+    return m_ulNotchedRbgsMask.empty() ? NrRbgMask(GetBandwidthInRbg(), true)
+                                       : m_ulNotchedRbgsMask;
 }
 
 std::vector<DciInfoElementTdma>
 NrMacSchedulerNs3::ReshapeAllocation(const std::vector<DciInfoElementTdma>& dcis,
                                      uint8_t& startingSymbol,
                                      uint8_t& numSymbols,
-                                     std::vector<bool>& bitmask,
+                                     NrRbgMask& bitmask,
                                      const bool isDl)
 {
     if (dcis.empty())
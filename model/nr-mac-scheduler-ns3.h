@@ -358,6 +358,29 @@ class NrMacSchedulerNs3 : public NrMacScheduler
     uint8_t GetUlCtrlSyms() const override;
     bool IsMaxSrsReached() const override;
 
+    /**
+     * @brief Check whether the triggers can run in parallel with the ones of other cells
+     *
+     * The triggers only use the state of this scheduler, except with fronthaul control,
+     * which is shared among the cells.
+     * @return true if there is no fronthaul control
+     */
+    bool IsParallelSchedulingSupported() const override;
+
+    /**
+     * @brief Replace the MAC SAP user with a recording one for the next trigger
+     *
+     * The recording SAP user answers the getters with the values of the MAC SAP user at
+     * this time, and records SchedConfigInd and BuildRarList. The trace sources fired
+     * through FireTrace are recorded as well.
+     */
+    void PrepareParallelTrigger() override;
+
+    /**
+     * @brief Restore the MAC SAP user, and make the calls recorded during the trigger
+     */
+    void CompleteParallelTrigger() override;
+
     /**
      * @brief Assign a fixed random variable stream number to the random variables
      * used by this model. Return the number of streams (possibly zero) that
@@ -485,7 +508,7 @@ class NrMacSchedulerNs3 : public NrMacScheduler
      * @brief Get the notched (blank) RBGs Mask for the DL
      * @return The mask of notched RBGs
      */
-    std::vector<bool> GetDlNotchedRbgMask() const;
+    const NrRbgMask& GetDlNotchedRbgMask() const;
 
     /**
      * @brief Set the notched (blank) RBGs Mask for the UL
@@ -497,7 +520,7 @@ class NrMacSchedulerNs3 : public NrMacScheduler
      * @brief Get the notched (blank) RBGs Mask for the UL
      * @return The mask of notched RBGs
      */
-    std::vector<bool> GetUlNotchedRbgMask() const;
+    const NrRbgMask& GetUlNotchedRbgMask() const;
 
     /**
      * @brief Set the number of UL SRS symbols
@@ -584,6 +607,15 @@ class NrMacSchedulerNs3 : public NrMacScheduler
      */
     virtual uint8_t GetTpc() const = 0;
 
+    /**
+     * @brief Fire a trace source, or record it if the trigger runs outside of the simulation thread
+     * @param fire the function that fires the trace source
+     *
+     * Trace sources fired during the triggers must go through this function, so that
+     * the sinks are always called in the simulation thread.
+     */
+    void FireTrace(std::function<void()> fire) const;
+
     /**
      * @brief Giving the input, append to slotAlloc the allocations for the DL HARQ retransmissions
      * @param startingPoint starting point of the first retransmission.
@@ -767,7 +799,7 @@ class NrMacSchedulerNs3 : public NrMacScheduler
                   uint8_t numSym,
                   uint8_t mcs,
                   uint8_t rank,
-                  const std::vector<bool>& rbgMask)
+                  const NrRbgMask& rbgMask)
             : m_rnti(rnti),
               m_tbs(tbs),
               m_symStart(symStart),
@@ -784,7 +816,7 @@ class NrMacSchedulerNs3 : public NrMacScheduler
         uint8_t m_numSym{0};         //!< Allocated symbols
         uint8_t m_mcs{0};            //!< MCS of the transmission
         uint8_t m_rank{1};           //!< rank of the transmission
-        std::vector<bool> m_rbgMask; //!< RBG Mask
+        NrRbgMask m_rbgMask;         //!< RBG Mask
     };
 
     /**
@@ -913,21 +945,21 @@ class NrMacSchedulerNs3 : public NrMacScheduler
     NrFhSchedSapProvider* m_nrFhSchedSapProvider{nullptr}; //!< FH Control SAP provider
 
     /**
-     * @brief Returns a boolean vector indicating whether a resource is available to be scheduled
+     * @brief Returns a mask indicating whether a resource is available to be scheduled
      * (true) or not (false) in the downlink.
      */
-    std::vector<bool> GetDlBitmask() const;
+    NrRbgMask GetDlBitmask() const;
     /**
-     * @brief Returns a boolean vector indicating whether a resource is available to be scheduled
+     * @brief Returns a mask indicating whether a resource is available to be scheduled
      * (true) or not (false) in the uplink.
      */
-    std::vector<bool> GetUlBitmask() const;
+    NrRbgMask GetUlBitmask() const;
 
     // Generic function serves as trampoline to Tdma and Ofdma, plus gives access to ueInfo map
     std::vector<DciInfoElementTdma> ReshapeAllocation(const std::vector<DciInfoElementTdma>& dcis,
                                                       uint8_t& startingSymbol,
                                                       uint8_t& numSymbols,
-                                                      std::vector<bool>& bitmask,
+                                                      NrRbgMask& bitmask,
                                                       const bool isDl);
 
     // Implementation from Tdma and Ofdma schedulers
@@ -935,11 +967,13 @@ class NrMacSchedulerNs3 : public NrMacScheduler
         const std::vector<DciInfoElementTdma>& dcis,
         uint8_t& startingSymbol,
         uint8_t& numSymbols,
-        std::vector<bool>& bitmask,
+        NrRbgMask& bitmask,
         const bool isDl,
         const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap) = 0;
 
   private:
+    class DeferredSchedSapUser;
+
     void CallNrFhControlForMapUpdate(
         const std::deque<VarTtiAllocInfo>& allocation,
         const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap);
@@ -982,8 +1016,8 @@ class NrMacSchedulerNs3 : public NrMacScheduler
     bool m_enableSrsInUlSlots{true}; //!< SRS allowed in UL slots (attribute)
     bool m_enableSrsInFSlots{true};  //!< SRS allowed in F slots (attribute)
 
-    std::vector<bool> m_dlNotchedRbgsMask; //!< The mask of notched (blank) RBGs for the DL
-    std::vector<bool> m_ulNotchedRbgsMask; //!< The mask of notched (blank) RBGs for the UL
+    NrRbgMask m_dlNotchedRbgsMask; //!< The mask of notched (blank) RBGs for the DL
+    NrRbgMask m_ulNotchedRbgsMask; //!< The mask of notched (blank) RBGs for the UL
 
     Ptr<NrMacSchedulerHarqRr> m_schedHarq; //!< Pointer to the real HARQ scheduler
 
@@ -998,6 +1032,10 @@ class NrMacSchedulerNs3 : public NrMacScheduler
 
     TracedCallback<uint16_t, uint16_t, const std::shared_ptr<NrMacSchedulerUeInfo>&>
         m_csiFeedbackReceived; //!< Traced callback to access CSI feedback
+
+    /// The SAP user installed between PrepareParallelTrigger and CompleteParallelTrigger
+    std::unique_ptr<DeferredSchedSapUser> m_deferredSapUser;
+    bool m_deferring{false}; //!< Whether a trigger prepared by PrepareParallelTrigger is pending
 };
 
 } // namespace ns3
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <typeinfo>
 
 namespace ns3
 {
@@ -53,6 +54,12 @@ NrMacSchedulerOfdmaAi::NrMacSchedulerOfdmaAi()
 {
 }
 
+bool
+NrMacSchedulerOfdmaAi::IsParallelSchedulingSupported() const
+{
+    return false;
+}
+
 std::shared_ptr<NrMacSchedulerUeInfo>
 NrMacSchedulerOfdmaAi::CreateUeRepresentation(
     const NrMacCschedSapProvider::CschedUeConfigReqParameters& params) const
@@ -62,7 +69,14 @@ NrMacSchedulerOfdmaAi::CreateUeRepresentation(
         m_alpha,
         params.m_rnti,
         params.m_beamId,
-        std::bind(&NrMacSchedulerOfdmaAi::GetNumRbPerRbg, this));
+        std::bind(&NrMacSchedulerOfdmaAi::GetNumRbPerRbg, this),
+        m_ueMetrics);
+}
+
+bool
+NrMacSchedulerOfdmaAi::UsesBatchedMetrics() const
+{
+    return typeid(*this) == typeid(NrMacSchedulerOfdmaAi);
 }
 
 std::function<bool(const NrMacSchedulerNs3::UePtrAndBufferReq& lhs,
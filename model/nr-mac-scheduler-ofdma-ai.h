@@ -49,6 +49,12 @@ class NrMacSchedulerOfdmaAi : public NrMacSchedulerOfdmaQos
      */
     NrMacSchedulerOfdmaAi();
 
+    /**
+     * @brief The triggers call the ns3-gym environment, so they always run serially
+     * @return false
+     */
+    bool IsParallelSchedulingSupported() const override;
+
   protected:
     /**
      * @brief Create an UE representation of the type NrMacSchedulerUeInfoAi
@@ -58,6 +64,13 @@ class NrMacSchedulerOfdmaAi : public NrMacSchedulerOfdmaQos
     std::shared_ptr<NrMacSchedulerUeInfo> CreateUeRepresentation(
         const NrMacCschedSapProvider::CschedUeConfigReqParameters& params) const override;
 
+    /**
+     * @brief Whether the UEs without resources can be updated with the metric store
+     * @return true only if the scheduler is exactly a NrMacSchedulerOfdmaAi, so that a subclass
+     * that overrides NotAssignedDlResources or NotAssignedUlResources is not bypassed
+     */
+    bool UsesBatchedMetrics() const override;
+
     /**
      * @brief Return the comparison function to sort DL UEs according to the scheduler policy
      * @return A pointer to NrMacSchedulerUeInfoAi::CompareUeWeightsDl if the AI model is activated,
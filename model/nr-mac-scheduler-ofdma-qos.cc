@@ -11,6 +11,7 @@
 #include "ns3/log.h"
 
 #include <algorithm>
+#include <typeinfo>
 
 namespace ns3
 {
@@ -45,6 +46,7 @@ NrMacSchedulerOfdmaQos::GetTypeId()
 NrMacSchedulerOfdmaQos::NrMacSchedulerOfdmaQos()
     : NrMacSchedulerOfdmaRR()
 {
+    m_ueMetrics = std::make_shared<NrMacSchedulerUeMetricStore>();
 }
 
 void
@@ -65,14 +67,14 @@ void
 NrMacSchedulerOfdmaQos::SetTimeWindow(double v)
 {
     NS_LOG_FUNCTION(this);
-    m_timeWindow = v;
+    m_ueMetrics->m_timeWindow = v;
 }
 
 double
 NrMacSchedulerOfdmaQos::GetTimeWindow() const
 {
     NS_LOG_FUNCTION(this);
-    return m_timeWindow;
+    return m_ueMetrics->m_timeWindow;
 }
 
 std::shared_ptr<NrMacSchedulerUeInfo>
@@ -84,7 +86,14 @@ NrMacSchedulerOfdmaQos::CreateUeRepresentation(
         m_alpha,
         params.m_rnti,
         params.m_beamId,
-        std::bind(&NrMacSchedulerOfdmaQos::GetNumRbPerRbg, this));
+        std::bind(&NrMacSchedulerOfdmaQos::GetNumRbPerRbg, this),
+        m_ueMetrics);
+}
+
+bool
+NrMacSchedulerOfdmaQos::UsesBatchedMetrics() const
+{
+    return typeid(*this) == typeid(NrMacSchedulerOfdmaQos);
 }
 
 std::function<bool(const NrMacSchedulerNs3::UePtrAndBufferReq& lhs,
@@ -108,7 +117,7 @@ NrMacSchedulerOfdmaQos::AssignedDlResources(const UePtrAndBufferReq& ue,
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoQos>(ue.first);
-    uePtr->UpdateDlQosMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateDlQosMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -119,7 +128,7 @@ NrMacSchedulerOfdmaQos::NotAssignedDlResources(
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoQos>(ue.first);
-    uePtr->UpdateDlQosMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateDlQosMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -129,7 +138,7 @@ NrMacSchedulerOfdmaQos::AssignedUlResources(const UePtrAndBufferReq& ue,
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoQos>(ue.first);
-    uePtr->UpdateUlQosMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateUlQosMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -140,7 +149,7 @@ NrMacSchedulerOfdmaQos::NotAssignedUlResources(
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoQos>(ue.first);
-    uePtr->UpdateUlQosMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateUlQosMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -71,6 +71,13 @@ class NrMacSchedulerOfdmaQos : public NrMacSchedulerOfdmaRR
     std::shared_ptr<NrMacSchedulerUeInfo> CreateUeRepresentation(
         const NrMacCschedSapProvider::CschedUeConfigReqParameters& params) const override;
 
+    /**
+     * @brief Whether the UEs without resources can be updated with the metric store
+     * @return true only if the scheduler is exactly a NrMacSchedulerOfdmaQos, so that a subclass
+     * that overrides NotAssignedDlResources or NotAssignedUlResources is not bypassed
+     */
+    bool UsesBatchedMetrics() const override;
+
     /**
      * @brief Return the comparison function to sort DL UE according to the scheduler policy
      * @return a pointer to NrMacSchedulerUeInfoQos::CompareUeWeightsDl
@@ -182,8 +189,6 @@ class NrMacSchedulerOfdmaQos : public NrMacSchedulerOfdmaRR
                        const FTResources& assignableInIteration) const override;
 
   private:
-    double m_timeWindow{
-        99.0}; //!< Time window to calculate the throughput. Better to make it an attribute.
     double m_alpha{0.0}; //!< PF Fairness index
 };
 
@@ -71,6 +71,31 @@ NrMacSchedulerOfdmaRR::AssignedDlResources(const UePtrAndBufferReq& ue,
     }
 }
 
+void
+NrMacSchedulerOfdmaRR::DlTbCapacityEstimated(const UePtrAndBufferReq& ue,
+                                             uint32_t tbSize,
+                                             uint32_t maxTbSize) const
+{
+    NS_LOG_FUNCTION(this);
+    if (maxTbSize == tbSize)
+    {
+        return;
+    }
+    auto it = std::find(m_dlRrRntiDeque.begin(), m_dlRrRntiDeque.end(), ue.first->m_rnti);
+    NS_ASSERT(it != m_dlRrRntiDeque.end());
+    m_dlRrRntiDeque.erase(it);
+
+    // The TB size increases and then decreases back, or the other way around
+    if (maxTbSize > tbSize)
+    {
+        m_dlRrRntiDeque.push_front(ue.first->m_rnti);
+    }
+    else
+    {
+        m_dlRrRntiDeque.push_back(ue.first->m_rnti);
+    }
+}
+
 void
 NrMacSchedulerOfdmaRR::AssignedUlResources(const UePtrAndBufferReq& ue,
                                            [[maybe_unused]] const FTResources& assigned,
@@ -122,6 +122,34 @@ class NrMacSchedulerOfdmaRR : public NrMacSchedulerOfdma
     {
     }
 
+    /**
+     * @brief Move the UE in the RR list as if the free RBGs had been assigned to it, and
+     * then removed
+     *
+     * If the TB size with the free RBGs is higher, the UE ends at the beginning of the list;
+     * if it is lower, at the end.
+     *
+     * @param ue the UE
+     * @param tbSize the TB size of the UE with its allocated RBGs
+     * @param maxTbSize the TB size of the UE with its allocated RBGs and all the free RBGs
+     */
+    void DlTbCapacityEstimated(const UePtrAndBufferReq& ue,
+                               uint32_t tbSize,
+                               uint32_t maxTbSize) const override;
+
+    /**
+     * @brief The RR order only moves the UE that was assigned resources
+     *
+     * It holds also for the PF, QoS and MR schedulers, since repeating their
+     * NotAssigned update on a UE whose resources did not change gives the same metric.
+     *
+     * @return true
+     */
+    bool IsUeOrderIncremental() const override
+    {
+        return true;
+    }
+
   private:
     /**
      * Deque used to keep priority order of round-robin.
@@ -16,6 +16,7 @@
 #include "ns3/log.h"
 
 #include <algorithm>
+#include <iterator>
 #include <random>
 
 namespace ns3
@@ -97,7 +98,9 @@ NrMacSchedulerOfdma::GetSymPerBeam(uint32_t symAvail,
     // the internal state of the class
     for (const auto& v : ret)
     {
-        const_cast<NrMacSchedulerOfdma*>(this)->m_tracedValueSymPerBeam = v.second;
+        FireTrace([this, sym = v.second]() {
+            const_cast<NrMacSchedulerOfdma*>(this)->m_tracedValueSymPerBeam = sym;
+        });
     }
     return ret;
 }
@@ -154,12 +157,68 @@ NrMacSchedulerOfdma::ShouldScheduleUeBasedOnFronthaul(
     return GetUe(*schedInfoIt)->m_dlRBG.size() + quantizationStep <= maxAssignable;
 }
 
+void
+NrMacSchedulerOfdma::UpdateUeVectorOrder(std::vector<UePtrAndBufferReq>* ueVector,
+                                         const std::vector<size_t>& changedUes,
+                                         const GetCompareUeFn& GetCompareFn) const
+{
+    auto compare = GetCompareFn();
+
+    // Take out the changed UEs. The remaining ones are still sorted, and their previous
+    // position is kept to break the ties as a stable sort would do.
+    std::vector<std::pair<UePtrAndBufferReq, size_t>> movedUes;
+    std::vector<size_t> prevPos;
+    movedUes.reserve(changedUes.size());
+    prevPos.reserve(ueVector->size());
+    auto changedIt = changedUes.begin();
+    size_t numKept = 0;
+    for (size_t i = 0; i < ueVector->size(); ++i)
+    {
+        if (changedIt != changedUes.end() && *changedIt == i)
+        {
+            movedUes.emplace_back(std::move(ueVector->at(i)), i);
+            ++changedIt;
+            continue;
+        }
+        if (numKept != i)
+        {
+            ueVector->at(numKept) = std::move(ueVector->at(i));
+        }
+        prevPos.push_back(i);
+        ++numKept;
+    }
+    ueVector->resize(numKept);
+
+    for (auto& [ue, pos] : movedUes)
+    {
+        // The UEs that go before are the lower ones, and the equivalent ones that were
+        // before the moved UE
+        size_t low = 0;
+        size_t high = ueVector->size();
+        while (low < high)
+        {
+            const size_t mid = low + (high - low) / 2;
+            const auto& other = ueVector->at(mid);
+            if (compare(other, ue) || (!compare(ue, other) && prevPos.at(mid) < pos))
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        ueVector->insert(ueVector->begin() + low, std::move(ue));
+        prevPos.insert(prevPos.begin() + low, pos);
+    }
+}
+
 void
 NrMacSchedulerOfdma::AllocateCurrentResourceToUe(std::shared_ptr<NrMacSchedulerUeInfo> currentUe,
                                                  const uint32_t& currentRbg,
                                                  const uint32_t beamSym,
                                                  FTResources& assignedResources,
-                                                 std::vector<bool>& availableRbgs)
+                                                 NrRbgMask& availableRbgs)
 {
     // Assign 1 RBG for each available symbols for the beam,
     // and then update the count of available resources
@@ -175,7 +234,7 @@ NrMacSchedulerOfdma::AllocateCurrentResourceToUe(std::shared_ptr<NrMacSchedulerU
     std::iota(assignedSymbols.begin() + existingSymbols, assignedSymbols.end(), 0);
     assignedResources.m_sym = beamSym; // We keep beams per symbol fixed, since it depends on beam
 
-    availableRbgs.at(currentRbg) = false; // Mark RBG as occupied
+    availableRbgs.Reset(currentRbg); // Mark RBG as occupied
 }
 
 void
@@ -184,7 +243,7 @@ NrMacSchedulerOfdma::DeallocateCurrentResourceFromUe(
     const uint32_t& currentRbg,
     const uint32_t beamSym,
     FTResources& assignedResources,
-    std::vector<bool>& availableRbgs)
+    NrRbgMask& availableRbgs)
 {
     auto& assignedRbgs = currentUe->m_dlRBG;
     auto& assignedSymbols = currentUe->m_dlSym;
@@ -197,62 +256,108 @@ NrMacSchedulerOfdma::DeallocateCurrentResourceFromUe(
     assignedResources.m_rbg--; // We decrement the allocated RBGs
     // We zero symbols allocated in case number of RBGs reaches 0
     assignedResources.m_sym = assignedResources.m_rbg == 0 ? 0 : assignedResources.m_sym;
-    availableRbgs.at(currentRbg) = true;
+    availableRbgs.Set(currentRbg);
 }
 
-uint32_t
-NrMacSchedulerOfdma::EstimateTotalTbCapacity(
-    std::vector<std::pair<std::shared_ptr<ns3::NrMacSchedulerUeInfo>, unsigned int>>::iterator
-        schedInfoIt,
-    std::shared_ptr<NrMacSchedulerUeInfo> currentUe,
-    const std::vector<bool>& availableRbgs,
-    const uint32_t beamSym,
-    FTResources& assignedResources) const
+NrMacSchedulerOfdma::DlRbgEstimateMap
+NrMacSchedulerOfdma::CreateDlRbgEstimates(const std::vector<UePtrAndBufferReq>& ueVector,
+                                          const NrRbgMask& remainingRbgs,
+                                          uint32_t beamSym) const
 {
-    // Compute maximum tb size achievable with current resources plus all remaining available ones
-    // so we know whether we never schedule based on sub-band CQI less than at least WB would
-
-    // We first allocate all remaining resources to UE
-    std::vector<bool> availableRbgsBackup = availableRbgs;
-    for (std::size_t i = 0; i < availableRbgs.size(); i++)
+    DlRbgEstimateMap estimates;
+    for (const auto& [ue, bufQueueSize] : ueVector)
     {
-        if (availableRbgs.at(i))
+        auto& estimate = estimates[ue->m_rnti];
+        if (ue->HasDlSbCsi())
         {
-            AllocateCurrentResourceToUe(currentUe,
-                                        i,
-                                        beamSym,
-                                        assignedResources,
-                                        availableRbgsBackup);
+            for (auto rbg : ue->m_dlRBG)
+            {
+                estimate.csiSum += ue->GetDlRbgCsi(rbg);
+            }
+            for (auto rbg = remainingRbgs.FindFirst(); rbg != NrRbgMask::NPOS;
+                 rbg = remainingRbgs.FindNext(rbg))
+            {
+                estimate.csiSum += beamSym * ue->GetDlRbgCsi(rbg);
+            }
+        }
+
+        // Same condition as in AttemptAllocationOfCurrentResourceToUe
+        if (!ue->m_dlSbMcsInfo.empty() &&
+            m_mcsCsiSource != NrMacSchedulerUeInfo::McsCsiSource::WIDEBAND_MCS)
+        {
+            // Sort by decreasing CQI, the RBGs with the same CQI stay in increasing order
+            auto cqi = [&ue](uint32_t rbg) {
+                return ue->m_dlSbMcsInfo.at(ue->m_rbgToSb.at(rbg)).cqi;
+            };
+            for (auto rbg = remainingRbgs.FindFirst(); rbg != NrRbgMask::NPOS;
+                 rbg = remainingRbgs.FindNext(rbg))
+            {
+                if (cqi(rbg) > 0)
+                {
+                    estimate.bestRbgs.push_back(rbg);
+                }
+            }
+            std::stable_sort(estimate.bestRbgs.begin(),
+                             estimate.bestRbgs.end(),
+                             [&cqi](uint32_t a, uint32_t b) { return cqi(a) > cqi(b); });
         }
     }
-    // Recompute tbSize and scheduler metrics
-    AssignedDlResources(*schedInfoIt, FTResources(beamSym, beamSym), assignedResources);
-    // Collect maximum tbSize
-    const auto maximumWbTbSize = currentUe->m_dlTbSize;
-    // Then reclaim resources
-    for (std::size_t i = 0; i < availableRbgs.size(); i++)
+    return estimates;
+}
+
+void
+NrMacSchedulerOfdma::UpdateDlRbgEstimates(DlRbgEstimateMap& estimates,
+                                          const std::vector<UePtrAndBufferReq>& ueVector,
+                                          uint16_t rnti,
+                                          uint32_t rbg,
+                                          uint32_t beamSym,
+                                          bool taken)
+{
+    for (const auto& [ue, bufQueueSize] : ueVector)
     {
-        if (availableRbgs.at(i))
+        auto& estimate = estimates.at(ue->m_rnti);
+        if (!taken)
+        {
+            // Free RBGs may have been skipped already
+            estimate.nextBestRbg = 0;
+        }
+        if (ue->m_rnti == rnti || !ue->HasDlSbCsi())
         {
-            DeallocateCurrentResourceFromUe(currentUe,
-                                            i,
-                                            beamSym,
-                                            assignedResources,
-                                            availableRbgsBackup);
+            continue;
         }
+        const auto csi = beamSym * ue->GetDlRbgCsi(rbg);
+        estimate.csiSum += taken ? -csi : csi;
     }
-    // And reset tbSize and scheduler metrics
-    AssignedDlResources(*schedInfoIt, FTResources(beamSym, beamSym), assignedResources);
-    return maximumWbTbSize;
+}
+
+uint32_t
+NrMacSchedulerOfdma::EstimateTotalTbCapacity(
+    const std::shared_ptr<NrMacSchedulerUeInfo>& currentUe,
+    const DlRbgEstimate& estimate,
+    size_t numFreeRbgs,
+    uint32_t beamSym) const
+{
+    // Compute maximum tb size achievable with current resources plus all remaining available ones
+    // so we know whether we never schedule based on sub-band CQI less than at least WB would
+    if (numFreeRbgs == 0)
+    {
+        return currentUe->m_dlTbSize;
+    }
+    const auto numRbgs = currentUe->m_dlRBG.size() + beamSym * numFreeRbgs;
+    return currentUe->m_dlAmc->CalculateTbSize(
+        currentUe->GetDlMcsForCsiSum(estimate.csiSum, numRbgs),
+        currentUe->m_dlRank,
+        numRbgs * GetNumRbPerRbg());
 }
 
 bool
 NrMacSchedulerOfdma::AttemptAllocationOfCurrentResourceToUe(
     std::vector<UePtrAndBufferReq>::iterator schedInfoIt,
-    std::set<uint32_t>& remainingRbgSet,
+    NrRbgMask& remainingRbgs,
     const uint32_t beamSym,
     FTResources& assignedResources,
-    std::vector<bool>& availableRbgs) const
+    NrRbgMask& availableRbgs,
+    DlRbgEstimate& estimate) const
 {
     auto currentUe = schedInfoIt->first;
 
@@ -262,27 +367,25 @@ NrMacSchedulerOfdma::AttemptAllocationOfCurrentResourceToUe(
     if (currentUe->m_dlSbMcsInfo.empty() ||
         m_mcsCsiSource == NrMacSchedulerUeInfo::McsCsiSource::WIDEBAND_MCS)
     {
-        currentRbgPos = *remainingRbgSet.begin();
+        currentRbgPos = remainingRbgs.FindFirst();
     }
     else
     {
-        // Find the best resource for UE among the available ones
-        int maxCqi = 0;
-        for (auto resourcePos : remainingRbgSet)
+        // Find the best resource for UE among the available ones, which is the first free RBG
+        // with the highest sub-band CQI. The RBGs taken by other UEs are skipped once.
+        auto& bestRbgs = estimate.bestRbgs;
+        while (estimate.nextBestRbg < bestRbgs.size() &&
+               !availableRbgs.Test(bestRbgs.at(estimate.nextBestRbg)))
         {
-            const auto resourceSb = currentUe->m_rbgToSb.at(resourcePos);
-            if (currentUe->m_dlSbMcsInfo.at(resourceSb).cqi > maxCqi)
-            {
-                currentRbgPos = resourcePos;
-                maxCqi = currentUe->m_dlSbMcsInfo.at(resourceSb).cqi;
-            }
+            ++estimate.nextBestRbg;
         }
 
         // Do not schedule RBGs with sub-band CQI equals to zero
-        if (currentRbgPos == std::numeric_limits<uint32_t>::max())
+        if (estimate.nextBestRbg == bestRbgs.size())
         {
             return false;
         }
+        currentRbgPos = bestRbgs.at(estimate.nextBestRbg);
     }
 
     AllocateCurrentResourceToUe(currentUe,
@@ -300,7 +403,8 @@ NrMacSchedulerOfdma::AttemptAllocationOfCurrentResourceToUe(
     const auto currentTbSize = currentUe->m_dlTbSize;
 
     const auto maximumTbSize =
-        EstimateTotalTbCapacity(schedInfoIt, currentUe, availableRbgs, beamSym, assignedResources);
+        EstimateTotalTbCapacity(currentUe, estimate, remainingRbgs.Count() - 1, beamSym);
+    DlTbCapacityEstimated(*schedInfoIt, currentTbSize, maximumTbSize);
 
     if (currentTbSize <= previousTbSize && previousTbSize >= maximumTbSize &&
         currentUe->GetDlMcs() > 0)
@@ -316,7 +420,7 @@ NrMacSchedulerOfdma::AttemptAllocationOfCurrentResourceToUe(
         AssignedDlResources(*schedInfoIt, FTResources(beamSym, beamSym), assignedResources);
         return false; // Unsuccessful allocation
     }
-    remainingRbgSet.erase(currentRbgPos);
+    remainingRbgs.Reset(currentRbgPos);
     return true; // Successful allocation
 }
 
@@ -325,7 +429,7 @@ NrMacSchedulerOfdma::DeallocateResourcesDueToFronthaulConstraint(
     const std::vector<UePtrAndBufferReq>& ueVector,
     const uint32_t& beamSym,
     FTResources& assignedResources,
-    std::vector<bool>& availableRbgs) const
+    NrRbgMask& availableRbgs) const
 {
     GetFirst GetUe;
     std::vector<UePtrAndBufferReq> fhUeVector = ueVector;
@@ -400,38 +504,53 @@ NrMacSchedulerOfdma::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl)
         uint32_t beamSym = symPerBeam.at(GetBeamId(el));
         std::vector<UePtrAndBufferReq> ueVector;
         FTResources assignedResources(0, 0);
-        std::vector<bool> availableRbgs = GetDlBitmask();
-        std::set<uint32_t> remainingRbgSet;
-        for (size_t i = 0; i < availableRbgs.size(); i++)
-        {
-            if (availableRbgs.at(i))
-            {
-                remainingRbgSet.emplace(i);
-            }
-        }
+        NrRbgMask availableRbgs = GetDlBitmask();
+        NrRbgMask remainingRbgs = availableRbgs;
 
-        NS_ASSERT(!remainingRbgSet.empty());
+        NS_ASSERT(remainingRbgs.Any());
 
         for (const auto& ue : GetUeVector(el))
         {
             ueVector.emplace_back(ue);
             BeforeDlSched(ueVector.back(), FTResources(beamSym, beamSym));
         }
+
+        auto rbgEstimates = CreateDlRbgEstimates(ueVector, remainingRbgs, beamSym);
+
+        // With an incremental UE order, the UE vector is sorted again only until the metrics
+        // of all the UEs have been updated after an allocation. Then, only the UEs that were
+        // tried for the previous RBG can change their position.
+        const bool incrementalOrder = IsUeOrderIncremental() && !m_activeDlAi;
+        bool metricsUpdated = false;
+        bool ueVectorSorted = false;
+        std::vector<size_t> triedUes;
         bool reapingResources = true;
         while (reapingResources)
         {
             // While there are resources to schedule
-            while (!remainingRbgSet.empty())
+            while (remainingRbgs.Any())
             {
                 // Keep track if resources are being allocated. If not, then stop.
-                const auto prevRemaining = remainingRbgSet.size();
+                const auto prevRemaining = remainingRbgs.Count();
 
                 if (m_activeDlAi)
                 {
                     CallNotifyDlFn(ueVector);
                 }
                 // Sort UEs based on the selected scheduler policy (PF, RR, QoS, AI)
-                SortUeVector(&ueVector, std::bind(&NrMacSchedulerOfdma::GetUeCompareDlFn, this));
+                if (ueVectorSorted)
+                {
+                    UpdateUeVectorOrder(&ueVector,
+                                        triedUes,
+                                        std::bind(&NrMacSchedulerOfdma::GetUeCompareDlFn, this));
+                }
+                else
+                {
+                    SortUeVector(&ueVector,
+                                 std::bind(&NrMacSchedulerOfdma::GetUeCompareDlFn, this));
+                    ueVectorSorted = incrementalOrder && metricsUpdated;
+                }
+                triedUes.clear();
 
                 // Select the first UE
                 auto schedInfoIt = ueVector.begin();
@@ -439,13 +558,17 @@ NrMacSchedulerOfdma::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl)
                 // Advance schedInfoIt iterator to the next UE to schedule
                 while (AdvanceToNextUeToSchedule(schedInfoIt, ueVector.end(), beamSym))
                 {
+                    triedUes.push_back(std::distance(ueVector.begin(), schedInfoIt));
+
                     // Try to allocate the resource to the current UE
                     // If it fails, try again for the next UE
-                    if (!AttemptAllocationOfCurrentResourceToUe(schedInfoIt,
-                                                                remainingRbgSet,
-                                                                beamSym,
-                                                                assignedResources,
-                                                                availableRbgs))
+                    if (!AttemptAllocationOfCurrentResourceToUe(
+                            schedInfoIt,
+                            remainingRbgs,
+                            beamSym,
+                            assignedResources,
+                            availableRbgs,
+                            rbgEstimates.at(schedInfoIt->first->m_rnti)))
                     {
                         std::advance(schedInfoIt, 1); // Get the next UE
                         continue;
@@ -455,30 +578,35 @@ NrMacSchedulerOfdma::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl)
                     NS_LOG_DEBUG("assignedResources "
                                  << GetUe(*schedInfoIt)->m_dlRBG.back() << " DL RBG, spanned over "
                                  << beamSym << " SYM, to UE " << GetUe(*schedInfoIt)->m_rnti);
+                    UpdateDlRbgEstimates(rbgEstimates,
+                                         ueVector,
+                                         GetUe(*schedInfoIt)->m_rnti,
+                                         GetUe(*schedInfoIt)->m_dlRBG.back(),
+                                         beamSym,
+                                         true);
 
                     // Update metrics for the unsuccessful UEs (who did not get any resource in this
-                    // iteration)
-                    for (auto& ue : ueVector)
+                    // iteration). With an incremental order, it is needed only once.
+                    if (!incrementalOrder || !metricsUpdated)
                     {
-                        if (GetUe(ue)->m_rnti != GetUe(*schedInfoIt)->m_rnti)
-                        {
-                            NotAssignedDlResources(ue,
-                                                   FTResources(beamSym, beamSym),
-                                                   assignedResources);
-                        }
+                        NotAssignedDlResourcesToUes(ueVector,
+                                                    GetUe(*schedInfoIt)->m_rnti,
+                                                    FTResources(beamSym, beamSym),
+                                                    assignedResources);
+                        metricsUpdated = true;
                     }
                     break; // Successful allocation
                 }
                 // No more UEs to allocate in the current beam
-                if (prevRemaining == remainingRbgSet.size())
+                if (prevRemaining == remainingRbgs.Count())
                 {
                     break;
                 }
             }
 
-            // If we got here, we either allocated all resources (remainingRbgSet.empty()),
+            // If we got here, we either allocated all resources (remainingRbgs.None()),
             // or the remaining RBGs do not improve TBS of UEs (prevRemaining ==
-            // remainingRbgSet.size()).
+            // remainingRbgs.Count()).
 
             // Now we need to check if there is a UE with less than the minimal TBS.
             std::sort(ueVector.begin(), ueVector.end(), [](auto a, auto b) {
@@ -498,19 +626,27 @@ NrMacSchedulerOfdma::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl)
                                                     beamSym,
                                                     assignedResources,
                                                     availableRbgs);
-                    remainingRbgSet.emplace(reapedRbg);
+                    remainingRbgs.Set(reapedRbg);
+                    UpdateDlRbgEstimates(rbgEstimates,
+                                         ueVector,
+                                         ue.first->m_rnti,
+                                         reapedRbg,
+                                         beamSym,
+                                         false);
                 }
                 // Update DL metrics
                 AssignedDlResources(ue, FTResources(beamSym, beamSym), assignedResources);
 
                 // After all resources were reaped, update statistics
-                for (auto& uev : ueVector)
-                {
-                    NotAssignedDlResources(uev, FTResources(beamSym, beamSym), assignedResources);
-                }
+                NotAssignedDlResourcesToUes(ueVector,
+                                            0,
+                                            FTResources(beamSym, beamSym),
+                                            assignedResources);
 
                 // Remove UE from allocation vector (it won't receive more resources in this round)
                 ueVector.pop_back();
+                metricsUpdated = false;
+                ueVectorSorted = false;
                 continue;
             }
             reapingResources = false;
@@ -575,17 +711,9 @@ NrMacSchedulerOfdma::AssignULRBG(uint32_t symAvail, const ActiveUeMap& activeUl)
         std::vector<UePtrAndBufferReq> ueVector;
         FTResources assigned(0, 0);
 
-        const std::vector<bool> availableRbgs = GetUlBitmask();
-        std::set<uint32_t> remainingRbgSet;
-        for (size_t i = 0; i < availableRbgs.size(); i++)
-        {
-            if (availableRbgs.at(i))
-            {
-                remainingRbgSet.emplace(i);
-            }
-        }
+        NrRbgMask remainingRbgs = GetUlBitmask();
 
-        NS_ASSERT(!remainingRbgSet.empty());
+        NS_ASSERT(remainingRbgs.Any());
 
         for (const auto& ue : GetUeVector(el))
         {
@@ -597,14 +725,32 @@ NrMacSchedulerOfdma::AssignULRBG(uint32_t symAvail, const ActiveUeMap& activeUl)
             BeforeUlSched(ue, FTResources(beamSym * beamSym, beamSym));
         }
 
-        while (!remainingRbgSet.empty())
+        // As in AssignDLRBG, with an incremental UE order only the UE that got the previous
+        // RBG is moved, once the metrics of all the UEs have been updated
+        const bool incrementalOrder = IsUeOrderIncremental() && !m_activeUlAi;
+        bool metricsUpdated = false;
+        bool ueVectorSorted = false;
+        std::vector<size_t> assignedUes;
+
+        while (remainingRbgs.Any())
         {
             if (m_activeUlAi)
             {
                 CallNotifyUlFn(ueVector);
             }
             GetFirst GetUe;
-            SortUeVector(&ueVector, std::bind(&NrMacSchedulerOfdma::GetUeCompareUlFn, this));
+            if (ueVectorSorted)
+            {
+                UpdateUeVectorOrder(&ueVector,
+                                    assignedUes,
+                                    std::bind(&NrMacSchedulerOfdma::GetUeCompareUlFn, this));
+            }
+            else
+            {
+                SortUeVector(&ueVector, std::bind(&NrMacSchedulerOfdma::GetUeCompareUlFn, this));
+                ueVectorSorted = incrementalOrder && metricsUpdated;
+            }
+            assignedUes.clear();
             auto schedInfoIt = ueVector.begin();
 
             // Ensure fairness: pass over UEs which already has enough resources to transmit
@@ -628,13 +774,13 @@ NrMacSchedulerOfdma::AssignULRBG(uint32_t symAvail, const ActiveUeMap& activeUl)
                 break;
             }
 
-            auto assignedRbg = remainingRbgSet.begin();
+            const auto assignedRbg = remainingRbgs.FindFirst();
             // Assign 1 RBG for each available symbols for the beam,
             // and then update the count of available resources
             auto& assignedRbgs = GetUe(*schedInfoIt)->m_ulRBG;
             auto existingRbgs = assignedRbgs.size();
             assignedRbgs.resize(assignedRbgs.size() + beamSym);
-            std::fill(assignedRbgs.begin() + existingRbgs, assignedRbgs.end(), *assignedRbg);
+            std::fill(assignedRbgs.begin() + existingRbgs, assignedRbgs.end(), assignedRbg);
             assigned.m_rbg++;
 
             auto& assignedSymbols = GetUe(*schedInfoIt)->m_ulSym;
@@ -643,22 +789,24 @@ NrMacSchedulerOfdma::AssignULRBG(uint32_t symAvail, const ActiveUeMap& activeUl)
             std::iota(assignedSymbols.begin() + existingSymbols, assignedSymbols.end(), 0);
             assigned.m_sym = beamSym;
 
-            remainingRbgSet.erase(
+            remainingRbgs.Reset(
                 assignedRbg); // Resources are RBG, so they do not consider the beamSym
 
             // Update metrics
             NS_LOG_DEBUG("Assigned " << assigned.m_rbg << " UL RBG, spanned over " << beamSym
                                      << " SYM, to UE " << GetUe(*schedInfoIt)->m_rnti);
             AssignedUlResources(*schedInfoIt, FTResources(beamSym, beamSym), assigned);
+            assignedUes.push_back(std::distance(ueVector.begin(), schedInfoIt));
 
             // Update metrics for the unsuccessful UEs (who did not get any resource in this
-            // iteration)
-            for (auto& ue : ueVector)
+            // iteration). With an incremental order, it is needed only once.
+            if (!incrementalOrder || !metricsUpdated)
             {
-                if (GetUe(ue)->m_rnti != GetUe(*schedInfoIt)->m_rnti)
-                {
-                    NotAssignedUlResources(ue, FTResources(beamSym, beamSym), assigned);
-                }
+                NotAssignedUlResourcesToUes(ueVector,
+                                            GetUe(*schedInfoIt)->m_rnti,
+                                            FTResources(beamSym, beamSym),
+                                            assigned);
+                metricsUpdated = true;
             }
         }
     }
@@ -704,7 +852,7 @@ NrMacSchedulerOfdma::CreateDlDci(NrMacSchedulerNs3::PointInFTPlane* spoint,
         return nullptr;
     }
 
-    const auto rbgBitmask = CreateRbgBitmaskFromAllocatedRbgs(ueInfo->m_dlRBG);
+    auto rbgBitmask = CreateRbgBitmaskFromAllocatedRbgs(ueInfo->m_dlRBG);
     std::ostringstream oss;
     for (const auto& x : rbgBitmask)
     {
@@ -731,8 +879,7 @@ NrMacSchedulerOfdma::CreateDlDci(NrMacSchedulerNs3::PointInFTPlane* spoint,
 
     dci->m_rbgBitmask = std::move(rbgBitmask);
 
-    NS_ASSERT(std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), 0) !=
-              GetBandwidthInRbg());
+    NS_ASSERT(dci->m_rbgBitmask.Any());
 
     return dci;
 }
@@ -760,7 +907,7 @@ NrMacSchedulerOfdma::CreateUlDci(PointInFTPlane* spoint,
     }
 
     uint32_t RBGNum = ueInfo->m_ulRBG.size() / maxSym;
-    const auto rbgBitmask = CreateRbgBitmaskFromAllocatedRbgs(ueInfo->m_ulRBG);
+    auto rbgBitmask = CreateRbgBitmaskFromAllocatedRbgs(ueInfo->m_ulRBG);
 
     NS_LOG_INFO("UE " << ueInfo->m_rnti << " assigned RBG from " << spoint->m_rbg << " to "
                       << spoint->m_rbg + RBGNum << " for " << static_cast<uint32_t>(maxSym)
@@ -791,8 +938,7 @@ NrMacSchedulerOfdma::CreateUlDci(PointInFTPlane* spoint,
     }
     NS_LOG_INFO("UE " << ueInfo->m_rnti << " DCI RBG mask: " << oss.str());
 
-    NS_ASSERT(std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), 0) !=
-              GetBandwidthInRbg());
+    NS_ASSERT(dci->m_rbgBitmask.Any());
 
     return dci;
 }
@@ -819,16 +965,12 @@ NrMacSchedulerOfdma::GetTpc() const
               // Table 7.1.1-1
 }
 
-std::vector<bool>
+NrRbgMask
 NrMacSchedulerOfdma::CreateRbgBitmaskFromAllocatedRbgs(
     const std::vector<uint16_t>& allocatedRbgs) const
 {
-    std::vector<bool> rbgNotchedBitmask = GetDlNotchedRbgMask();
-    if (rbgNotchedBitmask.empty())
-    {
-        rbgNotchedBitmask = std::vector<bool>(GetBandwidthInRbg(), true);
-    }
-    std::vector<bool> rbgBitmask = std::vector<bool>(GetBandwidthInRbg(), false);
+    const NrRbgMask rbgNotchedBitmask = GetDlBitmask();
+    NrRbgMask rbgBitmask(GetBandwidthInRbg(), false);
 
     NS_ASSERT(rbgNotchedBitmask.size() == rbgBitmask.size());
 
@@ -837,7 +979,7 @@ NrMacSchedulerOfdma::CreateRbgBitmaskFromAllocatedRbgs(
     for (auto rbg : allocatedRbgs)
     {
         NS_ASSERT_MSG(rbgNotchedBitmask.at(rbg), "Scheduled notched resource");
-        rbgBitmask.at(rbg) = true;
+        rbgBitmask.Set(rbg);
     }
     return rbgBitmask;
 }
@@ -10,6 +10,7 @@
 #include "ns3/traced-value.h"
 
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace ns3
@@ -106,6 +107,49 @@ class NrMacSchedulerOfdma : public NrMacSchedulerTdma
 
     uint8_t GetTpc() const override;
 
+    /**
+     * @brief Tell whether the UE order of the scheduler policy can be updated incrementally
+     *
+     * When true, AssignDLRBG and AssignULRBG sort the UE vector of a beam only until
+     * the metrics of all its UEs have been updated after an allocation. From then on,
+     * only the UEs that were considered for the last resource are moved to their new
+     * position, and NotAssignedDlResources and NotAssignedUlResources are not called
+     * again on the other UEs. The allocation is the same as with a full sort for each
+     * resource if:
+     * - assigning resources to a UE (or trying to) does not change the order of the
+     *   other UEs, and
+     * - NotAssignedDlResources and NotAssignedUlResources give the same metric when
+     *   called again on a UE whose resources did not change.
+     *
+     * A policy that overrides SortUeVector, or whose metrics change in every
+     * iteration, must return false.
+     *
+     * @return false by default
+     */
+    virtual bool IsUeOrderIncremental() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Notify the TB size that a UE would get with all the free RBGs of the beam
+     *
+     * It is called when trying to allocate an RBG to the UE, after NrMacSchedulerOfdma
+     * estimated the TB size without allocating the free RBGs to the UE. Since the estimate
+     * was previously done by calling AssignedDlResources with the free RBGs, and then
+     * without them, policies that keep track of the TB size changes can update their
+     * state here.
+     *
+     * @param ue the UE
+     * @param tbSize the TB size of the UE with its allocated RBGs
+     * @param maxTbSize the TB size of the UE with its allocated RBGs and all the free RBGs
+     */
+    virtual void DlTbCapacityEstimated([[maybe_unused]] const UePtrAndBufferReq& ue,
+                                       [[maybe_unused]] uint32_t tbSize,
+                                       [[maybe_unused]] uint32_t maxTbSize) const
+    {
+    }
+
     /**
      * @brief Enumeration of techniques to distribute the available symbols to the active beams
      */
@@ -122,7 +166,7 @@ class NrMacSchedulerOfdma : public NrMacSchedulerTdma
      * @param allocatedRbgs vector of allocated RBGs
      * @return RBG bitmask
      */
-    std::vector<bool> CreateRbgBitmaskFromAllocatedRbgs(
+    NrRbgMask CreateRbgBitmaskFromAllocatedRbgs(
         const std::vector<uint16_t>& allocatedRbgs) const;
 
     /**
@@ -148,6 +192,21 @@ class NrMacSchedulerOfdma : public NrMacSchedulerTdma
     bool AdvanceToNextUeToSchedule(std::vector<UePtrAndBufferReq>::iterator& schedInfoIt,
                                    const std::vector<UePtrAndBufferReq>::iterator end,
                                    uint32_t resourcesAssignable) const;
+    /**
+     * @brief Move the UEs whose metric changed to their position in a sorted UE vector
+     *
+     * The result is the same as sorting the vector again with SortUeVector: the UEs are
+     * ordered by the comparison function, and equivalent UEs keep their previous order.
+     * Each moved UE is placed with a binary search, instead of comparing all the UEs.
+     *
+     * @param ueVector the UE vector, sorted except for the changed UEs
+     * @param changedUes the positions of the UEs whose metric changed, in increasing order
+     * @param GetCompareFn the function that returns the comparison function of the policy
+     */
+    void UpdateUeVectorOrder(std::vector<UePtrAndBufferReq>* ueVector,
+                             const std::vector<size_t>& changedUes,
+                             const GetCompareUeFn& GetCompareFn) const;
+
     /**
      * @brief Decides whether UE pointed by schedInfoIt should be scheduled based on fronthaul
      * policy
@@ -168,12 +227,12 @@ class NrMacSchedulerOfdma : public NrMacSchedulerTdma
      * @param ueVector Reference to vector of UEs scheduled for a beam
      * @param beamSym Reference to number of resources (symbols per beam * 1 rbg) available
      * @param assignedResources Reference to currently assigned resources (symbols, rbgs)
-     * @param availableRbgs Reference to vector of available RBGs
+     * @param availableRbgs Reference to mask of available RBGs
      */
     void DeallocateResourcesDueToFronthaulConstraint(const std::vector<UePtrAndBufferReq>& ueVector,
                                                      const uint32_t& beamSym,
                                                      FTResources& assignedResources,
-                                                     std::vector<bool>& availableRbgs) const;
+                                                     NrRbgMask& availableRbgs) const;
     /**
      * @brief Allocate resources defined by currentRbg (RBG)*beamSym (symbols per beam) from
      * currentUe, then update list of assignedResources and availableRbgs
@@ -181,13 +240,13 @@ class NrMacSchedulerOfdma : public NrMacSchedulerTdma
      * @param currentRbg RBG to be deallocated
      * @param beamSym Symbols per beam to be deallocated
      * @param assignedResources Reference to total assigned resources
-     * @param availableRbgs Reference vector of available RBGs for scheduling
+     * @param availableRbgs Reference mask of available RBGs for scheduling
      */
     static void AllocateCurrentResourceToUe(std::shared_ptr<NrMacSchedulerUeInfo> currentUe,
                                             const uint32_t& currentRbg,
                                             const uint32_t beamSym,
                                             FTResources& assignedResources,
-                                            std::vector<bool>& availableRbgs);
+                                            NrRbgMask& availableRbgs);
     /**
      * @brief Deallocate resources defined by currentRbg (RBG)*beamSym (symbols per beam) from
      * currentUe, then update list of assignedResources and availableRbgs
@@ -195,57 +254,96 @@ class NrMacSchedulerOfdma : public NrMacSchedulerTdma
      * @param currentRbg RBG to be deallocated
      * @param beamSym Symbols per beam to be deallocated
      * @param assignedResources Reference to total assigned resources
-     * @param availableRbgs Reference vector of available RBGs for scheduling
+     * @param availableRbgs Reference mask of available RBGs for scheduling
      */
     static void DeallocateCurrentResourceFromUe(std::shared_ptr<NrMacSchedulerUeInfo> currentUe,
                                                 const uint32_t& currentRbg,
                                                 const uint32_t beamSym,
                                                 FTResources& assignedResources,
-                                                std::vector<bool>& availableRbgs);
+                                                NrRbgMask& availableRbgs);
+    /**
+     * @brief The RBGs that a UE can still get in a beam, maintained while the RBGs of the beam
+     * are assigned
+     */
+    struct DlRbgEstimate
+    {
+        std::vector<uint32_t> bestRbgs; //!< RBGs with non-zero sub-band CQI, by decreasing CQI
+                                        //!< and increasing index
+        size_t nextBestRbg{0};          //!< Position in bestRbgs before which all RBGs are taken
+        double csiSum{0.0}; //!< Sum of the sub-band CSI of the RBGs allocated to the UE and of
+                            //!< the free RBGs, once per symbol
+    };
+
+    /// Estimates of the UEs of a beam, by RNTI
+    using DlRbgEstimateMap = std::unordered_map<uint16_t, DlRbgEstimate>;
+
     /**
-     * @brief Try to schedule the best RBG out of remainingRbgSet to an UE referenced by
+     * @brief Create the estimates of the UEs of a beam, before assigning its RBGs
+     * @param ueVector the UEs of the beam
+     * @param remainingRbgs the free RBGs
+     * @param beamSym the number of symbols of the beam
+     * @return the estimates of the UEs
+     */
+    DlRbgEstimateMap CreateDlRbgEstimates(const std::vector<UePtrAndBufferReq>& ueVector,
+                                          const NrRbgMask& remainingRbgs,
+                                          uint32_t beamSym) const;
+
+    /**
+     * @brief Update the estimates of the other UEs of a beam after an RBG was taken by a UE,
+     * or after it was taken back from it
+     * @param estimates the estimates of the UEs of the beam
+     * @param ueVector the UEs of the beam
+     * @param rnti the UE that took the RBG, or from which it was taken back
+     * @param rbg the RBG
+     * @param beamSym the number of symbols of the beam
+     * @param taken true if the UE took the RBG, false if the RBG is free again
+     */
+    static void UpdateDlRbgEstimates(DlRbgEstimateMap& estimates,
+                                     const std::vector<UePtrAndBufferReq>& ueVector,
+                                     uint16_t rnti,
+                                     uint32_t rbg,
+                                     uint32_t beamSym,
+                                     bool taken);
+
+    /**
+     * @brief Try to schedule the best RBG out of remainingRbgs to an UE referenced by
      * schedInfoIt, for beamSym symbols, then update the list of assignedResources and availableRbgs
      * @param schedInfoIt Reference to the UE to be scheduled
-     * @param remainingRbgSet Reference to set of available RBGs to be scheduled
+     * @param remainingRbgs Reference to mask of available RBGs to be scheduled
      * @param beamSym Number of symbols per beam to be scheduled
      * @param assignedResources Number of resources scheduled
      * @param availableRbgs Mask of available RBGs
+     * @param estimate the estimate of the UE
      * @return true if scheduled, false if not scheduled
      */
     bool AttemptAllocationOfCurrentResourceToUe(
         std::vector<UePtrAndBufferReq>::iterator schedInfoIt,
-        std::set<uint32_t>& remainingRbgSet,
+        NrRbgMask& remainingRbgs,
         const uint32_t beamSym,
         FTResources& assignedResources,
-        std::vector<bool>& availableRbgs) const;
+        NrRbgMask& availableRbgs,
+        DlRbgEstimate& estimate) const;
 
     /**
      * Estimates the total achievable transport block (TB) capacity for a given UE, considering
      * all available resource block groups (RBGs) and the current resource assignment state.
      *
-     * This method calculates the maximum possible TB size that can be achieved for the given UE
-     * by temporarily allocating all available resources and evaluating the allocation. The result
-     * is used to assess if the UE should be scheduled or prioritized based on its potential
-     * capacity.
+     * The TB size is the one that the UE would get if all the free RBGs were allocated to it.
+     * It is computed from the estimate of the UE, which keeps the sum of the sub-band CSI of
+     * its RBGs and of the free RBGs, instead of allocating the free RBGs. The result is used
+     * to assess if the UE should be scheduled based on its potential capacity.
      *
-     * @param schedInfoIt Iterator pointing to the scheduling information of the UE within the
-     * scheduling container.
      * @param currentUe Shared pointer to the scheduling information object for the current UE.
-     * @param availableRbgs Vector representing the availability of resource block groups (RBGs).
-     *        Each element indicates whether the corresponding RBG is available for allocation.
+     * @param estimate the estimate of the UE
+     * @param numFreeRbgs the number of free RBGs
      * @param beamSym Number of symbols available in the current beam.
-     * @param assignedResources Reference to the structure that tracks the resources currently
-     * assigned to UEs during scheduling.
      * @return The maximum transport block size (in bits) that can be achieved for the UE with
      *         the given resources and configurations.
      */
-    uint32_t EstimateTotalTbCapacity(
-        std::vector<std::pair<std::shared_ptr<ns3::NrMacSchedulerUeInfo>, unsigned int>>::iterator
-            schedInfoIt,
-        std::shared_ptr<NrMacSchedulerUeInfo> currentUe,
-        const std::vector<bool>& availableRbgs,
-        const uint32_t beamSym,
-        FTResources& assignedResources) const;
+    uint32_t EstimateTotalTbCapacity(const std::shared_ptr<NrMacSchedulerUeInfo>& currentUe,
+                                     const DlRbgEstimate& estimate,
+                                     size_t numFreeRbgs,
+                                     uint32_t beamSym) const;
 
     void SetSymPerBeamType(SymPerBeamType type);
     TracedValue<uint32_t>
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <typeinfo>
 
 namespace ns3
 {
@@ -53,6 +54,12 @@ NrMacSchedulerTdmaAi::NrMacSchedulerTdmaAi()
 {
 }
 
+bool
+NrMacSchedulerTdmaAi::IsParallelSchedulingSupported() const
+{
+    return false;
+}
+
 std::shared_ptr<NrMacSchedulerUeInfo>
 NrMacSchedulerTdmaAi::CreateUeRepresentation(
     const NrMacCschedSapProvider::CschedUeConfigReqParameters& params) const
@@ -62,7 +69,14 @@ NrMacSchedulerTdmaAi::CreateUeRepresentation(
         m_alpha,
         params.m_rnti,
         params.m_beamId,
-        std::bind(&NrMacSchedulerTdmaAi::GetNumRbPerRbg, this));
+        std::bind(&NrMacSchedulerTdmaAi::GetNumRbPerRbg, this),
+        m_ueMetrics);
+}
+
+bool
+NrMacSchedulerTdmaAi::UsesBatchedMetrics() const
+{
+    return typeid(*this) == typeid(NrMacSchedulerTdmaAi);
 }
 
 std::function<bool(const NrMacSchedulerNs3::UePtrAndBufferReq& lhs,
@@ -47,6 +47,12 @@ class NrMacSchedulerTdmaAi : public NrMacSchedulerTdmaQos
      */
     NrMacSchedulerTdmaAi();
 
+    /**
+     * @brief The triggers call the ns3-gym environment, so they always run serially
+     * @return false
+     */
+    bool IsParallelSchedulingSupported() const override;
+
   protected:
     /**
      * @brief Create an UE representation of the type NrMacSchedulerUeInfoAi
@@ -56,6 +62,13 @@ class NrMacSchedulerTdmaAi : public NrMacSchedulerTdmaQos
     std::shared_ptr<NrMacSchedulerUeInfo> CreateUeRepresentation(
         const NrMacCschedSapProvider::CschedUeConfigReqParameters& params) const override;
 
+    /**
+     * @brief Whether the UEs without resources can be updated with the metric store
+     * @return true only if the scheduler is exactly a NrMacSchedulerTdmaAi, so that a subclass
+     * that overrides NotAssignedDlResources or NotAssignedUlResources is not bypassed
+     */
+    bool UsesBatchedMetrics() const override;
+
     /**
      * @brief Return the comparison function to sort DL UEs according to the scheduler policy
      * @return A pointer to NrMacSchedulerUeInfoAi::CompareUeWeightsDl if the AI model is activated,
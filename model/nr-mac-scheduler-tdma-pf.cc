@@ -10,6 +10,7 @@
 #include "ns3/log.h"
 
 #include <algorithm>
+#include <typeinfo>
 
 namespace ns3
 {
@@ -45,6 +46,7 @@ NrMacSchedulerTdmaPF::NrMacSchedulerTdmaPF()
     : NrMacSchedulerTdmaRR()
 {
     NS_LOG_FUNCTION(this);
+    m_ueMetrics = std::make_shared<NrMacSchedulerUeMetricStore>();
 }
 
 void
@@ -65,14 +67,14 @@ void
 NrMacSchedulerTdmaPF::SetTimeWindow(double v)
 {
     NS_LOG_FUNCTION(this);
-    m_timeWindow = v;
+    m_ueMetrics->m_timeWindow = v;
 }
 
 double
 NrMacSchedulerTdmaPF::GetTimeWindow() const
 {
     NS_LOG_FUNCTION(this);
-    return m_timeWindow;
+    return m_ueMetrics->m_timeWindow;
 }
 
 std::shared_ptr<NrMacSchedulerUeInfo>
@@ -84,7 +86,14 @@ NrMacSchedulerTdmaPF::CreateUeRepresentation(
         m_alpha,
         params.m_rnti,
         params.m_beamId,
-        std::bind(&NrMacSchedulerTdmaPF::GetNumRbPerRbg, this));
+        std::bind(&NrMacSchedulerTdmaPF::GetNumRbPerRbg, this),
+        m_ueMetrics);
+}
+
+bool
+NrMacSchedulerTdmaPF::UsesBatchedMetrics() const
+{
+    return typeid(*this) == typeid(NrMacSchedulerTdmaPF);
 }
 
 std::function<bool(const NrMacSchedulerNs3::UePtrAndBufferReq& lhs,
@@ -108,7 +117,7 @@ NrMacSchedulerTdmaPF::AssignedDlResources(const UePtrAndBufferReq& ue,
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoPF>(ue.first);
-    uePtr->UpdateDlPFMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateDlPFMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -119,7 +128,7 @@ NrMacSchedulerTdmaPF::NotAssignedDlResources(
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoPF>(ue.first);
-    uePtr->UpdateDlPFMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateDlPFMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -129,7 +138,7 @@ NrMacSchedulerTdmaPF::AssignedUlResources(const UePtrAndBufferReq& ue,
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoPF>(ue.first);
-    uePtr->UpdateUlPFMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateUlPFMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -140,7 +149,7 @@ NrMacSchedulerTdmaPF::NotAssignedUlResources(
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoPF>(ue.first);
-    uePtr->UpdateUlPFMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateUlPFMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
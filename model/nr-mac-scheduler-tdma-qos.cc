@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <typeinfo>
 
 namespace ns3
 {
@@ -46,6 +47,7 @@ NrMacSchedulerTdmaQos::NrMacSchedulerTdmaQos()
     : NrMacSchedulerTdmaRR()
 {
     NS_LOG_FUNCTION(this);
+    m_ueMetrics = std::make_shared<NrMacSchedulerUeMetricStore>();
 }
 
 void
@@ -66,14 +68,14 @@ void
 NrMacSchedulerTdmaQos::SetTimeWindow(double v)
 {
     NS_LOG_FUNCTION(this);
-    m_timeWindow = v;
+    m_ueMetrics->m_timeWindow = v;
 }
 
 double
 NrMacSchedulerTdmaQos::GetTimeWindow() const
 {
     NS_LOG_FUNCTION(this);
-    return m_timeWindow;
+    return m_ueMetrics->m_timeWindow;
 }
 
 std::shared_ptr<NrMacSchedulerUeInfo>
@@ -85,7 +87,14 @@ NrMacSchedulerTdmaQos::CreateUeRepresentation(
         m_alpha,
         params.m_rnti,
         params.m_beamId,
-        std::bind(&NrMacSchedulerTdmaQos::GetNumRbPerRbg, this));
+        std::bind(&NrMacSchedulerTdmaQos::GetNumRbPerRbg, this),
+        m_ueMetrics);
+}
+
+bool
+NrMacSchedulerTdmaQos::UsesBatchedMetrics() const
+{
+    return typeid(*this) == typeid(NrMacSchedulerTdmaQos);
 }
 
 std::function<bool(const NrMacSchedulerNs3::UePtrAndBufferReq& lhs,
@@ -109,7 +118,7 @@ NrMacSchedulerTdmaQos::AssignedDlResources(const UePtrAndBufferReq& ue,
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoQos>(ue.first);
-    uePtr->UpdateDlQosMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateDlQosMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -120,7 +129,7 @@ NrMacSchedulerTdmaQos::NotAssignedDlResources(
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoQos>(ue.first);
-    uePtr->UpdateDlQosMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateDlQosMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -130,7 +139,7 @@ NrMacSchedulerTdmaQos::AssignedUlResources(const UePtrAndBufferReq& ue,
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoQos>(ue.first);
-    uePtr->UpdateUlQosMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateUlQosMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
@@ -141,7 +150,7 @@ NrMacSchedulerTdmaQos::NotAssignedUlResources(
 {
     NS_LOG_FUNCTION(this);
     auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoQos>(ue.first);
-    uePtr->UpdateUlQosMetric(totAssigned, m_timeWindow);
+    uePtr->UpdateUlQosMetric(totAssigned, m_ueMetrics->m_timeWindow);
 }
 
 void
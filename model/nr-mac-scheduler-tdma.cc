@@ -10,6 +10,8 @@
 
 #include "nr-mac-scheduler-tdma.h"
 
+#include "nr-mac-scheduler-ue-info-metrics.h"
+
 #include "ns3/log.h"
 
 #include <algorithm>
@@ -65,8 +67,9 @@ NrMacSchedulerTdma::GetUeVectorFromActiveUeMap(const NrMacSchedulerNs3::ActiveUe
  * @param GetRBGFn Function to call to get a reference of the UL or DL RBG
  * @param GetSymFn Function to call to get a reference of the UL or DL symbols
  * @param SuccessfulAssignmentFn Function to call one time for the UE that got the resources
- * assigned in one iteration \param UnSuccessfulAssignmentFn Function to call for the UEs that did
- * not get anything in one iteration
+ * assigned in one iteration
+ * @param UnSuccessfulAssignmentFn Function to call, once per iteration, for the UEs that did
+ * not get anything in that iteration
  *
  * @return a map between the beam and the symbols assigned to each one
  *
@@ -81,8 +84,7 @@ NrMacSchedulerTdma::GetUeVectorFromActiveUeMap(const NrMacSchedulerNs3::ActiveUe
  *    GetRBGFn(ueVector.first()) += BandwidthInRBG();
  *    symbols--;
  *    SuccessfulAssignmentFn (ueVector.first());
- *    for each ue that did not get anything assigned:
- *        UnSuccessfulAssignmentFn (ue);
+ *    UnSuccessfulAssignmentFn (ueVector without ueVector.first());
  * </pre>
  *
  * To sort the UEs, the method uses the function returned by GetUeCompareDlFn().
@@ -124,17 +126,16 @@ NrMacSchedulerTdma::AssignRBGTDMA(uint32_t symAvail,
     uint32_t resources = symAvail;
     FTResources assigned(0, 0);
 
-    const std::vector<bool> notchedRBGsMask = type == "DL" ? GetDlBitmask() : GetUlBitmask();
-    uint32_t numOfAssignableRbgs = std::count(notchedRBGsMask.begin(), notchedRBGsMask.end(), true);
+    const NrRbgMask notchedRBGsMask = type == "DL" ? GetDlBitmask() : GetUlBitmask();
+    uint32_t numOfAssignableRbgs = notchedRBGsMask.Count();
     NS_ASSERT(numOfAssignableRbgs > 0);
 
-    std::set<uint32_t> remainingRbgSet;
-    for (size_t i = 0; i < notchedRBGsMask.size(); i++)
+    std::vector<uint16_t> assignableRbgs;
+    assignableRbgs.reserve(numOfAssignableRbgs);
+    for (auto rbg = notchedRBGsMask.FindFirst(); rbg != NrRbgMask::NPOS;
+         rbg = notchedRBGsMask.FindNext(rbg))
     {
-        if (notchedRBGsMask.at(i))
-        {
-            remainingRbgSet.emplace(i);
-        }
+        assignableRbgs.push_back(rbg);
     }
 
     for (auto& ue : ueVector)
@@ -184,8 +185,8 @@ NrMacSchedulerTdma::AssignRBGTDMA(uint32_t symAvail,
         auto& assignedRbgs = GetRBGFn(GetUe(*schedInfoIt));
         auto existingRbgs = assignedRbgs.size();
         assignedRbgs.resize(assignedRbgs.size() + numOfAssignableRbgs);
-        std::copy(remainingRbgSet.begin(),
-                  remainingRbgSet.end(),
+        std::copy(assignableRbgs.begin(),
+                  assignableRbgs.end(),
                   assignedRbgs.begin() + existingRbgs);
         assigned.m_rbg += numOfAssignableRbgs;
 
@@ -206,13 +207,10 @@ NrMacSchedulerTdma::AssignRBGTDMA(uint32_t symAvail,
         SuccessfulAssignmentFn(*schedInfoIt, FTResources(numOfAssignableRbgs, 1), assigned);
 
         // Update metrics for the unsuccessful UEs (who did not get any resource in this iteration)
-        for (auto& ue : ueVector)
-        {
-            if (GetUe(ue)->m_rnti != GetUe(*schedInfoIt)->m_rnti)
-            {
-                UnSuccessfulAssignmentFn(ue, FTResources(numOfAssignableRbgs, 1), assigned);
-            }
-        }
+        UnSuccessfulAssignmentFn(ueVector,
+                                 GetUe(*schedInfoIt)->m_rnti,
+                                 FTResources(numOfAssignableRbgs, 1),
+                                 assigned);
     }
 
     // Count the number of assigned symbol of each beam.
@@ -236,6 +234,58 @@ NrMacSchedulerTdma::SortUeVector(std::vector<UePtrAndBufferReq>* ueVector,
     std::stable_sort(ueVector->begin(), ueVector->end(), GetCompareFn());
 }
 
+void
+NrMacSchedulerTdma::NotAssignedDlResourcesToUes(const std::vector<UePtrAndBufferReq>& ueVector,
+                                                uint16_t assignedRnti,
+                                                const FTResources& notAssigned,
+                                                const FTResources& totalAssigned) const
+{
+    if (m_ueMetrics && UsesBatchedMetrics())
+    {
+        NrMacSchedulerUeInfoMetrics::UpdateDlTputs(ueVector,
+                                                  assignedRnti,
+                                                  totalAssigned,
+                                                  m_ueMetrics->m_timeWindow);
+        return;
+    }
+    for (const auto& ue : ueVector)
+    {
+        if (ue.first->m_rnti != assignedRnti)
+        {
+            NotAssignedDlResources(ue, notAssigned, totalAssigned);
+        }
+    }
+}
+
+void
+NrMacSchedulerTdma::NotAssignedUlResourcesToUes(const std::vector<UePtrAndBufferReq>& ueVector,
+                                                uint16_t assignedRnti,
+                                                const FTResources& notAssigned,
+                                                const FTResources& totalAssigned) const
+{
+    if (m_ueMetrics && UsesBatchedMetrics())
+    {
+        NrMacSchedulerUeInfoMetrics::UpdateUlTputs(ueVector,
+                                                  assignedRnti,
+                                                  totalAssigned,
+                                                  m_ueMetrics->m_timeWindow);
+        return;
+    }
+    for (const auto& ue : ueVector)
+    {
+        if (ue.first->m_rnti != assignedRnti)
+        {
+            NotAssignedUlResources(ue, notAssigned, totalAssigned);
+        }
+    }
+}
+
+bool
+NrMacSchedulerTdma::UsesBatchedMetrics() const
+{
+    return false;
+}
+
 /**
  * @brief Assign the available DL RBG to the UEs
  * @param symAvail Number of available symbols
@@ -259,11 +309,13 @@ NrMacSchedulerTdma::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl)
                                                    std::placeholders::_1,
                                                    std::placeholders::_2,
                                                    std::placeholders::_3);
-    AfterUnsuccessfulAssignmentFn UnSuccFn = std::bind(&NrMacSchedulerTdma::NotAssignedDlResources,
-                                                       this,
-                                                       std::placeholders::_1,
-                                                       std::placeholders::_2,
-                                                       std::placeholders::_3);
+    AfterUnsuccessfulAssignmentFn UnSuccFn =
+        std::bind(&NrMacSchedulerTdma::NotAssignedDlResourcesToUes,
+                  this,
+                  std::placeholders::_1,
+                  std::placeholders::_2,
+                  std::placeholders::_3,
+                  std::placeholders::_4);
     GetCompareUeFn compareFn = std::bind(&NrMacSchedulerTdma::GetUeCompareDlFn, this);
 
     GetTBSFn GetTbs = &NrMacSchedulerUeInfo::GetDlTBS;
@@ -309,11 +361,13 @@ NrMacSchedulerTdma::AssignULRBG(uint32_t symAvail, const ActiveUeMap& activeUl)
                                                    std::placeholders::_2,
                                                    std::placeholders::_3);
     GetCompareUeFn compareFn = std::bind(&NrMacSchedulerTdma::GetUeCompareUlFn, this);
-    AfterUnsuccessfulAssignmentFn UnSuccFn = std::bind(&NrMacSchedulerTdma::NotAssignedUlResources,
-                                                       this,
-                                                       std::placeholders::_1,
-                                                       std::placeholders::_2,
-                                                       std::placeholders::_3);
+    AfterUnsuccessfulAssignmentFn UnSuccFn =
+        std::bind(&NrMacSchedulerTdma::NotAssignedUlResourcesToUes,
+                  this,
+                  std::placeholders::_1,
+                  std::placeholders::_2,
+                  std::placeholders::_3,
+                  std::placeholders::_4);
     GetTBSFn GetTbs = &NrMacSchedulerUeInfo::GetUlTBS;
     GetRBGFn GetRBG = &NrMacSchedulerUeInfo::GetUlRBG;
     GetSymFn GetSym = &NrMacSchedulerUeInfo::GetUlSym;
@@ -364,8 +418,8 @@ NrMacSchedulerTdma::CreateDlDci(PointInFTPlane* spoint,
         return nullptr;
     }
 
-    const std::vector<bool> notchedRBGsMask = GetDlNotchedRbgMask();
-    int zeroes = std::count(notchedRBGsMask.begin(), notchedRBGsMask.end(), 0);
+    const auto& notchedRBGsMask = GetDlNotchedRbgMask();
+    int zeroes = notchedRBGsMask.size() - notchedRBGsMask.Count();
     uint32_t numOfAssignableRbgs = GetBandwidthInRbg() - zeroes;
 
     auto numSym = static_cast<uint8_t>(ueInfo->m_dlRBG.size() / numOfAssignableRbgs);
@@ -417,8 +471,8 @@ NrMacSchedulerTdma::CreateUlDci(NrMacSchedulerNs3::PointInFTPlane* spoint,
         return nullptr;
     }
 
-    const std::vector<bool> notchedRBGsMask = GetUlNotchedRbgMask();
-    int zeroes = std::count(notchedRBGsMask.begin(), notchedRBGsMask.end(), 0);
+    const auto& notchedRBGsMask = GetUlNotchedRbgMask();
+    int zeroes = notchedRBGsMask.size() - notchedRBGsMask.Count();
     uint32_t numOfAssignableRbgs = GetBandwidthInRbg() - zeroes;
 
     uint8_t numSym =
@@ -495,13 +549,7 @@ NrMacSchedulerTdma::CreateDci(NrMacSchedulerNs3::PointInFTPlane* spoint,
                                              GetBwpId(),
                                              GetTpc());
 
-    std::vector<bool> rbgAssigned =
-        fmt == DciInfoElementTdma::DL ? GetDlNotchedRbgMask() : GetUlNotchedRbgMask();
-
-    if (rbgAssigned.empty())
-    {
-        rbgAssigned = std::vector<bool>(GetBandwidthInRbg(), true);
-    }
+    NrRbgMask rbgAssigned = fmt == DciInfoElementTdma::DL ? GetDlBitmask() : GetUlBitmask();
 
     NS_ASSERT(rbgAssigned.size() == GetBandwidthInRbg());
 
@@ -516,8 +564,7 @@ NrMacSchedulerTdma::CreateDci(NrMacSchedulerNs3::PointInFTPlane* spoint,
     NS_LOG_INFO("UE " << ueInfo->m_rnti << " assigned RBG from " << spoint->m_rbg << " with mask "
                       << oss.str() << " for " << static_cast<uint32_t>(numSym) << " SYM ");
 
-    NS_ASSERT(std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), 0) !=
-              GetBandwidthInRbg());
+    NS_ASSERT(dci->m_rbgBitmask.Any());
 
     return dci;
 }
@@ -527,7 +574,7 @@ NrMacSchedulerTdma::DoReshapeAllocation(
     const std::vector<DciInfoElementTdma>& dcis,
     uint8_t& startingSymbol,
     uint8_t& numSymbols,
-    std::vector<bool>& bitmask,
+    NrRbgMask& bitmask,
     const bool isDl,
     const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap)
 {
@@ -580,17 +627,14 @@ NrMacSchedulerTdma::DoReshapeAllocation(
         auto& ueInfo = ueMap.at(dci.m_rnti);
 
         // Step 2, compute the number of resources needed
-        const std::size_t numResources =
-            dci.m_numSym * std::count(dci.m_rbgBitmask.begin(), dci.m_rbgBitmask.end(), true);
+        const std::size_t numResources = dci.m_numSym * dci.m_rbgBitmask.Count();
 
         // Step 3, allocate all RBGs to UE
         std::vector<uint16_t> allocatedRbgs;
-        for (std::size_t i = 0; i < bitmask.size(); i++)
+        allocatedRbgs.reserve(bitmask.Count());
+        for (auto rbg = bitmask.FindFirst(); rbg != NrRbgMask::NPOS; rbg = bitmask.FindNext(rbg))
         {
-            if (bitmask.at(i))
-            {
-                allocatedRbgs.push_back(i);
-            }
+            allocatedRbgs.push_back(rbg);
         }
 
         // We want to find the set of RBGs that return the maximum MCS
@@ -651,10 +695,10 @@ NrMacSchedulerTdma::DoReshapeAllocation(
 
         if (minSymbols <= availableSymbols && currResources == numResources)
         {
-            std::vector<bool> allocatedBitmask(bitmask.size(), false);
+            NrRbgMask allocatedBitmask(bitmask.size(), false);
             for (auto rbg : allocatedRbgs)
             {
-                allocatedBitmask.at(rbg) = true;
+                allocatedBitmask.Set(rbg);
             }
             // Update DCI after reshaping
             reshapedDcis.emplace_back(startingSymbol, minSymbols, allocatedBitmask, dci);
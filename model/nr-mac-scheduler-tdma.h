@@ -5,6 +5,7 @@
 #pragma once
 
 #include "nr-mac-scheduler-ns3.h"
+#include "nr-mac-scheduler-ue-metric-store.h"
 
 #include <functional>
 #include <memory>
@@ -184,6 +185,58 @@ class NrMacSchedulerTdma : public NrMacSchedulerNs3
                                         const FTResources& notAssigned,
                                         const FTResources& totalAssigned) const = 0;
 
+    /**
+     * @brief Update the representation of the UEs after a symbol (DL) has been assigned to
+     * other UE
+     * @param ueVector the UEs
+     * @param assignedRnti RNTI of the UE that got the resources, which is not updated, or 0
+     * to update all the UEs
+     * @param notAssigned the amount of resources not assigned
+     * @param totalAssigned the amount of total resources assigned until now
+     *
+     * If the scheduler keeps the throughput of its UEs in a metric store (m_ueMetrics) and
+     * UsesBatchedMetrics() returns true, the throughput of all the UEs is updated in one sweep
+     * over the store with NrMacSchedulerUeInfoMetrics::UpdateDlTputs, which gives the same
+     * result as NotAssignedDlResources of the PF and QoS schedulers. Otherwise, it calls
+     * NotAssignedDlResources for each UE.
+     */
+    virtual void NotAssignedDlResourcesToUes(const std::vector<UePtrAndBufferReq>& ueVector,
+                                             uint16_t assignedRnti,
+                                             const FTResources& notAssigned,
+                                             const FTResources& totalAssigned) const;
+
+    /**
+     * @brief Update the representation of the UEs after a symbol (UL) has been assigned to
+     * other UE
+     * @param ueVector the UEs
+     * @param assignedRnti RNTI of the UE that got the resources, which is not updated, or 0
+     * to update all the UEs
+     * @param notAssigned the amount of resources not assigned
+     * @param totalAssigned the amount of total resources assigned until now
+     *
+     * If the scheduler keeps the throughput of its UEs in a metric store (m_ueMetrics) and
+     * UsesBatchedMetrics() returns true, the throughput of all the UEs is updated in one sweep
+     * over the store with NrMacSchedulerUeInfoMetrics::UpdateUlTputs, which gives the same
+     * result as NotAssignedUlResources of the PF and QoS schedulers. Otherwise, it calls
+     * NotAssignedUlResources for each UE.
+     */
+    virtual void NotAssignedUlResourcesToUes(const std::vector<UePtrAndBufferReq>& ueVector,
+                                             uint16_t assignedRnti,
+                                             const FTResources& notAssigned,
+                                             const FTResources& totalAssigned) const;
+
+    /**
+     * @brief Whether NotAssignedDlResourcesToUes and NotAssignedUlResourcesToUes can update the
+     * UEs with the metric store, instead of calling NotAssignedDlResources and
+     * NotAssignedUlResources for each UE
+     * @return false by default
+     *
+     * The PF and QoS schedulers return true only when they are the actual type of the
+     * scheduler, so that the NotAssignedDlResources and NotAssignedUlResources of a subclass
+     * are always called. A subclass that does not change them can return true as well.
+     */
+    virtual bool UsesBatchedMetrics() const;
+
     /**
      * @brief Prepare UE for the DL scheduling
      * @param ue UE that is eligible for an assignation in any iteration round
@@ -252,6 +305,10 @@ class NrMacSchedulerTdma : public NrMacSchedulerNs3
     virtual void SortUeVector(std::vector<UePtrAndBufferReq>* ueVector,
                               [[maybe_unused]] const GetCompareUeFn& GetCompareFn) const;
 
+    /// Throughput metrics of the UEs, shared by their representations (which must derive
+    /// from NrMacSchedulerUeInfoMetrics), or null if the scheduler does not keep them
+    std::shared_ptr<NrMacSchedulerUeMetricStore> m_ueMetrics;
+
   private:
     /**
      * @brief Retrieve the UE vector from an ActiveUeMap
@@ -270,9 +327,13 @@ class NrMacSchedulerTdma : public NrMacSchedulerNs3
     typedef std::function<void(const UePtrAndBufferReq&, const FTResources&, const FTResources&)>
         AfterSuccessfulAssignmentFn;
     /**
-     * @brief Function to notify that the UE did not get any resource in one iteration
+     * @brief Function to notify that the UEs, except the one with the given RNTI, did not
+     * get any resource in one iteration
      */
-    typedef std::function<void(const UePtrAndBufferReq&, const FTResources&, const FTResources&)>
+    typedef std::function<void(const std::vector<UePtrAndBufferReq>&,
+                               uint16_t,
+                               const FTResources&,
+                               const FTResources&)>
         AfterUnsuccessfulAssignmentFn;
     typedef std::function<std::vector<uint16_t>&(const UePtr& ue)>
         GetRBGFn;                                               //!< Getter for the RBG of an UE
@@ -307,7 +368,7 @@ class NrMacSchedulerTdma : public NrMacSchedulerNs3
         const std::vector<DciInfoElementTdma>& dcis,
         uint8_t& startingSymbol,
         uint8_t& numSymbols,
-        std::vector<bool>& bitmask,
+        NrRbgMask& bitmask,
         const bool isDl,
         const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap) override;
 };
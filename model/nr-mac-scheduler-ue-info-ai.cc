@@ -87,12 +87,12 @@ NrMacSchedulerUeInfoAi::GetDlReward()
         for (const auto lcId : ueActiveLCs)
         {
             std::unique_ptr<NrMacSchedulerLC>& LCPtr = ueLcg.second->GetLC(lcId);
-            if (m_avgTputDl == 0 || LCPtr->m_rlcTransmissionQueueHolDelay == 0)
+            if (GetAvgTputDl() == 0 || LCPtr->m_rlcTransmissionQueueHolDelay == 0)
             {
                 continue;
             }
-            reward += std::pow(m_potentialTputDl, m_alpha) /
-                      (std::max(1E-9, m_avgTputDl) * LCPtr->m_priority *
+            reward += GetFairPotentialTputDl() /
+                      (std::max(1E-9, GetAvgTputDl()) * LCPtr->m_priority *
                        LCPtr->m_rlcTransmissionQueueHolDelay);
         }
     }
@@ -111,12 +111,12 @@ NrMacSchedulerUeInfoAi::GetUlReward()
         for (const auto lcId : ueActiveLCs)
         {
             std::unique_ptr<NrMacSchedulerLC>& LCPtr = ueLcg.second->GetLC(lcId);
-            if (m_avgTputUl == 0 || LCPtr->m_rlcTransmissionQueueHolDelay == 0)
+            if (GetAvgTputUl() == 0 || LCPtr->m_rlcTransmissionQueueHolDelay == 0)
             {
                 continue;
             }
-            reward += std::pow(m_potentialTputUl, m_alpha) /
-                      (std::max(1E-9, m_avgTputUl) * LCPtr->m_priority *
+            reward += GetFairPotentialTputUl() /
+                      (std::max(1E-9, GetAvgTputUl()) * LCPtr->m_priority *
                        LCPtr->m_rlcTransmissionQueueHolDelay);
         }
     }
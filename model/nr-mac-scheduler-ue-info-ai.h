@@ -33,9 +33,15 @@ class NrMacSchedulerUeInfoAi : public NrMacSchedulerUeInfoQos
      * @param rnti RNTI of the UE
      * @param beamId BeamId of the UE
      * @param fn A function that tells how many RB per RBG
+     * @param metrics the metric store shared by the UEs of the scheduler; if null, the UE
+     * creates its own store
      */
-    NrMacSchedulerUeInfoAi(float alpha, uint16_t rnti, BeamId beamId, const GetRbPerRbgFn& fn)
-        : NrMacSchedulerUeInfoQos(alpha, rnti, beamId, fn)
+    NrMacSchedulerUeInfoAi(float alpha,
+                           uint16_t rnti,
+                           BeamId beamId,
+                           const GetRbPerRbgFn& fn,
+                           std::shared_ptr<NrMacSchedulerUeMetricStore> metrics = nullptr)
+        : NrMacSchedulerUeInfoQos(alpha, rnti, beamId, fn, metrics)
     {
     }
 
@@ -0,0 +1,174 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-scheduler-ue-info-metrics.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMacSchedulerUeInfoMetrics");
+
+NrMacSchedulerUeInfoMetrics::NrMacSchedulerUeInfoMetrics(
+    float alpha,
+    uint16_t rnti,
+    BeamId beamId,
+    const GetRbPerRbgFn& fn,
+    std::shared_ptr<NrMacSchedulerUeMetricStore> metrics)
+    : NrMacSchedulerUeInfo(rnti, beamId, fn),
+      m_alpha(alpha),
+      m_metrics(metrics ? metrics : std::make_shared<NrMacSchedulerUeMetricStore>())
+{
+    m_metricsIdx = m_metrics->AddUe();
+    NrMacSchedulerUeMetricStore::SetPotentialTput(m_metrics->m_dl, m_metricsIdx, 0.0, m_alpha);
+    NrMacSchedulerUeMetricStore::SetPotentialTput(m_metrics->m_ul, m_metricsIdx, 0.0, m_alpha);
+}
+
+NrMacSchedulerUeInfoMetrics::~NrMacSchedulerUeInfoMetrics()
+{
+    m_metrics->RemoveUe(m_metricsIdx);
+}
+
+void
+NrMacSchedulerUeInfoMetrics::ResetDlSchedInfo()
+{
+    auto& metrics = m_metrics->m_dl;
+    metrics.m_lastAvgTput[m_metricsIdx] = metrics.m_avgTput[m_metricsIdx];
+    metrics.m_currTput[m_metricsIdx] = 0.0;
+    NrMacSchedulerUeMetricStore::SetPotentialTput(metrics, m_metricsIdx, 0.0, m_alpha);
+    NrMacSchedulerUeInfo::ResetDlSchedInfo();
+}
+
+void
+NrMacSchedulerUeInfoMetrics::ResetUlSchedInfo()
+{
+    auto& metrics = m_metrics->m_ul;
+    metrics.m_lastAvgTput[m_metricsIdx] = metrics.m_avgTput[m_metricsIdx];
+    metrics.m_currTput[m_metricsIdx] = 0.0;
+    NrMacSchedulerUeMetricStore::SetPotentialTput(metrics, m_metricsIdx, 0.0, m_alpha);
+    NrMacSchedulerUeInfo::ResetUlSchedInfo();
+}
+
+void
+NrMacSchedulerUeInfoMetrics::ResetDlMetric()
+{
+    NrMacSchedulerUeInfo::ResetDlMetric();
+    m_metrics->m_dl.m_avgTput[m_metricsIdx] = m_metrics->m_dl.m_lastAvgTput[m_metricsIdx];
+}
+
+void
+NrMacSchedulerUeInfoMetrics::ResetUlMetric()
+{
+    NrMacSchedulerUeInfo::ResetUlMetric();
+    m_metrics->m_ul.m_avgTput[m_metricsIdx] = m_metrics->m_ul.m_lastAvgTput[m_metricsIdx];
+}
+
+void
+NrMacSchedulerUeInfoMetrics::UpdateDlTput(const NrMacSchedulerNs3::FTResources& totAssigned,
+                                          double timeWindow)
+{
+    NrMacSchedulerUeInfo::UpdateDlMetric();
+    m_metrics->m_dl.m_tbSize[m_metricsIdx] = m_dlTbSize;
+    NrMacSchedulerUeMetricStore::UpdateAvgTput(m_metrics->m_dl,
+                                               m_metricsIdx,
+                                               totAssigned.m_sym,
+                                               timeWindow);
+}
+
+void
+NrMacSchedulerUeInfoMetrics::UpdateUlTput(const NrMacSchedulerNs3::FTResources& totAssigned,
+                                          double timeWindow)
+{
+    NrMacSchedulerUeInfo::UpdateUlMetric();
+    m_metrics->m_ul.m_tbSize[m_metricsIdx] = m_ulTbSize;
+    NrMacSchedulerUeMetricStore::UpdateAvgTput(m_metrics->m_ul,
+                                               m_metricsIdx,
+                                               totAssigned.m_sym,
+                                               timeWindow);
+}
+
+void
+NrMacSchedulerUeInfoMetrics::UpdateDlTputs(
+    const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector,
+    uint16_t skipRnti,
+    const NrMacSchedulerNs3::FTResources& totAssigned,
+    double timeWindow)
+{
+    UpdateTputs(ueVector, skipRnti, totAssigned, timeWindow, true);
+}
+
+void
+NrMacSchedulerUeInfoMetrics::UpdateUlTputs(
+    const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector,
+    uint16_t skipRnti,
+    const NrMacSchedulerNs3::FTResources& totAssigned,
+    double timeWindow)
+{
+    UpdateTputs(ueVector, skipRnti, totAssigned, timeWindow, false);
+}
+
+void
+NrMacSchedulerUeInfoMetrics::UpdateTputs(
+    const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector,
+    uint16_t skipRnti,
+    const NrMacSchedulerNs3::FTResources& totAssigned,
+    double timeWindow,
+    bool isDl)
+{
+    NS_LOG_FUNCTION(skipRnti << isDl);
+
+    NrMacSchedulerUeMetricStore* store = nullptr;
+    for (const auto& ue : ueVector)
+    {
+        if (ue.first->m_rnti == skipRnti)
+        {
+            continue;
+        }
+        auto uePtr = dynamic_cast<NrMacSchedulerUeInfoMetrics*>(ue.first.get());
+        NS_ASSERT(uePtr != nullptr);
+        if (!store)
+        {
+            store = uePtr->m_metrics.get();
+            store->m_sweep.clear();
+        }
+        if (uePtr->m_metrics.get() != store)
+        {
+            // UE created without the store of the scheduler
+            if (isDl)
+            {
+                uePtr->UpdateDlTput(totAssigned, timeWindow);
+            }
+            else
+            {
+                uePtr->UpdateUlTput(totAssigned, timeWindow);
+            }
+            continue;
+        }
+        if (isDl)
+        {
+            uePtr->NrMacSchedulerUeInfo::UpdateDlMetric();
+            store->m_dl.m_tbSize[uePtr->m_metricsIdx] = uePtr->m_dlTbSize;
+        }
+        else
+        {
+            uePtr->NrMacSchedulerUeInfo::UpdateUlMetric();
+            store->m_ul.m_tbSize[uePtr->m_metricsIdx] = uePtr->m_ulTbSize;
+        }
+        store->m_sweep.push_back(uePtr->m_metricsIdx);
+    }
+
+    if (store)
+    {
+        NrMacSchedulerUeMetricStore::UpdateAvgTput(isDl ? store->m_dl : store->m_ul,
+                                                   store->m_sweep,
+                                                   totAssigned.m_sym,
+                                                   timeWindow);
+        NS_LOG_DEBUG("Updated " << (isDl ? "DL" : "UL") << " throughput of "
+                                << store->m_sweep.size()
+                                << " UEs over n. of syms: " << +totAssigned.m_sym);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,252 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-mac-scheduler-ns3.h"
+#include "nr-mac-scheduler-ue-metric-store.h"
+
+#include <memory>
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief UE representation that keeps its throughput metrics in a NrMacSchedulerUeMetricStore
+ *
+ * Base of the UE representations of the PF and QoS schedulers. The current throughput,
+ * the average throughput, the last average throughput and the potential throughput of
+ * the UE are kept in an entry of a NrMacSchedulerUeMetricStore, usually shared with the
+ * other UEs of the scheduler; the representation holds only the index of the entry,
+ * which is released when the representation is destroyed. For this reason, the
+ * representation can be neither copied nor moved.
+ *
+ * The throughput of the UEs that share a store can be updated in one sweep over
+ * the arrays of the store with UpdateDlTputs() and UpdateUlTputs().
+ *
+ * @see NrMacSchedulerUeInfoPF
+ * @see NrMacSchedulerUeInfoQos
+ */
+class NrMacSchedulerUeInfoMetrics : public NrMacSchedulerUeInfo
+{
+  public:
+    /**
+     * @brief NrMacSchedulerUeInfoMetrics constructor
+     * @param alpha the fairness index of the UE
+     * @param rnti RNTI of the UE
+     * @param beamId Beam ID of the UE
+     * @param fn A function that tells how many RB per RBG
+     * @param metrics the metric store shared by the UEs of the scheduler; if null, the UE
+     * creates its own store
+     */
+    NrMacSchedulerUeInfoMetrics(float alpha,
+                                uint16_t rnti,
+                                BeamId beamId,
+                                const GetRbPerRbgFn& fn,
+                                std::shared_ptr<NrMacSchedulerUeMetricStore> metrics);
+
+    /**
+     * @brief ~NrMacSchedulerUeInfoMetrics, releases the entry of the UE in the metric store
+     */
+    ~NrMacSchedulerUeInfoMetrics() override;
+
+    NrMacSchedulerUeInfoMetrics(const NrMacSchedulerUeInfoMetrics&) = delete;
+    NrMacSchedulerUeInfoMetrics& operator=(const NrMacSchedulerUeInfoMetrics&) = delete;
+    NrMacSchedulerUeInfoMetrics(NrMacSchedulerUeInfoMetrics&&) = delete;
+    NrMacSchedulerUeInfoMetrics& operator=(NrMacSchedulerUeInfoMetrics&&) = delete;
+
+    /**
+     * @brief Reset DL scheduler info
+     *
+     * Set the last average throughput to the current average throughput,
+     * and zeroes the current and the potential throughput.
+     *
+     * It also calls NrMacSchedulerUeInfo::ResetDlSchedInfo.
+     */
+    void ResetDlSchedInfo() override;
+
+    /**
+     * @brief Reset UL scheduler info
+     *
+     * Set the last average throughput to the current average throughput,
+     * and zeroes the current and the potential throughput.
+     *
+     * It also calls NrMacSchedulerUeInfo::ResetUlSchedInfo.
+     */
+    void ResetUlSchedInfo() override;
+
+    /**
+     * @brief Reset the DL avg Th to the last value
+     */
+    void ResetDlMetric() override;
+
+    /**
+     * @brief Reset the UL avg Th to the last value
+     */
+    void ResetUlMetric() override;
+
+    /**
+     * @brief Update the DL throughput of several UEs
+     * @param ueVector the UEs, whose representations derive from NrMacSchedulerUeInfoMetrics
+     * @param skipRnti the RNTI of a UE to leave untouched, or 0 to update all the UEs
+     * @param totAssigned the resources assigned
+     * @param timeWindow the time window
+     *
+     * Same result as calling UpdateDlTput on each UE. The TBS of each UE is
+     * computed first, and then the throughput of all the UEs that share the metric
+     * store is updated in one sweep over the arrays of the store.
+     */
+    static void UpdateDlTputs(const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector,
+                              uint16_t skipRnti,
+                              const NrMacSchedulerNs3::FTResources& totAssigned,
+                              double timeWindow);
+
+    /**
+     * @brief Update the UL throughput of several UEs
+     * @param ueVector the UEs, whose representations derive from NrMacSchedulerUeInfoMetrics
+     * @param skipRnti the RNTI of a UE to leave untouched, or 0 to update all the UEs
+     * @param totAssigned the resources assigned
+     * @param timeWindow the time window
+     *
+     * Same result as calling UpdateUlTput on each UE. The TBS of each UE is
+     * computed first, and then the throughput of all the UEs that share the metric
+     * store is updated in one sweep over the arrays of the store.
+     */
+    static void UpdateUlTputs(const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector,
+                              uint16_t skipRnti,
+                              const NrMacSchedulerNs3::FTResources& totAssigned,
+                              double timeWindow);
+
+    /**
+     * @brief Get the current slot throughput in downlink
+     * @return the current slot throughput in downlink
+     */
+    double GetCurrTputDl() const
+    {
+        return m_metrics->m_dl.m_currTput[m_metricsIdx];
+    }
+
+    /**
+     * @brief Get the average throughput during all the slots in downlink
+     * @return the average throughput during all the slots in downlink
+     */
+    double GetAvgTputDl() const
+    {
+        return m_metrics->m_dl.m_avgTput[m_metricsIdx];
+    }
+
+    /**
+     * @brief Get the last average throughput in downlink
+     * @return the last average throughput in downlink
+     */
+    double GetLastAvgTputDl() const
+    {
+        return m_metrics->m_dl.m_lastAvgTput[m_metricsIdx];
+    }
+
+    /**
+     * @brief Get the potential throughput in one assignable resource in downlink
+     * @return the potential throughput in one assignable resource in downlink
+     */
+    double GetPotentialTputDl() const
+    {
+        return m_metrics->m_dl.m_potentialTput[m_metricsIdx];
+    }
+
+    /**
+     * @brief Get the fair potential throughput in downlink
+     * @return std::pow (potentialTput, alpha), as cached by the metric store
+     */
+    double GetFairPotentialTputDl() const
+    {
+        return m_metrics->m_dl.m_fairPotentialTput[m_metricsIdx];
+    }
+
+    /**
+     * @brief Get the current slot throughput in uplink
+     * @return the current slot throughput in uplink
+     */
+    double GetCurrTputUl() const
+    {
+        return m_metrics->m_ul.m_currTput[m_metricsIdx];
+    }
+
+    /**
+     * @brief Get the average throughput during all the slots in uplink
+     * @return the average throughput during all the slots in uplink
+     */
+    double GetAvgTputUl() const
+    {
+        return m_metrics->m_ul.m_avgTput[m_metricsIdx];
+    }
+
+    /**
+     * @brief Get the last average throughput in uplink
+     * @return the last average throughput in uplink
+     */
+    double GetLastAvgTputUl() const
+    {
+        return m_metrics->m_ul.m_lastAvgTput[m_metricsIdx];
+    }
+
+    /**
+     * @brief Get the potential throughput in one assignable resource in uplink
+     * @return the potential throughput in one assignable resource in uplink
+     */
+    double GetPotentialTputUl() const
+    {
+        return m_metrics->m_ul.m_potentialTput[m_metricsIdx];
+    }
+
+    /**
+     * @brief Get the fair potential throughput in uplink
+     * @return std::pow (potentialTput, alpha), as cached by the metric store
+     */
+    double GetFairPotentialTputUl() const
+    {
+        return m_metrics->m_ul.m_fairPotentialTput[m_metricsIdx];
+    }
+
+    float m_alpha{0.0}; //!< Fairness index
+
+  protected:
+    /**
+     * @brief Update the current and the average DL throughput
+     * @param totAssigned the resources assigned
+     * @param timeWindow the time window
+     *
+     * It gets the tbSize by calling NrMacSchedulerUeInfo::UpdateDlMetric.
+     */
+    void UpdateDlTput(const NrMacSchedulerNs3::FTResources& totAssigned, double timeWindow);
+
+    /**
+     * @brief Update the current and the average UL throughput
+     * @param totAssigned the resources assigned
+     * @param timeWindow the time window
+     *
+     * It gets the tbSize by calling NrMacSchedulerUeInfo::UpdateUlMetric.
+     */
+    void UpdateUlTput(const NrMacSchedulerNs3::FTResources& totAssigned, double timeWindow);
+
+    std::shared_ptr<NrMacSchedulerUeMetricStore> m_metrics; //!< Metric store of the UE
+    uint32_t m_metricsIdx{0};                               //!< Index of the UE in the store
+
+  private:
+    /**
+     * @brief Update the DL or UL throughput of several UEs
+     * @param ueVector the UEs, whose representations derive from NrMacSchedulerUeInfoMetrics
+     * @param skipRnti the RNTI of a UE to leave untouched, or 0 to update all the UEs
+     * @param totAssigned the resources assigned
+     * @param timeWindow the time window
+     * @param isDl true to update the DL throughput, false to update the UL one
+     */
+    static void UpdateTputs(const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector,
+                            uint16_t skipRnti,
+                            const NrMacSchedulerNs3::FTResources& totAssigned,
+                            double timeWindow,
+                            bool isDl);
+};
+
+} // namespace ns3
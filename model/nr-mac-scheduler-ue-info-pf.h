@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "nr-mac-scheduler-ue-info-metrics.h"
 #include "nr-mac-scheduler-ue-info-rr.h"
 
 namespace ns3
@@ -13,14 +14,15 @@ namespace ns3
  * @ingroup scheduler
  * @brief UE representation for a proportional fair scheduler
  *
- * The representation stores the current throughput, the average throughput,
- * and the last average throughput, as well as providing comparison functions
+ * The representation keeps the current throughput, the average throughput,
+ * and the last average throughput in a NrMacSchedulerUeMetricStore (see
+ * NrMacSchedulerUeInfoMetrics), as well as providing comparison functions
  * to sort the UEs in case of a PF scheduler.
  *
  * @see CompareUeWeightsDl
  * @see CompareUeWeightsUl
  */
-class NrMacSchedulerUeInfoPF : public NrMacSchedulerUeInfo
+class NrMacSchedulerUeInfoPF : public NrMacSchedulerUeInfoMetrics
 {
   public:
     /**
@@ -28,69 +30,21 @@ class NrMacSchedulerUeInfoPF : public NrMacSchedulerUeInfo
      * @param rnti RNTI of the UE
      * @param beamId Beam ID of the UE
      * @param fn A function that tells how many RB per RBG
+     * @param metrics the metric store shared by the UEs of the scheduler; if null, the UE
+     * creates its own store
      */
-    NrMacSchedulerUeInfoPF(float alpha, uint16_t rnti, BeamId beamId, const GetRbPerRbgFn& fn)
-        : NrMacSchedulerUeInfo(rnti, beamId, fn),
-          m_alpha(alpha)
-    {
-    }
-
-    /**
-     * @brief Reset DL PF scheduler info
-     *
-     * Set the last average throughput to the current average throughput,
-     * and zeroes the average throughput as well as the current throughput.
-     *
-     * It calls also NrMacSchedulerUeInfo::ResetDlSchedInfo.
-     */
-    void ResetDlSchedInfo() override
-    {
-        m_lastAvgTputDl = m_avgTputDl;
-        m_currTputDl = 0.0;
-        m_potentialTputDl = 0.0;
-        NrMacSchedulerUeInfo::ResetDlSchedInfo();
-    }
-
-    /**
-     * @brief Reset UL PF scheduler info
-     *
-     * Set the last average throughput to the current average throughput,
-     * and zeroes the average throughput as well as the current throughput.
-     *
-     * It also calls NrMacSchedulerUeInfo::ResetUlSchedInfo.
-     */
-    void ResetUlSchedInfo() override
-    {
-        m_lastAvgTputUl = m_avgTputUl;
-        m_currTputUl = 0.0;
-        m_potentialTputUl = 0.0;
-        NrMacSchedulerUeInfo::ResetUlSchedInfo();
-    }
-
-    /**
-     * @brief Reset the DL avg Th to the last value
-     */
-    void ResetDlMetric() override
-    {
-        NrMacSchedulerUeInfo::ResetDlMetric();
-        m_avgTputDl = m_lastAvgTputDl;
-    }
-
-    /**
-     * @brief Reset the UL avg Th to the last value
-     */
-    void ResetUlMetric() override
-    {
-        NrMacSchedulerUeInfo::ResetUlMetric();
-        m_avgTputUl = m_lastAvgTputUl;
-    }
+    NrMacSchedulerUeInfoPF(float alpha,
+                           uint16_t rnti,
+                           BeamId beamId,
+                           const GetRbPerRbgFn& fn,
+                           std::shared_ptr<NrMacSchedulerUeMetricStore> metrics = nullptr);
 
     /**
      * @brief Update the PF metric for downlink
      * @param totAssigned the resources assigned
      * @param timeWindow the time window
      *
-     * Updates m_currTputDl and m_avgTputDl by keeping in consideration
+     * Updates the current and the average DL throughput by keeping in consideration
      * the assigned resources (in form of TBS) and the time window.
      * It gets the tbSize by calling NrMacSchedulerUeInfo::UpdateDlMetric.
      */
@@ -101,7 +55,7 @@ class NrMacSchedulerUeInfoPF : public NrMacSchedulerUeInfo
      * @param totAssigned the resources assigned
      * @param timeWindow the time window
      *
-     * Updates m_currTputUl and m_avgTputUl by keeping in consideration
+     * Updates the current and the average UL throughput by keeping in consideration
      * the assigned resources (in form of TBS) and the time window.
      * It gets the tbSize by calling NrMacSchedulerUeInfo::UpdateUlMetric.
      */
@@ -140,10 +94,8 @@ class NrMacSchedulerUeInfoPF : public NrMacSchedulerUeInfo
         auto luePtr = dynamic_cast<NrMacSchedulerUeInfoPF*>(lue.first.get());
         auto ruePtr = dynamic_cast<NrMacSchedulerUeInfoPF*>(rue.first.get());
 
-        double lPfMetric = std::pow(luePtr->m_potentialTputDl, luePtr->m_alpha) /
-                           std::max(1E-9, luePtr->m_avgTputDl);
-        double rPfMetric = std::pow(ruePtr->m_potentialTputDl, ruePtr->m_alpha) /
-                           std::max(1E-9, ruePtr->m_avgTputDl);
+        double lPfMetric = luePtr->GetPfMetricDl();
+        double rPfMetric = ruePtr->GetPfMetricDl();
 
         return (lPfMetric > rPfMetric);
     }
@@ -169,26 +121,31 @@ class NrMacSchedulerUeInfoPF : public NrMacSchedulerUeInfo
         auto luePtr = dynamic_cast<NrMacSchedulerUeInfoPF*>(lue.first.get());
         auto ruePtr = dynamic_cast<NrMacSchedulerUeInfoPF*>(rue.first.get());
 
-        double lPfMetric = std::pow(luePtr->m_potentialTputUl, luePtr->m_alpha) /
-                           std::max(1E-9, luePtr->m_avgTputUl);
-        double rPfMetric = std::pow(ruePtr->m_potentialTputUl, ruePtr->m_alpha) /
-                           std::max(1E-9, ruePtr->m_avgTputUl);
+        double lPfMetric = luePtr->GetPfMetricUl();
+        double rPfMetric = ruePtr->GetPfMetricUl();
 
         return (lPfMetric > rPfMetric);
     }
 
-    double m_currTputDl{0.0};      //!< Current slot throughput in downlink
-    double m_avgTputDl{0.0};       //!< Average throughput in downlink during all the slots
-    double m_lastAvgTputDl{0.0};   //!< Last average throughput in downlink
-    double m_potentialTputDl{0.0}; //!< Potential throughput in downlink in one assignable resource
-                                   //!< (can be a symbol or a RBG)
-    float m_alpha{0.0};            //!< PF fairness metric
-
-    double m_currTputUl{0.0};      //!< Current slot throughput in uplink
-    double m_avgTputUl{0.0};       //!< Average throughput in uplink during all the slots
-    double m_lastAvgTputUl{0.0};   //!< Last average throughput in uplink
-    double m_potentialTputUl{0.0}; //!< Potential throughput in uplink in one assignable resource
-                                   //!< (can be a symbol or a RBG)
+    /**
+     * @brief Get the PF metric in downlink
+     * @return std::pow (potentialTput, alpha) / std::max (1E-9, avgTput), with the
+     * fair potential throughput cached by the metric store
+     */
+    double GetPfMetricDl() const
+    {
+        return NrMacSchedulerUeMetricStore::GetPfMetric(m_metrics->m_dl, m_metricsIdx);
+    }
+
+    /**
+     * @brief Get the PF metric in uplink
+     * @return std::pow (potentialTput, alpha) / std::max (1E-9, avgTput), with the
+     * fair potential throughput cached by the metric store
+     */
+    double GetPfMetricUl() const
+    {
+        return NrMacSchedulerUeMetricStore::GetPfMetric(m_metrics->m_ul, m_metricsIdx);
+    }
 };
 
 } // namespace ns3
@@ -11,23 +11,32 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("NrMacSchedulerUeInfoQos");
 
+NrMacSchedulerUeInfoQos::NrMacSchedulerUeInfoQos(
+    float alpha,
+    uint16_t rnti,
+    BeamId beamId,
+    const GetRbPerRbgFn& fn,
+    std::shared_ptr<NrMacSchedulerUeMetricStore> metrics)
+    : NrMacSchedulerUeInfoMetrics(alpha, rnti, beamId, fn, metrics)
+{
+}
+
 void
 NrMacSchedulerUeInfoQos::UpdateDlQosMetric(const NrMacSchedulerNs3::FTResources& totAssigned,
                                            double timeWindow)
 {
     NS_LOG_FUNCTION(this);
 
-    NrMacSchedulerUeInfo::UpdateDlMetric();
-    m_currTputDl = static_cast<double>(m_dlTbSize) / (totAssigned.m_sym);
-    m_avgTputDl = ((1.0 - (1.0 / static_cast<double>(timeWindow))) * m_lastAvgTputDl) +
-                  ((1.0 / timeWindow) * m_currTputDl);
+    UpdateDlTput(totAssigned, timeWindow);
 
     NS_LOG_DEBUG("Update DL QoS Metric for UE "
-                 << m_rnti << " DL TBS: " << m_dlTbSize << " Updated currTputDl " << m_currTputDl
-                 << " avgTputDl " << m_avgTputDl << " over n. of syms: " << +totAssigned.m_sym
-                 << ", last Avg TH Dl " << m_lastAvgTputDl << " total sym assigned "
+                 << m_rnti << " DL TBS: " << m_dlTbSize << " Updated currTputDl "
+                 << GetCurrTputDl() << " avgTputDl " << GetAvgTputDl()
+                 << " over n. of syms: " << +totAssigned.m_sym
+                 << ", last Avg TH Dl " << GetLastAvgTputDl() << " total sym assigned "
                  << static_cast<uint32_t>(totAssigned.m_sym)
-                 << " updated DL metric: " << m_potentialTputDl / std::max(1E-9, m_avgTputDl));
+                 << " updated DL metric: "
+                 << GetPotentialTputDl() / std::max(1E-9, GetAvgTputDl()));
 }
 
 void
@@ -36,18 +45,16 @@ NrMacSchedulerUeInfoQos::UpdateUlQosMetric(const NrMacSchedulerNs3::FTResources&
 {
     NS_LOG_FUNCTION(this);
 
-    NrMacSchedulerUeInfo::UpdateUlMetric();
-
-    m_currTputUl = static_cast<double>(m_ulTbSize) / (totAssigned.m_sym);
-    m_avgTputUl = ((1.0 - (1.0 / static_cast<double>(timeWindow))) * m_lastAvgTputUl) +
-                  ((1.0 / timeWindow) * m_currTputUl);
+    UpdateUlTput(totAssigned, timeWindow);
 
     NS_LOG_DEBUG("Update UL PF Metric for UE "
-                 << m_rnti << " UL TBS: " << m_ulTbSize << " Updated currTputUl " << m_currTputUl
-                 << " avgTputUl " << m_avgTputUl << " over n. of syms: " << +totAssigned.m_sym
-                 << ", last Avg TH Ul " << m_lastAvgTputUl << " total sym assigned "
+                 << m_rnti << " UL TBS: " << m_ulTbSize << " Updated currTputUl "
+                 << GetCurrTputUl() << " avgTputUl " << GetAvgTputUl()
+                 << " over n. of syms: " << +totAssigned.m_sym
+                 << ", last Avg TH Ul " << GetLastAvgTputUl() << " total sym assigned "
                  << static_cast<uint32_t>(totAssigned.m_sym)
-                 << " updated UL metric: " << m_potentialTputUl / std::max(1E-9, m_avgTputUl));
+                 << " updated UL metric: "
+                 << GetPotentialTputUl() / std::max(1E-9, GetAvgTputUl()));
 }
 
 void
@@ -57,15 +64,16 @@ NrMacSchedulerUeInfoQos::CalculatePotentialTPutDl(
     NS_LOG_FUNCTION(this);
 
     uint32_t rbsAssignable = assignableInIteration.m_rbg * GetNumRbPerRbg();
-    // Since we compute a new potential throughput every time, there is no harm
-    // in initializing it to zero here.
-    m_potentialTputDl = 0.0;
-    m_potentialTputDl = m_dlAmc->GetPayloadSize(m_dlMcs, m_dlRank, rbsAssignable);
-    m_potentialTputDl /= assignableInIteration.m_sym;
-
-    NS_LOG_INFO("UE " << m_rnti << " potentialTputDl " << m_potentialTputDl << " lastAvgThDl "
-                      << m_lastAvgTputDl << " DL PF metric (partial part of QoS metric): "
-                      << m_potentialTputDl / std::max(1E-9, m_avgTputDl));
+    double potentialTput = m_dlAmc->GetPayloadSize(m_dlMcs, m_dlRank, rbsAssignable);
+    potentialTput /= assignableInIteration.m_sym;
+    NrMacSchedulerUeMetricStore::SetPotentialTput(m_metrics->m_dl,
+                                                  m_metricsIdx,
+                                                  potentialTput,
+                                                  m_alpha);
+
+    NS_LOG_INFO("UE " << m_rnti << " potentialTputDl " << GetPotentialTputDl() << " lastAvgThDl "
+                      << GetLastAvgTputDl() << " DL PF metric (partial part of QoS metric): "
+                      << GetPotentialTputDl() / std::max(1E-9, GetAvgTputDl()));
 }
 
 void
@@ -75,12 +83,16 @@ NrMacSchedulerUeInfoQos::CalculatePotentialTPutUl(
     NS_LOG_FUNCTION(this);
 
     uint32_t rbsAssignable = assignableInIteration.m_rbg * GetNumRbPerRbg();
-    m_potentialTputUl = m_ulAmc->GetPayloadSize(m_ulMcs, m_ulRank, rbsAssignable);
-    m_potentialTputUl /= assignableInIteration.m_sym;
-
-    NS_LOG_INFO("UE " << m_rnti << " potentialTputUl " << m_potentialTputUl << " lastAvgThUl "
-                      << m_lastAvgTputUl << " UL PF metric (partial part of QoS metric): "
-                      << m_potentialTputUl / std::max(1E-9, m_avgTputUl));
+    double potentialTput = m_ulAmc->GetPayloadSize(m_ulMcs, m_ulRank, rbsAssignable);
+    potentialTput /= assignableInIteration.m_sym;
+    NrMacSchedulerUeMetricStore::SetPotentialTput(m_metrics->m_ul,
+                                                  m_metricsIdx,
+                                                  potentialTput,
+                                                  m_alpha);
+
+    NS_LOG_INFO("UE " << m_rnti << " potentialTputUl " << GetPotentialTputUl() << " lastAvgThUl "
+                      << GetLastAvgTputUl() << " UL PF metric (partial part of QoS metric): "
+                      << GetPotentialTputUl() / std::max(1E-9, GetAvgTputUl()));
 }
 
 } // namespace ns3
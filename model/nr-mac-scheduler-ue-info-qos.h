@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "nr-mac-scheduler-ue-info-metrics.h"
 #include "nr-mac-scheduler-ue-info-rr.h"
 
 namespace ns3
@@ -12,14 +13,15 @@ namespace ns3
  * @ingroup scheduler
  * @brief UE representation for a QoS-based scheduler
  *
- * The representation stores the current throughput, the average throughput,
- * and the last average throughput, as well as providing comparison functions
+ * The representation keeps the current throughput, the average throughput,
+ * and the last average throughput in a NrMacSchedulerUeMetricStore (see
+ * NrMacSchedulerUeInfoMetrics), as well as providing comparison functions
  * to sort the UEs in case of a QoS scheduler, according to its 5QI and priority.
  *
  * @see CompareUeWeightsDl
  * @see CompareUeWeightsUl
  */
-class NrMacSchedulerUeInfoQos : public NrMacSchedulerUeInfo
+class NrMacSchedulerUeInfoQos : public NrMacSchedulerUeInfoMetrics
 {
   public:
     /**
@@ -27,69 +29,21 @@ class NrMacSchedulerUeInfoQos : public NrMacSchedulerUeInfo
      * @param rnti RNTI of the UE
      * @param beamId BeamId of the UE
      * @param fn A function that tells how many RB per RBG
+     * @param metrics the metric store shared by the UEs of the scheduler; if null, the UE
+     * creates its own store
      */
-    NrMacSchedulerUeInfoQos(float alpha, uint16_t rnti, BeamId beamId, const GetRbPerRbgFn& fn)
-        : NrMacSchedulerUeInfo(rnti, beamId, fn),
-          m_alpha(alpha)
-    {
-    }
-
-    /**
-     * @brief Reset DL QoS scheduler info
-     *
-     * Set the last average throughput to the current average throughput,
-     * and zeroes the average throughput as well as the current throughput.
-     *
-     * It calls also NrMacSchedulerUeInfoQos::ResetDlSchedInfo.
-     */
-    void ResetDlSchedInfo() override
-    {
-        m_lastAvgTputDl = m_avgTputDl;
-        m_currTputDl = 0.0;
-        m_potentialTputDl = 0.0;
-        NrMacSchedulerUeInfo::ResetDlSchedInfo();
-    }
-
-    /**
-     * @brief Reset UL QoS scheduler info
-     *
-     * Set the last average throughput to the current average throughput,
-     * and zeroes the average throughput as well as the current throughput.
-     *
-     * It also calls NrMacSchedulerUeInfoQos::ResetUlSchedInfo.
-     */
-    void ResetUlSchedInfo() override
-    {
-        m_lastAvgTputUl = m_avgTputUl;
-        m_currTputUl = 0.0;
-        m_potentialTputUl = 0.0;
-        NrMacSchedulerUeInfo::ResetUlSchedInfo();
-    }
-
-    /**
-     * @brief Reset the DL avg Th to the last value
-     */
-    void ResetDlMetric() override
-    {
-        NrMacSchedulerUeInfo::ResetDlMetric();
-        m_avgTputDl = m_lastAvgTputDl;
-    }
-
-    /**
-     * @brief Reset the UL avg Th to the last value
-     */
-    void ResetUlMetric() override
-    {
-        NrMacSchedulerUeInfo::ResetUlMetric();
-        m_avgTputUl = m_lastAvgTputUl;
-    }
+    NrMacSchedulerUeInfoQos(float alpha,
+                            uint16_t rnti,
+                            BeamId beamId,
+                            const GetRbPerRbgFn& fn,
+                            std::shared_ptr<NrMacSchedulerUeMetricStore> metrics = nullptr);
 
     /**
      * @brief Update the QoS metric for downlink
      * @param totAssigned the resources assigned
      * @param timeWindow the time window
      *
-     * Updates m_currTputDl and m_avgTputDl by keeping in consideration
+     * Updates the current and the average DL throughput by keeping in consideration
      * the assigned resources (in form of TBS) and the time window.
      * It gets the tbSize by calling NrMacSchedulerUeInfo::UpdateDlMetric.
      */
@@ -100,7 +54,7 @@ class NrMacSchedulerUeInfoQos : public NrMacSchedulerUeInfo
      * @param totAssigned the resources assigned
      * @param timeWindow the time window
      *
-     * Updates m_currTputUl and m_avgTputUl by keeping in consideration
+     * Updates the current and the average UL throughput by keeping in consideration
      * the assigned resources (in form of TBS) and the time window.
      * It gets the tbSize by calling NrMacSchedulerUeInfo::UpdateUlMetric.
      */
@@ -171,9 +125,8 @@ class NrMacSchedulerUeInfoQos : public NrMacSchedulerUeInfo
                         CalculateDelayBudgetFactor(LCPtr->m_delayBudget.GetMilliSeconds(),
                                                    LCPtr->m_rlcTransmissionQueueHolDelay);
                 }
-                weight += (100 - LCPtr->m_priority) *
-                          std::pow(uePtr->m_potentialTputDl, uePtr->m_alpha) /
-                          std::max(1E-9, uePtr->m_avgTputDl) * delayBudgetFactor;
+                weight += (100 - LCPtr->m_priority) * uePtr->GetFairPotentialTputDl() /
+                          std::max(1E-9, uePtr->GetAvgTputDl()) * delayBudgetFactor;
                 NS_ASSERT_MSG(weight > 0, "Weight must be greater than zero");
             }
         }
@@ -228,10 +181,10 @@ class NrMacSchedulerUeInfoQos : public NrMacSchedulerUeInfo
         NS_ABORT_IF(leftP == 0);
         NS_ABORT_IF(rightP == 0);
 
-        double lQoSMetric = (100 - leftP) * std::pow(luePtr->m_potentialTputUl, luePtr->m_alpha) /
-                            std::max(1E-9, luePtr->m_avgTputUl);
-        double rQoSMetric = (100 - rightP) * std::pow(ruePtr->m_potentialTputUl, ruePtr->m_alpha) /
-                            std::max(1E-9, ruePtr->m_avgTputUl);
+        double lQoSMetric = (100 - leftP) * luePtr->GetFairPotentialTputUl() /
+                            std::max(1E-9, luePtr->GetAvgTputUl());
+        double rQoSMetric = (100 - rightP) * ruePtr->GetFairPotentialTputUl() /
+                            std::max(1E-9, ruePtr->GetAvgTputUl());
 
         return (lQoSMetric > rQoSMetric);
     }
@@ -313,19 +266,6 @@ class NrMacSchedulerUeInfoQos : public NrMacSchedulerUeInfo
         }
         return ueMinPriority;
     }
-
-    double m_currTputDl{0.0};      //!< Current slot throughput in downlink
-    double m_avgTputDl{0.0};       //!< Average throughput in downlink during all the slots
-    double m_lastAvgTputDl{0.0};   //!< Last average throughput in downlink
-    double m_potentialTputDl{0.0}; //!< Potential throughput in downlink in one assignable resource
-                                   //!< (can be a symbol or a RBG)
-    float m_alpha{0.0};            //!< PF fairness metric
-
-    double m_currTputUl{0.0};      //!< Current slot throughput in uplink
-    double m_avgTputUl{0.0};       //!< Average throughput in uplink during all the slots
-    double m_lastAvgTputUl{0.0};   //!< Last average throughput in uplink
-    double m_potentialTputUl{0.0}; //!< Potential throughput in uplink in one assignable resource
-                                   //!< (can be a symbol or a RBG)
 };
 
 } // namespace ns3
@@ -54,27 +54,31 @@ NrMacSchedulerUeInfo::GetDlMcs(const UePtr& ue)
     return ue->m_dlMcs;
 }
 
-template <typename T>
-uint8_t
-ComputeMcs(const NrMacSchedulerUeInfo* ueInfo,
-           T NrMacSchedulerUeInfo::SbMcsInfo::* field,
-           std::function<uint8_t(double)> postProcessing)
+bool
+NrMacSchedulerUeInfo::HasDlSbCsi() const
 {
-    // Compute average field of allocated RBGs
-    const auto sum = std::transform_reduce(
-        ueInfo->m_dlRBG.begin(),
-        ueInfo->m_dlRBG.end(),
-        0.0,
-        [](auto a, auto b) { return a + b; },
-        [ueInfo, field](auto a) {
-            return ueInfo->m_dlSbMcsInfo.at(ueInfo->m_rbgToSb.at(a)).*field;
-        });
-    const auto avg = sum / ueInfo->m_dlRBG.size();
-    return postProcessing(avg);
+    return !m_dlSbMcsInfo.empty() && m_mcsCsiSource != McsCsiSource::WIDEBAND_MCS;
+}
+
+double
+NrMacSchedulerUeInfo::GetDlRbgCsi(uint32_t rbg) const
+{
+    const auto& sbMcsInfo = m_dlSbMcsInfo.at(m_rbgToSb.at(rbg));
+    switch (m_mcsCsiSource)
+    {
+    case McsCsiSource::AVG_MCS:
+        return sbMcsInfo.mcs;
+    case McsCsiSource::AVG_SPEC_EFF:
+        return sbMcsInfo.specEff;
+    case McsCsiSource::AVG_SINR:
+        return sbMcsInfo.sinr;
+    default:
+        NS_ABORT_MSG("Invalid csi source for MCS computation");
+    }
 }
 
 uint8_t
-NrMacSchedulerUeInfo::GetDlMcs() const
+NrMacSchedulerUeInfo::GetDlMcsForCsiSum(double csiSum, size_t numRbgs) const
 {
     // Return maximum allowed MCS according to Fronthaul control
     if (m_fhMaxMcsAssignable.has_value())
@@ -82,36 +86,46 @@ NrMacSchedulerUeInfo::GetDlMcs() const
         return m_fhMaxMcsAssignable.value();
     }
 
-    // In case there is no sub-band info or no RBG has been allocated, return the wideband MCS
-    if (m_dlSbMcsInfo.empty() || m_dlRBG.empty() || (m_mcsCsiSource == McsCsiSource::WIDEBAND_MCS))
+    // In case there is no sub-band info or no RBG, return the wideband MCS
+    if (!HasDlSbCsi() || numRbgs == 0)
     {
         return m_dlMcs;
     }
 
-    // Otherwise, compute the SINR of allocated RBGs
+    const auto avg = csiSum / numRbgs;
     switch (m_mcsCsiSource)
     {
-    // Estimate MCS based on the average MCS of allocated RBGs
-    case McsCsiSource::AVG_MCS: {
-        return ComputeMcs(this, &SbMcsInfo::mcs, [](double avg) { return (uint8_t)floor(avg); });
-    }
-    // Estimate MCS based on the average spectral efficiency of allocated RBGs
-    case McsCsiSource::AVG_SPEC_EFF: {
-        return ComputeMcs(this,
-                          &SbMcsInfo::specEff,
-                          std::bind_front(&NrAmc::GetMcsFromSpectralEfficiency, m_dlAmc));
-    }
-    // Estimate MCS based on the average SINR of allocated RBGs
-    case McsCsiSource::AVG_SINR: {
-        return ComputeMcs(this, &SbMcsInfo::sinr, [amc = m_dlAmc](double avgSinr) {
-            return amc->GetMcsFromSpectralEfficiency(amc->GetSpectralEfficiencyForSinr(avgSinr));
-        });
-    }
+    // Estimate MCS based on the average MCS of the RBGs
+    case McsCsiSource::AVG_MCS:
+        return static_cast<uint8_t>(floor(avg));
+    // Estimate MCS based on the average spectral efficiency of the RBGs
+    case McsCsiSource::AVG_SPEC_EFF:
+        return m_dlAmc->GetMcsFromSpectralEfficiency(avg);
+    // Estimate MCS based on the average SINR of the RBGs
+    case McsCsiSource::AVG_SINR:
+        return m_dlAmc->GetMcsFromSpectralEfficiency(m_dlAmc->GetSpectralEfficiencyForSinr(avg));
     default:
         NS_ABORT_MSG("Invalid csi source for MCS computation");
     }
 }
 
+uint8_t
+NrMacSchedulerUeInfo::GetDlMcs() const
+{
+    if (m_fhMaxMcsAssignable.has_value() || !HasDlSbCsi() || m_dlRBG.empty())
+    {
+        return GetDlMcsForCsiSum(0.0, 0);
+    }
+
+    // Otherwise, compute the average CSI of allocated RBGs
+    const auto sum = std::transform_reduce(m_dlRBG.begin(),
+                                           m_dlRBG.end(),
+                                           0.0,
+                                           std::plus<>(),
+                                           [this](auto rbg) { return GetDlRbgCsi(rbg); });
+    return GetDlMcsForCsiSum(sum, m_dlRBG.size());
+}
+
 uint8_t&
 NrMacSchedulerUeInfo::GetUlMcs(const UePtr& ue)
 {
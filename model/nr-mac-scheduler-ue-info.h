@@ -109,6 +109,30 @@ class NrMacSchedulerUeInfo
      * @return downlink mcs
      */
     uint8_t GetDlMcs() const;
+    /**
+     * @brief Tell whether the DL MCS is computed from the sub-band CSI of the allocated RBGs
+     * @return true if there is sub-band information and the MCS CSI source is not WIDEBAND_MCS
+     */
+    bool HasDlSbCsi() const;
+    /**
+     * @brief Get the sub-band CSI of a RBG that is averaged to compute the DL MCS
+     *
+     * Depending on the MCS CSI source, it is the MCS, the spectral efficiency or the SINR
+     * of the sub-band of the RBG. It must only be called if HasDlSbCsi() is true.
+     * @param rbg the RBG
+     * @return the CSI of the RBG
+     */
+    double GetDlRbgCsi(uint32_t rbg) const;
+    /**
+     * @brief Get the downlink MCS of a set of RBGs, given the sum of their sub-band CSI
+     *
+     * GetDlMcs() uses it for the allocated RBGs. The scheduler also uses it to estimate the
+     * MCS with RBGs that are not allocated yet.
+     * @param csiSum the sum of GetDlRbgCsi() over the RBGs, with repetitions
+     * @param numRbgs the number of RBGs in the sum, with repetitions
+     * @return downlink mcs
+     */
+    uint8_t GetDlMcsForCsiSum(double csiSum, size_t numRbgs) const;
     /**
      * @brief GetDlMcs
      * @param ue UE pointer from which obtain the value
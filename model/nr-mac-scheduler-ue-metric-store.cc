@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-scheduler-ue-metric-store.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMacSchedulerUeMetricStore");
+
+uint32_t
+NrMacSchedulerUeMetricStore::AddUe()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t idx;
+    if (!m_freeIdx.empty())
+    {
+        idx = m_freeIdx.back();
+        m_freeIdx.pop_back();
+    }
+    else
+    {
+        idx = GetSize();
+        Resize(m_dl, idx + 1);
+        Resize(m_ul, idx + 1);
+    }
+    Clear(m_dl, idx);
+    Clear(m_ul, idx);
+    return idx;
+}
+
+void
+NrMacSchedulerUeMetricStore::RemoveUe(uint32_t idx)
+{
+    NS_LOG_FUNCTION(this << idx);
+    NS_ASSERT(idx < GetSize());
+    NS_ASSERT(std::find(m_freeIdx.begin(), m_freeIdx.end(), idx) == m_freeIdx.end());
+    m_freeIdx.push_back(idx);
+}
+
+void
+NrMacSchedulerUeMetricStore::SetPotentialTput(Metrics& metrics,
+                                              uint32_t idx,
+                                              double potentialTput,
+                                              double alpha)
+{
+    metrics.m_potentialTput[idx] = potentialTput;
+    metrics.m_fairPotentialTput[idx] = std::pow(potentialTput, alpha);
+}
+
+double
+NrMacSchedulerUeMetricStore::GetPfMetric(const Metrics& metrics, uint32_t idx)
+{
+    return metrics.m_fairPotentialTput[idx] / std::max(1E-9, metrics.m_avgTput[idx]);
+}
+
+void
+NrMacSchedulerUeMetricStore::UpdateAvgTput(Metrics& metrics,
+                                           uint32_t idx,
+                                           uint32_t numSym,
+                                           double timeWindow)
+{
+    metrics.m_currTput[idx] = static_cast<double>(metrics.m_tbSize[idx]) / numSym;
+    metrics.m_avgTput[idx] = ((1.0 - (1.0 / timeWindow)) * metrics.m_lastAvgTput[idx]) +
+                             ((1.0 / timeWindow) * metrics.m_currTput[idx]);
+}
+
+void
+NrMacSchedulerUeMetricStore::UpdateAvgTput(Metrics& metrics,
+                                           const std::vector<uint32_t>& ues,
+                                           uint32_t numSym,
+                                           double timeWindow)
+{
+    const double lastWeight = 1.0 - (1.0 / timeWindow);
+    const double currWeight = 1.0 / timeWindow;
+    const double sym = numSym;
+    const uint32_t* tbSize = metrics.m_tbSize.data();
+    const double* lastAvgTput = metrics.m_lastAvgTput.data();
+    double* currTput = metrics.m_currTput.data();
+    double* avgTput = metrics.m_avgTput.data();
+
+    for (const auto idx : ues)
+    {
+        const double curr = static_cast<double>(tbSize[idx]) / sym;
+        currTput[idx] = curr;
+        avgTput[idx] = (lastWeight * lastAvgTput[idx]) + (currWeight * curr);
+    }
+}
+
+void
+NrMacSchedulerUeMetricStore::Resize(Metrics& metrics, uint32_t size)
+{
+    metrics.m_currTput.resize(size);
+    metrics.m_avgTput.resize(size);
+    metrics.m_lastAvgTput.resize(size);
+    metrics.m_potentialTput.resize(size);
+    metrics.m_fairPotentialTput.resize(size);
+    metrics.m_tbSize.resize(size);
+}
+
+void
+NrMacSchedulerUeMetricStore::Clear(Metrics& metrics, uint32_t idx)
+{
+    metrics.m_currTput[idx] = 0.0;
+    metrics.m_avgTput[idx] = 0.0;
+    metrics.m_lastAvgTput[idx] = 0.0;
+    metrics.m_potentialTput[idx] = 0.0;
+    metrics.m_fairPotentialTput[idx] = 0.0;
+    metrics.m_tbSize[idx] = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,140 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief Throughput metrics of the UEs of a PF or QoS scheduler, stored as arrays
+ *
+ * The metrics used to sort the UEs (current, average and last average throughput,
+ * and potential throughput) are kept in one array per metric and per direction,
+ * instead of inside each UE representation. Each UE representation (e.g.,
+ * NrMacSchedulerUeInfoPF) holds only the index of its entry in the arrays.
+ *
+ * The store is owned by the scheduler and shared by all its UEs, so that the
+ * average throughput of all the UEs that did not get resources in an iteration
+ * is updated with one sweep over contiguous arrays (see UpdateAvgTput()),
+ * instead of following one pointer per UE.
+ *
+ * The fair potential throughput, i.e., std::pow (potentialTput, alpha), is cached
+ * when the potential throughput is set, so that the comparison functions do not
+ * compute it at each comparison.
+ */
+class NrMacSchedulerUeMetricStore
+{
+  public:
+    /**
+     * @brief The metrics of one direction (DL or UL), indexed by UE
+     */
+    struct Metrics
+    {
+        std::vector<double> m_currTput;          //!< Current slot throughput
+        std::vector<double> m_avgTput;           //!< Average throughput during all the slots
+        std::vector<double> m_lastAvgTput;       //!< Last average throughput
+        std::vector<double> m_potentialTput;     //!< Potential throughput in one resource
+        std::vector<double> m_fairPotentialTput; //!< std::pow (potential throughput, alpha)
+        std::vector<uint32_t> m_tbSize;          //!< TBS used to compute the current throughput
+    };
+
+    /**
+     * @brief Add the entry of a new UE, with all the metrics to zero
+     * @return the index of the UE in the arrays
+     *
+     * The entries of removed UEs are reused.
+     */
+    uint32_t AddUe();
+
+    /**
+     * @brief Release the entry of a UE
+     * @param idx the index of the UE
+     */
+    void RemoveUe(uint32_t idx);
+
+    /**
+     * @brief Get the number of entries (used or free) in the arrays
+     * @return the size of the arrays
+     */
+    uint32_t GetSize() const
+    {
+        return static_cast<uint32_t>(m_dl.m_avgTput.size());
+    }
+
+    /**
+     * @brief Set the potential throughput of a UE and cache its fair value
+     * @param metrics the metrics of the direction
+     * @param idx the index of the UE
+     * @param potentialTput the potential throughput
+     * @param alpha the fairness index of the UE
+     */
+    static void SetPotentialTput(Metrics& metrics,
+                                 uint32_t idx,
+                                 double potentialTput,
+                                 double alpha);
+
+    /**
+     * @brief Get the PF metric of a UE
+     * @param metrics the metrics of the direction
+     * @param idx the index of the UE
+     * @return std::pow (potentialTput, alpha) / std::max (1E-9, avgTput)
+     */
+    static double GetPfMetric(const Metrics& metrics, uint32_t idx);
+
+    /**
+     * @brief Update the current and average throughput of one UE from its TBS
+     * @param metrics the metrics of the direction
+     * @param idx the index of the UE
+     * @param numSym the number of symbols over which the TBS is spread
+     * @param timeWindow the time window of the average
+     */
+    static void UpdateAvgTput(Metrics& metrics, uint32_t idx, uint32_t numSym, double timeWindow);
+
+    /**
+     * @brief Update the current and average throughput of several UEs from their TBS
+     * @param metrics the metrics of the direction
+     * @param ues the indexes of the UEs
+     * @param numSym the number of symbols over which the TBS are spread
+     * @param timeWindow the time window of the average
+     *
+     * The result is the same as calling the single-UE version for each UE.
+     */
+    static void UpdateAvgTput(Metrics& metrics,
+                              const std::vector<uint32_t>& ues,
+                              uint32_t numSym,
+                              double timeWindow);
+
+    Metrics m_dl; //!< DL metrics
+    Metrics m_ul; //!< UL metrics
+
+    /// Time window of the average throughput (attribute "LastAvgTPutWeight" of the scheduler)
+    double m_timeWindow{99.0};
+
+    /// Scratch list of the UEs to update in a sweep, kept to avoid allocations
+    std::vector<uint32_t> m_sweep;
+
+  private:
+    /**
+     * @brief Resize the arrays of one direction
+     * @param metrics the metrics of the direction
+     * @param size the new size
+     */
+    static void Resize(Metrics& metrics, uint32_t size);
+
+    /**
+     * @brief Zero the metrics of one UE
+     * @param metrics the metrics of the direction
+     * @param idx the index of the UE
+     */
+    static void Clear(Metrics& metrics, uint32_t idx);
+
+    std::vector<uint32_t> m_freeIdx; //!< Indexes of the removed UEs
+};
+
+} // namespace ns3
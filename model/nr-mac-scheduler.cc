@@ -142,6 +142,21 @@ class NrMacGeneralSchedSapProvider : public NrMacSchedSapProvider
         return m_scheduler->IsMaxSrsReached();
     };
 
+    bool IsParallelSchedulingSupported() const override
+    {
+        return m_scheduler->IsParallelSchedulingSupported();
+    };
+
+    void PrepareParallelTrigger() override
+    {
+        m_scheduler->PrepareParallelTrigger();
+    };
+
+    void CompleteParallelTrigger() override
+    {
+        m_scheduler->CompleteParallelTrigger();
+    };
+
   private:
     NrMacScheduler* m_scheduler{nullptr};
 };
@@ -171,4 +186,20 @@ NrMacScheduler::~NrMacScheduler()
     m_macCschedSapProvider = nullptr;
 }
 
+bool
+NrMacScheduler::IsParallelSchedulingSupported() const
+{
+    return false;
+}
+
+void
+NrMacScheduler::PrepareParallelTrigger()
+{
+}
+
+void
+NrMacScheduler::CompleteParallelTrigger()
+{
+}
+
 } // namespace ns3
@@ -248,6 +248,33 @@ class NrMacScheduler : public Object
     virtual bool IsHarqReTxEnable() const = 0;
 
     virtual bool IsMaxSrsReached() const = 0;
+
+    /**
+     * @brief Check whether the triggers can run in parallel with the ones of other cells
+     *
+     * The default implementation returns false, so that schedulers run serially unless
+     * they declare that their triggers only use objects of their own cell.
+     * @return true if the triggers can run in parallel with other cells
+     */
+    virtual bool IsParallelSchedulingSupported() const;
+
+    /**
+     * @brief Prepare the next trigger to run outside of the simulation thread
+     *
+     * The default implementation does nothing, as it is never called when
+     * IsParallelSchedulingSupported returns false.
+     * @see NrMacSchedSapProvider::PrepareParallelTrigger
+     */
+    virtual void PrepareParallelTrigger();
+
+    /**
+     * @brief Complete a trigger prepared with PrepareParallelTrigger
+     *
+     * The default implementation does nothing.
+     * @see NrMacSchedSapProvider::CompleteParallelTrigger
+     */
+    virtual void CompleteParallelTrigger();
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
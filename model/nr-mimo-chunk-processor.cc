@@ -11,15 +11,33 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("NrMimoChunkProcessor");
 
+NrMimoChunk::NrMimoChunk(MimoSinrChunk sinrChunk, MimoSignalChunk signalChunk)
+    : m_sinrChunk(std::move(sinrChunk)),
+      m_signalChunk(std::move(signalChunk))
+{
+}
+
+const MimoSinrChunk&
+NrMimoChunk::GetSinrChunk() const
+{
+    return m_sinrChunk;
+}
+
+const MimoSignalChunk&
+NrMimoChunk::GetSignalChunk() const
+{
+    return m_signalChunk;
+}
+
 void
-NrMimoChunkProcessor::AddCallback(MimoSinrChunksCb cb)
+NrMimoChunkProcessor::AddSinrCallback(MimoSinrChunksCb cb)
 {
     NS_LOG_FUNCTION(this);
     m_sinrChunksCbs.push_back(cb);
 }
 
 void
-NrMimoChunkProcessor::AddCallback(MimoSignalChunksCb cb)
+NrMimoChunkProcessor::AddSignalCallback(MimoSignalChunksCb cb)
 {
     NS_LOG_FUNCTION(this);
     m_signalChunksCbs.push_back(cb);
@@ -29,22 +47,26 @@ void
 NrMimoChunkProcessor::Start()
 {
     NS_LOG_FUNCTION(this);
-    m_mimoSinrChunks.clear();
-    m_mimoSignalChunks.clear();
+    m_mimoChunks.clear();
 }
 
 void
-NrMimoChunkProcessor::EvaluateChunk(const MimoSinrChunk& mimoSinr)
+NrMimoChunkProcessor::EvaluateChunk(Ptr<const NrMimoChunk> chunk)
 {
     NS_LOG_FUNCTION(this);
-    m_mimoSinrChunks.push_back(mimoSinr);
+    m_mimoChunks.push_back(chunk);
 }
 
-void
-NrMimoChunkProcessor::EvaluateChunk(const MimoSignalChunk& mimoSignal)
+bool
+NrMimoChunkProcessor::HasSinrCallbacks() const
 {
-    NS_LOG_FUNCTION(this);
-    m_mimoSignalChunks.push_back(mimoSignal);
+    return !m_sinrChunksCbs.empty();
+}
+
+bool
+NrMimoChunkProcessor::HasSignalCallbacks() const
+{
+    return !m_signalChunksCbs.empty();
 }
 
 void
@@ -52,15 +74,14 @@ NrMimoChunkProcessor::End()
 {
     NS_LOG_FUNCTION(this);
 
-    // Callbacks with a list of all SINR chunks seen in this slot
+    // Callbacks with all the chunks seen in this slot, shared without copying them
     for (const auto& cb : m_sinrChunksCbs)
     {
-        (cb)(m_mimoSinrChunks);
+        (cb)(m_mimoChunks);
     }
-    // Callbacks with a list of all signal chunks seen in this slot
     for (const auto& cb : m_signalChunksCbs)
     {
-        (cb)(m_mimoSignalChunks);
+        (cb)(m_mimoChunks);
     }
 }
 
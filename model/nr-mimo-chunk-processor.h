@@ -32,37 +32,67 @@ struct MimoSignalChunk
     Time dur;                    ///< Duration of the signal
 };
 
-using MimoSinrChunksCb = Callback<void, const std::vector<MimoSinrChunk>&>;
-using MimoSignalChunksCb = Callback<void, const std::vector<MimoSignalChunk>&>;
+/**
+ * @brief MIMO SINR and signal information of a received signal during one chunk.
+ *
+ * NrInterference computes it once per chunk and received signal, and passes the same
+ * instance to all its MIMO chunk processors, which keep a reference to it until the end
+ * of the reception. It is not modified after its creation.
+ */
+class NrMimoChunk : public SimpleRefCount<NrMimoChunk>
+{
+  public:
+    /// @brief Create the chunk
+    /// @param sinrChunk the MIMO SINR information
+    /// @param signalChunk the MIMO signal information
+    NrMimoChunk(MimoSinrChunk sinrChunk, MimoSignalChunk signalChunk);
+
+    /// @return the MIMO SINR information
+    const MimoSinrChunk& GetSinrChunk() const;
+
+    /// @return the MIMO signal information
+    const MimoSignalChunk& GetSignalChunk() const;
+
+  private:
+    MimoSinrChunk m_sinrChunk;     ///< The MIMO SINR information
+    MimoSignalChunk m_signalChunk; ///< The MIMO signal information
+};
+
+/// @brief The MIMO chunks of a reception, shared among the chunk processors and their callbacks
+using NrMimoChunks = std::vector<Ptr<const NrMimoChunk>>;
+
+using MimoSinrChunksCb = Callback<void, const NrMimoChunks&>;
+using MimoSignalChunksCb = Callback<void, const NrMimoChunks&>;
 
 class NrMimoChunkProcessor : public SimpleRefCount<NrMimoChunkProcessor>
 {
   public:
     /// @brief Add a callback for processing received SINR values
-    /// @param cb the callback function
-    void AddCallback(MimoSinrChunksCb cb);
+    /// @param cb the callback function, which reads the SINR information of the chunks
+    void AddSinrCallback(MimoSinrChunksCb cb);
 
     /// @brief Add a callback for processing the MIMO signal parameters
-    /// @param cb the callback function
-    void AddCallback(MimoSignalChunksCb cb);
+    /// @param cb the callback function, which reads the signal information of the chunks
+    void AddSignalCallback(MimoSignalChunksCb cb);
 
     /// @brief Start processing a transmission, clear internal variables
     void Start();
 
-    /// @brief Store the current MIMO SINR and duration
-    /// @param mimoSinr the MIMO SINR information
-    void EvaluateChunk(const MimoSinrChunk& mimoSinr);
+    /// @brief Store a reference to the MIMO information of the current chunk
+    /// @param chunk the MIMO SINR and signal information, shared with other chunk processors
+    void EvaluateChunk(Ptr<const NrMimoChunk> chunk);
+
+    /// @return whether a callback for SINR values was added
+    bool HasSinrCallbacks() const;
 
-    /// @brief Store the current MIMO signal parameters
-    /// @param mimoSignal the signal parameters including channel and interference covariance matrix
-    void EvaluateChunk(const MimoSignalChunk& mimoSignal);
+    /// @return whether a callback for MIMO signal parameters was added
+    bool HasSignalCallbacks() const;
 
     /// @brief Finish calculation and inform interested objects about calculated values
     void End();
 
   private:
-    std::vector<MimoSinrChunk> m_mimoSinrChunks;     ///< The MIMO SINR values seen in this TTI
-    std::vector<MimoSignalChunk> m_mimoSignalChunks; ///< The MIMO signal values seen in this TTI
+    NrMimoChunks m_mimoChunks; ///< The MIMO chunks seen in this TTI
 
     std::vector<MimoSinrChunksCb> m_sinrChunksCbs;     ///< The callbacks for SINR values
     std::vector<MimoSignalChunksCb> m_signalChunksCbs; ///< The callbacks for signal values
@@ -4,8 +4,12 @@
 
 #include "nr-mimo-matrices.h"
 
+#include "nr-mimo-thread-pool.h"
+
 #include "ns3/matrix-array.h"
 
+#include <type_traits>
+
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunknown-pragmas"
@@ -34,25 +38,246 @@ using EigenMatrix = Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>
 template <class T>
 using ConstEigenMatrix = Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>;
 
+/// @brief Call a function with the matrix dimension n as a compile-time constant.
+/// Port and rank dimensions in NR are 1, 2, 4 or 8, for which the Eigen matrices can have a
+/// fixed size and live on the stack. Any other dimension is passed as Eigen::Dynamic.
+/// @param n the matrix dimension
+/// @param f the function, called with a std::integral_constant<int, dim>
+template <class F>
+void
+DispatchFixedDim(size_t n, F&& f)
+{
+    switch (n)
+    {
+    case 1:
+        f(std::integral_constant<int, 1>{});
+        break;
+    case 2:
+        f(std::integral_constant<int, 2>{});
+        break;
+    case 4:
+        f(std::integral_constant<int, 4>{});
+        break;
+    case 8:
+        f(std::integral_constant<int, 8>{});
+        break;
+    default:
+        f(std::integral_constant<int, Eigen::Dynamic>{});
+    }
+}
+
+/// @brief Call a function with the scalar type of the MIMO computations, std::complex<float> if
+/// NrMimoUseSinglePrecision() is true, and std::complex<double> otherwise.
+/// @param f the function, called with a value of the scalar type
+template <class F>
+void
+DispatchPrecision(F&& f)
+{
+    if (NrMimoUseSinglePrecision())
+    {
+        f(std::complex<float>{});
+    }
+    else
+    {
+        f(std::complex<double>{});
+    }
+}
+
+/// @brief Compute inv(L) * chanMat for each page, where L is the Cholesky decomposition of
+/// the covariance matrix of that page. The pages are split among the NrMimoThreadPool threads.
+/// @tparam T the scalar type of the computations, the input and output are in double precision
+/// @tparam R the number of rows of chanMat (RX ports), or Eigen::Dynamic
+/// @tparam C the number of columns of chanMat (TX ports), or Eigen::Dynamic
+/// @param covMat the interference-and-noise covariance matrices (dim: nRxPorts * nRxPorts * nRbs)
+/// @param chanMat the channel matrices (dim: nRxPorts * nTxPorts * nRbs)
+/// @param res the interference-normalized channel matrices, with the dimensions of chanMat
+template <class T, int R, int C>
+void
+CalcIntfNormChannelPages(const ComplexMatrixArray& covMat,
+                         const ComplexMatrixArray& chanMat,
+                         ComplexMatrixArray& res)
+{
+    using CovMatrix = Eigen::Matrix<std::complex<double>, R, R>;
+    using ChanMatrix = Eigen::Matrix<std::complex<double>, R, C>;
+    auto nRows = chanMat.GetNumRows();
+    auto nCols = chanMat.GetNumCols();
+    NrMimoThreadPool::ParallelFor(chanMat.GetNumPages(), [&](size_t begin, size_t end) {
+        Eigen::LLT<Eigen::Matrix<T, R, R>, Eigen::Upper> llt(nRows);
+        for (size_t iRb = begin; iRb < end; iRb++)
+        {
+            Eigen::Map<const CovMatrix> covMatEigen(covMat.GetPagePtr(iRb), nRows, nRows);
+            Eigen::Map<const ChanMatrix> chanMatEigen(chanMat.GetPagePtr(iRb), nRows, nCols);
+            Eigen::Map<ChanMatrix> resEigen(res.GetPagePtr(iRb), nRows, nCols);
+            llt.compute(covMatEigen.template cast<T>());
+            if constexpr (std::is_same_v<T, std::complex<double>>)
+            {
+                resEigen = llt.matrixL().solve(chanMatEigen);
+            }
+            else
+            {
+                Eigen::Matrix<T, R, C> resT = llt.matrixL().solve(chanMatEigen.template cast<T>());
+                resEigen = resT.template cast<std::complex<double>>();
+            }
+        }
+    });
+}
+
+/// @brief Compute the MSE matrix inv(I + chanPrec' * chanPrec) of an MMSE receiver for each
+/// page, where chanPrec = chanMat * precMats, and pass it to a function that stores the required
+/// values. The pages are split among the NrMimoThreadPool threads.
+/// @tparam T the scalar type of the computations, the input is in double precision
+/// @tparam R the number of rows of chanMat (RX ports), or Eigen::Dynamic
+/// @tparam N the number of columns of precMats (rank), or Eigen::Dynamic
+/// @param chanMat the interference-normalized channel (dim: nRxPorts * nTxPorts * nRbs)
+/// @param precMats the precoding matrices (dim: nTxPorts * rank * nRbs), or a single precoding
+/// matrix (dim: nTxPorts * rank * 1) that is applied to all pages
+/// @param storeMse the function called with the page index and the MSE matrix of the page
+template <class T, int R, int N, class F>
+void
+ComputeMsePages(const ComplexMatrixArray& chanMat, const ComplexMatrixArray& precMats, F&& storeMse)
+{
+    using SquareMatrix = Eigen::Matrix<T, N, N>;
+    using ChanMatrix = Eigen::Matrix<std::complex<double>, R, Eigen::Dynamic>;
+    using PrecMatrix = Eigen::Matrix<std::complex<double>, Eigen::Dynamic, N>;
+    using ChanPrecMatrix = Eigen::Matrix<T, R, N>;
+    auto nRows = chanMat.GetNumRows();
+    auto nCols = chanMat.GetNumCols();
+    auto nDims = precMats.GetNumCols();
+    NS_ASSERT_MSG(precMats.GetNumRows() == nCols, "Precoding and channel dimensions mismatch");
+    NS_ASSERT_MSG(precMats.GetNumPages() == chanMat.GetNumPages() || precMats.GetNumPages() == 1,
+                  "Precoding and channel dimensions mismatch");
+    auto broadcastPrec = precMats.GetNumPages() != chanMat.GetNumPages();
+    NrMimoThreadPool::ParallelFor(chanMat.GetNumPages(), [&](size_t begin, size_t end) {
+        const SquareMatrix identity = SquareMatrix::Identity(nDims, nDims);
+        ChanPrecMatrix chanPrec;
+        SquareMatrix temp;
+        SquareMatrix mse;
+        chanPrec.resize(nRows, nDims);
+        temp.resize(nDims, nDims);
+        mse.resize(nDims, nDims);
+        Eigen::LLT<SquareMatrix, Eigen::Lower> llt(nDims);
+        for (size_t iRb = begin; iRb < end; iRb++)
+        {
+            Eigen::Map<const ChanMatrix> chanEigen(chanMat.GetPagePtr(iRb), nRows, nCols);
+            Eigen::Map<const PrecMatrix> precEigen(precMats.GetPagePtr(broadcastPrec ? 0 : iRb),
+                                                   nCols,
+                                                   nDims);
+            chanPrec.noalias() = chanEigen.template cast<T>() * precEigen.template cast<T>();
+            temp.noalias() = chanPrec.adjoint() * chanPrec;
+            temp += identity;
+            llt.compute(temp);
+            mse = llt.solve(identity);
+            storeMse(iRb, mse);
+        }
+    });
+}
+
+/// @brief Compute the Shannon capacity of an MMSE receiver for several precoding matrices in
+/// each page. The candidate precoding matrices are stacked side by side, so that the channel is
+/// multiplied by all of them at once, and the MSE matrix of each candidate is computed from the
+/// corresponding columns of the product. The pages are split among the NrMimoThreadPool threads.
+/// @tparam T the scalar type of the computations, the input is in double precision
+/// @tparam R the number of rows of chanMat (RX ports), or Eigen::Dynamic
+/// @tparam N the number of columns of the precoding matrices (rank), or Eigen::Dynamic
+/// @param chanMat the interference-normalized channel (dim: nRxPorts * nTxPorts * nRbs)
+/// @param precMats the candidate precoding matrices (dim: nTxPorts * rank * nRbs, or
+/// nTxPorts * rank * 1 to apply the same matrix to all pages)
+/// @param res the capacity for each page and candidate (dim: nRbs x precMats.size())
+template <class T, int R, int N>
+void
+ComputeCapacityPages(const ComplexMatrixArray& chanMat,
+                     const std::vector<ComplexMatrixArray>& precMats,
+                     DoubleMatrixArray& res)
+{
+    using SquareMatrix = Eigen::Matrix<T, N, N>;
+    using ChanMatrix = Eigen::Matrix<std::complex<double>, R, Eigen::Dynamic>;
+    using StackedMatrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+    using ChanPrecMatrix = Eigen::Matrix<T, R, Eigen::Dynamic>;
+    auto nRows = chanMat.GetNumRows();
+    auto nCols = chanMat.GetNumCols();
+    auto nPages = chanMat.GetNumPages();
+    auto nDims = precMats[0].GetNumCols();
+    auto numPrec = precMats.size();
+    auto samePrecForAllPages = true;
+    for (const auto& precMat : precMats)
+    {
+        NS_ASSERT_MSG(precMat.GetNumRows() == nCols && precMat.GetNumCols() == nDims,
+                      "Precoding and channel dimensions mismatch");
+        NS_ASSERT_MSG(precMat.GetNumPages() == nPages || precMat.GetNumPages() == 1,
+                      "Precoding and channel dimensions mismatch");
+        samePrecForAllPages = samePrecForAllPages && (precMat.GetNumPages() == 1);
+    }
+
+    // Stack the precoding matrices of a page: [W_0, W_1, ...] (dim: nTxPorts * numPrec.rank)
+    auto stackPrecoders = [&](size_t iRb, StackedMatrix& stacked) {
+        stacked.resize(nCols, numPrec * nDims);
+        for (size_t k = 0; k < numPrec; k++)
+        {
+            auto page = (precMats[k].GetNumPages() == 1) ? 0 : iRb;
+            ConstEigenMatrix<std::complex<double>> precEigen(precMats[k].GetPagePtr(page),
+                                                             nCols,
+                                                             nDims);
+            stacked.middleCols(k * nDims, nDims) = precEigen.template cast<T>();
+        }
+    };
+    StackedMatrix sharedStacked;
+    if (samePrecForAllPages)
+    {
+        stackPrecoders(0, sharedStacked);
+    }
+
+    NrMimoThreadPool::ParallelFor(nPages, [&](size_t begin, size_t end) {
+        const SquareMatrix identity = SquareMatrix::Identity(nDims, nDims);
+        StackedMatrix pageStacked;
+        ChanPrecMatrix chanPrec;
+        SquareMatrix temp;
+        SquareMatrix mse;
+        chanPrec.resize(nRows, numPrec * nDims);
+        temp.resize(nDims, nDims);
+        mse.resize(nDims, nDims);
+        Eigen::LLT<SquareMatrix, Eigen::Lower> llt(nDims);
+        for (size_t iRb = begin; iRb < end; iRb++)
+        {
+            if (!samePrecForAllPages)
+            {
+                stackPrecoders(iRb, pageStacked);
+            }
+            const auto& stacked = samePrecForAllPages ? sharedStacked : pageStacked;
+            Eigen::Map<const ChanMatrix> chanEigen(chanMat.GetPagePtr(iRb), nRows, nCols);
+            chanPrec.noalias() = chanEigen.template cast<T>() * stacked;
+            for (size_t k = 0; k < numPrec; k++)
+            {
+                const auto block = chanPrec.middleCols(k * nDims, nDims);
+                temp.noalias() = block.adjoint() * block;
+                temp += identity;
+                llt.compute(temp);
+                mse = llt.solve(identity);
+                double cap = 0.0;
+                for (size_t layer = 0; layer < nDims; layer++)
+                {
+                    auto sinr = 1.0 / std::real(mse(layer, layer)) - 1.0;
+                    cap += std::log2(1.0 + sinr);
+                }
+                res(iRb, k) = cap;
+            }
+        }
+    });
+}
+
 NrIntfNormChanMat
 NrCovMat::CalcIntfNormChannelMimo(const ComplexMatrixArray& chanMat) const
 {
     auto res = NrIntfNormChanMat{
         ComplexMatrixArray{chanMat.GetNumRows(), chanMat.GetNumCols(), chanMat.GetNumPages()}};
-    for (size_t iRb = 0; iRb < chanMat.GetNumPages(); iRb++)
-    {
-        ConstEigenMatrix<std::complex<double>> covMatEigen(GetPagePtr(iRb),
-                                                           GetNumRows(),
-                                                           GetNumCols());
-        ConstEigenMatrix<std::complex<double>> chanMatEigen(chanMat.GetPagePtr(iRb),
-                                                            chanMat.GetNumRows(),
-                                                            chanMat.GetNumCols());
-        EigenMatrix<std::complex<double>> resEigen(res.GetPagePtr(iRb),
-                                                   res.GetNumRows(),
-                                                   res.GetNumCols());
-        auto covMat = covMatEigen.selfadjointView<Eigen::Upper>();
-        resEigen = covMat.llt().matrixL().solve(chanMatEigen);
-    }
+    DispatchPrecision([&](auto scalar) {
+        DispatchFixedDim(chanMat.GetNumRows(), [&](auto rows) {
+            DispatchFixedDim(chanMat.GetNumCols(), [&](auto cols) {
+                CalcIntfNormChannelPages<decltype(scalar),
+                                         decltype(rows)::value,
+                                         decltype(cols)::value>(*this, chanMat, res);
+            });
+        });
+    });
     return res;
 }
 
@@ -60,21 +285,64 @@ ComplexMatrixArray
 NrIntfNormChanMat::ComputeMseMimo(const ComplexMatrixArray& precMats) const
 {
     auto nDims = precMats.GetNumCols();
-    auto identity = Eigen::MatrixXcd::Identity(nDims, nDims);
-    auto res = ComplexMatrixArray{nDims, nDims, precMats.GetNumPages()};
-    auto chanPrec = (*this) * precMats;
-    auto chanCov = chanPrec.HermitianTranspose() * chanPrec;
-    for (size_t iRb = 0; iRb < res.GetNumPages(); iRb++)
-    {
-        ConstEigenMatrix<std::complex<double>> chanCovEigen(chanCov.GetPagePtr(iRb),
-                                                            chanCov.GetNumRows(),
-                                                            chanCov.GetNumCols());
-        EigenMatrix<std::complex<double>> resEigen(res.GetPagePtr(iRb),
-                                                   res.GetNumRows(),
-                                                   res.GetNumCols());
-        Eigen::MatrixXcd temp = chanCovEigen + identity;
-        resEigen = temp.selfadjointView<Eigen::Lower>().llt().solve(identity);
-    }
+    auto res = ComplexMatrixArray{nDims, nDims, GetNumPages()};
+    DispatchPrecision([&](auto scalar) {
+        DispatchFixedDim(GetNumRows(), [&](auto rows) {
+            DispatchFixedDim(nDims, [&](auto dims) {
+                ComputeMsePages<decltype(scalar), decltype(rows)::value, decltype(dims)::value>(
+                    *this,
+                    precMats,
+                    [&res, nDims](size_t iRb, const auto& mse) {
+                        EigenMatrix<std::complex<double>> resEigen(res.GetPagePtr(iRb),
+                                                                   nDims,
+                                                                   nDims);
+                        resEigen = mse.template cast<std::complex<double>>();
+                    });
+            });
+        });
+    });
+    return res;
+}
+
+NrSinrMatrix
+NrIntfNormChanMat::ComputeSinrForPrecodingMimo(const ComplexMatrixArray& precMats) const
+{
+    // Only the diagonal of the MSE matrices is needed, so they are not stored
+    auto rank = precMats.GetNumCols();
+    auto res = DoubleMatrixArray{rank, GetNumPages()};
+    DispatchPrecision([&](auto scalar) {
+        DispatchFixedDim(GetNumRows(), [&](auto rows) {
+            DispatchFixedDim(rank, [&](auto dims) {
+                ComputeMsePages<decltype(scalar), decltype(rows)::value, decltype(dims)::value>(
+                    *this,
+                    precMats,
+                    [&res, rank](size_t iRb, const auto& mse) {
+                        for (size_t layer = 0; layer < rank; layer++)
+                        {
+                            res(layer, iRb) = 1.0 / std::real(mse(layer, layer)) - 1.0;
+                        }
+                    });
+            });
+        });
+    });
+    return NrSinrMatrix{res};
+}
+
+DoubleMatrixArray
+NrIntfNormChanMat::ComputeCapacityForPrecodersMimo(
+    const std::vector<ComplexMatrixArray>& precMats) const
+{
+    auto rank = precMats[0].GetNumCols();
+    auto res = DoubleMatrixArray{GetNumPages(), precMats.size()};
+    DispatchPrecision([&](auto scalar) {
+        DispatchFixedDim(GetNumRows(), [&](auto rows) {
+            DispatchFixedDim(rank, [&](auto dims) {
+                ComputeCapacityPages<decltype(scalar),
+                                     decltype(rows)::value,
+                                     decltype(dims)::value>(*this, precMats, res);
+            });
+        });
+    });
     return res;
 }
 
@@ -83,21 +351,23 @@ NrIntfNormChanMat::GetSasaokaWidebandRank() const
 {
     // Extract eigenvalues for each subband
     std::vector<std::vector<double>> subbandRankEigenval(m_numPages);
-    for (std::size_t subband = 0; subband < m_numPages; subband++)
-    {
-        ConstEigenMatrix<std::complex<double>> HEigen(this->GetPagePtr(subband),
-                                                      this->GetNumRows(),
-                                                      this->GetNumCols());
-        auto eigenvalues = HEigen.eigenvalues();
-
-        // Store them in descending order
-        subbandRankEigenval[subband].resize(eigenvalues.size());
-        for (int64_t i = 0; i < eigenvalues.size(); i++)
+    NrMimoThreadPool::ParallelFor(m_numPages, [&](size_t begin, size_t end) {
+        for (std::size_t subband = begin; subband < end; subband++)
         {
-            subbandRankEigenval[subband][i] =
-                std::abs(eigenvalues.coeff(eigenvalues.size() - i - 1));
+            ConstEigenMatrix<std::complex<double>> HEigen(this->GetPagePtr(subband),
+                                                          this->GetNumRows(),
+                                                          this->GetNumCols());
+            auto eigenvalues = HEigen.eigenvalues();
+
+            // Store them in descending order
+            subbandRankEigenval[subband].resize(eigenvalues.size());
+            for (int64_t i = 0; i < eigenvalues.size(); i++)
+            {
+                subbandRankEigenval[subband][i] =
+                    std::abs(eigenvalues.coeff(eigenvalues.size() - i - 1));
+            }
         }
-    }
+    });
     // Calculate capacity increment for each rank
     int minDim = std::min(m_numCols, m_numRows);
     std::vector<double> rankCapacityIncrease(minDim);
@@ -176,19 +446,21 @@ NrIntfNormChanMat::GetEigenWidebandRank(double thr) const
 std::vector<uint8_t>
 NrIntfNormChanMat::GetEigenSubbandRanks(double thr) const
 {
-    std::vector<uint8_t> ranks;
-    for (size_t iRb = 0; iRb < this->GetNumPages(); iRb++)
-    {
-        // Compute the rank via SVD decomposition
-        ConstEigenMatrix<std::complex<double>> HEigen(this->GetPagePtr(iRb),
-                                                      this->GetNumRows(),
-                                                      this->GetNumCols());
-        auto svd = HEigen.jacobiSvd();
-
-        // Set value threshold to limit rank search
-        svd.setThreshold(thr);
-        ranks.push_back(svd.rank());
-    }
+    std::vector<uint8_t> ranks(this->GetNumPages());
+    NrMimoThreadPool::ParallelFor(this->GetNumPages(), [&](size_t begin, size_t end) {
+        for (size_t iRb = begin; iRb < end; iRb++)
+        {
+            // Compute the rank via SVD decomposition
+            ConstEigenMatrix<std::complex<double>> HEigen(this->GetPagePtr(iRb),
+                                                          this->GetNumRows(),
+                                                          this->GetNumCols());
+            auto svd = HEigen.jacobiSvd();
+
+            // Set value threshold to limit rank search
+            svd.setThreshold(thr);
+            ranks[iRb] = svd.rank();
+        }
+    });
     return ranks;
 }
 
@@ -197,23 +469,82 @@ NrIntfNormChanMat::ExtractOptimalPrecodingMatrices(uint8_t rank) const
 {
     NS_ASSERT_MSG(rank > 0, "Rank should be greater than 0");
     ComplexMatrixArray optPrecoders(this->GetNumRows(), rank, this->GetNumPages());
-    for (size_t iRb = 0; iRb < m_numPages; iRb++)
-    {
-        ConstEigenMatrix<std::complex<double>> H(this->GetPagePtr(iRb),
-                                                 this->GetNumRows(),
-                                                 this->GetNumCols());
+    NrMimoThreadPool::ParallelFor(m_numPages, [&](size_t begin, size_t end) {
+        for (size_t iRb = begin; iRb < end; iRb++)
+        {
+            ConstEigenMatrix<std::complex<double>> H(this->GetPagePtr(iRb),
+                                                     this->GetNumRows(),
+                                                     this->GetNumCols());
 
-        auto svd = H.jacobiSvd(Eigen::ComputeFullV);
-        auto V = svd.matrixV();
-        for (size_t i = 0; i < m_numRows; i++)
+            auto svd = H.jacobiSvd(Eigen::ComputeFullV);
+            auto V = svd.matrixV();
+            for (size_t i = 0; i < m_numRows; i++)
+            {
+                for (size_t j = 0; j < rank; j++)
+                {
+                    optPrecoders(i, j, iRb) = V(i, j);
+                }
+            }
+        }
+    });
+    return optPrecoders;
+}
+
+ComplexMatrixArray
+NrIntfNormChanMat::ComputeHosvdFactor(size_t mode, double tolerance) const
+{
+    NS_ASSERT_MSG(mode < 3, "The channel tensor has only 3 modes");
+    // The left singular vectors of the mode-n unfolding X_(n) are the eigenvectors of its Gram
+    // matrix X_(n) * X_(n)', which is computed from the pages without forming the unfolding
+    Eigen::MatrixXcd gram;
+    if (mode == 2)
+    {
+        // Each row of the unfolding is a vectorized page
+        ConstEigenMatrix<std::complex<double>> pages(this->GetPagePtr(0),
+                                                     m_numRows * m_numCols,
+                                                     m_numPages);
+        gram = (pages.adjoint() * pages).transpose();
+    }
+    else
+    {
+        auto size = (mode == 0) ? m_numRows : m_numCols;
+        gram = Eigen::MatrixXcd::Zero(size, size);
+        for (size_t iRb = 0; iRb < m_numPages; iRb++)
         {
-            for (size_t j = 0; j < rank; j++)
+            ConstEigenMatrix<std::complex<double>> H(this->GetPagePtr(iRb), m_numRows, m_numCols);
+            if (mode == 0)
             {
-                optPrecoders(i, j, iRb) = V(i, j);
+                gram.noalias() += H * H.adjoint();
+            }
+            else
+            {
+                gram.noalias() += (H.adjoint() * H).transpose();
             }
         }
     }
-    return optPrecoders;
+
+    // The eigenvalues are the squared singular values, in ascending order
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> eigenSolver(gram);
+    const auto& eigenvalues = eigenSolver.eigenvalues();
+    auto size = static_cast<size_t>(eigenvalues.size());
+    auto maxDiscarded = tolerance * tolerance * eigenvalues.sum() / 3;
+    auto rank = size;
+    auto discarded = 0.0;
+    while (rank > 1 && discarded + eigenvalues(size - rank) <= maxDiscarded)
+    {
+        discarded += eigenvalues(size - rank);
+        rank--;
+    }
+
+    ComplexMatrixArray factor(size, rank);
+    for (size_t i = 0; i < size; i++)
+    {
+        for (size_t j = 0; j < rank; j++)
+        {
+            factor(i, j) = eigenSolver.eigenvectors()(i, size - 1 - j);
+        }
+    }
+    return factor;
 }
 
 } // namespace ns3
@@ -21,6 +21,20 @@ NrIntfNormChanMat::ComputeMseMimo([[maybe_unused]] const ComplexMatrixArray& pre
     NS_FATAL_ERROR("MIMO MSE computation requires Eigen matrix library.");
 }
 
+NrSinrMatrix
+NrIntfNormChanMat::ComputeSinrForPrecodingMimo(
+    [[maybe_unused]] const ComplexMatrixArray& precMats) const
+{
+    NS_FATAL_ERROR("MIMO SINR computation requires Eigen matrix library.");
+}
+
+DoubleMatrixArray
+NrIntfNormChanMat::ComputeCapacityForPrecodersMimo(
+    [[maybe_unused]] const std::vector<ComplexMatrixArray>& precMats) const
+{
+    NS_FATAL_ERROR("MIMO capacity computation requires Eigen matrix library.");
+}
+
 uint8_t
 NrIntfNormChanMat::GetSasaokaWidebandRank() const
 {
@@ -51,4 +65,11 @@ NrIntfNormChanMat::ExtractOptimalPrecodingMatrices(uint8_t rank) const
     NS_FATAL_ERROR("GetEigenRank requires Eigen matrix library.");
 }
 
+ComplexMatrixArray
+NrIntfNormChanMat::ComputeHosvdFactor([[maybe_unused]] size_t mode,
+                                      [[maybe_unused]] double tolerance) const
+{
+    NS_FATAL_ERROR("ComputeHosvdFactor requires Eigen matrix library.");
+}
+
 } // namespace ns3
@@ -4,9 +4,31 @@
 
 #include "nr-mimo-matrices.h"
 
+#include "ns3/boolean.h"
+#include "ns3/global-value.h"
+
+#include <mutex>
+#include <unordered_map>
+
 namespace ns3
 {
 
+/// Whether the per-RB MIMO computations use single precision
+static GlobalValue g_nrMimoSinglePrecision(
+    "NrMimoSinglePrecision",
+    "If true, the MIMO interference whitening, MSE and SINR computations run in single precision "
+    "(std::complex<float>), which is faster but less accurate. Requires Eigen.",
+    BooleanValue(false),
+    MakeBooleanChecker());
+
+bool
+NrMimoUseSinglePrecision()
+{
+    BooleanValue singlePrecision;
+    g_nrMimoSinglePrecision.GetValue(singlePrecision);
+    return singlePrecision.Get();
+}
+
 void
 NrCovMat::AddInterferenceSignal(const ComplexMatrixArray& rhs)
 {
@@ -44,6 +66,11 @@ NrCovMat::CalcIntfNormChannel(const ComplexMatrixArray& chanMat) const
 NrSinrMatrix
 NrIntfNormChanMat::ComputeSinrForPrecoding(const ComplexMatrixArray& precMats) const
 {
+    if ((GetNumRows() != 1) || (GetNumCols() != 1)) // MIMO
+    {
+        return ComputeSinrForPrecodingMimo(precMats);
+    }
+
     auto mseMat = ComputeMse(precMats);
 
     // Compute the SINR values from the diagonal elements of the mseMat.
@@ -60,6 +87,28 @@ NrIntfNormChanMat::ComputeSinrForPrecoding(const ComplexMatrixArray& precMats) c
     return NrSinrMatrix{res};
 }
 
+DoubleMatrixArray
+NrIntfNormChanMat::ComputeCapacityForPrecoders(
+    const std::vector<ComplexMatrixArray>& precMats) const
+{
+    NS_ASSERT_MSG(!precMats.empty(), "No precoding matrix to evaluate");
+    if ((GetNumRows() != 1) || (GetNumCols() != 1)) // MIMO
+    {
+        return ComputeCapacityForPrecodersMimo(precMats);
+    }
+
+    auto res = DoubleMatrixArray{GetNumPages(), precMats.size()};
+    for (size_t k = 0; k < precMats.size(); k++)
+    {
+        auto sinr = ComputeSinrForPrecoding(precMats[k]);
+        for (size_t iRb = 0; iRb < GetNumPages(); iRb++)
+        {
+            res(iRb, k) = std::log2(1.0 + sinr(0, iRb));
+        }
+    }
+    return res;
+}
+
 ComplexMatrixArray
 NrIntfNormChanMat::ComputeMse(const ComplexMatrixArray& precMats) const
 {
@@ -68,7 +117,10 @@ NrIntfNormChanMat::ComputeMse(const ComplexMatrixArray& precMats) const
     if ((GetNumRows() == 1) && (GetNumCols() == 1)) // SISO
     {
         auto res = ComplexMatrixArray{1, 1, GetNumPages()};
-        auto chanPrec = (*this) * precMats;
+        // A single precoding matrix is applied to all RBs
+        auto chanPrec = (precMats.GetNumPages() == GetNumPages())
+                            ? ComplexMatrixArray{(*this) * precMats}
+                            : ComplexMatrixArray{(*this) * precMats.MakeNCopies(GetNumPages())};
         for (size_t iRb = 0; iRb < GetNumPages(); iRb++)
         {
             res(0, 0, iRb) = 1.0 / (1.0 + std::norm(chanPrec.Elem(0, 0, iRb)));
@@ -115,9 +167,7 @@ SpectrumValue
 NrSinrMatrix::GetVectorizedSpecVal() const
 {
     // Convert the 2D SINR matrix into a one-dimensional SpectrumValue
-    auto bands = std::vector<BandInfo>(GetNumRows() * GetNumCols());
-    auto specModel = Create<SpectrumModel>(bands);
-    auto vectorizedSinr = SpectrumValue{specModel};
+    auto vectorizedSinr = SpectrumValue{GetVectorizedSpectrumModel(GetSize())};
     auto idx = size_t{0};
     for (auto it = vectorizedSinr.ValuesBegin(); it != vectorizedSinr.ValuesEnd(); it++)
     {
@@ -127,4 +177,28 @@ NrSinrMatrix::GetVectorizedSpecVal() const
     }
     return vectorizedSinr;
 }
+
+std::span<const double>
+NrSinrMatrix::GetVectorizedValues() const
+{
+    return {std::begin(m_values), GetSize()};
+}
+
+Ptr<const SpectrumModel>
+NrSinrMatrix::GetVectorizedSpectrumModel(size_t numValues)
+{
+    // The vectorized values have no frequency meaning, so a single model per size is enough.
+    // The cache (and the reference count of the cached models) is protected by a lock, as
+    // the error models may be used from several threads.
+    static std::mutex mutex;
+    static std::unordered_map<size_t, Ptr<const SpectrumModel>> models;
+
+    std::lock_guard lock(mutex);
+    auto& model = models[numValues];
+    if (!model)
+    {
+        model = Create<SpectrumModel>(std::vector<BandInfo>(numValues));
+    }
+    return model;
+}
 } // namespace ns3
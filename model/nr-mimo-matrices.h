@@ -8,12 +8,21 @@
 #include "ns3/matrix-array.h"
 #include "ns3/spectrum-value.h"
 
+#include <span>
+
 namespace ns3
 {
 
 class NrIntfNormChanMat;
 class NrSinrMatrix;
 
+/// @ingroup Matrices
+/// @brief Check whether the MIMO interference whitening, MSE and SINR computations run in single
+/// precision (std::complex<float>), as configured with the global value "NrMimoSinglePrecision".
+/// The matrices are stored in double precision in both cases.
+/// @return true if the computations use single precision
+bool NrMimoUseSinglePrecision();
+
 /// @ingroup Matrices
 /// NrCovMat stores the interference-plus-noise covariance matrices of a MIMO signal, with one
 /// matrix page for each frequency bin. Operations for efficient computation, addition, and
@@ -68,10 +77,21 @@ class NrIntfNormChanMat : public ComplexMatrixArray
         : ComplexMatrixArray(arr) {};
 
     /// @brief Compute the MIMO SINR when a specific precoder is applied.
-    /// @param precMats the precoding matrices (dim: nTxPorts * rank * nRbs)
+    /// @param precMats the precoding matrices (dim: nTxPorts * rank * nRbs), or a single
+    /// precoding matrix (dim: nTxPorts * rank * 1) that is applied to all RBs
     /// @returns the SINR values for each layer and RB (dim: rank x nRbs)
     virtual NrSinrMatrix ComputeSinrForPrecoding(const ComplexMatrixArray& precMats) const;
 
+    /// @brief Compute the Shannon capacity of an MMSE receiver for several candidate precoders.
+    /// The result is the same as computing the SINR of each candidate separately, but the
+    /// candidates are evaluated together in a single pass over the RBs.
+    /// @param precMats the candidate precoding matrices, all with the same rank (dim: nTxPorts
+    /// * rank * nRbs, or nTxPorts * rank * 1 to apply the same matrix to all RBs)
+    /// @returns the sum over the layers of log2(1 + SINR), for each RB and candidate
+    /// (dim: nRbs x precMats.size())
+    virtual DoubleMatrixArray ComputeCapacityForPrecoders(
+        const std::vector<ComplexMatrixArray>& precMats) const;
+
     /**
      *  @brief Compute the average received signal parameters (channel and interference matrix)
      *  between the different channel subbands.
@@ -104,6 +124,17 @@ class NrIntfNormChanMat : public ComplexMatrixArray
     /// @brief ExtractOptimalPrecodingMatrices extracts optimal precoding matrices for a given rank
     virtual ComplexMatrixArray ExtractOptimalPrecodingMatrices(uint8_t rank) const;
 
+    /// @brief Compute a factor matrix of the truncated higher-order SVD (HOSVD) of the channel,
+    /// seen as a nRows x nCols x nRbs tensor. The factor matrix of a mode holds the leading left
+    /// singular vectors of the mode-n unfolding of the tensor. As in the hosvd of the Tensor
+    /// Toolbox, the singular vectors are kept until the discarded squared singular values sum
+    /// less than tolerance^2 * ||H||^2 / 3.
+    /// @param mode the mode of the tensor (0: rows, 1: columns, 2: RBs)
+    /// @param tolerance the relative error tolerance of the decomposition
+    /// @return the factor matrix, with the singular vectors in descending order of singular value
+    /// (dim: size of the mode x number of kept singular vectors)
+    virtual ComplexMatrixArray ComputeHosvdFactor(size_t mode, double tolerance) const;
+
   private:
     /// @brief Compute the MSE (mean square error) for an MMSE receiver, for SISO and MIMO.
     /// @param precMats the precoding matrices (dim: nTxPorts * rank * nRbs)
@@ -115,6 +146,19 @@ class NrIntfNormChanMat : public ComplexMatrixArray
     /// @param precMats the precoding matrices (dim: nTxPorts * rank * nRbs)
     /// @returns the MSE matrix as inv(I + precMats' * this' * this * precMats).
     virtual ComplexMatrixArray ComputeMseMimo(const ComplexMatrixArray& precMats) const;
+
+    /// @brief Compute the SINR of a MIMO MMSE receiver, from the diagonal of its MSE matrix
+    /// When the simulation is SISO only, this method will not be called.
+    /// @param precMats the precoding matrices (dim: nTxPorts * rank * nRbs)
+    /// @returns the SINR values for each layer and RB (dim: rank x nRbs)
+    virtual NrSinrMatrix ComputeSinrForPrecodingMimo(const ComplexMatrixArray& precMats) const;
+
+    /// @brief Compute the Shannon capacity of a MIMO MMSE receiver for several candidate precoders
+    /// When the simulation is SISO only, this method will not be called.
+    /// @param precMats the candidate precoding matrices
+    /// @returns the capacity for each RB and candidate (dim: nRbs x precMats.size())
+    virtual DoubleMatrixArray ComputeCapacityForPrecodersMimo(
+        const std::vector<ComplexMatrixArray>& precMats) const;
 };
 
 /// @brief NrSinrMatrix stores the MIMO SINR matrix, with dimension rank x nRbs
@@ -135,6 +179,19 @@ class NrSinrMatrix : public DoubleMatrixArray
     /// Matches layer-to-codeword mapping in TR 38.211, Table 7.3.1.3-1
     /// @return A SpectrumValue with the (nRB * nMimoLayers) SINR values
     SpectrumValue GetVectorizedSpecVal() const;
+
+    /// @brief View of the SINR values in the same order as GetVectorizedSpecVal, i.e., the
+    /// value of layer l in RB j is at index j * rank + l. No copy is made.
+    /// @return A span over the (nRB * nMimoLayers) SINR values
+    std::span<const double> GetVectorizedValues() const;
+
+    /// @brief Get the spectrum model of vectorized SINR values. The model has no band
+    /// information, and it is created once per number of values and shared afterwards.
+    /// The cache is thread-safe; the reference count of the returned model is not, so the
+    /// values built on it must not be copied or released concurrently in several threads.
+    /// @param numValues the number of SINR values (nRB * nMimoLayers)
+    /// @return the spectrum model
+    static Ptr<const SpectrumModel> GetVectorizedSpectrumModel(size_t numValues);
 };
 
 } // namespace ns3
@@ -9,7 +9,7 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("NrMimoSignal");
 
-NrMimoSignal::NrMimoSignal(const std::vector<MimoSignalChunk>& mimoChunks)
+NrMimoSignal::NrMimoSignal(const NrMimoChunks& mimoChunks)
 {
     NS_ASSERT_MSG(!mimoChunks.empty(), "mimoChunks cannot be empty");
     m_chanMat = ConsolidateChanSpctMimo(mimoChunks);
@@ -17,14 +17,15 @@ NrMimoSignal::NrMimoSignal(const std::vector<MimoSignalChunk>& mimoChunks)
 }
 
 ComplexMatrixArray
-NrMimoSignal::ConsolidateChanSpctMimo(const std::vector<MimoSignalChunk>& mimoChunks)
+NrMimoSignal::ConsolidateChanSpctMimo(const NrMimoChunks& mimoChunks)
 {
     NS_ASSERT(!mimoChunks.empty());
 
     // Create a consolidated chanSpct that combines all non-zero pages of the different chanSpcts.
-    auto chanSpct = mimoChunks[0].chanSpct;
-    for (const auto& chunk : mimoChunks)
+    auto chanSpct = mimoChunks[0]->GetSignalChunk().chanSpct;
+    for (const auto& mimoChunk : mimoChunks)
     {
+        const auto& chunk = mimoChunk->GetSignalChunk();
         for (auto iRb = size_t{0}; iRb < chunk.chanSpct.GetNumPages(); iRb++)
         {
             if (chunk.chanSpct(0, 0, iRb) == 0.0)
@@ -45,15 +46,16 @@ NrMimoSignal::ConsolidateChanSpctMimo(const std::vector<MimoSignalChunk>& mimoCh
 }
 
 NrCovMat
-NrMimoSignal::ComputeAvgCovMatMimo(const std::vector<MimoSignalChunk>& mimoChunks)
+NrMimoSignal::ComputeAvgCovMatMimo(const NrMimoChunks& mimoChunks)
 {
     NS_ASSERT(!mimoChunks.empty());
-    auto nRx = mimoChunks[0].interfNoiseCov.GetNumRows();
-    auto avgMat =
-        NrCovMat{ComplexMatrixArray{nRx, nRx, mimoChunks[0].interfNoiseCov.GetNumPages()}};
+    const auto& firstCov = mimoChunks[0]->GetSignalChunk().interfNoiseCov;
+    auto nRx = firstCov.GetNumRows();
+    auto avgMat = NrCovMat{ComplexMatrixArray{nRx, nRx, firstCov.GetNumPages()}};
     auto totDur = double{0.0};
-    for (const auto& chunk : mimoChunks)
+    for (const auto& mimoChunk : mimoChunks)
     {
+        const auto& chunk = mimoChunk->GetSignalChunk();
         avgMat += chunk.interfNoiseCov * std::complex<double>{chunk.dur.GetDouble()};
         totDur += chunk.dur.GetDouble();
     }
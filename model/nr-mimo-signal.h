@@ -18,8 +18,8 @@ struct NrMimoSignal : public SimpleRefCount<NrMimoSignal>
 {
     NrMimoSignal() = default;
     /// @brief Constructor that consolidates the different signals in a vector of received chunks.
-    /// @param mimoChunks the signal chunks with channel and interference covariance matrices
-    NrMimoSignal(const std::vector<MimoSignalChunk>& mimoChunks);
+    /// @param mimoChunks the chunks with channel and interference covariance matrices
+    NrMimoSignal(const NrMimoChunks& mimoChunks);
 
     /// @brief Combine the multiple received PDSCH channel matrices into a single channel matrix.
     /// Each of the individual channel matrices can have pages with all-zero elements when the
@@ -29,15 +29,14 @@ struct NrMimoSignal : public SimpleRefCount<NrMimoSignal>
     /// @param mimoChunks the vector of received signal chunks, one per UE and per time chunk.
     /// @return a single channel matrix that combines all non-zero pages of the different channel
     /// matrices in mimoChunks
-    static ComplexMatrixArray ConsolidateChanSpctMimo(
-        const std::vector<MimoSignalChunk>& mimoChunks);
+    static ComplexMatrixArray ConsolidateChanSpctMimo(const NrMimoChunks& mimoChunks);
 
     /// @brief Combine the multiple received PDSCH interference matrices into a single matrix.
     /// This function performs a simple linear average. When there multiple UEs, the interference
     /// matrix in each time chunk is counted multiple times, but this is averaged out.
     /// @param mimoChunks the vector of received signal chunks, one per UE and per time chunk.
     /// @return a single average interference and noise covariance matrix
-    static NrCovMat ComputeAvgCovMatMimo(const std::vector<MimoSignalChunk>& mimoChunks);
+    static NrCovMat ComputeAvgCovMatMimo(const NrMimoChunks& mimoChunks);
 
     ComplexMatrixArray m_chanMat{}; ///< Channel Matrix; nRxPorts * nTxPorts * nRbs
     NrCovMat m_covMat{}; ///< Interference and noise covariance matrix; nRxPorts * nRxPorts * nRbs
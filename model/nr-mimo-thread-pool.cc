@@ -0,0 +1,182 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mimo-thread-pool.h"
+
+#include "ns3/assert.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMimoThreadPool");
+
+/// Number of threads used by NrMimoThreadPool
+static GlobalValue g_nrMimoThreads(
+    "NrMimoThreads",
+    "Number of threads used for the per-RB MIMO SINR computations of a receiver. With 1, the "
+    "computations run in the simulation thread. The results do not depend on this value.",
+    UintegerValue(1),
+    MakeUintegerChecker<uint32_t>(1, 1024));
+
+/// Number of threads used by the SCHEDULING pool of NrMimoThreadPool
+static GlobalValue g_nrSchedulingThreads(
+    "NrSchedulingThreads",
+    "Number of threads used for the scheduler triggers of the gNB MACs with the attribute "
+    "ParallelScheduling. With 1, the triggers run in the simulation thread. The results do not "
+    "depend on this value.",
+    UintegerValue(1),
+    MakeUintegerChecker<uint32_t>(1, 1024));
+
+/// Whether the current thread is running a block of a ParallelFor call
+static thread_local bool t_inParallelFor = false;
+
+uint32_t
+NrMimoThreadPool::GetNumThreads(Pool pool)
+{
+    UintegerValue numThreads;
+    (pool == SCHEDULING ? g_nrSchedulingThreads : g_nrMimoThreads).GetValue(numThreads);
+    return static_cast<uint32_t>(numThreads.Get());
+}
+
+void
+NrMimoThreadPool::ParallelFor(size_t numItems,
+                              const RangeFunction& f,
+                              size_t minItemsPerThread,
+                              Pool pool)
+{
+    auto numBlocks = std::min<size_t>(GetNumThreads(pool),
+                                      numItems / std::max<size_t>(minItemsPerThread, 1));
+    // Nested calls run serially, the outer call already uses all the threads
+    if (numBlocks <= 1 || t_inParallelFor)
+    {
+        f(0, numItems);
+        return;
+    }
+    Get(pool).Run(numItems, static_cast<uint32_t>(numBlocks), f);
+}
+
+NrMimoThreadPool&
+NrMimoThreadPool::Get(Pool pool)
+{
+    static NrMimoThreadPool mimoPool(MIMO);
+    static NrMimoThreadPool schedulingPool(SCHEDULING);
+    return pool == SCHEDULING ? schedulingPool : mimoPool;
+}
+
+NrMimoThreadPool::NrMimoThreadPool(Pool pool)
+    : m_pool(pool)
+{
+}
+
+NrMimoThreadPool::~NrMimoThreadPool()
+{
+    StopWorkers();
+}
+
+void
+NrMimoThreadPool::Run(size_t numItems, uint32_t numBlocks, const RangeFunction& f)
+{
+    std::unique_lock runLock(m_runMutex, std::try_to_lock);
+    if (!runLock.owns_lock())
+    {
+        // The workers are busy with a call from another thread
+        f(0, numItems);
+        return;
+    }
+    Resize(GetNumThreads(m_pool) - 1);
+    NS_ASSERT(numBlocks <= m_workers.size() + 1);
+    {
+        std::lock_guard lock(m_mutex);
+        m_job = &f;
+        m_numItems = numItems;
+        m_numBlocks = numBlocks;
+        m_pending = numBlocks - 1;
+        ++m_generation;
+    }
+    m_startCv.notify_all();
+
+    // The first block is processed by the calling thread
+    t_inParallelFor = true;
+    f(0, numItems / numBlocks);
+    t_inParallelFor = false;
+
+    std::unique_lock lock(m_mutex);
+    m_doneCv.wait(lock, [this] { return m_pending == 0; });
+    m_job = nullptr;
+}
+
+void
+NrMimoThreadPool::Resize(uint32_t numWorkers)
+{
+    if (m_workers.size() == numWorkers)
+    {
+        return;
+    }
+    NS_LOG_INFO("Using " << numWorkers << (m_pool == SCHEDULING ? " scheduling" : " MIMO")
+                         << " worker threads");
+    StopWorkers();
+    m_stop = false;
+    for (uint32_t i = 0; i < numWorkers; ++i)
+    {
+        m_workers.emplace_back(&NrMimoThreadPool::WorkerLoop, this, i + 1, m_generation);
+    }
+}
+
+void
+NrMimoThreadPool::StopWorkers()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_startCv.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+void
+NrMimoThreadPool::WorkerLoop(uint32_t block, uint64_t lastGeneration)
+{
+    t_inParallelFor = true;
+    while (true)
+    {
+        const RangeFunction* job;
+        size_t begin;
+        size_t end;
+        {
+            std::unique_lock lock(m_mutex);
+            m_startCv.wait(lock, [&] { return m_stop || m_generation != lastGeneration; });
+            if (m_stop)
+            {
+                return;
+            }
+            lastGeneration = m_generation;
+            if (block >= m_numBlocks)
+            {
+                continue; // no block for this worker in this job
+            }
+            job = m_job;
+            begin = m_numItems * block / m_numBlocks;
+            end = m_numItems * (block + 1) / m_numBlocks;
+        }
+
+        (*job)(begin, end);
+
+        std::lock_guard lock(m_mutex);
+        if (--m_pending == 0)
+        {
+            m_doneCv.notify_one();
+        }
+    }
+}
+
+} // namespace ns3
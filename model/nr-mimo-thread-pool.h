@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_MIMO_THREAD_POOL_H
+#define NR_MIMO_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup spectrum
+ *
+ * @brief Process-wide pools of worker threads for the per-RB MIMO computations and the
+ * parallel scheduling of the gNB MACs.
+ *
+ * The MIMO channel whitening, MSE and SINR computations are independent for each RB (page of
+ * the matrix arrays). ParallelFor splits the RB range into contiguous blocks, one per thread,
+ * and waits until all of them are processed. Since each RB is computed by the same code
+ * regardless of the block it belongs to, the results do not depend on the number of threads.
+ *
+ * The number of threads is taken from the global value "NrMimoThreads" (default 1, i.e., the
+ * computations run in the simulation thread, and no worker is created). It can be set, e.g.,
+ * with Config::SetGlobal or with the command line argument --NrMimoThreads. The function passed
+ * to ParallelFor must not use ns-3 simulator facilities (scheduling, logging, Ptr reference
+ * counting of shared objects), since it may run outside of the simulation thread.
+ *
+ * A second, independent pool runs the scheduler triggers of the gNB MACs with the attribute
+ * ParallelScheduling, one MAC per item (see NrGnbMac). Its number of threads is taken from the
+ * global value "NrSchedulingThreads" (default 1). The MIMO computations called by a scheduler
+ * job run serially in the worker of that job.
+ */
+class NrMimoThreadPool
+{
+  public:
+    /// Function that processes the items in the range [begin, end)
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    /// The process-wide pools
+    enum Pool : uint8_t
+    {
+        MIMO,       //!< Per-RB MIMO computations (global value "NrMimoThreads")
+        SCHEDULING, //!< Scheduler triggers of the gNB MACs (global value "NrSchedulingThreads")
+    };
+
+    /**
+     * @brief Process the items [0, numItems) in parallel, in contiguous blocks
+     * @param numItems the number of items (e.g., RBs)
+     * @param f the function that processes a block of items
+     * @param minItemsPerThread the minimum number of items assigned to each thread, so that
+     * small ranges are not split among more threads than worth it
+     * @param pool the pool whose threads process the blocks
+     */
+    static void ParallelFor(size_t numItems,
+                            const RangeFunction& f,
+                            size_t minItemsPerThread = 16,
+                            Pool pool = MIMO);
+
+    /**
+     * @brief Get the configured number of threads of a pool
+     * @param pool the pool
+     * @return the value of the global value "NrMimoThreads" or "NrSchedulingThreads"
+     */
+    static uint32_t GetNumThreads(Pool pool = MIMO);
+
+  private:
+    /**
+     * @brief Create a pool, without workers
+     * @param pool the pool that this instance implements
+     */
+    explicit NrMimoThreadPool(Pool pool);
+    ~NrMimoThreadPool();
+
+    /**
+     * @brief Get the process-wide instance of a pool
+     * @param pool the pool
+     * @return the pool instance
+     */
+    static NrMimoThreadPool& Get(Pool pool);
+
+    /**
+     * @brief Run the blocks of a ParallelFor call, the first one in the calling thread
+     * @param numItems the number of items
+     * @param numBlocks the number of blocks, at most the number of workers plus one
+     * @param f the function that processes a block of items
+     */
+    void Run(size_t numItems, uint32_t numBlocks, const RangeFunction& f);
+
+    /**
+     * @brief Create or destroy worker threads, so that there are numWorkers of them
+     * @param numWorkers the number of worker threads
+     */
+    void Resize(uint32_t numWorkers);
+
+    /**
+     * @brief Stop and join all the worker threads
+     */
+    void StopWorkers();
+
+    /**
+     * @brief Main loop of a worker thread
+     * @param block the index of the block that this worker processes
+     * @param lastGeneration the generation of the last job before the worker was created
+     */
+    void WorkerLoop(uint32_t block, uint64_t lastGeneration);
+
+    Pool m_pool;                         //!< The pool that this instance implements
+    std::mutex m_runMutex;               //!< Held by the thread whose job the workers run
+    std::vector<std::thread> m_workers;  //!< Worker threads, worker i processes block i + 1
+    std::mutex m_mutex;                  //!< Protects the state below
+    std::condition_variable m_startCv;   //!< Notifies the workers of a new job
+    std::condition_variable m_doneCv;    //!< Notifies the caller that all the blocks are done
+    const RangeFunction* m_job{nullptr}; //!< The function of the current job
+    size_t m_numItems{0};                //!< The number of items of the current job
+    uint32_t m_numBlocks{0};             //!< The number of blocks of the current job
+    uint32_t m_pending{0};               //!< Blocks of the current job not processed yet
+    uint64_t m_generation{0};            //!< Incremented for every job
+    bool m_stop{false};                  //!< Whether the workers must exit
+};
+
+} // namespace ns3
+
+#endif /* NR_MIMO_THREAD_POOL_H */
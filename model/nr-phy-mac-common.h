@@ -8,6 +8,7 @@
 #define SRC_NR_MODEL_NR_PHY_MAC_COMMON_H
 
 #include "nr-error-model.h"
+#include "nr-rbg-mask.h"
 #include "sfnsf.h"
 
 #include "ns3/log.h"
@@ -138,7 +139,7 @@ struct DciInfoElementTdma
                        uint8_t numSym,
                        DciFormat format,
                        VarTtiType type,
-                       const std::vector<bool>& rbgBitmask)
+                       const NrRbgMask& rbgBitmask)
         : m_format(format),
           m_symStart(symStart),
           m_numSym(numSym),
@@ -231,7 +232,7 @@ struct DciInfoElementTdma
      */
     DciInfoElementTdma(uint8_t symStart,
                        uint8_t numSym,
-                       const std::vector<bool>& rbgBitmask,
+                       const NrRbgMask& rbgBitmask,
                        const DciInfoElementTdma& o)
         : m_rnti(o.m_rnti),
           m_format(o.m_format),
@@ -287,7 +288,7 @@ struct DciInfoElementTdma
     const VarTtiType m_type{SRS};     //!< Var TTI type
     const uint8_t m_bwpIndex{0};      //!< BWP Index to identify to which BWP this DCI applies to.
     uint8_t m_harqProcess{0};         //!< HARQ process id
-    std::vector<bool> m_rbgBitmask{}; //!< RBG mask: 0 if the RBG is not used, 1 otherwise
+    NrRbgMask m_rbgBitmask{};         //!< RBG mask: 0 if the RBG is not used, 1 otherwise
     const uint8_t m_tpc{0};           //!< Tx power control command
 };
 
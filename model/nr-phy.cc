@@ -162,23 +162,19 @@ NrPhy::GetTypeId()
 }
 
 std::vector<int>
-NrPhy::FromRBGBitmaskToRBAssignment(const std::vector<bool> rbgBitmask) const
+NrPhy::FromRBGBitmaskToRBAssignment(const NrRbgMask& rbgBitmask) const
 {
+    const uint32_t numRbPerRbg = GetNumRbPerRbg();
     std::vector<int> ret;
+    ret.reserve(rbgBitmask.Count() * numRbPerRbg);
 
-    for (uint32_t i = 0; i < rbgBitmask.size(); ++i)
+    for (auto i = rbgBitmask.FindFirst(); i != NrRbgMask::NPOS; i = rbgBitmask.FindNext(i))
     {
-        if (rbgBitmask.at(i) == 1)
+        for (uint32_t k = 0; k < numRbPerRbg; ++k)
         {
-            for (uint32_t k = 0; k < GetNumRbPerRbg(); ++k)
-            {
-                ret.push_back((i * GetNumRbPerRbg()) + k);
-            }
+            ret.push_back((i * numRbPerRbg) + k);
         }
     }
-
-    NS_ASSERT(static_cast<uint32_t>(std::count(rbgBitmask.begin(), rbgBitmask.end(), 1) *
-                                    GetNumRbPerRbg()) == ret.size());
     return ret;
 }
 
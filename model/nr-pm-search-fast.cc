@@ -4,6 +4,8 @@
 
 #include "nr-pm-search-fast.h"
 
+#include <numeric>
+
 namespace ns3
 {
 
@@ -24,15 +26,17 @@ NrPmSearchFast::NrPmSearchFast()
       };
 
 size_t
-NrPmSearchFast::GetWidebandI1(Ptr<const NrCbTypeOne> cb, const ComplexMatrixArray& Havg) const
+NrPmSearchFast::GetWidebandI1(Ptr<const NrCbTypeOne> cb,
+                              const ComplexMatrixArray& Havg,
+                              const std::vector<size_t>& i1Candidates) const
 {
     // Instead of calculating all subband i2s to find the best wideband i1,
     // we instead calculate the best wideband i1, then search for subband i2s
-    auto numI1 = cb->GetNumI1();
+    NS_ASSERT(!i1Candidates.empty());
     auto numI2 = cb->GetNumI2();
-    int maxI1 = 0;
+    auto maxI1 = i1Candidates.front();
     double maxCap = 0.0;
-    for (auto i1 = size_t{0}; i1 < numI1; i1++)
+    for (auto i1 : i1Candidates)
     {
         for (auto i2 = size_t{0}; i2 < numI2; i2++)
         {
@@ -74,17 +78,38 @@ NrPmSearchFast::CreateCqiFeedbackMimo(const NrMimoSignal& rxSignalRb, PmiUpdate
         auto C = NrIntfNormChanMat(sbNormChanMat.HermitianTranspose() * sbNormChanMat);
 
         // Select the maximum rank
-        m_periodMaxRank = SelectRank(C);
+        auto rank = SelectRank(C);
 
         // Compute the channel average over bands
         auto Cavg = C.GetWidebandChannel();
 
-        // Find the optimal wideband PMI i1
-        auto maxI1 = GetWidebandI1(m_rankParams[m_periodMaxRank].cb, Cavg);
-
-        // Find optimal PMI i2
-        m_rankParams[m_periodMaxRank].precParams =
-            FindOptSubbandPrecoding(sbNormChanMat, maxI1, m_periodMaxRank);
+        // When tracking and the rank did not change, only evaluate the previous wideband PMI
+        // i1 and its neighbors, unless the capacity dropped
+        auto cb = m_rankParams[rank].codebook->cb;
+        Ptr<PrecMatParams> optPrec;
+        if (IsTrackingAllowed() && rank == m_periodMaxRank && m_rankParams[rank].precParams)
+        {
+            auto candidates = GetTrackingI1Candidates(rank, m_rankParams[rank].precParams->wbPmi);
+            auto maxI1 = GetWidebandI1(cb, Cavg, candidates);
+            optPrec = FindOptSubbandPrecoding(sbNormChanMat, maxI1, rank);
+            if (!AcceptTrackedMetric(optPrec->perfMetric))
+            {
+                optPrec = nullptr;
+            }
+        }
+        if (!optPrec)
+        {
+            // Find the optimal wideband PMI i1 among all of them
+            std::vector<size_t> allI1(cb->GetNumI1());
+            std::iota(allI1.begin(), allI1.end(), 0);
+            auto maxI1 = GetWidebandI1(cb, Cavg, allI1);
+
+            // Find optimal PMI i2
+            optPrec = FindOptSubbandPrecoding(sbNormChanMat, maxI1, rank);
+            NotifyFullSearch(optPrec->perfMetric);
+        }
+        m_periodMaxRank = rank;
+        m_rankParams[rank].precParams = optPrec;
     }
     else if (pmiUpdate.updateSb)
     {
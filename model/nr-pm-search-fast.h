@@ -40,19 +40,20 @@ class NrPmSearchFast : public NrPmSearchFull
 
   protected:
     /**
-     * @brief Create CQI feedback with optimal rank, optimal PMI, and corresponding CQI values.
-     * Optimal rank is considered as the rank that maximizes the achievable TB size when using the
-     * optimal PMI. The optimal WB/SB PMI values are updated based on pmiUpdate. If there is no
-     * update to the PMI values, the previously found PMI values are used.
-     * @param rxSignalRb the receive signal parameters (channel and interference matrices)
-     * @param pmiUpdate struct that defines if WB/SB PMIs need to be updated
-     * @return the CQI feedback message that contains the optimum CQI, RI, PMI, and full precoding
-     * matrix (dimensions: nGnbPorts * rank * nRbs)
+     * @brief Find the wideband PMI i1 whose best base precoding matrix maximizes the capacity of
+     * the wideband (averaged) channel.
+     * @param cb the codebook of the selected rank
+     * @param Havg the wideband channel
+     * @param i1Candidates the i1 values to evaluate (all of them, or the ones around the previous
+     * i1 when tracking)
+     * @return the optimal i1 among the candidates
      */
-    size_t GetWidebandI1(Ptr<const NrCbTypeOne> cb, const ComplexMatrixArray& Havg) const;
+    size_t GetWidebandI1(Ptr<const NrCbTypeOne> cb,
+                         const ComplexMatrixArray& Havg,
+                         const std::vector<size_t>& i1Candidates) const;
 
   private:
-    uint8_t m_periodMaxRank;
+    uint8_t m_periodMaxRank{0};
 };
 
 } // namespace ns3
@@ -5,10 +5,13 @@
 #include "nr-pm-search-full.h"
 
 #include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <map>
 #include <numeric>
+#include <sstream>
 
 namespace ns3
 {
@@ -19,14 +22,43 @@ NS_OBJECT_ENSURE_REGISTERED(NrPmSearchFull);
 TypeId
 NrPmSearchFull::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::NrPmSearchFull")
-                            .SetParent<NrPmSearch>()
-                            .AddConstructor<NrPmSearchFull>()
-                            .AddAttribute("CodebookType",
-                                          "Codebook class to be used",
-                                          TypeIdValue(NrCbTwoPort::GetTypeId()),
-                                          MakeTypeIdAccessor(&NrPmSearchFull::SetCodebookTypeId),
-                                          MakeTypeIdChecker());
+    static TypeId tid =
+        TypeId("ns3::NrPmSearchFull")
+            .SetParent<NrPmSearch>()
+            .AddConstructor<NrPmSearchFull>()
+            .AddAttribute("CodebookType",
+                          "Codebook class to be used",
+                          TypeIdValue(NrCbTwoPort::GetTypeId()),
+                          MakeTypeIdAccessor(&NrPmSearchFull::SetCodebookTypeId),
+                          MakeTypeIdChecker())
+            .AddAttribute("TrackingMode",
+                          "If true, a wideband PMI update first evaluates the previous i1 and its "
+                          "neighbors in the codebook, and only falls back to the exhaustive "
+                          "search when the capacity drops or the full search period expires",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NrPmSearchFull::m_tracking),
+                          MakeBooleanChecker())
+            .AddAttribute("TrackingMaxCapacityDrop",
+                          "Maximum relative drop of the capacity of the tracked precoding, with "
+                          "respect to the last exhaustive wideband PMI search, above which the "
+                          "exhaustive search is done",
+                          DoubleValue(0.1),
+                          MakeDoubleAccessor(&NrPmSearchFull::m_trackingMaxDrop),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("TrackingFullSearchPeriod",
+                          "Maximum time between two exhaustive wideband PMI searches when "
+                          "tracking the PMI",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&NrPmSearchFull::m_trackingFullSearchPeriod),
+                          MakeTimeChecker())
+            .AddTraceSource("TrackingHits",
+                            "Number of wideband PMI updates done by tracking the previous PMI",
+                            MakeTraceSourceAccessor(&NrPmSearchFull::m_trackingHits),
+                            "ns3::TracedValueCallback::Uint64")
+            .AddTraceSource("TrackingFallbacks",
+                            "Number of tracking updates that fell back to the exhaustive search",
+                            MakeTraceSourceAccessor(&NrPmSearchFull::m_trackingFallbacks),
+                            "ns3::TracedValueCallback::Uint64");
     return tid;
 }
 
@@ -43,6 +75,18 @@ NrPmSearchFull::SetCodebookAttribute(const std::string& attrName, const Attribut
     m_cbFactory.Set(attrName, attrVal);
 }
 
+uint64_t
+NrPmSearchFull::GetTrackingHits() const
+{
+    return m_trackingHits;
+}
+
+uint64_t
+NrPmSearchFull::GetTrackingFallbacks() const
+{
+    return m_trackingFallbacks;
+}
+
 void
 NrPmSearchFull::InitCodebooks()
 {
@@ -57,11 +101,37 @@ NrPmSearchFull::InitCodebooks()
     for (auto rank : m_ranks)
     {
         m_cbFactory.Set("Rank", UintegerValue(rank));
-        m_rankParams[rank].cb = m_cbFactory.Create<NrCbTypeOne>();
-        m_rankParams[rank].cb->Init();
+        m_rankParams[rank].codebook = GetCodebook(m_cbFactory);
     }
 }
 
+std::shared_ptr<const NrPmSearchFull::Codebook>
+NrPmSearchFull::GetCodebook(const ObjectFactory& factory)
+{
+    // The serialized factory (TypeId and attribute values) identifies the configuration
+    static std::map<std::string, std::shared_ptr<const Codebook>> cache;
+    std::ostringstream key;
+    key << factory;
+    auto& codebook = cache[key.str()];
+    if (!codebook)
+    {
+        NS_LOG_LOGIC("Creating codebook " << key.str());
+        auto newCodebook = std::make_shared<Codebook>();
+        newCodebook->cb = factory.Create<NrCbTypeOne>();
+        newCodebook->cb->Init();
+        newCodebook->basePrecMats.resize(newCodebook->cb->GetNumI1());
+        for (auto i1 = size_t{0}; i1 < newCodebook->cb->GetNumI1(); i1++)
+        {
+            for (auto i2 = size_t{0}; i2 < newCodebook->cb->GetNumI2(); i2++)
+            {
+                newCodebook->basePrecMats[i1].emplace_back(newCodebook->cb->GetBasePrecMat(i1, i2));
+            }
+        }
+        codebook = newCodebook;
+    }
+    return codebook;
+}
+
 PmCqiInfo
 NrPmSearchFull::CreateCqiFeedbackMimo(const NrMimoSignal& rxSignalRb, PmiUpdate pmiUpdate)
 {
@@ -110,7 +180,10 @@ NrPmSearchFull::ConditionallyUpdatePrecoding(const NrIntfNormChanMat& rbNormChan
 {
     if (pmiUpdate.updateWb)
     {
-        UpdateAllPrecoding(rbNormChanMat);
+        if (!IsTrackingAllowed() || !TrackAllPrecoding(rbNormChanMat))
+        {
+            UpdateAllPrecoding(rbNormChanMat);
+        }
     }
     else if (pmiUpdate.updateSb)
     {
@@ -124,11 +197,12 @@ NrPmSearchFull::UpdateAllPrecoding(const NrIntfNormChanMat& rbNormChanMat)
     // Compute downsampled channel per subband
     auto sbNormChanMat = SubbandDownsampling(rbNormChanMat);
 
+    double maxMetric = 0.0;
     for (auto rank : m_ranks)
     {
         // Loop over wideband precoding matrices W1 (index i1).
         std::vector<Ptr<PrecMatParams>> optSubbandPrecoders{};
-        auto numI1 = m_rankParams[rank].cb->GetNumI1();
+        auto numI1 = m_rankParams[rank].codebook->cb->GetNumI1();
         for (auto i1 = size_t{0}; i1 < numI1; i1++)
         {
             // Find the optimal subband PMI values (i2) for this particular i1
@@ -145,7 +219,83 @@ NrPmSearchFull::UpdateAllPrecoding(const NrIntfNormChanMat& rbNormChanMat)
                               [](const Ptr<PrecMatParams>& a, const Ptr<PrecMatParams>& b) {
                                   return a->perfMetric < b->perfMetric;
                               });
+        maxMetric = std::max(maxMetric, m_rankParams[rank].precParams->perfMetric);
+    }
+    NotifyFullSearch(maxMetric);
+}
+
+bool
+NrPmSearchFull::TrackAllPrecoding(const NrIntfNormChanMat& rbNormChanMat)
+{
+    // Compute downsampled channel per subband
+    auto sbNormChanMat = SubbandDownsampling(rbNormChanMat);
+
+    std::vector<Ptr<PrecMatParams>> trackedParams(m_rankParams.size());
+    double maxMetric = 0.0;
+    for (auto rank : m_ranks)
+    {
+        // Only evaluate the previous wideband PMI i1 and its neighbors
+        const auto& prevParams = m_rankParams[rank].precParams;
+        NS_ASSERT(prevParams);
+        for (auto i1 : GetTrackingI1Candidates(rank, prevParams->wbPmi))
+        {
+            auto subbandParams = FindOptSubbandPrecoding(sbNormChanMat, i1, rank);
+            if (!trackedParams[rank] || subbandParams->perfMetric > trackedParams[rank]->perfMetric)
+            {
+                trackedParams[rank] = subbandParams;
+            }
+        }
+        maxMetric = std::max(maxMetric, trackedParams[rank]->perfMetric);
+    }
+
+    if (!AcceptTrackedMetric(maxMetric))
+    {
+        return false;
+    }
+    for (auto rank : m_ranks)
+    {
+        m_rankParams[rank].precParams = trackedParams[rank];
     }
+    return true;
+}
+
+bool
+NrPmSearchFull::IsTrackingAllowed() const
+{
+    return m_tracking && m_lastFullSearch &&
+           (Simulator::Now() - *m_lastFullSearch < m_trackingFullSearchPeriod);
+}
+
+std::vector<size_t>
+NrPmSearchFull::GetTrackingI1Candidates(uint8_t rank, size_t i1) const
+{
+    auto candidates = m_rankParams[rank].codebook->cb->GetNeighborI1s(i1);
+    candidates.insert(candidates.begin(), i1);
+    return candidates;
+}
+
+bool
+NrPmSearchFull::AcceptTrackedMetric(double perfMetric)
+{
+    // The reference is not updated by the tracking updates, so that a sequence of small drops
+    // cannot lower it below the capacity found by the exhaustive search
+    if (perfMetric < (1.0 - m_trackingMaxDrop) * m_fullSearchMetric)
+    {
+        NS_LOG_LOGIC("Tracked PMI capacity " << perfMetric << " dropped from "
+                                             << m_fullSearchMetric
+                                             << ", falling back to the exhaustive search");
+        ++m_trackingFallbacks;
+        return false;
+    }
+    ++m_trackingHits;
+    return true;
+}
+
+void
+NrPmSearchFull::NotifyFullSearch(double perfMetric)
+{
+    m_lastFullSearch = Simulator::Now();
+    m_fullSearchMetric = perfMetric;
 }
 
 void
@@ -215,17 +365,20 @@ NrPmSearchFull::FindOptSubbandPrecoding(const NrIntfNormChanMat& sbNormChanMat,
                                         size_t i1,
                                         uint8_t rank) const
 {
-    // Create the possible subband precoding matrices for each value of i2, and compute the
-    // corresponding performance metric (channel capacity) for each subband and each i2.
+    // Get the base precoding matrices for each value of i2, and compute the corresponding
+    // performance metric (channel capacity) for each subband and each i2. Each base matrix is
+    // applied to all subbands, without expanding it.
     auto nSubbands = sbNormChanMat.GetNumPages();
-    auto allPrecMats = CreateSubbandPrecoders(i1, rank, nSubbands);
-    auto subbandMetricForPrec = ComputeCapacityForPrecoders(sbNormChanMat, allPrecMats);
-    auto numI2 = allPrecMats.size();
+    const auto& basePrecMats = GetBasePrecoders(i1, rank);
+    auto subbandMetricForPrec = ComputeCapacityForPrecoders(sbNormChanMat, basePrecMats);
+    auto numI2 = basePrecMats.size();
 
     // For each subband, find the optimal value of i2 (subband PMI value)
     auto sbPmis = std::vector<size_t>(nSubbands);
     auto optSubbandMetric = DoubleMatrixArray{nSubbands};
-    auto optPrecMat = allPrecMats[0]; // Initialize optimal precoding matrix
+    auto optPrecMat = ComplexMatrixArray{basePrecMats[0].GetNumRows(),
+                                         basePrecMats[0].GetNumCols(),
+                                         nSubbands};
     for (auto iSb = size_t{0}; iSb < nSubbands; iSb++)
     {
         // Find the optimal value of i2 (subband PMI value) for the current subband
@@ -238,11 +391,12 @@ NrPmSearchFull::FindOptSubbandPrecoding(const NrIntfNormChanMat& sbNormChanMat,
             }
         }
         // Store the optimal precoding matrix for this subband
+        const auto& basePrecMat = basePrecMats[sbPmis[iSb]];
         for (size_t i = 0; i < optPrecMat.GetNumRows(); i++)
         {
             for (size_t j = 0; j < optPrecMat.GetNumCols(); j++)
             {
-                optPrecMat(i, j, iSb) = allPrecMats[sbPmis[iSb]](i, j, iSb);
+                optPrecMat(i, j, iSb) = basePrecMat(i, j);
             }
         }
     }
@@ -256,66 +410,21 @@ NrPmSearchFull::FindOptSubbandPrecoding(const NrIntfNormChanMat& sbNormChanMat,
     return res;
 }
 
-std::vector<ComplexMatrixArray>
-NrPmSearchFull::CreateSubbandPrecoders(size_t i1, uint8_t rank, size_t nSubbands) const
-{
-    const auto& cb = m_rankParams[rank].cb;
-    auto numI2 = cb->GetNumI2();
-
-    std::vector<ComplexMatrixArray> allPrecMats;
-
-    for (auto i2 = size_t{0}; i2 < numI2; i2++)
-    {
-        auto basePrecMat = cb->GetBasePrecMat(i1, i2);
-        auto sbPrecMat = ExpandPrecodingMatrix(basePrecMat, nSubbands);
-        allPrecMats.emplace_back(sbPrecMat);
-    }
-    return allPrecMats;
-}
-
-ComplexMatrixArray
-NrPmSearchFull::ExpandPrecodingMatrix(ComplexMatrixArray basePrecMat, size_t nSubbands)
+const std::vector<ComplexMatrixArray>&
+NrPmSearchFull::GetBasePrecoders(size_t i1, uint8_t rank) const
 {
-    NS_ASSERT_MSG(basePrecMat.GetNumPages() == 1, "Expanding to 3D requires a 2D input");
-    auto nRows = basePrecMat.GetNumRows();
-    auto nCols = basePrecMat.GetNumCols();
-    ComplexMatrixArray res{nRows, nCols, nSubbands};
-    for (size_t p = 0; p < nSubbands; p++)
-    {
-        for (size_t i = 0; i < nRows; i++)
-        {
-            for (size_t j = 0; j < nCols; j++)
-            {
-                res(i, j, p) = basePrecMat(i, j);
-            }
-        }
-    }
-    return res;
+    const auto& codebook = m_rankParams[rank].codebook;
+    NS_ASSERT_MSG(codebook, "Codebook of rank " << +rank << " not initialized");
+    return codebook->basePrecMats.at(i1);
 }
 
 DoubleMatrixArray
-NrPmSearchFull::ComputeCapacityForPrecoders(const NrIntfNormChanMat& sbNormChanMat,
-                                            std::vector<ComplexMatrixArray> allPrecMats) const
+NrPmSearchFull::ComputeCapacityForPrecoders(
+    const NrIntfNormChanMat& sbNormChanMat,
+    const std::vector<ComplexMatrixArray>& allPrecMats) const
 {
-    auto nSubbands = sbNormChanMat.GetNumPages();
-    auto numI2 = allPrecMats.size();
-    // Loop over subband PMI value i2 and store the capacity for each subband and each i2
-    DoubleMatrixArray subbandCap{nSubbands, numI2};
-    for (auto i2 = size_t{0}; i2 < numI2; i2++)
-    {
-        const auto& sbPrecMat = allPrecMats[i2];
-        auto sinr = sbNormChanMat.ComputeSinrForPrecoding(sbPrecMat);
-        for (auto iSb = size_t{0}; iSb < nSubbands; iSb++)
-        {
-            double currCap = 0;
-            for (size_t iLayer = 0; iLayer < sinr.GetNumRows(); iLayer++)
-            {
-                currCap += log2(1.0 + sinr(iLayer, iSb));
-            }
-            subbandCap(iSb, i2) = currCap;
-        }
-    }
-    return subbandCap;
+    // Evaluate all the candidates at once, for each subband and each i2
+    return sbNormChanMat.ComputeCapacityForPrecoders(allPrecMats);
 }
 
 } // namespace ns3
@@ -9,7 +9,12 @@
 #include "nr-cb-two-port.h"
 #include "nr-pm-search.h"
 
+#include "ns3/nstime.h"
 #include "ns3/object-factory.h"
+#include "ns3/traced-value.h"
+
+#include <memory>
+#include <optional>
 
 namespace ns3
 {
@@ -20,6 +25,12 @@ namespace ns3
 /// When a PMI update is requested, the optimal precoding matrices (PMI) are updated using
 /// exhaustive search over all possible precoding matrices specified in a codebook that is
 /// compatible to 3GPP TS 38.214 Type-I.
+///
+/// With the TrackingMode attribute, a wideband PMI update first evaluates, for each rank, only
+/// the previous i1 and its neighbors in the codebook (NrCbTypeOne::GetNeighborI1s). The
+/// exhaustive search is only done when the capacity of the tracked precoders dropped by more than
+/// TrackingMaxCapacityDrop with respect to the capacity found by the last exhaustive search, or
+/// when the last exhaustive search is older than TrackingFullSearchPeriod.
 class NrPmSearchFull : public NrPmSearch
 {
   public:
@@ -49,13 +60,38 @@ class NrPmSearchFull : public NrPmSearch
     /// @param attrVal the value of the attribute
     void SetCodebookAttribute(const std::string& attrName, const AttributeValue& attrVal);
 
+    /// @brief Get the number of wideband PMI updates done by tracking the previous PMI.
+    /// @return the number of tracking updates whose result was used
+    uint64_t GetTrackingHits() const;
+
+    /// @brief Get the number of tracking updates that fell back to the exhaustive search, since
+    /// the capacity dropped by more than the TrackingMaxCapacityDrop attribute.
+    /// @return the number of fallbacks to the exhaustive search
+    uint64_t GetTrackingFallbacks() const;
+
   protected:
+    /// @brief A codebook and all its base precoding matrices. Codebooks only depend on their
+    /// attributes, so they are shared by all the instances that use the same configuration.
+    struct Codebook
+    {
+        Ptr<NrCbTypeOne> cb; ///< The codebook
+        /// The base precoding matrices (nGnbPorts * rank), indexed by i1 and i2
+        std::vector<std::vector<ComplexMatrixArray>> basePrecMats;
+    };
+
     struct RankParams
     {
-        Ptr<PrecMatParams> precParams; ///< The precoding parameters (WB/SB PMIs)
-        Ptr<NrCbTypeOne> cb;           ///< The codebook
+        Ptr<PrecMatParams> precParams;            ///< The precoding parameters (WB/SB PMIs)
+        std::shared_ptr<const Codebook> codebook; ///< The codebook and its base precoders
     };
 
+    /// @brief Get the codebook for the configuration of a factory, from a process-wide cache.
+    /// The codebook is created, initialized, and its base precoding matrices are computed the
+    /// first time that a configuration is used.
+    /// @param factory the factory of the codebook, with all its attributes set
+    /// @return the codebook and its base precoding matrices
+    static std::shared_ptr<const Codebook> GetCodebook(const ObjectFactory& factory);
+
     /// @brief Update the WB and/or SB PMI, or neither.
     /// @param rbNormChanMat the interference-normed channel matrix per RB
     /// @param pmiUpdate the struct defining if updates to SB or WB PMI are necessary
@@ -65,6 +101,36 @@ class NrPmSearchFull : public NrPmSearch
     /// @param rbNormChanMat the interference-normed channel matrix per RB
     void UpdateAllPrecoding(const NrIntfNormChanMat& rbNormChanMat);
 
+    /// @brief For all ranks, update the optimum precoding matrices by only evaluating the previous
+    /// wideband PMI and its neighbors. The update is discarded, and the fallback counted, if the
+    /// capacity dropped too much with respect to the capacity found by the last exhaustive search
+    /// (m_fullSearchMetric).
+    /// @param rbNormChanMat the interference-normed channel matrix per RB
+    /// @return true if the precoding matrices were updated, false if an exhaustive search is needed
+    bool TrackAllPrecoding(const NrIntfNormChanMat& rbNormChanMat);
+
+    /// @brief Check whether the next wideband PMI update can be done by tracking the previous
+    /// one, i.e., if tracking is enabled and the last exhaustive search is recent enough.
+    /// @return true if the wideband PMI can be tracked
+    bool IsTrackingAllowed() const;
+
+    /// @brief Get the wideband PMI values evaluated when tracking: the previous one and its
+    /// neighbors in the codebook.
+    /// @param rank the rank (number of MIMO layers)
+    /// @param i1 the previous wideband PMI
+    /// @return the candidate values of i1
+    std::vector<size_t> GetTrackingI1Candidates(uint8_t rank, size_t i1) const;
+
+    /// @brief Check whether the performance metric of a tracking update is acceptable, with
+    /// respect to the one of the last exhaustive search, and count the hit or the fallback.
+    /// @param perfMetric the performance metric (capacity) of the tracked precoding
+    /// @return true if the tracked precoding can be used
+    bool AcceptTrackedMetric(double perfMetric);
+
+    /// @brief Record an exhaustive wideband PMI search, which restarts the full search period.
+    /// @param perfMetric the performance metric (capacity) of the optimal precoding
+    void NotifyFullSearch(double perfMetric);
+
     /// @brief For all ranks, update the opt subband PMI assuming previous value of wideband PMI.
     /// @param rbNormChanMat the interference-normed channel matrix per RB
     void UpdateSubbandPrecoding(const NrIntfNormChanMat& rbNormChanMat);
@@ -84,28 +150,32 @@ class NrPmSearchFull : public NrPmSearch
                                                        size_t i1,
                                                        uint8_t rank) const;
 
-    /// @brief Create the subband precoding matrices for the given wideband precoding.
+    /// @brief Get the base precoding matrices for the given wideband precoding.
     /// @param i1 the index of the wideband precoding matrix W1
     /// @param rank the rank (number of MIMO layers)
-    /// @param nSubbands the number of subbands (desired number of pages in each precoding matrix)
-    /// @return a vector of all possible precoding matrices for fixed i1 and rank
-    std::vector<ComplexMatrixArray> CreateSubbandPrecoders(size_t i1,
-                                                           uint8_t rank,
-                                                           size_t nSubbands) const;
-
-    static ComplexMatrixArray ExpandPrecodingMatrix(ComplexMatrixArray basePrecMat,
-                                                    size_t nSubbands);
+    /// @return the base precoding matrices (nGnbPorts * rank * 1) for all values of i2
+    const std::vector<ComplexMatrixArray>& GetBasePrecoders(size_t i1, uint8_t rank) const;
 
     /// @brief Compute the Shannon capacity for each possible precoding matrix in each subband.
     /// @param sbNormChanMat the interference-normed channel matrix per subband
-    /// @param allPrecMats a vector of all possible subband precoding matrices for fixed i1 and rank
+    /// @param allPrecMats a vector of all possible subband precoding matrices for fixed i1 and
+    /// rank. Each of them is either a 3D matrix with one page per subband, or a 2D matrix that
+    /// is applied to all subbands.
     /// @return a matrix with the capacity values (nSubbands x allPrecMats.size())
     DoubleMatrixArray ComputeCapacityForPrecoders(
         const NrIntfNormChanMat& sbNormChanMat,
-        std::vector<ComplexMatrixArray> allPrecMats) const;
+        const std::vector<ComplexMatrixArray>& allPrecMats) const;
 
     std::vector<RankParams> m_rankParams; ///< The parameters (PMI values, codebook) for each rank
     ObjectFactory m_cbFactory;            ///< The factory used to create the codebooks
+
+    bool m_tracking{false};          ///< Whether the wideband PMI is tracked between updates
+    double m_trackingMaxDrop{0.1};   ///< Maximum relative capacity drop of a tracking update
+    Time m_trackingFullSearchPeriod; ///< Maximum time between exhaustive searches when tracking
+    std::optional<Time> m_lastFullSearch; ///< Time of the last exhaustive wideband PMI search
+    double m_fullSearchMetric{0.0};       ///< Performance metric of the last exhaustive search
+    TracedValue<uint64_t> m_trackingHits{0};      ///< Number of tracking updates used
+    TracedValue<uint64_t> m_trackingFallbacks{0}; ///< Number of tracking updates discarded
 };
 
 } // namespace ns3
@@ -5,15 +5,10 @@
 #include "nr-pm-search-maleki.h"
 
 #include "nr-cb-type-one-sp.h"
-#include "pybind11/numpy.h"
-#include "pybind11/pybind11.h"
 
 #include "ns3/angles.h"
 
 #include <algorithm>
-#include <pybind11/embed.h>
-
-namespace py = pybind11;
 
 namespace ns3
 {
@@ -35,8 +30,6 @@ NrPmSearchMaleki::NrPmSearchMaleki()
 {
 }
 
-py::scoped_interpreter* g_interpreter = nullptr;
-
 PmCqiInfo
 NrPmSearchMaleki::CreateCqiFeedbackMimo(const NrMimoSignal& rxSignalRb, PmiUpdate pmiUpdate)
 {
@@ -60,70 +53,25 @@ NrPmSearchMaleki::CreateCqiFeedbackMimo(const NrMimoSignal& rxSignalRb, PmiUpdat
         //  Retrieve number of ports and oversampling factors
         int N1, N2, O1, O2;
         {
-            auto codeBook = DynamicCast<NrCbTypeOneSp>(m_rankParams[1].cb);
+            auto codeBook = DynamicCast<NrCbTypeOneSp>(m_rankParams[1].codebook->cb);
             N1 = codeBook->m_n1;
             N2 = codeBook->m_n2;
             O1 = codeBook->m_o1;
             O2 = codeBook->m_o2;
         }
 
-        // Start the interpreter and keep it alive
-        if (!g_interpreter)
-        {
-            g_interpreter = new py::scoped_interpreter{};
-        }
-
-        // Create a non-owning py::array_t from the valarray data using the same shape
-        std::vector<size_t> shape = {sbNormChanMat.GetNumPages(),
-                                     sbNormChanMat.GetNumRows(),
-                                     sbNormChanMat.GetNumCols()};
-        std::vector<size_t> strides = {sizeof(std::complex<double>) * sbNormChanMat.GetNumRows() *
-                                           sbNormChanMat.GetNumCols(),
-                                       sizeof(std::complex<double>),
-                                       sizeof(std::complex<double>) * sbNormChanMat.GetNumCols()};
-        py::array HPython = py::array(py::buffer_info(
-            const_cast<std::complex<double>*>(&sbNormChanMat.GetValues()[0]), // Pointer to data
-            sizeof(std::complex<double>),                                     // Size of one scalar
-            py::format_descriptor<std::complex<double>>::format(), // Type format descriptor
-            3,                                                     // Number of dimensions
-            shape,                                                 // Buffer dimensions
-            strides                                                // Strides for each dimension
-            ));
-
-        // Transform numpy array into pyttb Tensor
-        py::module_ pyttb = py::module_::import("pyttb");
-        py::object tensor = pyttb.attr("tensor")(HPython);
-
-        //  Calculate the HOSVD
-        auto hosvdResult = pyttb.attr("hosvd")(tensor, 1e-3, -1);
-
-        // Extract U2 and U3 (equivalent of us = hosvdResult.u)
-        py::list us = hosvdResult.attr("factor_matrices");
-
-        // Slice the first column of both U2 and U3 matrices (equivalent of us[1][:,0] and
-        // us[2][:,0])
-        py::object slice_all = py::slice(py::none(), py::none(), py::none());
-        py::array u1FirstColumnPython = us[1].attr("__getitem__")(py::make_tuple(slice_all, 0));
-        py::array u2FirstColumnPython = us[2].attr("__getitem__")(py::make_tuple(slice_all, 0));
-
-        // Convert the first columns to std::vectors
-        std::vector<std::complex<double>> u1, u2;
-        for (int i = 0; i < u1FirstColumnPython.attr("__len__")().cast<int>(); i++)
-        {
-            u1.push_back(u1FirstColumnPython.attr("__getitem__")(i).cast<std::complex<double>>());
-        }
-        for (int i = 0; i < u2FirstColumnPython.attr("__len__")().cast<int>(); i++)
-        {
-            u2.push_back(u2FirstColumnPython.attr("__getitem__")(i).cast<std::complex<double>>());
-        }
+        // Calculate the HOSVD of the subband channel tensor, and take the first columns
+        // of the factor matrices of the receive and transmit port modes
+        auto u1 = sbNormChanMat.ComputeHosvdFactor(0, 1e-3);
+        auto u2 = sbNormChanMat.ComputeHosvdFactor(1, 1e-3);
 
-        // At this point we have u1 and u2 first columns
-        // of left singular vectors U2 and U3 from HOSVD
-        auto sumConjugate = [](std::vector<std::complex<double>>& u, int limit, int offset) {
+        // The first columns of u1 and u2 are the dominant left singular vectors
+        // of the receive and transmit port unfoldings
+        auto sumConjugate = [](const ComplexMatrixArray& u, int limit, int offset) {
             std::complex<double> sum{0.0, 0.0};
             for (int k = 0; k < limit; k++)
             {
-                sum += std::conj(u[k]) * u[(k + offset) % u.size()];
+                sum += std::conj(u(k, 0)) * u((k + offset) % u.GetNumRows(), 0);
             }
             return sum;
         };
@@ -146,7 +94,7 @@ NrPmSearchMaleki::CreateCqiFeedbackMimo(const NrMimoSignal& rxSignalRb, PmiUpdat
         ComplexMatrixArray bestPrec;
         for (auto rank : m_ranks)
         {
-            auto codeBook = DynamicCast<NrCbTypeOneSp>(m_rankParams[rank].cb);
+            auto codeBook = DynamicCast<NrCbTypeOneSp>(m_rankParams[rank].codebook->cb);
             if (!codeBook)
             {
                 NS_FATAL_ERROR(
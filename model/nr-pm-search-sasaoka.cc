@@ -33,7 +33,7 @@ NrPmSearchSasaoka::FindOptSubbandPrecoding(const NrIntfNormChanMat& sbNormChanMa
     auto Hcorr = NrIntfNormChanMat(sbNormChanMat.HermitianTranspose() * sbNormChanMat);
 
     // Extract codebook for rank and the number of I2 entries
-    auto& cb = m_rankParams[m_periodMaxRank].cb;
+    const auto& cb = m_rankParams[m_periodMaxRank].codebook->cb;
     auto numI2 = cb->GetNumI2();
 
     // Create an I2 entry per subband
@@ -43,7 +43,7 @@ NrPmSearchSasaoka::FindOptSubbandPrecoding(const NrIntfNormChanMat& sbNormChanMa
     for (auto i2 = size_t{0}; i2 < numI2; i2++)
     {
         // Get band precoding matrix
-        auto basePrecMat = cb->GetBasePrecMat(i1, i2);
+        const auto& basePrecMat = GetBasePrecoders(i1, m_periodMaxRank)[i2];
 
         // Copy precoding matrix to test all bands at once
         auto extendedPrecMat = basePrecMat.MakeNCopies(numSubbands);
@@ -122,7 +122,7 @@ NrPmSearchSasaoka::CreateCqiFeedbackMimo(const NrMimoSignal& rxSignalRb, PmiUpda
         m_periodMaxRank = SelectRank(Hcorr);
 
         // Find the optimal wideband PMI i1 and sub-band i2
-        auto& cb = m_rankParams[m_periodMaxRank].cb;
+        const auto& cb = m_rankParams[m_periodMaxRank].codebook->cb;
         auto numI1 = cb->GetNumI1();
 
         Ptr<PrecMatParams> tempMax;
@@ -0,0 +1,20 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-rbg-mask.h"
+
+namespace ns3
+{
+
+std::ostream&
+operator<<(std::ostream& os, const NrRbgMask& mask)
+{
+    for (auto bit : mask)
+    {
+        os << (int)bit;
+    }
+    return os;
+}
+
+} // namespace ns3
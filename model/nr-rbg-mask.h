@@ -0,0 +1,533 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_RBG_MASK_H
+#define NR_RBG_MASK_H
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief Compact mask of RBGs, one bit per RBG
+ *
+ * The bits are stored in 64-bit words, so that the set operations between masks (e.g.,
+ * applying the notching mask, or removing the RBGs already used by a HARQ retransmission)
+ * process 64 RBGs at a time, and counting or finding the set RBGs uses the popcount and
+ * count-trailing-zeros instructions. Masks of up to NUM_INLINE_WORDS * 64 RBGs, which covers
+ * the 275 PRBs of a NR carrier with one PRB per RBG, are stored inline and do not allocate.
+ *
+ * For compatibility with the code that used std::vector<bool>, the class can be constructed
+ * from a std::vector<bool> or an initializer list, and offers size(), at(), operator[] and
+ * const iterators over the bits (e.g., for std::count or range-based for loops). The bits
+ * are modified with Set() and Reset().
+ */
+class NrRbgMask
+{
+  public:
+    /// Value returned by FindFirst and FindNext when there is no set bit
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    /**
+     * @brief Const iterator over the bits of the mask
+     */
+    class ConstIterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag; //!< Iterator category
+        using value_type = bool;                             //!< Value type
+        using difference_type = std::ptrdiff_t;              //!< Difference type
+        using pointer = void;                                //!< Pointer type
+        using reference = bool;                              //!< Reference type
+
+        ConstIterator() = default;
+
+        /**
+         * @brief Create an iterator
+         * @param mask the mask
+         * @param pos the position of the bit
+         */
+        ConstIterator(const NrRbgMask* mask, size_t pos)
+            : m_mask(mask),
+              m_pos(pos)
+        {
+        }
+
+        /// @return the value of the bit
+        bool operator*() const
+        {
+            return m_mask->Test(m_pos);
+        }
+
+        /// @return this iterator, moved to the next bit
+        ConstIterator& operator++()
+        {
+            ++m_pos;
+            return *this;
+        }
+
+        /// @return a copy of this iterator before moving it to the next bit
+        ConstIterator operator++(int)
+        {
+            auto ret = *this;
+            ++m_pos;
+            return ret;
+        }
+
+        /**
+         * @brief Compare two iterators
+         * @param o the other iterator
+         * @return true if both point to the same bit
+         */
+        bool operator==(const ConstIterator& o) const
+        {
+            return m_pos == o.m_pos && m_mask == o.m_mask;
+        }
+
+      private:
+        const NrRbgMask* m_mask{nullptr}; //!< The mask
+        size_t m_pos{0};                  //!< The position of the bit
+    };
+
+    NrRbgMask() = default;
+
+    /**
+     * @brief Create a mask with all the bits to the same value
+     * @param size the number of RBGs
+     * @param value the value of all the bits
+     */
+    explicit NrRbgMask(size_t size, bool value = false)
+    {
+        resize(size, value);
+    }
+
+    /**
+     * @brief Create a mask from a list of values
+     * @param values the value of each RBG
+     */
+    NrRbgMask(std::initializer_list<bool> values)
+    {
+        Assign(values.begin(), values.end(), values.size());
+    }
+
+    /**
+     * @brief Create a mask from a vector of booleans
+     * @param values the value of each RBG
+     */
+    NrRbgMask(const std::vector<bool>& values)
+    {
+        Assign(values.begin(), values.end(), values.size());
+    }
+
+    /**
+     * @brief Convert the mask to a vector of booleans
+     * @return the value of each RBG
+     */
+    std::vector<bool> ToVector() const
+    {
+        return std::vector<bool>(begin(), end());
+    }
+
+    /// @return the number of RBGs
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /// @return true if the mask has no RBG
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief Change the number of RBGs
+     * @param size the new number of RBGs
+     * @param value the value of the added bits
+     */
+    void resize(size_t size, bool value = false)
+    {
+        const size_t oldSize = m_size;
+        SetNumWords(NumWords(size));
+        m_size = size;
+        if (size > oldSize && value)
+        {
+            SetRange(oldSize, size);
+        }
+        ClearUnusedBits();
+    }
+
+    /**
+     * @brief Get the value of a bit
+     * @param i the RBG index
+     * @return true if the RBG is set
+     */
+    bool Test(size_t i) const
+    {
+        NS_ASSERT_MSG(i < m_size, "RBG " << i << " out of a mask of " << m_size);
+        return (Words()[i / 64] >> (i % 64)) & 1;
+    }
+
+    /**
+     * @brief Get the value of a bit
+     * @param i the RBG index
+     * @return true if the RBG is set
+     */
+    bool at(size_t i) const
+    {
+        return Test(i);
+    }
+
+    /**
+     * @brief Get the value of a bit
+     * @param i the RBG index
+     * @return true if the RBG is set
+     */
+    bool operator[](size_t i) const
+    {
+        return Test(i);
+    }
+
+    /**
+     * @brief Set the value of a bit
+     * @param i the RBG index
+     * @param value the new value
+     */
+    void Set(size_t i, bool value = true)
+    {
+        NS_ASSERT_MSG(i < m_size, "RBG " << i << " out of a mask of " << m_size);
+        const uint64_t bit = uint64_t{1} << (i % 64);
+        if (value)
+        {
+            Words()[i / 64] |= bit;
+        }
+        else
+        {
+            Words()[i / 64] &= ~bit;
+        }
+    }
+
+    /**
+     * @brief Clear a bit
+     * @param i the RBG index
+     */
+    void Reset(size_t i)
+    {
+        Set(i, false);
+    }
+
+    /**
+     * @brief Set all the bits to the same value
+     * @param value the value
+     */
+    void SetAll(bool value)
+    {
+        std::fill_n(Words(), NumWords(m_size), value ? ~uint64_t{0} : 0);
+        ClearUnusedBits();
+    }
+
+    /// @return the number of set RBGs
+    size_t Count() const
+    {
+        size_t count = 0;
+        const uint64_t* words = Words();
+        for (size_t w = 0; w < NumWords(m_size); ++w)
+        {
+            count += std::popcount(words[w]);
+        }
+        return count;
+    }
+
+    /// @return true if at least one RBG is set
+    bool Any() const
+    {
+        const uint64_t* words = Words();
+        return std::any_of(words, words + NumWords(m_size), [](uint64_t w) { return w != 0; });
+    }
+
+    /// @return true if no RBG is set
+    bool None() const
+    {
+        return !Any();
+    }
+
+    /// @return the index of the first set RBG, or NPOS if there is none
+    size_t FindFirst() const
+    {
+        return FindFrom(0);
+    }
+
+    /**
+     * @brief Find the next set RBG after a position
+     * @param pos the position
+     * @return the index of the first set RBG after pos, or NPOS if there is none
+     */
+    size_t FindNext(size_t pos) const
+    {
+        return FindFrom(pos + 1);
+    }
+
+    /**
+     * @brief Keep only the RBGs that are also set in another mask
+     * @param o the other mask, with the same size
+     * @return this mask
+     */
+    NrRbgMask& operator&=(const NrRbgMask& o)
+    {
+        NS_ASSERT(o.m_size == m_size);
+        uint64_t* words = Words();
+        const uint64_t* other = o.Words();
+        for (size_t w = 0; w < NumWords(m_size); ++w)
+        {
+            words[w] &= other[w];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Set the RBGs that are set in another mask
+     * @param o the other mask, with the same size
+     * @return this mask
+     */
+    NrRbgMask& operator|=(const NrRbgMask& o)
+    {
+        NS_ASSERT(o.m_size == m_size);
+        uint64_t* words = Words();
+        const uint64_t* other = o.Words();
+        for (size_t w = 0; w < NumWords(m_size); ++w)
+        {
+            words[w] |= other[w];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Clear the RBGs that are set in another mask
+     * @param o the other mask, with the same size
+     * @return this mask
+     */
+    NrRbgMask& AndNot(const NrRbgMask& o)
+    {
+        NS_ASSERT(o.m_size == m_size);
+        uint64_t* words = Words();
+        const uint64_t* other = o.Words();
+        for (size_t w = 0; w < NumWords(m_size); ++w)
+        {
+            words[w] &= ~other[w];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Check whether two masks have set RBGs in common
+     * @param o the other mask, with the same size
+     * @return true if at least one RBG is set in both masks
+     */
+    bool Intersects(const NrRbgMask& o) const
+    {
+        NS_ASSERT(o.m_size == m_size);
+        const uint64_t* words = Words();
+        const uint64_t* other = o.Words();
+        for (size_t w = 0; w < NumWords(m_size); ++w)
+        {
+            if (words[w] & other[w])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Check whether all the set RBGs of this mask are also set in another mask
+     * @param o the other mask, with the same size
+     * @return true if no RBG is set in this mask but not in the other one
+     */
+    bool IsSubsetOf(const NrRbgMask& o) const
+    {
+        NS_ASSERT(o.m_size == m_size);
+        const uint64_t* words = Words();
+        const uint64_t* other = o.Words();
+        for (size_t w = 0; w < NumWords(m_size); ++w)
+        {
+            if (words[w] & ~other[w])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Compare two masks
+     * @param o the other mask
+     * @return true if both have the same size and the same RBGs set
+     */
+    bool operator==(const NrRbgMask& o) const
+    {
+        return m_size == o.m_size && std::equal(Words(), Words() + NumWords(m_size), o.Words());
+    }
+
+    /// @return an iterator to the first bit
+    ConstIterator begin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    /// @return an iterator past the last bit
+    ConstIterator end() const
+    {
+        return ConstIterator(this, m_size);
+    }
+
+  private:
+    /// Number of words stored inside the object
+    static constexpr size_t NUM_INLINE_WORDS = 5;
+
+    /**
+     * @brief Get the number of words of a mask
+     * @param size the number of RBGs
+     * @return the number of 64-bit words
+     */
+    static size_t NumWords(size_t size)
+    {
+        return (size + 63) / 64;
+    }
+
+    /// @return the words of the mask
+    uint64_t* Words()
+    {
+        return m_heapWords.empty() ? m_inlineWords.data() : m_heapWords.data();
+    }
+
+    /// @return the words of the mask
+    const uint64_t* Words() const
+    {
+        return m_heapWords.empty() ? m_inlineWords.data() : m_heapWords.data();
+    }
+
+    /**
+     * @brief Change the number of words, keeping the current ones and zeroing the new ones
+     * @param numWords the number of words
+     */
+    void SetNumWords(size_t numWords)
+    {
+        const size_t oldNumWords = NumWords(m_size);
+        if (numWords <= NUM_INLINE_WORDS)
+        {
+            if (!m_heapWords.empty())
+            {
+                std::copy_n(m_heapWords.begin(), numWords, m_inlineWords.begin());
+                m_heapWords.clear();
+            }
+            std::fill(m_inlineWords.begin() + std::min(oldNumWords, numWords),
+                      m_inlineWords.end(),
+                      0);
+        }
+        else
+        {
+            if (m_heapWords.empty())
+            {
+                m_heapWords.assign(m_inlineWords.begin(), m_inlineWords.end());
+            }
+            m_heapWords.resize(numWords, 0);
+        }
+    }
+
+    /// Clear the bits of the last word that are after the last RBG
+    void ClearUnusedBits()
+    {
+        if (m_size % 64 != 0)
+        {
+            Words()[m_size / 64] &= (uint64_t{1} << (m_size % 64)) - 1;
+        }
+    }
+
+    /**
+     * @brief Set the bits of a range
+     * @param begin the first RBG
+     * @param end the RBG after the last one
+     */
+    void SetRange(size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            Words()[i / 64] |= uint64_t{1} << (i % 64);
+        }
+    }
+
+    /**
+     * @brief Copy the bits from a sequence of booleans
+     * @param first the first value
+     * @param last the end of the values
+     * @param size the number of values
+     */
+    template <class It>
+    void Assign(It first, It last, size_t size)
+    {
+        resize(size);
+        SetAll(false);
+        size_t i = 0;
+        for (auto it = first; it != last; ++it, ++i)
+        {
+            if (*it)
+            {
+                Set(i);
+            }
+        }
+    }
+
+    /**
+     * @brief Find the first set RBG from a position
+     * @param pos the position, included in the search
+     * @return the index of the first set RBG from pos, or NPOS if there is none
+     */
+    size_t FindFrom(size_t pos) const
+    {
+        if (pos >= m_size)
+        {
+            return NPOS;
+        }
+        const uint64_t* words = Words();
+        size_t w = pos / 64;
+        uint64_t word = words[w] & (~uint64_t{0} << (pos % 64));
+        while (word == 0)
+        {
+            if (++w >= NumWords(m_size))
+            {
+                return NPOS;
+            }
+            word = words[w];
+        }
+        return w * 64 + std::countr_zero(word);
+    }
+
+    std::array<uint64_t, NUM_INLINE_WORDS> m_inlineWords{}; //!< Words, for small masks
+    std::vector<uint64_t> m_heapWords; //!< Words, for masks of more than the inline words
+    size_t m_size{0};                  //!< Number of RBGs
+};
+
+/**
+ * @brief Print the mask as a sequence of 0s and 1s
+ * @param os the output stream
+ * @param mask the mask
+ * @return the output stream
+ */
+std::ostream& operator<<(std::ostream& os, const NrRbgMask& mask);
+
+} // namespace ns3
+
+#endif /* NR_RBG_MASK_H */
@@ -165,6 +165,27 @@ NrSpectrumPhy::GetTypeId()
                 UintegerValue(1),
                 MakeUintegerAccessor(&NrSpectrumPhy::SetNumPanels, &NrSpectrumPhy::GetNumPanels),
                 MakeUintegerChecker<uint8_t>())
+            .AddAttribute("InterferenceCulling",
+                          "Ignore the signals from other cells whose received power is lower "
+                          "than the noise power by more than InterferenceCullingThreshold in "
+                          "every RB, before computing their channel matrix and adding them to "
+                          "the interference calculations. PSS signals are never ignored.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NrSpectrumPhy::m_interferenceCulling),
+                          MakeBooleanChecker())
+            .AddAttribute("InterferenceCullingThreshold",
+                          "Received power of a signal in an RB relative to the noise power in "
+                          "the RB (dB), including the maximum beamforming gain, below which the "
+                          "signal is ignored when it is below it in all the RBs, when "
+                          "InterferenceCulling is enabled.",
+                          DoubleValue(-30.0),
+                          MakeDoubleAccessor(&NrSpectrumPhy::SetInterferenceCullingThreshold,
+                                             &NrSpectrumPhy::GetInterferenceCullingThreshold),
+                          MakeDoubleChecker<double>())
+            .AddTraceSource("CulledSignals",
+                            "Number of received signals ignored by the interference culling",
+                            MakeTraceSourceAccessor(&NrSpectrumPhy::m_numCulledSignals),
+                            "ns3::TracedValueCallback::Uint64")
             .AddTraceSource("RxPacketTraceGnb",
                             "The no. of packets received and transmitted by the Base Station",
                             MakeTraceSourceAccessor(&NrSpectrumPhy::m_rxPacketTraceGnb),
@@ -538,6 +559,19 @@ NrSpectrumPhy::GetCcaMode1Threshold() const
     return 10.0 * std::log10(m_ccaMode1ThresholdW * 1000.0);
 }
 
+void
+NrSpectrumPhy::SetInterferenceCullingThreshold(double thresholdDb)
+{
+    NS_LOG_FUNCTION(this << thresholdDb);
+    m_interferenceCullingRatio = std::pow(10.0, thresholdDb / 10.0);
+}
+
+double
+NrSpectrumPhy::GetInterferenceCullingThreshold() const
+{
+    return 10.0 * std::log10(m_interferenceCullingRatio);
+}
+
 void
 NrSpectrumPhy::SetUnlicensedMode(bool unlicensedMode)
 {
@@ -567,6 +601,7 @@ NrSpectrumPhy::SetNoisePowerSpectralDensity(const Ptr<const SpectrumValue>& nois
     NS_LOG_FUNCTION(this << noisePsd);
     NS_ASSERT(noisePsd);
     m_rxSpectrumModel = noisePsd->GetSpectrumModel();
+    m_noisePsd = noisePsd;
     m_interferenceData->SetNoisePowerSpectralDensity(noisePsd);
     m_interferenceCtrl->SetNoisePowerSpectralDensity(noisePsd);
     if (m_interferenceSrs)
@@ -649,6 +684,14 @@ NrSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
         return;
     }
 
+    // drop negligible interference before any channel matrix or interference computation
+    if (m_interferenceCulling && IsNegligibleInterference(params))
+    {
+        NS_LOG_INFO("Received power below the interference culling threshold, ignoring signal.");
+        ++m_numCulledSignals;
+        return;
+    }
+
     // phased-array mimo expects a channel
     if (!params->spectrumChannelMatrix &&
         GetSpectrumChannel()->GetPhasedArraySpectrumPropagationLossModel())
@@ -812,6 +855,75 @@ NrSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
     }
 }
 
+bool
+NrSpectrumPhy::IsNegligibleInterference(const Ptr<const SpectrumSignalParameters>& params) const
+{
+    // Keep the signals of this cell, which may be intended for this receiver, and the PSS of
+    // any cell, which are used to measure the neighbor cells
+    if (auto dataParams = DynamicCast<const NrSpectrumSignalParametersDataFrame>(params))
+    {
+        if (dataParams->cellId == GetCellId())
+        {
+            return false;
+        }
+    }
+    else if (auto dlCtrlParams = DynamicCast<const NrSpectrumSignalParametersDlCtrlFrame>(params))
+    {
+        if (dlCtrlParams->cellId == GetCellId() || dlCtrlParams->pss)
+        {
+            return false;
+        }
+    }
+    else if (auto ulCtrlParams = DynamicCast<const NrSpectrumSignalParametersUlCtrlFrame>(params))
+    {
+        if (ulCtrlParams->cellId == GetCellId())
+        {
+            return false;
+        }
+    }
+    else if (auto csiRsParams = DynamicCast<const NrSpectrumSignalParametersCsiRs>(params))
+    {
+        if (csiRsParams->cellId == GetCellId())
+        {
+            return false;
+        }
+    }
+
+    // The received PSD does not include the beamforming gain, which is at most the number of
+    // antenna elements of the transmitter times the number of antenna elements of the receiver
+    double maxArrayGain = 1.0;
+    if (auto rxAntenna = DynamicCast<PhasedArrayModel>(GetAntenna()))
+    {
+        maxArrayGain *= rxAntenna->GetNumElems();
+    }
+    if (params->txPhy)
+    {
+        if (auto txAntenna = DynamicCast<PhasedArrayModel>(params->txPhy->GetAntenna()))
+        {
+            maxArrayGain *= txAntenna->GetNumElems();
+        }
+    }
+
+    // Compare RB by RB: a narrowband signal can be far above the noise in the RBs it occupies
+    // while its total power is negligible with respect to the noise over the whole band
+    NS_ASSERT(m_noisePsd);
+    if (params->psd->GetValuesN() != m_noisePsd->GetValuesN())
+    {
+        return false;
+    }
+    const double ratio = m_interferenceCullingRatio / maxArrayGain;
+    auto noiseIt = m_noisePsd->ConstValuesBegin();
+    for (auto it = params->psd->ConstValuesBegin(); it != params->psd->ConstValuesEnd();
+         ++it, ++noiseIt)
+    {
+        if (*it >= *noiseIt * ratio)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void
 NrSpectrumPhy::StartTxDataFrames(const Ptr<PacketBurst>& pb,
                                  const std::list<Ptr<NrControlMessage>>& ctrlMsgList,
@@ -1543,9 +1655,9 @@ NrSpectrumPhy::GetMimoSinrForRnti(uint16_t rnti, uint8_t rank)
     std::vector<MimoSinrChunk> res;
     for (const auto& chunk : m_mimoSinrPerceived)
     {
-        if (chunk.rnti == rnti)
+        if (chunk->GetSinrChunk().rnti == rnti)
         {
-            res.emplace_back(chunk);
+            res.emplace_back(chunk->GetSinrChunk());
         }
     }
     if (res.empty())
@@ -1620,12 +1732,17 @@ NrSpectrumPhy::CheckTransportBlockCorruptionStatus()
             auto sinrChunks = GetMimoSinrForRnti(expectedTb.m_rnti, expectedTb.m_rank);
             NS_ASSERT(!sinrChunks.empty());
 
-            tbInfo.m_outputOfEM = m_errorModel->GetTbDecodificationStatsMimo(sinrChunks,
-                                                                             expectedTb.m_rbBitmap,
-                                                                             expectedTb.m_tbSize,
-                                                                             expectedTb.m_mcs,
-                                                                             expectedTb.m_rank,
-                                                                             harqInfoList);
+            // Compute the time-domain average of the SINR matrix, and pass it to the error
+            // model in place (i.e., without converting it to a SpectrumValue)
+            auto avgSinrMat = m_errorModel->ComputeAvgSinrMimo(sinrChunks);
+            NS_ASSERT(avgSinrMat.GetNumRows() == expectedTb.m_rank);
+            tbInfo.m_outputOfEM =
+                m_errorModel->GetTbDecodificationStatsMimoSpan(avgSinrMat.GetVectorizedValues(),
+                                                               expectedTb.m_rank,
+                                                               expectedTb.m_rbBitmap,
+                                                               expectedTb.m_tbSize,
+                                                               expectedTb.m_mcs,
+                                                               harqInfoList);
         }
         else
         {
@@ -2015,7 +2132,7 @@ NrSpectrumPhy::AssignStreams(int64_t stream)
 }
 
 void
-NrSpectrumPhy::UpdateMimoSinrPerceived(const std::vector<MimoSinrChunk>& mimoChunks)
+NrSpectrumPhy::UpdateMimoSinrPerceived(const NrMimoChunks& mimoChunks)
 {
     m_mimoSinrPerceived = mimoChunks;
 }
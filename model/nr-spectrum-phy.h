@@ -18,6 +18,7 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/spectrum-channel.h"
 #include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
 
 #include <functional>
 
@@ -305,6 +306,17 @@ class NrSpectrumPhy : public SpectrumPhy
      * @return CCA threshold in dBms
      */
     double GetCcaMode1Threshold() const;
+    /**
+     * @brief Set the received power, relative to the noise power, below which the signals
+     * from other cells are ignored when the interference culling is enabled
+     * @param thresholdDb the threshold in dB
+     */
+    void SetInterferenceCullingThreshold(double thresholdDb);
+    /**
+     * @brief Get the interference culling threshold
+     * @return the threshold in dB, relative to the noise power
+     */
+    double GetInterferenceCullingThreshold() const;
     /**
      * @brief Sets whether to perform in unlicensed mode in which the channel monitoring is enabled
      * @param unlicensedMode if true the unlicensed mode is enabled
@@ -573,10 +585,11 @@ class NrSpectrumPhy : public SpectrumPhy
     void AddCsiImMimoChunkProcessor(const Ptr<NrMimoChunkProcessor>& p);
 
     /// @brief Store the SINR chunks for all received signals at end of interference calculations
-    /// @param sinr The vector of all SINR values of receive signals. A new chunk is generated for
-    /// each different receive signal (for example for each UL reception of a signal from a
-    /// different UE) and at each time instant where the interference changes.
-    void UpdateMimoSinrPerceived(const std::vector<MimoSinrChunk>& sinr);
+    /// @param sinr The chunks of all receive signals, with their SINR values. A new chunk is
+    /// generated for each different receive signal (for example for each UL reception of a signal
+    /// from a different UE) and at each time instant where the interference changes. The chunks
+    /// are shared with the chunk processors, not copied.
+    void UpdateMimoSinrPerceived(const NrMimoChunks& sinr);
     /**
      * @return true if this class is inside an enb/gnb
      */
@@ -652,9 +665,9 @@ class NrSpectrumPhy : public SpectrumPhy
     void NotifyTxDataTrace(Time duration) const;
 
   private:
-    std::vector<MimoSinrChunk>
-        m_mimoSinrPerceived; //!< received SINR values during data reception for TB decoding, to
-                             //!< replace m_sinrPerceived for all (MIMO and SISO) receivers
+    NrMimoChunks m_mimoSinrPerceived; //!< received SINR values during data reception for TB
+                                      //!< decoding, to replace m_sinrPerceived for all (MIMO
+                                      //!< and SISO) receivers
 
     /**
      * @brief Function is called when what is being received is holding data
@@ -743,6 +756,17 @@ class NrSpectrumPhy : public SpectrumPhy
      * @returns an indicator whether the ctrlListMessage contains only SRS message
      */
     bool IsOnlySrs(const std::list<Ptr<NrControlMessage>>& ctrlMsgList);
+    /**
+     * @brief Checks whether a received signal can be ignored by the interference culling.
+     * Only the signals from other cells, except PSS, with received power lower than the noise
+     * power by more than the interference culling threshold in every RB can be ignored. The
+     * received power is increased by the maximum beamforming gain (the product of the number of
+     * antenna elements of the transmitter and of the receiver), as the received PSD does not
+     * include it.
+     * @param params the received signal
+     * @returns true if the signal can be ignored
+     */
+    bool IsNegligibleInterference(const Ptr<const SpectrumSignalParameters>& params) const;
 
     /**
      * @brief Function that is called when the rx signal does not contain an expected channel
@@ -794,6 +818,10 @@ class NrSpectrumPhy : public SpectrumPhy
         false}; //!< Whether this spectrum phy is configure to work in an unlicensed mode.
                 //   Unlicensed mode additionally to licensed mode allows channel monitoring to
                 //   discover if is busy before transmission.
+    bool m_interferenceCulling{false};      //!< Whether negligible interference is ignored
+    double m_interferenceCullingRatio{0.0}; //!< Culling threshold relative to the noise power,
+                                            //!< in linear units
+    Ptr<const SpectrumValue> m_noisePsd;    //!< Noise PSD of the receiver
 
     Ptr<SpectrumChannel> m_channel{
         nullptr}; //!< channel is needed to be able to connect listener spectrum phy (AddRx) or to
@@ -875,6 +903,8 @@ class NrSpectrumPhy : public SpectrumPhy
                                         //!< starts to occupy the channel with data transmission
     TracedCallback<Time> m_txCtrlTrace; //!< trace callback that is notifying when this spectrum phy
                                         //!< starts to occupy the channel with transmission of CTRL
+    TracedValue<uint64_t>
+        m_numCulledSignals{0}; //!< Number of received signals ignored by the interference culling
     TracedCallback<RxPacketTraceParams>
         m_rxPacketTraceGnb; //!< trace callback that is notifying when Gnb received the packet
     TracedCallback<RxPacketTraceParams>
@@ -787,7 +787,7 @@ NrUePhy::PushCtrlAllocations(const SfnSf currentSfnSf)
 
     // The UE does not know anything from the GNB yet, so listen on the default
     // bandwidth.
-    std::vector<bool> rbgBitmask(GetRbNum(), true);
+    NrRbgMask rbgBitmask(GetRbNum(), true);
 
     // The UE still doesn't know the TDD pattern, so just add a DL CTRL
     if (m_tddPattern.empty())
@@ -1874,7 +1874,7 @@ NrUePhy::GetCsiFeedbackType() const
 }
 
 void
-NrUePhy::CsiRsReceived(const std::vector<MimoSignalChunk>& csiRsMimoSignal)
+NrUePhy::CsiRsReceived(const NrMimoChunks& csiRsMimoSignal)
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(csiRsMimoSignal.size() == 1);
@@ -1900,7 +1900,7 @@ NrUePhy::GenerateCsiRsCqi()
 }
 
 void
-NrUePhy::CsiImEnded(const std::vector<MimoSignalChunk>& csiImSignalChunks)
+NrUePhy::CsiImEnded(const NrMimoChunks& csiImSignalChunks)
 {
     NS_LOG_FUNCTION(this);
     // Combine multiple CSI-IM signal chunks into a single channel,
@@ -1918,7 +1918,7 @@ NrUePhy::CsiImEnded(const std::vector<MimoSignalChunk>& csiImSignalChunks)
 }
 
 void
-NrUePhy::PdschMimoReceived(const std::vector<MimoSignalChunk>& pdschMimoChunks)
+NrUePhy::PdschMimoReceived(const NrMimoChunks& pdschMimoChunks)
 {
     NS_LOG_FUNCTION(this);
     // Combine multiple signal chunks into a single channel matrix and interference covariance
@@ -486,7 +486,7 @@ class NrUePhy : public NrPhy
     /// @brief A callback function that is called from NrMimoChunkProcessor
     /// when CSI-RS is being received. It stores the CSI-RS signal information
     /// @param csiRsSignal the structure that represents the CSI-RS signal
-    void CsiRsReceived(const std::vector<MimoSignalChunk>& csiRsSignal);
+    void CsiRsReceived(const NrMimoChunks& csiRsSignal);
     /**
      * @brief Function that will be called in the case that CSI-RS is received, but CSI-IM is
      * disabled and there is no PDSCH in the same slot, so this function will trigger CQI feedback
@@ -507,7 +507,7 @@ class NrUePhy : public NrPhy
      * CSI-RS, and the interference information from this CSI-IM signal.
      * @param csiImSignalChunks Chunks of the interference signals measured during the CSI-IM period
      */
-    void CsiImEnded(const std::vector<MimoSignalChunk>& csiImSignalChunks);
+    void CsiImEnded(const NrMimoChunks& csiImSignalChunks);
     /**
      * @brief Function is called when PDSCH is received by the UE. It contains
      * the channel and interference information of all the PDSCH signals of own gNB
@@ -517,7 +517,7 @@ class NrUePhy : public NrPhy
      * the generation of the CQI feedback if there was CSI-RS in the current slot, or in the case
      * that CSI-RS is disabled, so CQI feedback is only based on PDSCH.
      */
-    void PdschMimoReceived(const std::vector<MimoSignalChunk>& pdschMimoChunks);
+    void PdschMimoReceived(const NrMimoChunks& pdschMimoChunks);
     /**
      * @brief Function is called in different possible scenarios to generate CQI information.
      * For example, this function is called upon PDSCH reception, or upon CSI-IM period. It could be
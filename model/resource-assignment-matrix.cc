@@ -19,8 +19,7 @@ static constexpr ResourceAssignmentMatrix::Rnti CTRL_RESOURCE_RNTI = EMPTY_RESOU
 
 NS_LOG_COMPONENT_DEFINE("ResourceAssignmentMatrix");
 
-ResourceAssignmentMatrix::ResourceAssignmentMatrix(std::vector<bool> notchingMask,
-                                                   uint8_t numSymbols)
+ResourceAssignmentMatrix::ResourceAssignmentMatrix(NrRbgMask notchingMask, uint8_t numSymbols)
 {
     m_notchingMask = notchingMask;
     m_symbolResources.resize(numSymbols);
@@ -324,7 +323,7 @@ void
 ResourceAssignmentMatrix::CheckResourceMatrixFromVarTtiAllocInfo(
     const std::deque<VarTtiAllocInfo>& allocInfo,
     const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap,
-    const std::vector<bool>& notchingMask,
+    const NrRbgMask& notchingMask,
     uint8_t numSym,
     bool plot)
 {
@@ -39,7 +39,7 @@ class ResourceAssignmentMatrix
     using Rnti = uint16_t;
     using Rbg = uint16_t;
 
-    ResourceAssignmentMatrix(std::vector<bool> notchingMask, uint8_t numSymbols);
+    ResourceAssignmentMatrix(NrRbgMask notchingMask, uint8_t numSymbols);
     /**
      * @brief Assigns beam ID to symbols
      *
@@ -190,14 +190,14 @@ class ResourceAssignmentMatrix
      *
      * @param allocInfo - The deque of VarTtiAllocInfo to check
      * @param ueMap - The unordered map of UE information
-     * @param notchingMask - The vector of booleans indicating which RBGs are notching
+     * @param notchingMask - The mask indicating which RBGs are notching
      * @param numSym - The number of symbols in the allocation period
      * @param plot - Whether or not to plot the ResourceAssignmentMatrix
      */
     [[maybe_unused]] static void CheckResourceMatrixFromVarTtiAllocInfo(
         const std::deque<VarTtiAllocInfo>& allocInfo,
         const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap,
-        const std::vector<bool>& notchingMask,
+        const NrRbgMask& notchingMask,
         const uint8_t numSym,
         bool plot = false);
 
@@ -227,7 +227,7 @@ class ResourceAssignmentMatrix
         std::vector<ResourceMatrixEntry> rbgs; ///< Resource for allocation
     };
 
-    std::vector<bool> m_notchingMask; ///< Notching bitmask applied to channel bandwidth
+    NrRbgMask m_notchingMask; ///< Notching bitmask applied to channel bandwidth
     std::vector<bool>
         m_beamIdAssigned; ///< Bitmask indicating whether a beamId was already assigned to a symbol
     std::vector<SymbolResources> m_symbolResources; ///< The allocation resource matrix itself
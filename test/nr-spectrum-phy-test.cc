@@ -5,12 +5,16 @@
 #include "nr-spectrum-phy-test.h"
 
 #include "ns3/beam-manager.h"
+#include "ns3/boolean.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
 #include "ns3/multi-model-spectrum-channel.h"
 #include "ns3/nr-gnb-phy.h"
 #include "ns3/nr-interference.h"
 #include "ns3/nr-spectrum-phy.h"
 #include "ns3/nr-spectrum-value-helper.h"
+#include "ns3/uinteger.h"
+#include "ns3/uniform-planar-array.h"
 
 #include <numeric>
 
@@ -200,6 +204,115 @@ SetNoisePsdTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Save the number of signals ignored by the interference culling
+ * @param numCulledSignals where to save the number
+ * @param oldValue the previous number
+ * @param newValue the current number
+ */
+void
+TestSaveCulledSignals(uint64_t* numCulledSignals, uint64_t oldValue, uint64_t newValue)
+{
+    *numCulledSignals = newValue;
+}
+
+InterferenceCullingTestCase::InterferenceCullingTestCase()
+    : TestCase("NrSpectrumPhy interference culling test case")
+{
+}
+
+void
+InterferenceCullingTestCase::DoRun()
+{
+    const double thresholdDb = -30.0;
+    const uint32_t antennaRows = 2;
+    const uint32_t antennaColumns = 2;
+    // Maximum beamforming gain: the number of elements of the transmitter times the receiver
+    const double maxArrayGainDb = 20 * std::log10(antennaRows * antennaColumns);
+
+    Ptr<MultiModelSpectrumChannel> spectrumChannel = CreateObject<MultiModelSpectrumChannel>();
+    spectrumChannel->AddSpectrumPropagationLossModel(
+        CreateObject<NoLossSpectrumPropagationLossModel>());
+
+    auto createPhy = [&](uint16_t cellId) {
+        Ptr<NrSpectrumPhy> spectrumPhy = CreateObject<NrSpectrumPhy>();
+        spectrumPhy->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+        spectrumPhy->SetChannel(spectrumChannel);
+        Ptr<NrGnbPhy> phy = CreateObject<NrGnbPhy>();
+        phy->InstallSpectrumPhy(spectrumPhy);
+        spectrumPhy->InstallPhy(phy);
+        Ptr<UniformPlanarArray> antenna = CreateObject<UniformPlanarArray>();
+        antenna->SetAttribute("NumRows", UintegerValue(antennaRows));
+        antenna->SetAttribute("NumColumns", UintegerValue(antennaColumns));
+        spectrumPhy->SetAntenna(antenna);
+        Ptr<BeamManager> beamManager = CreateObject<BeamManager>();
+        beamManager->Configure(antenna);
+        phy->DoSetCellId(cellId);
+        return std::make_pair(spectrumPhy, phy);
+    };
+
+    auto [rxPhy, rxGnbPhy] = createPhy(99);
+    auto [txPhy, txGnbPhy] = createPhy(100);
+    rxPhy->SetAttribute("InterferenceCulling", BooleanValue(true));
+    rxPhy->SetAttribute("InterferenceCullingThreshold", DoubleValue(thresholdDb));
+
+    uint64_t numCulledSignals = 0;
+    rxPhy->TraceConnectWithoutContext("CulledSignals",
+                                      MakeBoundCallback(&TestSaveCulledSignals, &numCulledSignals));
+
+    Ptr<const SpectrumModel> sm = NrSpectrumValueHelper::GetSpectrumModel(100, 28e9, 15000);
+    Ptr<const SpectrumValue> noisePsd =
+        NrSpectrumValueHelper::CreateNoisePowerSpectralDensity(5, sm);
+    rxPhy->SetNoisePowerSpectralDensity(noisePsd);
+    spectrumChannel->AddRx(rxPhy);
+
+    // Signal of the other cell, with the given power relative to the noise in the given RBs
+    auto createSignal = [&](double relativePowerDb, uint32_t firstRb, uint32_t numRbs) {
+        Ptr<SpectrumValue> psd = Create<SpectrumValue>(sm);
+        for (uint32_t rb = firstRb; rb < firstRb + numRbs; ++rb)
+        {
+            (*psd)[rb] = noisePsd->ValuesAt(rb) * std::pow(10.0, relativePowerDb / 10.0);
+        }
+        Ptr<NrSpectrumSignalParametersDataFrame> params =
+            Create<NrSpectrumSignalParametersDataFrame>();
+        params->duration = MilliSeconds(1);
+        params->psd = psd;
+        params->cellId = 100;
+        params->txPhy = txPhy;
+        return params;
+    };
+
+    // Narrowband signal: 20 dB below the noise in one RB, i.e., 40 dB below the noise over
+    // the 100 RBs of the band. It is kept.
+    Simulator::Schedule(MilliSeconds(1),
+                        &MultiModelSpectrumChannel::StartTx,
+                        spectrumChannel,
+                        createSignal(-20, 10, 1));
+    // Wideband signal below the threshold in all the RBs, but above it with the maximum
+    // beamforming gain. It is kept.
+    Simulator::Schedule(MilliSeconds(3),
+                        &MultiModelSpectrumChannel::StartTx,
+                        spectrumChannel,
+                        createSignal(thresholdDb - maxArrayGainDb / 2, 0, 100));
+    // Far away wideband signal, below the threshold in all the RBs even with the maximum
+    // beamforming gain. It is ignored.
+    Simulator::Schedule(MilliSeconds(5),
+                        &MultiModelSpectrumChannel::StartTx,
+                        spectrumChannel,
+                        createSignal(thresholdDb - maxArrayGainDb - 10, 0, 100));
+
+    Simulator::Stop(MilliSeconds(8));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(numCulledSignals, 1, "Only the far away wideband signal is ignored");
+
+    rxPhy->Dispose();
+    txPhy->Dispose();
+    rxGnbPhy->Dispose();
+    txGnbPhy->Dispose();
+    Simulator::Destroy();
+}
+
 NrSpectrumPhyTestSuite::NrSpectrumPhyTestSuite()
     : TestSuite("nr-spectrum-phy-test")
 {
@@ -293,6 +406,8 @@ NrSpectrumPhyTestSuite::NrSpectrumPhyTestSuite()
                                             input.numerology),
                     Duration::QUICK);
     }
+
+    AddTestCase(new InterferenceCullingTestCase(), Duration::QUICK);
 }
 
 // Allocate an instance of this TestSuite
@@ -90,6 +90,27 @@ class SetNoisePsdTestCase : public TestCase
     uint8_t m_numerology;    //!< numerology to be used to create spectrum phy
 };
 
+/**
+ * @ingroup test
+ * @brief Test of the interference culling of NrSpectrumPhy. Signals of another cell are sent
+ * to a receiver with interference culling enabled, and the number of ignored signals reported
+ * by the CulledSignals trace source is checked: a narrowband signal, strong in the only RB it
+ * occupies but negligible over the whole band, must be kept, and a wideband signal below the
+ * threshold in all the RBs, even with the maximum beamforming gain, must be ignored.
+ */
+class InterferenceCullingTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    InterferenceCullingTestCase();
+
+  private:
+    /**
+     * @brief Run test case
+     */
+    void DoRun() override;
+};
+
 /**
  * @ingroup test
  * The test suite that runs different test cases to test NrSpectrumPhy.
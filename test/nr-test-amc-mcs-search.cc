@@ -0,0 +1,257 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/enum.h"
+#include "ns3/nr-amc.h"
+#include "ns3/nr-eesm-cc-t1.h"
+#include "ns3/nr-eesm-cc-t2.h"
+#include "ns3/nr-eesm-ir-t1.h"
+#include "ns3/nr-eesm-ir-t2.h"
+#include "ns3/nr-mimo-matrices.h"
+#include "ns3/nr-spectrum-value-helper.h"
+#include "ns3/object-factory.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <optional>
+#include <sstream>
+
+/**
+ * @file nr-test-amc-mcs-search.cc
+ * @ingroup test
+ *
+ * @brief This test validates the bisection search of the maximum MCS in NrAmc against
+ * the linear search. For several error models, number of RBs and SINR profiles, the
+ * test computes whether each MCS satisfies the target TBLER. When this validity is
+ * monotone in the MCS, the bisection (with and without a seed MCS) must return the same
+ * MCS and CQI as the linear search. Otherwise, the bisection must return a valid MCS
+ * whose successor is not valid.
+ */
+namespace ns3
+{
+
+/**
+ * @brief Testcase for the MCS search algorithms of NrAmc
+ */
+class NrAmcMcsSearchTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case for one error model type
+     * @param errorModelType the TypeId of the error model
+     */
+    NrAmcMcsSearchTestCase(const TypeId& errorModelType)
+        : TestCase("MCS search with " + errorModelType.GetName()),
+          m_errorModelType(errorModelType)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Create an NrAmc with the given search algorithm
+     * @param search the MCS search algorithm
+     * @return the AMC object
+     */
+    Ptr<NrAmc> CreateAmc(NrAmc::McsSearch search) const;
+
+    /**
+     * @brief Check the bisection result against the per-MCS validity
+     * @param valid the validity of each MCS
+     * @param linearMcs the MCS returned by the linear search
+     * @param bisectionMcs the MCS returned by the bisection search
+     * @param desc a description of the case, for the error messages
+     */
+    void CheckBisection(const std::vector<bool>& valid,
+                        uint8_t linearMcs,
+                        uint8_t bisectionMcs,
+                        const std::string& desc);
+
+    void TestSiso(uint32_t numRbs, double meanDb, double spreadDb);
+    void TestMimo(uint32_t numRbs, uint8_t rank, double meanDb, double spreadDb);
+
+    TypeId m_errorModelType; //!< The error model type
+};
+
+Ptr<NrAmc>
+NrAmcMcsSearchTestCase::CreateAmc(NrAmc::McsSearch search) const
+{
+    ObjectFactory factory;
+    factory.SetTypeId(NrAmc::GetTypeId());
+    factory.Set("AmcModel", EnumValue(NrAmc::ErrorModel));
+    factory.Set("ErrorModelType", TypeIdValue(m_errorModelType));
+    factory.Set("McsSearch", EnumValue(search));
+    return factory.Create<NrAmc>();
+}
+
+void
+NrAmcMcsSearchTestCase::CheckBisection(const std::vector<bool>& valid,
+                                       uint8_t linearMcs,
+                                       uint8_t bisectionMcs,
+                                       const std::string& desc)
+{
+    // Validity is monotone if it is a (possibly empty) run of valid MCSs, followed by
+    // a (possibly empty) run of non-valid ones
+    size_t firstInvalid = 0;
+    while (firstInvalid < valid.size() && valid[firstInvalid])
+    {
+        ++firstInvalid;
+    }
+    bool monotone = true;
+    for (size_t mcs = firstInvalid; mcs < valid.size(); ++mcs)
+    {
+        monotone = monotone && !valid[mcs];
+    }
+
+    if (monotone)
+    {
+        NS_TEST_ASSERT_MSG_EQ(+bisectionMcs,
+                              +linearMcs,
+                              "Bisection differs from linear search with monotone TBLER, "
+                                  << desc);
+    }
+    else if (bisectionMcs == 0 && !valid[0])
+    {
+        // No valid MCS was found, which is fine if MCS 0 is not valid
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(valid.at(bisectionMcs),
+                              true,
+                              "Bisection returned a non-valid MCS, " << desc);
+        bool isBoundary = (bisectionMcs + 1U == valid.size()) || !valid.at(bisectionMcs + 1);
+        NS_TEST_ASSERT_MSG_EQ(isBoundary,
+                              true,
+                              "Bisection did not stop at a boundary, " << desc);
+    }
+}
+
+void
+NrAmcMcsSearchTestCase::TestSiso(uint32_t numRbs, double meanDb, double spreadDb)
+{
+    auto linear = CreateAmc(NrAmc::LinearSearch);
+    auto bisection = CreateAmc(NrAmc::BisectionSearch);
+
+    Ptr<const SpectrumModel> sm = NrSpectrumValueHelper::GetSpectrumModel(numRbs, 3.5e9, 30e3);
+    SpectrumValue sinr(sm);
+    std::vector<int> map;
+    for (uint32_t i = 0; i < numRbs; ++i)
+    {
+        sinr[i] = std::pow(10.0, (meanDb + spreadDb * std::sin(1.7 * i)) / 10);
+        map.push_back(static_cast<int>(i));
+    }
+
+    ObjectFactory emFactory;
+    emFactory.SetTypeId(m_errorModelType);
+    auto em = emFactory.Create<NrErrorModel>();
+    auto tblerEvaluator = em->GetTblerEvaluator(sinr, map);
+    std::vector<bool> valid;
+    for (uint8_t mcs = 0; mcs <= em->GetMaxMcs(); ++mcs)
+    {
+        auto tbSize = linear->CalculateTbSize(mcs, 1, numRbs);
+        valid.push_back(!(tblerEvaluator(tbSize, mcs) > 0.1));
+    }
+
+    uint8_t linearMcs = 0;
+    auto linearCqi = linear->CreateCqiFeedbackSiso(sinr, linearMcs);
+
+    for (std::optional<uint8_t> seed : {std::optional<uint8_t>{},
+                                        std::optional<uint8_t>{0},
+                                        std::optional<uint8_t>{linearMcs},
+                                        std::optional<uint8_t>{em->GetMaxMcs()}})
+    {
+        std::stringstream desc;
+        desc << "SISO " << numRbs << " RBs, mean " << meanDb << " dB, spread " << spreadDb
+             << " dB, seed " << (seed ? std::to_string(*seed) : "none");
+
+        uint8_t bisectionMcs = 0;
+        auto bisectionCqi = bisection->CreateCqiFeedbackSiso(sinr, bisectionMcs, seed);
+        CheckBisection(valid, linearMcs, bisectionMcs, desc.str());
+        if (bisectionMcs == linearMcs)
+        {
+            NS_TEST_ASSERT_MSG_EQ(+bisectionCqi, +linearCqi, "CQI differs, " << desc.str());
+        }
+    }
+}
+
+void
+NrAmcMcsSearchTestCase::TestMimo(uint32_t numRbs, uint8_t rank, double meanDb, double spreadDb)
+{
+    auto linear = CreateAmc(NrAmc::LinearSearch);
+    auto bisection = CreateAmc(NrAmc::BisectionSearch);
+
+    DoubleMatrixArray sinrArr(rank, numRbs);
+    std::vector<int> map;
+    for (uint32_t i = 0; i < numRbs; ++i)
+    {
+        for (uint8_t layer = 0; layer < rank; ++layer)
+        {
+            sinrArr(layer, i) =
+                std::pow(10.0, (meanDb - 3.0 * layer + spreadDb * std::sin(1.7 * i)) / 10);
+        }
+        map.push_back(static_cast<int>(i));
+    }
+    NrSinrMatrix sinrMat{sinrArr};
+
+    ObjectFactory emFactory;
+    emFactory.SetTypeId(m_errorModelType);
+    auto em = emFactory.Create<NrErrorModel>();
+    auto tblerEvaluator = em->GetTblerEvaluatorMimo(sinrMat, map);
+    std::vector<bool> valid;
+    for (uint8_t mcs = 0; mcs <= em->GetMaxMcs(); ++mcs)
+    {
+        auto tbSize =
+            linear->CalculateTbSize(mcs, rank, numRbs * NrAmc::NR_AMC_NUM_SYMBOLS_DEFAULT);
+        valid.push_back(!(tblerEvaluator(tbSize, mcs) > 0.1));
+    }
+
+    auto linearMcs = linear->GetMcs(sinrMat);
+    for (std::optional<uint8_t> seed : {std::optional<uint8_t>{},
+                                        std::optional<uint8_t>{0},
+                                        std::optional<uint8_t>{linearMcs},
+                                        std::optional<uint8_t>{em->GetMaxMcs()}})
+    {
+        std::stringstream desc;
+        desc << "rank " << +rank << ", " << numRbs << " RBs, mean " << meanDb << " dB, spread "
+             << spreadDb << " dB, seed " << (seed ? std::to_string(*seed) : "none");
+        CheckBisection(valid, linearMcs, bisection->GetMcs(sinrMat, seed), desc.str());
+    }
+}
+
+void
+NrAmcMcsSearchTestCase::DoRun()
+{
+    for (uint32_t numRbs : {1, 3, 12, 52, 273})
+    {
+        for (double spreadDb : {0.0, 6.0, 15.0})
+        {
+            for (double meanDb = -10.0; meanDb <= 32.0; meanDb += 1.5)
+            {
+                TestSiso(numRbs, meanDb, spreadDb);
+                TestMimo(numRbs, 2, meanDb, spreadDb);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Test suite for the MCS search algorithms of NrAmc
+ */
+class NrTestAmcMcsSearch : public TestSuite
+{
+  public:
+    NrTestAmcMcsSearch()
+        : TestSuite("nr-test-amc-mcs-search", Type::UNIT)
+    {
+        AddTestCase(new NrAmcMcsSearchTestCase(NrEesmCcT1::GetTypeId()), Duration::QUICK);
+        AddTestCase(new NrAmcMcsSearchTestCase(NrEesmCcT2::GetTypeId()), Duration::QUICK);
+        AddTestCase(new NrAmcMcsSearchTestCase(NrEesmIrT1::GetTypeId()), Duration::QUICK);
+        AddTestCase(new NrAmcMcsSearchTestCase(NrEesmIrT2::GetTypeId()), Duration::QUICK);
+    }
+};
+
+static NrTestAmcMcsSearch NrTestAmcMcsSearchTestSuite; //!< Nr test suite
+
+} // namespace ns3
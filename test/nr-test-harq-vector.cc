@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/nr-mac-harq-vector.h"
+#include "ns3/test.h"
+
+#include <random>
+#include <set>
+
+/**
+ * @file nr-test-harq-vector.cc
+ * @ingroup test
+ *
+ * @brief Unit test of NrMacHarqVector. Processes are randomly inserted and erased, and the
+ * vector is compared against a std::set of the active IDs: the size, the free ID returned by
+ * FirstAvailableId, the search of the active processes and the iteration over all the processes.
+ */
+namespace ns3
+{
+
+/**
+ * @brief Testcase that compares NrMacHarqVector with a std::set of the active IDs
+ */
+class NrHarqVectorTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case for one number of processes
+     * @param size the number of HARQ processes
+     */
+    NrHarqVectorTestCase(uint8_t size)
+        : TestCase("NrMacHarqVector with " + std::to_string(size) + " processes"),
+          m_size(size)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    uint8_t m_size; //!< Number of HARQ processes
+};
+
+void
+NrHarqVectorTestCase::DoRun()
+{
+    NrMacHarqVector harq;
+    harq.SetMaxSize(m_size);
+    std::set<uint8_t> active;
+    std::mt19937 rng(m_size);
+    const HarqProcess process(true, HarqProcess::WAITING_FEEDBACK, 0, nullptr);
+
+    for (uint32_t iter = 0; iter < 500; ++iter)
+    {
+        if (rng() % 2 == 0)
+        {
+            uint8_t expectedId = NrMacHarqVector::NO_ID;
+            for (uint8_t i = 0; i < m_size; ++i)
+            {
+                if (active.count(i) == 0)
+                {
+                    expectedId = i;
+                    break;
+                }
+            }
+            NS_TEST_ASSERT_MSG_EQ(+harq.FirstAvailableId(), +expectedId, "Wrong free ID");
+            NS_TEST_ASSERT_MSG_EQ(harq.CanInsert(), (active.size() < m_size), "Wrong CanInsert");
+
+            uint8_t id = NrMacHarqVector::NO_ID;
+            NS_TEST_ASSERT_MSG_EQ(harq.Insert(&id, process),
+                                  (expectedId != NrMacHarqVector::NO_ID),
+                                  "Wrong result of the insertion");
+            NS_TEST_ASSERT_MSG_EQ(+id, +expectedId, "Wrong inserted ID");
+            if (expectedId != NrMacHarqVector::NO_ID)
+            {
+                active.insert(id);
+            }
+        }
+        else if (!active.empty())
+        {
+            auto it = active.begin();
+            std::advance(it, rng() % active.size());
+            harq.Erase(*it);
+            active.erase(it);
+        }
+
+        NS_TEST_ASSERT_MSG_EQ(harq.Size(), active.size(), "Wrong size");
+
+        auto id = harq.FindFirstActive();
+        for (const auto expectedId : active)
+        {
+            NS_TEST_ASSERT_MSG_EQ(+id, +expectedId, "Wrong active process");
+            id = harq.FindNextActive(id);
+        }
+        NS_TEST_ASSERT_MSG_EQ(+id, +NrMacHarqVector::NO_ID, "Unexpected active process");
+
+        uint32_t count = 0;
+        for (auto it = harq.Begin(); it != harq.End(); ++it, ++count)
+        {
+            NS_TEST_ASSERT_MSG_EQ(static_cast<uint32_t>(it->first),
+                                  count,
+                                  "Wrong ID of the iterated process");
+            NS_TEST_ASSERT_MSG_EQ(it->second.m_active,
+                                  (active.count(it->first) == 1),
+                                  "Wrong state of process " << count);
+            NS_TEST_ASSERT_MSG_EQ((harq.Find(it->first) == it), true, "Wrong Find");
+        }
+        NS_TEST_ASSERT_MSG_EQ(count, m_size, "Wrong number of iterated processes");
+        NS_TEST_ASSERT_MSG_EQ((harq.Find(m_size) == harq.End()), true, "Found a missing ID");
+    }
+}
+
+/**
+ * @brief Test suite for NrMacHarqVector
+ */
+class NrTestHarqVector : public TestSuite
+{
+  public:
+    NrTestHarqVector()
+        : TestSuite("nr-test-harq-vector", Type::UNIT)
+    {
+        for (uint8_t size : {1, 16, 20, 31, 32})
+        {
+            AddTestCase(new NrHarqVectorTestCase(size), Duration::QUICK);
+        }
+    }
+};
+
+static NrTestHarqVector NrTestHarqVectorTestSuite; //!< Nr test suite
+
+} // namespace ns3
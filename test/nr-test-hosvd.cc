@@ -0,0 +1,193 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-test-mimo-utils.h"
+
+#include "ns3/nr-mimo-matrices.h"
+#include "ns3/test.h"
+
+#include <Eigen/Dense>
+#include <Eigen/SVD>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file nr-test-hosvd.cc
+ * @ingroup test
+ *
+ * @brief Unit test of NrIntfNormChanMat::ComputeHosvdFactor. For each mode of several channel
+ * tensors, the mode-n unfolding is built explicitly and decomposed with Eigen::JacobiSVD. The
+ * factor matrix must have the rank given by the truncation rule (the discarded squared singular
+ * values sum at most tolerance^2 * ||H||^2 / 3), and its columns must be the leading left
+ * singular vectors of the unfolding, up to a phase.
+ */
+namespace ns3
+{
+
+/**
+ * @brief Testcase that compares the HOSVD factors with the SVD of the explicit unfoldings
+ */
+class NrHosvdTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case for one channel tensor
+     * @param nRows the number of rows of the channel (RX ports)
+     * @param nCols the number of columns of the channel (TX ports)
+     * @param nPages the number of pages of the channel (RBs)
+     * @param lowRank whether the tensor has rank 2 in all modes, plus a small perturbation
+     */
+    NrHosvdTestCase(size_t nRows, size_t nCols, size_t nPages, bool lowRank)
+        : TestCase("HOSVD of a " + std::to_string(nRows) + "x" + std::to_string(nCols) + "x" +
+                   std::to_string(nPages) + (lowRank ? " low-rank" : "") + " channel"),
+          m_nRows(nRows),
+          m_nCols(nCols),
+          m_nPages(nPages),
+          m_lowRank(lowRank)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    size_t m_nRows;  //!< Number of rows
+    size_t m_nCols;  //!< Number of columns
+    size_t m_nPages; //!< Number of pages
+    bool m_lowRank;  //!< Whether the tensor has rank 2 in all modes, plus a small perturbation
+};
+
+void
+NrHosvdTestCase::DoRun()
+{
+    ComplexMatrixArray chanMat(m_nRows, m_nCols, m_nPages);
+    double normSquared = 0.0;
+    for (size_t k = 0; k < m_nPages; ++k)
+    {
+        for (size_t i = 0; i < m_nRows; ++i)
+        {
+            for (size_t j = 0; j < m_nCols; ++j)
+            {
+                std::complex<double> value;
+                if (m_lowRank)
+                {
+                    // Sum of two rank-one tensors, with a perturbation well below the tolerance
+                    value = NrTestChannelValue(i, 0, 0) * NrTestChannelValue(j, 1, 0) *
+                                NrTestChannelValue(k, 2, 0) +
+                            0.5 * NrTestChannelValue(i, 3, 1) * NrTestChannelValue(j, 4, 1) *
+                                NrTestChannelValue(k, 5, 1) +
+                            1e-6 * NrTestChannelValue(i, j, k);
+                }
+                else
+                {
+                    value = NrTestChannelValue(i, j, k);
+                }
+                chanMat(i, j, k) = value;
+                normSquared += std::norm(value);
+            }
+        }
+    }
+    NrIntfNormChanMat normChanMat{chanMat};
+
+    const size_t sizes[] = {m_nRows, m_nCols, m_nPages};
+    for (size_t mode = 0; mode < 3; ++mode)
+    {
+        // Explicit mode-n unfolding: the rows are the indexes of the mode, the columns all the
+        // combinations of the indexes of the other two modes
+        Eigen::MatrixXcd unfolding(sizes[mode], m_nRows * m_nCols * m_nPages / sizes[mode]);
+        for (size_t k = 0; k < m_nPages; ++k)
+        {
+            for (size_t i = 0; i < m_nRows; ++i)
+            {
+                for (size_t j = 0; j < m_nCols; ++j)
+                {
+                    const size_t idx[] = {i, j, k};
+                    const size_t row = idx[mode];
+                    const size_t col = (mode == 0)   ? j + m_nCols * k
+                                       : (mode == 1) ? i + m_nRows * k
+                                                     : i + m_nRows * j;
+                    unfolding(row, col) = chanMat(i, j, k);
+                }
+            }
+        }
+        Eigen::JacobiSVD<Eigen::MatrixXcd> svd(unfolding, Eigen::ComputeThinU);
+        const auto& singularValues = svd.singularValues();
+        const auto numSingularValues = static_cast<size_t>(singularValues.size());
+
+        // The tolerances are above the rounding errors, because some unfoldings are rank deficient
+        for (double tolerance : {1e-6, 1e-3, 1e-2, 0.5})
+        {
+            // Keep the singular vectors until the discarded squared singular values would sum
+            // more than tolerance^2 * ||H||^2 / 3, keeping at least one of them
+            const double maxDiscarded = tolerance * tolerance * normSquared / 3;
+            size_t expectedRank = numSingularValues;
+            double discarded = 0.0;
+            while (expectedRank > 1)
+            {
+                const double next = std::pow(singularValues(expectedRank - 1), 2);
+                if (discarded + next > maxDiscarded)
+                {
+                    break;
+                }
+                discarded += next;
+                --expectedRank;
+            }
+
+            auto factor = normChanMat.ComputeHosvdFactor(mode, tolerance);
+            NS_TEST_ASSERT_MSG_EQ(factor.GetNumRows(), sizes[mode], "Wrong factor size");
+            NS_TEST_ASSERT_MSG_EQ(factor.GetNumCols(),
+                                  expectedRank,
+                                  "Wrong rank of mode " << mode << ", tolerance " << tolerance);
+            if (m_lowRank && tolerance == 1e-2)
+            {
+                NS_TEST_ASSERT_MSG_EQ(factor.GetNumCols(),
+                                      2,
+                                      "The low-rank tensor has rank 2 in mode " << mode);
+            }
+
+            // Compare the vectors of the significant and well separated singular values, which are
+            // unique up to a phase
+            for (size_t c = 0; c < std::min<size_t>(factor.GetNumCols(), numSingularValues); ++c)
+            {
+                const double sv = singularValues(c);
+                const double minGap = 1e-3 * singularValues(0);
+                const bool distinct =
+                    (c == 0 || singularValues(c - 1) - sv > minGap) &&
+                    (c + 1 >= numSingularValues || sv - singularValues(c + 1) > minGap);
+                if (!distinct || sv < minGap)
+                {
+                    continue;
+                }
+                std::complex<double> innerProduct{0.0};
+                for (size_t r = 0; r < sizes[mode]; ++r)
+                {
+                    innerProduct += std::conj(svd.matrixU()(r, c)) * factor(r, c);
+                }
+                NS_TEST_ASSERT_MSG_EQ_TOL(std::abs(innerProduct),
+                                          1.0,
+                                          1e-6,
+                                          "Wrong singular vector " << c << " of mode " << mode);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Test suite for the HOSVD of the channel
+ */
+class NrTestHosvd : public TestSuite
+{
+  public:
+    NrTestHosvd()
+        : TestSuite("nr-test-hosvd", Type::UNIT)
+    {
+        AddTestCase(new NrHosvdTestCase(2, 4, 12, false), Duration::QUICK);
+        AddTestCase(new NrHosvdTestCase(4, 8, 17, false), Duration::QUICK);
+        AddTestCase(new NrHosvdTestCase(4, 2, 3, false), Duration::QUICK);
+        AddTestCase(new NrHosvdTestCase(4, 8, 17, true), Duration::QUICK);
+    }
+};
+
+static NrTestHosvd NrTestHosvdTestSuite; //!< Nr test suite
+
+} // namespace ns3
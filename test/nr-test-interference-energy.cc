@@ -0,0 +1,232 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/nr-interference.h"
+#include "ns3/nr-spectrum-value-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+/**
+ * @file nr-test-interference-energy.cc
+ * @ingroup test
+ *
+ * @brief This test validates the energy detection of NrInterference. Many signals, with
+ * pseudo-random powers and durations, start and end so that about fifteen of them overlap,
+ * while some of them are received. At regular times, the channel busy duration returned
+ * by NrInterference::GetEnergyDuration for several thresholds is compared against the one
+ * computed from scratch from the powers of the signals added so far.
+ */
+namespace ns3
+{
+
+/**
+ * @brief Testcase for the energy detection of NrInterference
+ */
+class NrInterferenceEnergyTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case
+     */
+    NrInterferenceEnergyTestCase()
+        : TestCase("Energy detection with many overlapping signals")
+    {
+    }
+
+  private:
+    /// @brief A signal added to the interference object
+    struct AddedSignal
+    {
+        Time start;    ///< Start of the transmission
+        Time end;      ///< End of the transmission
+        double powerW; ///< Power of the signal in W
+    };
+
+    void DoRun() override;
+
+    /**
+     * @brief Add a signal to the interference object, and optionally start receiving it
+     * @param spd the power spectral density of the signal
+     * @param duration the duration of the signal
+     * @param receive whether to receive the signal
+     */
+    void AddSignal(Ptr<const SpectrumValue> spd, Time duration, bool receive);
+
+    /**
+     * @brief Get the power of the signals added so far at a given time
+     * @param t the time
+     * @return the sum of the powers of the signals with start <= t < end
+     */
+    double GetPowerAt(Time t) const;
+
+    /**
+     * @brief Compare GetEnergyDuration against the duration computed from the added signals
+     * @param energyW the energy detection threshold
+     */
+    void CheckEnergyDuration(double energyW);
+
+    Ptr<NrInterference> m_interference; //!< The interference object under test
+    std::vector<AddedSignal> m_signals; //!< The signals added so far
+    Time m_rxEnd;                       //!< End of the last reception
+    uint32_t m_numChecks{0};            //!< Number of non-ambiguous checks with a busy channel
+};
+
+void
+NrInterferenceEnergyTestCase::AddSignal(Ptr<const SpectrumValue> spd, Time duration, bool receive)
+{
+    m_interference->AddSignal(spd, duration);
+    m_signals.push_back({Simulator::Now(), Simulator::Now() + duration, Integral(*spd)});
+
+    if (receive && Simulator::Now() >= m_rxEnd)
+    {
+        // Stop receiving at a time when no signal starts or ends, and no check is done
+        m_rxEnd = Simulator::Now() + MicroSeconds(41);
+        m_interference->StartRx(spd);
+        Simulator::Schedule(MicroSeconds(41), &NrInterference::EndRx, m_interference);
+    }
+}
+
+double
+NrInterferenceEnergyTestCase::GetPowerAt(Time t) const
+{
+    double powerW = 0.0;
+    for (const auto& signal : m_signals)
+    {
+        if (signal.start <= t && t < signal.end)
+        {
+            powerW += signal.powerW;
+        }
+    }
+    return powerW;
+}
+
+void
+NrInterferenceEnergyTestCase::CheckEnergyDuration(double energyW)
+{
+    auto now = Simulator::Now();
+
+    // The power changes when a signal starts or ends, the channel is busy until it goes below
+    // the threshold after one of the future changes, or until the last signal ends
+    std::vector<Time> changes;
+    for (const auto& signal : m_signals)
+    {
+        changes.push_back(signal.start);
+        changes.push_back(signal.end);
+    }
+    std::sort(changes.begin(), changes.end());
+
+    // The powers are summed in a different order than in NrInterference, skip the checks in
+    // which the result depends on the rounding
+    auto isAmbiguous = [energyW](double powerW) {
+        return std::abs(powerW - energyW) < 1e-9 * energyW;
+    };
+
+    auto powerW = GetPowerAt(now);
+    auto ambiguous = isAmbiguous(powerW);
+    auto expected = Seconds(0);
+    if (powerW > energyW)
+    {
+        expected = changes.back() - now;
+        for (const auto& t : changes)
+        {
+            if (t <= now)
+            {
+                continue;
+            }
+            auto futurePowerW = GetPowerAt(t);
+            ambiguous = ambiguous || isAmbiguous(futurePowerW);
+            if (futurePowerW < energyW)
+            {
+                expected = t - now;
+                break;
+            }
+        }
+    }
+    if (ambiguous)
+    {
+        return;
+    }
+    m_numChecks += (powerW > energyW) ? 1 : 0;
+
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetEnergyDuration(energyW),
+                          expected,
+                          "Wrong busy duration at " << now << " with threshold " << energyW);
+}
+
+void
+NrInterferenceEnergyTestCase::DoRun()
+{
+    const uint32_t numRbs = 52;
+    const uint32_t numSignals = 300;
+    auto sm = NrSpectrumValueHelper::GetSpectrumModel(numRbs, 3.5e9, 30e3);
+
+    m_interference = CreateObject<NrInterference>();
+    auto noise = Create<SpectrumValue>(sm);
+    (*noise) = 1e-20;
+    m_interference->SetNoisePowerSpectralDensity(noise);
+
+    // Signals start at 4k + 1 us and end at 4m + 3 us, while the checks are done at 4j us, so
+    // that no two of these events happen at the same time. Signals that end at the same time
+    // are fine, since the power can only decrease at that time.
+    std::mt19937 rng(11);
+    std::vector<uint32_t> slots(2 * numSignals);
+    std::iota(slots.begin(), slots.end(), 0);
+    std::shuffle(slots.begin(), slots.end(), rng);
+    slots.resize(numSignals);
+    std::sort(slots.begin(), slots.end());
+
+    double meanPowerW = 0.0;
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+        auto spd = Create<SpectrumValue>(sm);
+        (*spd) = 1e-18 * (1 + rng() % 100);
+        auto start = MicroSeconds(4 * slots[i] + 1);
+        auto duration = MicroSeconds(4 * (1 + rng() % 60) + 2);
+        meanPowerW += Integral(*spd) / numSignals;
+        Simulator::Schedule(start,
+                            &NrInterferenceEnergyTestCase::AddSignal,
+                            this,
+                            spd,
+                            duration,
+                            i % 10 == 0);
+    }
+
+    for (uint32_t j = 0; j <= 2 * numSignals + 70; ++j)
+    {
+        for (double factor : {0.5, 2.0, 5.0, 10.0, 20.0})
+        {
+            Simulator::Schedule(MicroSeconds(4 * j),
+                                &NrInterferenceEnergyTestCase::CheckEnergyDuration,
+                                this,
+                                factor * meanPowerW);
+        }
+    }
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_numChecks, 1000, "Too few checks with a busy channel");
+}
+
+/**
+ * @brief Test suite for the energy detection of NrInterference
+ */
+class NrTestInterferenceEnergy : public TestSuite
+{
+  public:
+    NrTestInterferenceEnergy()
+        : TestSuite("nr-test-interference-energy", Type::UNIT)
+    {
+        AddTestCase(new NrInterferenceEnergyTestCase(), Duration::QUICK);
+    }
+};
+
+static NrTestInterferenceEnergy NrTestInterferenceEnergyTestSuite; //!< Nr test suite
+
+} // namespace ns3
@@ -0,0 +1,457 @@
+// Copyright (c) 2024 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-test-mimo-utils.h"
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/nr-interference.h"
+#include "ns3/nr-mimo-chunk-processor.h"
+#include "ns3/nr-spectrum-value-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+
+/**
+ * @file nr-test-interference-mimo.cc
+ * @ingroup test
+ *
+ * @brief This test validates the interference-and-noise covariance matrices that
+ * NrInterference reports to the MIMO chunk processors. Interfering signals start and
+ * end during two receptions, one of them with a precoding matrix, and the signal of
+ * the first reception keeps being transmitted during the second one. For each chunk,
+ * the covariance matrix is compared against the noise plus the covariance of all the
+ * signals that are active during the chunk, computed from scratch. A second chunk
+ * processor must report the same chunks, since they are shared by all the processors.
+ *
+ * It also checks that the SINR of a single precoding matrix applied to all RBs is identical
+ * to the SINR of its copies, that the whitened channel and the MIMO SINR are identical when
+ * the per-RB computations are split among several threads (global value "NrMimoThreads"),
+ * and that the single-precision SINR (global value "NrMimoSinglePrecision") is within 0.01 dB
+ * of the double-precision one.
+ */
+namespace ns3
+{
+
+/**
+ * @brief Testcase for the MIMO interference covariance of NrInterference
+ */
+class NrInterferenceMimoTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case
+     */
+    NrInterferenceMimoTestCase()
+        : TestCase("MIMO out-of-cell interference covariance")
+    {
+    }
+
+  private:
+    /// @brief A signal and the time interval during which it is transmitted
+    struct ActiveSignal
+    {
+        Ptr<SpectrumSignalParameters> params; ///< The signal
+        Time start;                           ///< Start of the transmission
+        Time end;                             ///< End of the transmission
+    };
+
+    void DoRun() override;
+
+    /**
+     * @brief Create a signal with a pseudo-random channel and an optional precoding matrix
+     * @param seed the seed of the channel values
+     * @param nTxPorts the number of TX ports
+     * @param rank the number of layers of the precoding matrix, or 0 for no precoding
+     * @return the signal parameters
+     */
+    Ptr<SpectrumSignalParameters> CreateSignal(double seed, size_t nTxPorts, size_t rank) const;
+
+    /**
+     * @brief Add a signal to the interference object and remember its active interval
+     * @param params the signal
+     * @param duration the duration of the signal
+     */
+    void AddSignal(Ptr<SpectrumSignalParameters> params, Time duration);
+
+    /**
+     * @brief Start a reception
+     * @param params the received signal
+     */
+    void StartRx(Ptr<SpectrumSignalParameters> params);
+
+    /**
+     * @brief Check the chunks of a finished reception against the brute-force covariance
+     * @param chunks the signal chunks of the reception
+     */
+    void CheckChunks(const NrMimoChunks& chunks);
+
+    /**
+     * @brief Check that a second chunk processor gets the same signal chunks
+     * @param chunks the signal chunks of the reception
+     */
+    void CheckSharedChunks(const NrMimoChunks& chunks);
+
+    /**
+     * @brief Check the dimensions of the SINR chunks of a finished reception
+     * @param chunks the SINR chunks of the reception
+     */
+    void CheckSinrChunks(const NrMimoChunks& chunks);
+
+    static constexpr size_t NUM_RBS = 6;      //!< Number of RBs
+    static constexpr size_t NUM_RX_PORTS = 2; //!< Number of RX ports
+
+    Ptr<NrInterference> m_interference;       //!< The interference object under test
+    Ptr<SpectrumValue> m_noisePsd;            //!< The noise PSD
+    Ptr<SpectrumValue> m_psd;                 //!< The PSD of all the signals
+    std::vector<ActiveSignal> m_signals;      //!< All the signals that were added
+    Ptr<SpectrumSignalParameters> m_rxSignal; //!< The signal of the current reception
+    Time m_rxStart;                           //!< Start of the current reception
+    NrMimoChunks m_lastChunks;                //!< The chunks of the last reception
+    uint32_t m_numReceptions{0};              //!< Number of finished receptions
+    uint32_t m_numSinrReceptions{0};          //!< Number of finished receptions with SINR
+};
+
+Ptr<SpectrumSignalParameters>
+NrInterferenceMimoTestCase::CreateSignal(double seed, size_t nTxPorts, size_t rank) const
+{
+    auto params = Create<SpectrumSignalParameters>();
+    params->psd = m_psd;
+    auto chanMat = Create<ComplexMatrixArray>(NUM_RX_PORTS, nTxPorts, NUM_RBS);
+    for (size_t iRb = 0; iRb < NUM_RBS; ++iRb)
+    {
+        for (size_t i = 0; i < NUM_RX_PORTS; ++i)
+        {
+            for (size_t j = 0; j < nTxPorts; ++j)
+            {
+                auto x = seed + 1.3 * iRb + 2.1 * i + 0.7 * j;
+                (*chanMat)(i, j, iRb) =
+                    std::complex<double>{0.1 * std::sin(x), 0.1 * std::cos(3 * x)};
+            }
+        }
+    }
+    params->spectrumChannelMatrix = chanMat;
+    if (rank > 0)
+    {
+        auto precMat = Create<ComplexMatrixArray>(nTxPorts, rank, NUM_RBS);
+        for (size_t iRb = 0; iRb < NUM_RBS; ++iRb)
+        {
+            for (size_t j = 0; j < nTxPorts; ++j)
+            {
+                for (size_t l = 0; l < rank; ++l)
+                {
+                    auto x = seed + 0.9 * iRb + 1.7 * j + 0.3 * l;
+                    (*precMat)(j, l, iRb) = std::complex<double>{std::cos(x), std::sin(2 * x)};
+                }
+            }
+        }
+        params->precodingMatrix = precMat;
+    }
+    return params;
+}
+
+void
+NrInterferenceMimoTestCase::AddSignal(Ptr<SpectrumSignalParameters> params, Time duration)
+{
+    m_signals.push_back({params, Simulator::Now(), Simulator::Now() + duration});
+    m_interference->AddSignalMimo(params, duration);
+}
+
+void
+NrInterferenceMimoTestCase::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    m_rxSignal = params;
+    m_rxStart = Simulator::Now();
+    m_interference->StartRxMimo(params);
+}
+
+void
+NrInterferenceMimoTestCase::CheckChunks(const NrMimoChunks& chunks)
+{
+    ++m_numReceptions;
+    m_lastChunks = chunks;
+    NS_TEST_ASSERT_MSG_EQ(chunks.empty(), false, "No chunk was evaluated");
+
+    auto chunkStart = m_rxStart;
+    for (const auto& mimoChunk : chunks)
+    {
+        const auto& chunk = mimoChunk->GetSignalChunk();
+        auto chunkEnd = chunkStart + chunk.dur;
+
+        // Brute-force covariance of the noise plus all signals active during the chunk
+        NrCovMat expected{ComplexMatrixArray(NUM_RX_PORTS, NUM_RX_PORTS, NUM_RBS)};
+        for (size_t iRb = 0; iRb < NUM_RBS; ++iRb)
+        {
+            for (size_t i = 0; i < NUM_RX_PORTS; ++i)
+            {
+                expected(i, i, iRb) = m_noisePsd->ValuesAt(iRb);
+            }
+        }
+        for (const auto& signal : m_signals)
+        {
+            if (signal.params == m_rxSignal || signal.start > chunkStart || signal.end < chunkEnd)
+            {
+                continue;
+            }
+            const auto& chanMat = *signal.params->spectrumChannelMatrix;
+            if (signal.params->precodingMatrix)
+            {
+                expected.AddInterferenceSignal(chanMat * (*signal.params->precodingMatrix));
+            }
+            else
+            {
+                expected.AddInterferenceSignal(chanMat);
+            }
+        }
+
+        const auto& actual = chunk.interfNoiseCov;
+        NS_TEST_ASSERT_MSG_EQ(actual.GetNumPages(), NUM_RBS, "Wrong number of RBs");
+        for (size_t iRb = 0; iRb < NUM_RBS; ++iRb)
+        {
+            for (size_t i = 0; i < NUM_RX_PORTS; ++i)
+            {
+                for (size_t j = 0; j < NUM_RX_PORTS; ++j)
+                {
+                    NS_TEST_ASSERT_MSG_LT(std::abs(actual.Elem(i, j, iRb) - expected(i, j, iRb)),
+                                          1e-12,
+                                          "Wrong covariance in reception "
+                                              << m_numReceptions << ", chunk starting at "
+                                              << chunkStart.As(Time::MS) << ", RB " << iRb);
+                }
+            }
+        }
+        chunkStart = chunkEnd;
+    }
+}
+
+void
+NrInterferenceMimoTestCase::CheckSharedChunks(const NrMimoChunks& chunks)
+{
+    NS_TEST_ASSERT_MSG_EQ(chunks.size(), m_lastChunks.size(), "Different number of chunks");
+    for (size_t c = 0; c < chunks.size(); ++c)
+    {
+        // The chunk processors share the same chunks, they do not get copies
+        NS_TEST_ASSERT_MSG_EQ((chunks[c] == m_lastChunks[c]), true, "Chunk " << c << " copied");
+    }
+}
+
+void
+NrInterferenceMimoTestCase::CheckSinrChunks(const NrMimoChunks& chunks)
+{
+    ++m_numSinrReceptions;
+    NS_TEST_ASSERT_MSG_EQ(chunks.size(), m_lastChunks.size(), "Different number of chunks");
+    for (const auto& mimoChunk : chunks)
+    {
+        const auto& chunk = mimoChunk->GetSinrChunk();
+        // Both received signals have rank 2
+        NS_TEST_ASSERT_MSG_EQ(chunk.mimoSinr.GetNumRows(), 2, "Wrong SINR rank");
+        NS_TEST_ASSERT_MSG_EQ(chunk.mimoSinr.GetNumCols(), NUM_RBS, "Wrong number of RBs");
+    }
+}
+
+void
+NrInterferenceMimoTestCase::DoRun()
+{
+    auto sm = NrSpectrumValueHelper::GetSpectrumModel(NUM_RBS, 3.5e9, 30e3);
+    m_noisePsd = Create<SpectrumValue>(sm);
+    (*m_noisePsd) = 1e-4;
+    m_psd = Create<SpectrumValue>(sm);
+    (*m_psd) = 1e-3;
+
+    m_interference = CreateObject<NrInterference>();
+    auto cp = Create<NrMimoChunkProcessor>();
+    cp->AddSignalCallback(MakeCallback(&NrInterferenceMimoTestCase::CheckChunks, this));
+    m_interference->AddMimoChunkProcessor(cp);
+    // A second chunk processor reports the same chunks, as well as the SINR
+    auto cp2 = Create<NrMimoChunkProcessor>();
+    cp2->AddSignalCallback(MakeCallback(&NrInterferenceMimoTestCase::CheckSharedChunks, this));
+    cp2->AddSinrCallback(MakeCallback(&NrInterferenceMimoTestCase::CheckSinrChunks, this));
+    m_interference->AddMimoChunkProcessor(cp2);
+    m_interference->SetNoisePowerSpectralDensity(m_noisePsd);
+
+    auto intfA = CreateSignal(0.1, 4, 0);
+    auto intfB = CreateSignal(1.2, 4, 2);
+    auto intfC = CreateSignal(2.3, 2, 0);
+    auto intfD = CreateSignal(3.4, 4, 1);
+    auto rx1 = CreateSignal(4.5, 4, 2);
+    auto rx2 = CreateSignal(5.6, 4, 2);
+
+    // First reception from 1 to 7 ms, while interferers start and end
+    Simulator::Schedule(MilliSeconds(0),
+                        &NrInterferenceMimoTestCase::AddSignal,
+                        this,
+                        intfA,
+                        MilliSeconds(12));
+    Simulator::Schedule(MilliSeconds(0),
+                        &NrInterferenceMimoTestCase::AddSignal,
+                        this,
+                        intfB,
+                        MilliSeconds(4));
+    Simulator::Schedule(MilliSeconds(1),
+                        &NrInterferenceMimoTestCase::AddSignal,
+                        this,
+                        rx1,
+                        MilliSeconds(8));
+    Simulator::Schedule(MilliSeconds(1), &NrInterferenceMimoTestCase::StartRx, this, rx1);
+    Simulator::Schedule(MilliSeconds(2),
+                        &NrInterferenceMimoTestCase::AddSignal,
+                        this,
+                        intfC,
+                        MilliSeconds(1));
+    Simulator::Schedule(MilliSeconds(5),
+                        &NrInterferenceMimoTestCase::AddSignal,
+                        this,
+                        intfD,
+                        MilliSeconds(5));
+    Simulator::Schedule(MilliSeconds(7), &NrInterference::EndRx, m_interference);
+
+    // Second reception from 8 to 11 ms. The first received signal interferes until 9 ms.
+    Simulator::Schedule(MilliSeconds(8),
+                        &NrInterferenceMimoTestCase::AddSignal,
+                        this,
+                        rx2,
+                        MilliSeconds(3));
+    Simulator::Schedule(MilliSeconds(8), &NrInterferenceMimoTestCase::StartRx, this, rx2);
+    Simulator::Schedule(MilliSeconds(11), &NrInterference::EndRx, m_interference);
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_numReceptions, 2, "Unexpected number of receptions");
+    NS_TEST_ASSERT_MSG_EQ(m_numSinrReceptions, 2, "Unexpected number of SINR receptions");
+}
+
+/**
+ * @brief Testcase for the multi-threaded and single-precision per-RB MIMO computations
+ */
+class NrMimoSinrComputationTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case
+     * @param nRxPorts the number of RX ports
+     * @param nTxPorts the number of TX ports
+     * @param rank the rank of the precoding matrices
+     */
+    NrMimoSinrComputationTestCase(size_t nRxPorts, size_t nTxPorts, size_t rank)
+        : TestCase("MIMO SINR computation modes, " + std::to_string(nRxPorts) + "x" +
+                   std::to_string(nTxPorts) + " rank " + std::to_string(rank)),
+          m_nRxPorts(nRxPorts),
+          m_nTxPorts(nTxPorts),
+          m_rank(rank)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    size_t m_nRxPorts; //!< Number of RX ports
+    size_t m_nTxPorts; //!< Number of TX ports
+    size_t m_rank;     //!< Rank of the precoding matrices
+};
+
+void
+NrMimoSinrComputationTestCase::DoRun()
+{
+    const size_t nRbs = 273;
+
+    ComplexMatrixArray chanMat(m_nRxPorts, m_nTxPorts, nRbs);
+    ComplexMatrixArray precMats(m_nTxPorts, m_rank, nRbs);
+    ComplexMatrixArray intfMat(m_nRxPorts, m_nRxPorts, nRbs);
+    NrCovMat covMat{ComplexMatrixArray(m_nRxPorts, m_nRxPorts, nRbs)};
+    for (size_t iRb = 0; iRb < nRbs; ++iRb)
+    {
+        for (size_t i = 0; i < m_nRxPorts; ++i)
+        {
+            for (size_t j = 0; j < m_nTxPorts; ++j)
+            {
+                chanMat(i, j, iRb) = NrTestChannelValue(i, j, iRb);
+            }
+            for (size_t j = 0; j < m_nRxPorts; ++j)
+            {
+                intfMat(i, j, iRb) = 0.2 * NrTestChannelValue(j + 7, i, iRb);
+            }
+            covMat(i, i, iRb) = 0.1;
+        }
+        for (size_t j = 0; j < m_nTxPorts; ++j)
+        {
+            for (size_t l = 0; l < m_rank; ++l)
+            {
+                precMats(j, l, iRb) = NrTestChannelValue(l + 3, j, 2 * iRb);
+            }
+        }
+    }
+    covMat.AddInterferenceSignal(intfMat);
+
+    auto serialChan = covMat.CalcIntfNormChannel(chanMat);
+    auto serialSinr = serialChan.ComputeSinrForPrecoding(precMats);
+
+    // A single precoding matrix is applied to all RBs as if it was copied to each of them
+    ComplexMatrixArray basePrecMat(m_nTxPorts, m_rank);
+    for (size_t j = 0; j < m_nTxPorts; ++j)
+    {
+        for (size_t l = 0; l < m_rank; ++l)
+        {
+            basePrecMat(j, l) = precMats(j, l, 0);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ((serialChan.ComputeSinrForPrecoding(basePrecMat) ==
+                           serialChan.ComputeSinrForPrecoding(basePrecMat.MakeNCopies(nRbs))),
+                          true,
+                          "SINR of a broadcast precoding matrix differs from the copied one");
+
+    for (uint32_t numThreads : {2, 3, 8})
+    {
+        Config::SetGlobal("NrMimoThreads", UintegerValue(numThreads));
+        auto parallelChan = covMat.CalcIntfNormChannel(chanMat);
+        auto parallelSinr = parallelChan.ComputeSinrForPrecoding(precMats);
+        NS_TEST_EXPECT_MSG_EQ((parallelChan == serialChan),
+                              true,
+                              "Whitened channel differs with " << numThreads << " threads");
+        NS_TEST_EXPECT_MSG_EQ((parallelSinr == serialSinr),
+                              true,
+                              "SINR differs with " << numThreads << " threads");
+    }
+    Config::SetGlobal("NrMimoThreads", UintegerValue(1));
+
+    Config::SetGlobal("NrMimoSinglePrecision", BooleanValue(true));
+    auto floatSinr = covMat.CalcIntfNormChannel(chanMat).ComputeSinrForPrecoding(precMats);
+    Config::SetGlobal("NrMimoSinglePrecision", BooleanValue(false));
+    for (size_t iRb = 0; iRb < nRbs; ++iRb)
+    {
+        for (size_t layer = 0; layer < m_rank; ++layer)
+        {
+            auto sinr = serialSinr(layer, iRb);
+            auto diffDb = std::abs(10 * std::log10(floatSinr(layer, iRb)) - 10 * std::log10(sinr));
+            NS_TEST_EXPECT_MSG_LT(diffDb,
+                                  0.01,
+                                  "Single-precision SINR differs from " << sinr << " in RB " << iRb
+                                                                        << ", layer " << layer);
+        }
+    }
+}
+
+/**
+ * @brief Test suite for the MIMO interference covariance of NrInterference
+ */
+class NrTestInterferenceMimo : public TestSuite
+{
+  public:
+    NrTestInterferenceMimo()
+        : TestSuite("nr-test-interference-mimo", Type::UNIT)
+    {
+        AddTestCase(new NrInterferenceMimoTestCase(), Duration::QUICK);
+        AddTestCase(new NrMimoSinrComputationTestCase(2, 2, 1), Duration::QUICK);
+        AddTestCase(new NrMimoSinrComputationTestCase(4, 4, 2), Duration::QUICK);
+        AddTestCase(new NrMimoSinrComputationTestCase(8, 4, 4), Duration::QUICK);
+        AddTestCase(new NrMimoSinrComputationTestCase(3, 5, 2), Duration::QUICK);
+    }
+};
+
+static NrTestInterferenceMimo NrTestInterferenceMimoTestSuite; //!< Nr test suite
+
+} // namespace ns3
@@ -8,16 +8,29 @@
 #include "ns3/nr-eesm-error-model.h"
 #include "ns3/nr-eesm-ir-t1.h"
 #include "ns3/nr-eesm-ir-t2.h"
+#include "ns3/nr-spectrum-value-helper.h"
+#include "ns3/object-factory.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <cmath>
+
 /**
  * @file nr-test-l2sm-eesm.cc
  * @ingroup test
  *
  * @brief This test validates specific functions of the NR PHY abstraction model.
- * The test checks two issues: 1) LDPC base graph (BG) selection works properly, and 2)
+ * The test checks four issues: 1) LDPC base graph (BG) selection works properly, 2)
  * BLER values are properly obtained from the BLER-SINR look up tables for different
- * block sizes, MCS Tables, BG types, and SINR values.
+ * block sizes, MCS Tables, BG types, and SINR values, 3) the BLER obtained with the
+ * uniform-grid mapping stays within the bounds given by the exact mapping one grid step
+ * around the SINR, and close to it on average, and 4) the batched computation of the
+ * exponential SINR sums (for all the MCSs at once) gives the same sums and TBLERs as
+ * the per-MCS computation, and 5) the MIMO decoding over the SINR matrix read in place
+ * gives the same outputs, also as HARQ history, as the one over the vectorized
+ * SpectrumValue, and 6) the running HARQ combining state (combined SINR per RB for
+ * HARQ-CC, exponential SINR, code bits and RB sums for HARQ-IR) gives the same
+ * effective SINR as combining the whole history, also when the RB map size changes.
  *
  */
 namespace ns3
@@ -48,6 +61,10 @@ class NrL2smEesmTestCase : public TestCase
     void TestMappingSinrBler2(const Ptr<NrEesmErrorModel>& em);
     void TestBgType1(const Ptr<NrEesmErrorModel>& em);
     void TestBgType2(const Ptr<NrEesmErrorModel>& em);
+    void TestMappingSinrBlerGrid(const TypeId& type);
+    void TestSinrExpBatch(const Ptr<NrEesmErrorModel>& em);
+    void TestTbDecodificationStatsMimoSpan(const Ptr<NrEesmErrorModel>& em);
+    void TestHarqCombining(const Ptr<NrEesmErrorModel>& em, bool chaseCombining);
 
     void TestEesmCcTable1();
     void TestEesmCcTable2();
@@ -210,6 +227,237 @@ NrL2smEesmTestCase::TestMappingSinrBler2(const Ptr<NrEesmErrorModel>& em)
     }
 }
 
+void
+NrL2smEesmTestCase::TestMappingSinrBlerGrid(const TypeId& type)
+{
+    ObjectFactory factory(type);
+    Ptr<NrEesmErrorModel> exact = factory.Create<NrEesmErrorModel>();
+    factory.Set("BlerMapping", EnumValue(NrEesmErrorModel::UNIFORM_GRID));
+    Ptr<NrEesmErrorModel> grid = factory.Create<NrEesmErrorModel>();
+
+    const double step = 0.01; // default grid step, in dB
+    const double tolerance = 1e-9;
+    double sumDeviation = 0.0;
+    uint32_t samples = 0;
+    for (uint8_t mcs = 0; mcs <= exact->GetMaxMcs(); ++mcs)
+    {
+        for (uint32_t cbSize : {120, 1000, 3200, 3900, 6300, 8448})
+        {
+            for (double sinrDb = -5.0; sinrDb < 30.0; sinrDb += 0.0437)
+            {
+                auto bler = grid->MappingSinrBler(std::pow(10.0, sinrDb / 10), mcs, cbSize);
+                // BLER curves are non-increasing in the SINR
+                auto upper = exact->MappingSinrBler(std::pow(10.0, (sinrDb - step) / 10),
+                                                    mcs,
+                                                    cbSize);
+                auto lower = exact->MappingSinrBler(std::pow(10.0, (sinrDb + step) / 10),
+                                                    mcs,
+                                                    cbSize);
+                NS_TEST_ASSERT_MSG_LT_OR_EQ(bler,
+                                            upper + tolerance,
+                                            "Grid BLER above the exact one at SINR - step. SINR="
+                                                << sinrDb << " MCS " << +mcs << " CBS " << cbSize);
+                NS_TEST_ASSERT_MSG_GT_OR_EQ(bler,
+                                            lower - tolerance,
+                                            "Grid BLER below the exact one at SINR + step. SINR="
+                                                << sinrDb << " MCS " << +mcs << " CBS " << cbSize);
+                sumDeviation += std::abs(
+                    bler - exact->MappingSinrBler(std::pow(10.0, sinrDb / 10), mcs, cbSize));
+                ++samples;
+            }
+        }
+    }
+    NS_TEST_ASSERT_MSG_LT(sumDeviation / samples,
+                          1e-3,
+                          "Average deviation of the grid BLER too high for " << type.GetName());
+}
+
+void
+NrL2smEesmTestCase::TestSinrExpBatch(const Ptr<NrEesmErrorModel>& em)
+{
+    const uint32_t numRbs = 52;
+    Ptr<const SpectrumModel> sm = NrSpectrumValueHelper::GetSpectrumModel(numRbs, 3.5e9, 30e3);
+    SpectrumValue sinr(sm);
+    std::vector<int> map;
+    for (uint32_t i = 0; i < numRbs; ++i)
+    {
+        sinr[i] = std::pow(10.0, (-2.0 + 0.55 * i) / 10); // from -2 dB to ~26 dB
+        if (i % 3 != 0)
+        {
+            map.push_back(static_cast<int>(i));
+        }
+    }
+
+    std::vector<double> sinrExpSums;
+    em->SinrExpBatch(sinr, map, sinrExpSums);
+    NS_TEST_ASSERT_MSG_EQ(sinrExpSums.size(),
+                          em->GetMaxMcs() + 1U,
+                          "The batched sums must cover all the MCSs");
+
+    auto tblerEvaluator = em->GetTblerEvaluator(sinr, map);
+    for (uint8_t mcs = 0; mcs <= em->GetMaxMcs(); ++mcs)
+    {
+        NS_TEST_ASSERT_MSG_EQ(sinrExpSums.at(mcs),
+                              em->SinrExp(sinr, map, mcs),
+                              "Batched exponential sum differs for MCS " << +mcs);
+        for (uint32_t size : {100, 1500, 10000})
+        {
+            auto output = em->GetTbDecodificationStats(sinr,
+                                                       map,
+                                                       size,
+                                                       mcs,
+                                                       NrErrorModel::NrErrorModelHistory());
+            NS_TEST_ASSERT_MSG_EQ(tblerEvaluator(size, mcs),
+                                  output->m_tbler,
+                                  "TBLER evaluator differs for MCS " << +mcs << " size " << size);
+        }
+    }
+}
+
+void
+NrL2smEesmTestCase::TestTbDecodificationStatsMimoSpan(const Ptr<NrEesmErrorModel>& em)
+{
+    const uint8_t rank = 2;
+    const size_t numRbs = 24;
+    NrSinrMatrix sinrMat{rank, numRbs};
+    std::vector<int> map;
+    for (size_t i = 0; i < numRbs; ++i)
+    {
+        for (uint8_t layer = 0; layer < rank; ++layer)
+        {
+            sinrMat(layer, i) = std::pow(10.0, (4.0 + 0.5 * i - 3.0 * layer) / 10);
+        }
+        if (i % 4 != 1)
+        {
+            map.push_back(static_cast<int>(i));
+        }
+    }
+    auto sinr = sinrMat.GetVectorizedValues();
+
+    for (uint8_t mcs = 0; mcs <= em->GetMaxMcs(); mcs += 3)
+    {
+        for (uint32_t size : {100, 1500, 10000})
+        {
+            // In place (EESM) vs. vectorized SpectrumValue (NrErrorModel) implementation
+            auto outSpan = DynamicCast<NrEesmErrorModelOutput>(
+                em->GetTbDecodificationStatsMimoSpan(sinr, rank, map, size, mcs, {}));
+            auto outSpecVal = DynamicCast<NrEesmErrorModelOutput>(
+                em->NrErrorModel::GetTbDecodificationStatsMimoSpan(sinr, rank, map, size, mcs, {}));
+            NS_TEST_ASSERT_MSG_EQ(outSpan->m_tbler,
+                                  outSpecVal->m_tbler,
+                                  "TBLER differs for MCS " << +mcs << " size " << size);
+            NS_TEST_ASSERT_MSG_EQ(outSpan->m_sinrEff,
+                                  outSpecVal->m_sinrEff,
+                                  "Effective SINR differs for MCS " << +mcs << " size " << size);
+            NS_TEST_ASSERT_MSG_EQ(outSpan->m_sinrExp,
+                                  outSpecVal->m_sinrExp,
+                                  "Exponential sum differs for MCS " << +mcs << " size " << size);
+            NS_TEST_ASSERT_MSG_EQ(outSpan->m_codeBits,
+                                  outSpecVal->m_codeBits,
+                                  "Code bits differ for MCS " << +mcs << " size " << size);
+
+            // Both outputs must give the same retransmission TBLER when used as HARQ history
+            auto retxSpan = em->GetTbDecodificationStatsMimoSpan(sinr,
+                                                                 rank,
+                                                                 map,
+                                                                 size,
+                                                                 mcs,
+                                                                 {outSpan});
+            auto retxSpecVal = em->GetTbDecodificationStatsMimoSpan(sinr,
+                                                                    rank,
+                                                                    map,
+                                                                    size,
+                                                                    mcs,
+                                                                    {outSpecVal});
+            NS_TEST_ASSERT_MSG_EQ(retxSpan->m_tbler,
+                                  retxSpecVal->m_tbler,
+                                  "Retransmission TBLER differs for MCS " << +mcs << " size "
+                                                                          << size);
+        }
+    }
+}
+
+void
+NrL2smEesmTestCase::TestHarqCombining(const Ptr<NrEesmErrorModel>& em, bool chaseCombining)
+{
+    const uint32_t numRbs = 52;
+    const uint32_t size = 1500;
+    const uint8_t mcs = 12;
+    Ptr<const SpectrumModel> sm = NrSpectrumValueHelper::GetSpectrumModel(numRbs, 3.5e9, 30e3);
+
+    // RB maps of the transmissions of the same TB: the number of RBs grows and shrinks
+    std::vector<std::vector<int>> maps;
+    for (uint32_t first : {30, 5, 0, 2, 40})
+    {
+        maps.emplace_back();
+        for (uint32_t rb = first; rb < numRbs; rb += (first % 2) + 1)
+        {
+            maps.back().push_back(static_cast<int>(rb));
+        }
+    }
+    maps.at(3).resize(10);
+
+    NrErrorModel::NrErrorModelHistory history;
+    std::vector<SpectrumValue> sinrs;
+    double expSumPrevious = 0.0;
+    double mapSizeSum = 0.0;
+    for (size_t tx = 0; tx < maps.size(); ++tx)
+    {
+        SpectrumValue sinr(sm);
+        for (uint32_t i = 0; i < numRbs; ++i)
+        {
+            sinr[i] = std::pow(10.0, (-6.0 + 0.3 * i - 2.0 * tx) / 10);
+        }
+        sinrs.push_back(sinr);
+        const auto& map = maps.at(tx);
+
+        auto output = DynamicCast<NrEesmErrorModelOutput>(
+            em->GetTbDecodificationStats(sinr, map, size, mcs, history));
+
+        // Effective SINR combining the whole history at once
+        double expected = 0.0;
+        if (history.empty())
+        {
+            expected = em->SinrEff(sinr, map, mcs, 0.0, map.size());
+        }
+        else if (chaseCombining)
+        {
+            size_t maxSize = 0;
+            for (size_t i = 0; i <= tx; ++i)
+            {
+                maxSize = std::max(maxSize, maps.at(i).size());
+            }
+            SpectrumValue sinrSum(sm);
+            std::vector<int> mapSum;
+            for (size_t j = 0; j < maxSize; ++j)
+            {
+                sinrSum[j] = 0;
+                mapSum.push_back(static_cast<int>(j));
+            }
+            for (size_t i = 0; i <= tx; ++i)
+            {
+                for (size_t j = 0; j < maxSize; ++j)
+                {
+                    sinrSum[j] += sinrs.at(i)[maps.at(i)[j % maps.at(i).size()]];
+                }
+            }
+            expected = em->SinrEff(sinrSum, mapSum, mcs, 0.0, mapSum.size());
+        }
+        else
+        {
+            expected = em->SinrEff(sinr, map, mcs, expSumPrevious, mapSizeSum + map.size());
+        }
+        expSumPrevious += em->SinrExp(sinr, map, mcs);
+        mapSizeSum += map.size();
+
+        NS_TEST_ASSERT_MSG_EQ_TOL(output->m_sinrEff,
+                                  expected,
+                                  expected * 1e-12,
+                                  "Effective SINR after combining differs at tx " << tx);
+        history.push_back(output);
+    }
+}
+
 void
 NrL2smEesmTestCase::TestEesmCcTable1()
 {
@@ -223,6 +471,9 @@ NrL2smEesmTestCase::TestEesmCcTable1()
     // Test here the functions:
     TestBgType1(em);
     TestMappingSinrBler1(em);
+    TestSinrExpBatch(em);
+    TestTbDecodificationStatsMimoSpan(em);
+    TestHarqCombining(em, true);
 }
 
 void
@@ -238,6 +489,9 @@ NrL2smEesmTestCase::TestEesmCcTable2()
     // Test here the functions:
     TestBgType2(em);
     TestMappingSinrBler2(em);
+    TestSinrExpBatch(em);
+    TestTbDecodificationStatsMimoSpan(em);
+    TestHarqCombining(em, true);
 }
 
 void
@@ -253,6 +507,9 @@ NrL2smEesmTestCase::TestEesmIrTable1()
     // Test here the functions:
     TestBgType1(em);
     TestMappingSinrBler1(em);
+    TestSinrExpBatch(em);
+    TestTbDecodificationStatsMimoSpan(em);
+    TestHarqCombining(em, false);
 }
 
 void
@@ -268,6 +525,9 @@ NrL2smEesmTestCase::TestEesmIrTable2()
     // Test here the functions:
     TestBgType2(em);
     TestMappingSinrBler2(em);
+    TestSinrExpBatch(em);
+    TestTbDecodificationStatsMimoSpan(em);
+    TestHarqCombining(em, false);
 }
 
 void
@@ -277,6 +537,11 @@ NrL2smEesmTestCase::DoRun()
     TestEesmCcTable2();
     TestEesmIrTable1();
     TestEesmIrTable2();
+
+    TestMappingSinrBlerGrid(NrEesmCcT1::GetTypeId());
+    TestMappingSinrBlerGrid(NrEesmCcT2::GetTypeId());
+    TestMappingSinrBlerGrid(NrEesmIrT1::GetTypeId());
+    TestMappingSinrBlerGrid(NrEesmIrT2::GetTypeId());
 }
 
 class NrTestL2smEesm : public TestSuite
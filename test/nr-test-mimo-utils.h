@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_TEST_MIMO_UTILS_H
+#define NR_TEST_MIMO_UTILS_H
+
+#include "ns3/nr-mimo-matrices.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+/**
+ * @file nr-test-mimo-utils.h
+ * @ingroup test
+ *
+ * @brief Helpers shared by the MIMO tests: a deterministic synthetic channel and the reference
+ * per-candidate capacity computation of the PMI search.
+ */
+namespace ns3
+{
+
+/**
+ * @brief Get an element of a deterministic synthetic channel, which is well conditioned and has
+ * different values in every position
+ * @param a the first index (e.g., the RX port)
+ * @param b the second index (e.g., the TX port)
+ * @param c the third index (e.g., the RB or subband)
+ * @return the value of the element
+ */
+inline std::complex<double>
+NrTestChannelValue(size_t a, size_t b, size_t c)
+{
+    auto x = 0.37 * a + 1.1 * b + 0.13 * c;
+    return std::complex<double>{std::sin(x), std::cos(2.3 * x)};
+}
+
+/**
+ * @brief Create the interference-normalized synthetic channel of NrTestChannelValue, with white
+ * noise of power 0.1 in each RX port
+ * @param nRxPorts the number of RX ports
+ * @param nTxPorts the number of TX ports
+ * @param nPages the number of RBs or subbands
+ * @return the interference-normalized channel matrix
+ */
+inline NrIntfNormChanMat
+NrTestCreateIntfNormChanMat(size_t nRxPorts, size_t nTxPorts, size_t nPages)
+{
+    ComplexMatrixArray chanMat(nRxPorts, nTxPorts, nPages);
+    NrCovMat covMat{ComplexMatrixArray(nRxPorts, nRxPorts, nPages)};
+    for (size_t iPage = 0; iPage < nPages; ++iPage)
+    {
+        for (size_t i = 0; i < nRxPorts; ++i)
+        {
+            for (size_t j = 0; j < nTxPorts; ++j)
+            {
+                chanMat(i, j, iPage) = NrTestChannelValue(i, j, iPage);
+            }
+            covMat(i, i, iPage) = 0.1;
+        }
+    }
+    return covMat.CalcIntfNormChannel(chanMat);
+}
+
+/**
+ * @brief Compute the capacity of candidate precoders by computing the SINR of each candidate
+ * separately, as NrPmSearchFull did before NrIntfNormChanMat::ComputeCapacityForPrecoders
+ * @param normChanMat the interference-normalized channel matrix
+ * @param basePrecMats the candidate precoders, each one a single-page matrix
+ * @return the capacity of each page (row) and candidate (column)
+ */
+inline DoubleMatrixArray
+NrTestComputeCapacityPerCandidate(const NrIntfNormChanMat& normChanMat,
+                                  const std::vector<ComplexMatrixArray>& basePrecMats)
+{
+    const size_t nPages = normChanMat.GetNumPages();
+    DoubleMatrixArray capacity{nPages, basePrecMats.size()};
+    for (size_t i2 = 0; i2 < basePrecMats.size(); ++i2)
+    {
+        auto sinr = normChanMat.ComputeSinrForPrecoding(basePrecMats[i2].MakeNCopies(nPages));
+        for (size_t iPage = 0; iPage < nPages; ++iPage)
+        {
+            double cap = 0.0;
+            for (size_t layer = 0; layer < sinr.GetNumRows(); ++layer)
+            {
+                cap += std::log2(1.0 + sinr(layer, iPage));
+            }
+            capacity(iPage, i2) = cap;
+        }
+    }
+    return capacity;
+}
+
+} // namespace ns3
+
+#endif // NR_TEST_MIMO_UTILS_H
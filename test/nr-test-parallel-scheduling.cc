@@ -0,0 +1,453 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/nr-channel-helper.h"
+#include "ns3/nr-gnb-mac.h"
+#include "ns3/nr-gnb-net-device.h"
+#include "ns3/nr-helper.h"
+#include "ns3/nr-mac-scheduler.h"
+#include "ns3/nr-point-to-point-epc-helper.h"
+#include "ns3/parabolic-antenna-model.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/test.h"
+#include "ns3/udp-client-server-helper.h"
+#include "ns3/uinteger.h"
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file nr-test-parallel-scheduling.cc
+ * @ingroup test
+ *
+ * @brief System test of the parallel scheduling of the gNB MACs
+ * (attribute NrGnbMac::ParallelScheduling).
+ *
+ * A multi-cell scenario with DL and UL traffic, sent at the slot boundaries, runs
+ * with the parallel scheduling disabled, and enabled with different numbers of
+ * scheduling and MIMO threads. The allocations traced by the MACs, and the SymPerBeam
+ * values traced by the OFDMA schedulers, must not depend on the number of threads.
+ * With the parallel scheduling, the decisions of the schedulers are applied after the
+ * other events of the time instant, so the bytes received by the PDCP of each UE, in
+ * DL and UL, and their mean delay must only be close to the ones of the serial
+ * execution.
+ */
+namespace ns3
+{
+
+/// Allocations and SymPerBeam values traced by each gNB, in order, one string per value
+using NrCellSchedulingTraces = std::vector<std::vector<std::string>>;
+
+/**
+ * @ingroup test
+ * @brief PDUs received by a PDCP entity
+ */
+struct NrPdcpRxStats
+{
+    uint64_t m_bytes{0};   //!< Received bytes
+    uint64_t m_pdus{0};    //!< Received PDUs
+    uint64_t m_delayNs{0}; //!< Sum of the delays of the PDUs, in ns
+};
+
+/// PDCP reception of each DL and UL data radio bearer, by trace context
+using NrPdcpRxStatsMap = std::map<std::string, NrPdcpRxStats>;
+
+/**
+ * @ingroup test
+ * @brief Results of a run of the scenario
+ */
+struct NrParallelSchedulingResults
+{
+    NrCellSchedulingTraces m_traces; //!< Traces of the gNBs
+    NrPdcpRxStatsMap m_pdcpRx;       //!< PDCP reception of the data radio bearers
+};
+
+/**
+ * @ingroup test
+ * @brief A configuration of the parallel scheduling
+ */
+struct NrParallelSchedulingConf
+{
+    bool m_parallelScheduling;    //!< Value of NrGnbMac::ParallelScheduling
+    uint32_t m_schedulingThreads; //!< Value of NrSchedulingThreads
+    uint32_t m_mimoThreads;       //!< Value of NrMimoThreads
+};
+
+/**
+ * @brief Record an allocation traced by a gNB MAC
+ * @param trace the trace of the gNB
+ * @param direction "DL" or "UL"
+ * @param info the allocation
+ */
+static void
+RecordAllocation(std::vector<std::string>* trace,
+                 std::string direction,
+                 NrSchedulingCallbackInfo info)
+{
+    std::ostringstream os;
+    os << direction << " " << info.m_frameNum << "/" << +info.m_subframeNum << "/"
+       << info.m_slotNum << " sym " << +info.m_symStart << "+" << +info.m_numSym << " rnti "
+       << info.m_rnti << " mcs " << +info.m_mcs << " tbs " << info.m_tbSize << " ndi "
+       << +info.m_ndi << " rv " << +info.m_rv << " harq " << +info.m_harqId;
+    trace->emplace_back(os.str());
+}
+
+/**
+ * @brief Record a SymPerBeam value traced by an OFDMA scheduler
+ * @param trace the trace of the gNB
+ * @param oldValue the previous value
+ * @param newValue the new value
+ */
+static void
+RecordSymPerBeam(std::vector<std::string>* trace, uint32_t oldValue, uint32_t newValue)
+{
+    trace->emplace_back("SymPerBeam " + std::to_string(newValue));
+}
+
+/**
+ * @brief Record a PDU received by a PDCP entity
+ * @param stats the PDCP reception of the data radio bearers
+ * @param context the trace context, which identifies the bearer
+ * @param rnti the RNTI
+ * @param lcid the LCID
+ * @param size the size of the PDU
+ * @param delay the delay of the PDU, in ns
+ */
+static void
+RecordPdcpRx(NrPdcpRxStatsMap* stats,
+             std::string context,
+             uint16_t rnti,
+             uint8_t lcid,
+             uint32_t size,
+             uint64_t delay)
+{
+    auto& bearer = (*stats)[context];
+    bearer.m_bytes += size;
+    ++bearer.m_pdus;
+    bearer.m_delayNs += delay;
+}
+
+/**
+ * @brief Connect the RxPDU traces of the PDCP of the DL and UL data radio bearers
+ * @param stats the PDCP reception of the data radio bearers
+ */
+static void
+ConnectPdcpRx(NrPdcpRxStatsMap* stats)
+{
+    Config::Connect("/NodeList/*/DeviceList/*/NrUeRrc/DataRadioBearerMap/*/NrPdcp/RxPDU",
+                    MakeBoundCallback(&RecordPdcpRx, stats));
+    Config::Connect("/NodeList/*/DeviceList/*/NrGnbRrc/UeMap/*/DataRadioBearerMap/*/NrPdcp/RxPDU",
+                    MakeBoundCallback(&RecordPdcpRx, stats));
+}
+
+/**
+ * @ingroup test
+ * @brief Compare the serial and the parallel scheduling
+ */
+class NrParallelSchedulingTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case
+     * @param schedulerType the TypeId name of the scheduler
+     * @param confs the configurations to compare with the serial execution
+     * @param simTime the duration of the simulation
+     */
+    NrParallelSchedulingTestCase(const std::string& schedulerType,
+                                 const std::vector<NrParallelSchedulingConf>& confs,
+                                 Time simTime)
+        : TestCase(schedulerType + ", " + std::to_string(confs.size()) + " configurations, " +
+                   std::to_string(simTime.GetMilliSeconds()) + " ms"),
+          m_schedulerType(schedulerType),
+          m_confs(confs),
+          m_simTime(simTime)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Run the scenario
+     * @param parallelScheduling the value of NrGnbMac::ParallelScheduling
+     * @param schedulingThreads the value of the global value NrSchedulingThreads
+     * @param mimoThreads the value of the global value NrMimoThreads
+     * @return the traces of the gNBs and the PDCP reception of the bearers
+     */
+    NrParallelSchedulingResults RunScenario(bool parallelScheduling,
+                                            uint32_t schedulingThreads,
+                                            uint32_t mimoThreads) const;
+
+    std::string m_schedulerType;                   //!< The TypeId name of the scheduler
+    std::vector<NrParallelSchedulingConf> m_confs; //!< The configurations to compare
+    Time m_simTime;                                //!< Duration of the simulation
+};
+
+NrParallelSchedulingResults
+NrParallelSchedulingTestCase::RunScenario(bool parallelScheduling,
+                                          uint32_t schedulingThreads,
+                                          uint32_t mimoThreads) const
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    RngSeedManager::ResetNextStreamIndex();
+    Config::SetGlobal("NrSchedulingThreads", UintegerValue(schedulingThreads));
+    Config::SetGlobal("NrMimoThreads", UintegerValue(mimoThreads));
+    Config::SetDefault("ns3::ThreeGppChannelModel::UpdatePeriod", TimeValue(MilliSeconds(0)));
+
+    const uint32_t numGnbs = 3;
+    const uint32_t uesPerGnb = 4;
+    // A slot boundary of numerology 1
+    Time appStartTime = MilliSeconds(100);
+
+    NodeContainer gnbContainer;
+    gnbContainer.Create(numGnbs);
+    NodeContainer ueContainer;
+    ueContainer.Create(numGnbs * uesPerGnb);
+
+    // The gNBs are aligned, and the UEs of a gNB are around it, at different distances
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    Ptr<ListPositionAllocator> gnbPositions = CreateObject<ListPositionAllocator>();
+    Ptr<ListPositionAllocator> uePositions = CreateObject<ListPositionAllocator>();
+    for (uint32_t gnb = 0; gnb < numGnbs; ++gnb)
+    {
+        gnbPositions->Add(Vector(300.0 * gnb, 0.0, 25.0));
+        for (uint32_t ue = 0; ue < uesPerGnb; ++ue)
+        {
+            uePositions->Add(Vector(300.0 * gnb + 20.0 + 25.0 * ue, 10.0 * ue, 1.5));
+        }
+    }
+    mobility.SetPositionAllocator(gnbPositions);
+    mobility.Install(gnbContainer);
+    mobility.SetPositionAllocator(uePositions);
+    mobility.Install(ueContainer);
+
+    Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper>();
+    epcHelper->SetAttribute("S1uLinkDelay", TimeValue(MilliSeconds(0)));
+
+    Ptr<NrHelper> nrHelper = CreateObject<NrHelper>();
+    nrHelper->SetEpcHelper(epcHelper);
+    nrHelper->SetSchedulerTypeId(TypeId::LookupByName(m_schedulerType));
+    nrHelper->SetGnbMacAttribute("ParallelScheduling", BooleanValue(parallelScheduling));
+    nrHelper->SetGnbPhyAttribute("Numerology", UintegerValue(1));
+    nrHelper->SetGnbPhyAttribute("TxPower", DoubleValue(30));
+    nrHelper->SetUePhyAttribute("TxPower", DoubleValue(23));
+    nrHelper->SetUeAntennaTypeId(ParabolicAntennaModel::GetTypeId().GetName());
+    nrHelper->SetGnbAntennaTypeId(ParabolicAntennaModel::GetTypeId().GetName());
+
+    Ptr<NrChannelHelper> channelHelper = CreateObject<NrChannelHelper>();
+    channelHelper->ConfigurePropagationFactory(FriisPropagationLossModel::GetTypeId());
+
+    // All the cells use the same band, so that they interfere
+    CcBwpCreator ccBwpCreator;
+    CcBwpCreator::SimpleOperationBandConf bandConf(3.5e9, 20e6, 1);
+    OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc(bandConf);
+    channelHelper->AssignChannelsToBands({band});
+    BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps({band});
+
+    NetDeviceContainer gnbNetDev = nrHelper->InstallGnbDevice(gnbContainer, allBwps);
+    NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice(ueContainer, allBwps);
+
+    int64_t randomStream = 1;
+    randomStream += nrHelper->AssignStreams(gnbNetDev, randomStream);
+    randomStream += nrHelper->AssignStreams(ueNetDev, randomStream);
+
+    NrParallelSchedulingResults results;
+    auto& traces = results.m_traces;
+    traces.resize(numGnbs);
+    for (uint32_t gnb = 0; gnb < numGnbs; ++gnb)
+    {
+        auto gnbDev = DynamicCast<NrGnbNetDevice>(gnbNetDev.Get(gnb));
+        gnbDev->GetMac(0)->TraceConnectWithoutContext(
+            "DlScheduling",
+            MakeBoundCallback(&RecordAllocation, &traces[gnb], std::string("DL")));
+        gnbDev->GetMac(0)->TraceConnectWithoutContext(
+            "UlScheduling",
+            MakeBoundCallback(&RecordAllocation, &traces[gnb], std::string("UL")));
+        // Only the OFDMA schedulers have this trace source
+        gnbDev->GetScheduler(0)->TraceConnectWithoutContext(
+            "SymPerBeam",
+            MakeBoundCallback(&RecordSymPerBeam, &traces[gnb]));
+    }
+
+    auto [remoteHost, remoteHostIpv4Address] =
+        epcHelper->SetupRemoteHost("100Gb/s", 2500, Seconds(0.000));
+
+    InternetStackHelper internet;
+    internet.Install(ueContainer);
+    Ipv4InterfaceContainer ueIpIface = epcHelper->AssignUeIpv4Address(ueNetDev);
+
+    nrHelper->AttachToClosestGnb(ueNetDev, gnbNetDev);
+
+    // DL and UL CBR traffic, below the capacity of the cells, with one packet per slot
+    uint16_t dlPort = 1234;
+    uint16_t ulPort = 2000;
+    ApplicationContainer serverApps;
+    ApplicationContainer clientApps;
+    serverApps.Add(UdpServerHelper(dlPort).Install(ueContainer));
+    serverApps.Add(UdpServerHelper(ulPort).Install(remoteHost));
+
+    UdpClientHelper dlClient;
+    dlClient.SetAttribute("MaxPackets", UintegerValue(0xFFFFFFFF));
+    dlClient.SetAttribute("PacketSize", UintegerValue(1000));
+    dlClient.SetAttribute("Interval", TimeValue(MicroSeconds(500)));
+    UdpClientHelper ulClient;
+    ulClient.SetAttribute("MaxPackets", UintegerValue(0xFFFFFFFF));
+    ulClient.SetAttribute("PacketSize", UintegerValue(500));
+    ulClient.SetAttribute("Interval", TimeValue(MicroSeconds(500)));
+    ulClient.SetAttribute(
+        "Remote",
+        AddressValue(InetSocketAddress(remoteHostIpv4Address, ulPort).ConvertTo()));
+    for (uint32_t i = 0; i < ueContainer.GetN(); ++i)
+    {
+        dlClient.SetAttribute(
+            "Remote",
+            AddressValue(
+                InetSocketAddress(Ipv4Address::ConvertFrom(ueIpIface.GetAddress(i)), dlPort)
+                    .ConvertTo()));
+        clientApps.Add(dlClient.Install(remoteHost));
+        clientApps.Add(ulClient.Install(ueContainer.Get(i)));
+    }
+
+    serverApps.Start(appStartTime);
+    clientApps.Start(appStartTime);
+    serverApps.Stop(m_simTime);
+    clientApps.Stop(m_simTime);
+
+    // The data radio bearers are set up before the applications start
+    Simulator::Schedule(appStartTime, &ConnectPdcpRx, &results.m_pdcpRx);
+
+    Simulator::Stop(m_simTime);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return results;
+}
+
+void
+NrParallelSchedulingTestCase::DoRun()
+{
+    NrParallelSchedulingResults reference = RunScenario(false, 1, 1);
+    std::vector<NrParallelSchedulingResults> results;
+    for (const auto& conf : m_confs)
+    {
+        results.emplace_back(
+            RunScenario(conf.m_parallelScheduling, conf.m_schedulingThreads, conf.m_mimoThreads));
+    }
+    Config::SetGlobal("NrSchedulingThreads", UintegerValue(1));
+    Config::SetGlobal("NrMimoThreads", UintegerValue(1));
+
+    for (const auto& cellTrace : reference.m_traces)
+    {
+        NS_TEST_ASSERT_MSG_GT(cellTrace.size(), 0U, "Expected allocations in every cell");
+    }
+    // One DL and one UL data radio bearer per UE
+    NS_TEST_ASSERT_MSG_EQ(reference.m_pdcpRx.size(), 24U, "Expected traffic in every bearer");
+
+    // The serial runs must give the reference traces, and the parallel runs the traces of
+    // the first parallel run, whatever the number of threads
+    const NrParallelSchedulingResults* parallelReference = nullptr;
+    for (size_t i = 0; i < m_confs.size(); ++i)
+    {
+        std::ostringstream conf;
+        conf << "ParallelScheduling " << m_confs[i].m_parallelScheduling
+             << ", NrSchedulingThreads " << m_confs[i].m_schedulingThreads << ", NrMimoThreads "
+             << m_confs[i].m_mimoThreads;
+
+        const NrParallelSchedulingResults* expected = &reference;
+        if (m_confs[i].m_parallelScheduling)
+        {
+            if (!parallelReference)
+            {
+                parallelReference = &results[i];
+            }
+            expected = parallelReference;
+        }
+
+        for (size_t cell = 0; cell < expected->m_traces.size(); ++cell)
+        {
+            const auto& trace = results[i].m_traces[cell];
+            const auto& expectedTrace = expected->m_traces[cell];
+            NS_TEST_ASSERT_MSG_EQ(trace.size(),
+                                  expectedTrace.size(),
+                                  "Different number of allocations in cell " << cell << " with "
+                                                                             << conf.str());
+            for (size_t j = 0; j < trace.size(); ++j)
+            {
+                NS_TEST_ASSERT_MSG_EQ(trace[j],
+                                      expectedTrace[j],
+                                      "Different allocation " << j << " in cell " << cell
+                                                              << " with " << conf.str());
+            }
+        }
+
+        // Compared with the serial execution, the bytes received by each bearer can only
+        // differ by the PDUs in flight at the end, and the mean delay by a fraction of slot
+        const auto& pdcpRx = results[i].m_pdcpRx;
+        NS_TEST_ASSERT_MSG_EQ(pdcpRx.size(),
+                              reference.m_pdcpRx.size(),
+                              "Different number of bearers with " << conf.str());
+        for (const auto& [bearer, expectedRx] : reference.m_pdcpRx)
+        {
+            NS_TEST_ASSERT_MSG_EQ(pdcpRx.count(bearer),
+                                  1U,
+                                  "No traffic in " << bearer << " with " << conf.str());
+            const auto& rx = pdcpRx.at(bearer);
+            NS_TEST_ASSERT_MSG_EQ_TOL(static_cast<double>(rx.m_bytes),
+                                      static_cast<double>(expectedRx.m_bytes),
+                                      0.05 * expectedRx.m_bytes,
+                                      "Different received bytes in " << bearer << " with "
+                                                                     << conf.str());
+            NS_TEST_ASSERT_MSG_EQ_TOL(static_cast<double>(rx.m_delayNs) / rx.m_pdus,
+                                      static_cast<double>(expectedRx.m_delayNs) / expectedRx.m_pdus,
+                                      250e3,
+                                      "Different mean delay in " << bearer << " with "
+                                                                 << conf.str());
+        }
+    }
+}
+
+/**
+ * @ingroup test
+ * @brief Test suite of the parallel scheduling of the gNB MACs
+ */
+class NrParallelSchedulingTestSuite : public TestSuite
+{
+  public:
+    NrParallelSchedulingTestSuite()
+        : TestSuite("nr-test-parallel-scheduling", Type::SYSTEM)
+    {
+        // A short run with two configurations, and longer runs with all of them
+        AddTestCase(new NrParallelSchedulingTestCase("ns3::NrMacSchedulerOfdmaPF",
+                                                     {{true, 1, 1}, {true, 3, 4}},
+                                                     MilliSeconds(150)),
+                    Duration::QUICK);
+        const std::vector<NrParallelSchedulingConf> confs = {
+            {false, 1, 4},
+            {true, 1, 1},
+            {true, 1, 4},
+            {true, 3, 1},
+            {true, 3, 4},
+        };
+        for (const auto& schedulerType :
+             {"ns3::NrMacSchedulerOfdmaPF", "ns3::NrMacSchedulerTdmaQos"})
+        {
+            AddTestCase(new NrParallelSchedulingTestCase(schedulerType, confs, MilliSeconds(300)),
+                        Duration::EXTENSIVE);
+        }
+    }
+};
+
+static NrParallelSchedulingTestSuite
+    g_nrParallelSchedulingTestSuite; //!< Parallel scheduling test suite
+
+} // namespace ns3
@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-test-mimo-utils.h"
+
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/nr-cb-type-one.h"
+#include "ns3/object-factory.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+/**
+ * @file nr-test-pm-capacity.cc
+ * @ingroup test
+ *
+ * @brief Unit test of NrIntfNormChanMat::ComputeCapacityForPrecoders, used by the PMI search.
+ * For 2, 4, 8, 16 and 32 dual-polarized gNB ports, the capacity of all the i2 candidates of
+ * several i1 values is computed per subband, once by computing the SINR of each candidate
+ * separately and once with ComputeCapacityForPrecoders. The results must match. The
+ * extensive cases also repeat both computations to time them, and log the time taken by each
+ * one with the NrTestPmCapacity log component.
+ */
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrTestPmCapacity");
+
+/**
+ * @brief Testcase that compares, and optionally times, the per-candidate and batched capacity
+ * computations
+ */
+class NrPmCapacityTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case for one gNB port configuration
+     * @param n1 the number of horizontal gNB ports (per polarization)
+     * @param n2 the number of vertical gNB ports (per polarization)
+     * @param numRepetitions the number of times each computation is repeated to time it, or 0
+     * to only compare the results
+     */
+    NrPmCapacityTestCase(size_t n1, size_t n2, size_t numRepetitions = 0)
+        : TestCase("PMI capacity computation, " + std::to_string(2 * n1 * n2) + " ports" +
+                   (numRepetitions > 0 ? ", benchmark" : "")),
+          m_n1(n1),
+          m_n2(n2),
+          m_numRepetitions(numRepetitions)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    size_t m_n1;             //!< Number of horizontal gNB ports
+    size_t m_n2;             //!< Number of vertical gNB ports
+    size_t m_numRepetitions; //!< Number of repetitions of each timed computation
+};
+
+void
+NrPmCapacityTestCase::DoRun()
+{
+    const size_t nRxPorts = 4;
+    const size_t nSubbands = 17;
+    const size_t maxNumI1 = 16;
+    const size_t nTxPorts = 2 * m_n1 * m_n2;
+    auto sbNormChanMat = NrTestCreateIntfNormChanMat(nRxPorts, nTxPorts, nSubbands);
+
+    ObjectFactory cbFactory;
+    cbFactory.SetTypeId("ns3::NrCbTypeOneSp");
+    cbFactory.Set("N1", UintegerValue(m_n1));
+    cbFactory.Set("N2", UintegerValue(m_n2));
+    cbFactory.Set("IsDualPol", BooleanValue(true));
+
+    std::chrono::duration<double, std::milli> perCandidateTime{0};
+    std::chrono::duration<double, std::milli> batchedTime{0};
+    for (size_t rank : {1, 2, 4})
+    {
+        if (rank > nTxPorts)
+        {
+            continue;
+        }
+        cbFactory.Set("Rank", UintegerValue(rank));
+        auto cb = cbFactory.Create<NrCbTypeOne>();
+        cb->Init();
+        for (size_t i1 = 0; i1 < std::min(cb->GetNumI1(), maxNumI1); ++i1)
+        {
+            std::vector<ComplexMatrixArray> basePrecMats;
+            for (size_t i2 = 0; i2 < cb->GetNumI2(); ++i2)
+            {
+                basePrecMats.emplace_back(cb->GetBasePrecMat(i1, i2));
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            for (size_t rep = 0; rep < m_numRepetitions; ++rep)
+            {
+                NrTestComputeCapacityPerCandidate(sbNormChanMat, basePrecMats);
+            }
+            auto middle = std::chrono::steady_clock::now();
+            for (size_t rep = 0; rep < m_numRepetitions; ++rep)
+            {
+                sbNormChanMat.ComputeCapacityForPrecoders(basePrecMats);
+            }
+            perCandidateTime += middle - start;
+            batchedTime += std::chrono::steady_clock::now() - middle;
+
+            auto perCandidateCap = NrTestComputeCapacityPerCandidate(sbNormChanMat, basePrecMats);
+            auto batchedCap = sbNormChanMat.ComputeCapacityForPrecoders(basePrecMats);
+
+            NS_TEST_ASSERT_MSG_EQ(batchedCap.GetNumRows(), nSubbands, "Wrong number of rows");
+            NS_TEST_ASSERT_MSG_EQ(batchedCap.GetNumCols(),
+                                  basePrecMats.size(),
+                                  "Wrong number of columns");
+            for (size_t i2 = 0; i2 < basePrecMats.size(); ++i2)
+            {
+                for (size_t iSb = 0; iSb < nSubbands; ++iSb)
+                {
+                    NS_TEST_ASSERT_MSG_EQ_TOL(batchedCap(iSb, i2),
+                                              perCandidateCap(iSb, i2),
+                                              1e-9 * perCandidateCap(iSb, i2),
+                                              "Capacity differs for rank "
+                                                  << rank << ", i1 " << i1 << ", i2 " << i2
+                                                  << ", subband " << iSb);
+                }
+            }
+        }
+    }
+
+    if (m_numRepetitions > 0)
+    {
+        NS_LOG_INFO(GetName() << ": per-candidate " << perCandidateTime.count()
+                              << " ms, batched " << batchedTime.count() << " ms");
+    }
+}
+
+/**
+ * @brief Test suite for the capacity computation used by the PMI search
+ */
+class NrTestPmCapacity : public TestSuite
+{
+  public:
+    NrTestPmCapacity()
+        : TestSuite("nr-test-pm-capacity", Type::UNIT)
+    {
+        // (N1, N2) of 2, 4, 8, 16 and 32 dual-polarized gNB ports
+        const std::vector<std::pair<size_t, size_t>> portConfs{{1, 1},
+                                                               {2, 1},
+                                                               {4, 1},
+                                                               {4, 2},
+                                                               {8, 2}};
+        for (const auto& [n1, n2] : portConfs)
+        {
+            AddTestCase(new NrPmCapacityTestCase(n1, n2), Duration::QUICK);
+        }
+        for (const auto& [n1, n2] : portConfs)
+        {
+            AddTestCase(new NrPmCapacityTestCase(n1, n2, 20), Duration::EXTENSIVE);
+        }
+    }
+};
+
+static NrTestPmCapacity NrTestPmCapacityTestSuite; //!< Nr test suite
+
+} // namespace ns3
@@ -0,0 +1,198 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-test-mimo-utils.h"
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/nr-amc.h"
+#include "ns3/nr-cb-type-one-sp.h"
+#include "ns3/nr-eesm-cc-t1.h"
+#include "ns3/nr-pm-search-full.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/test.h"
+
+/**
+ * @file nr-test-pm-search-tracking.cc
+ * @ingroup test
+ *
+ * @brief This test validates the tracking mode of the PMI search. Two searches, with and without
+ * tracking, create the CQI/PMI feedback for the same sequence of channels. While the channel does
+ * not change, the tracking updates must be used (hits) and give the same RI and PMI as the
+ * exhaustive search. When the capacity drops by more than the threshold, the tracking update
+ * must fall back to the exhaustive search. With a zero full search period, the exhaustive
+ * search must always be done.
+ */
+namespace ns3
+{
+
+/**
+ * @brief Testcase for the tracking mode of a PMI search method
+ */
+class NrPmSearchTrackingTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case for one PMI search method
+     * @param pmSearchType the TypeId of the PMI search
+     */
+    NrPmSearchTrackingTestCase(const std::string& pmSearchType)
+        : TestCase("PMI tracking with " + pmSearchType),
+          m_pmSearchType(pmSearchType)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Create and initialize a PMI search
+     * @param tracking whether the tracking mode is enabled
+     * @param fullSearchPeriod the maximum time between exhaustive searches
+     * @return the PMI search
+     */
+    Ptr<NrPmSearchFull> CreatePmSearch(bool tracking, Time fullSearchPeriod) const;
+
+    /**
+     * @brief Create the received signal of a channel whose strength is scaled by a gain
+     * @param gain the amplitude gain of the channel
+     * @return the received signal
+     */
+    NrMimoSignal CreateSignal(double gain) const;
+
+    /**
+     * @brief Check that two feedback messages have the same RI and PMI
+     * @param actual the feedback of the search under test
+     * @param expected the feedback of the exhaustive search
+     * @param desc a description of the case, for the error messages
+     */
+    void CheckSamePmi(const PmCqiInfo& actual, const PmCqiInfo& expected, const std::string& desc);
+
+    std::string m_pmSearchType; //!< The TypeId of the PMI search
+};
+
+Ptr<NrPmSearchFull>
+NrPmSearchTrackingTestCase::CreatePmSearch(bool tracking, Time fullSearchPeriod) const
+{
+    ObjectFactory amcFactory;
+    amcFactory.SetTypeId(NrAmc::GetTypeId());
+    amcFactory.Set("AmcModel", EnumValue(NrAmc::ErrorModel));
+    amcFactory.Set("ErrorModelType", TypeIdValue(NrEesmCcT1::GetTypeId()));
+
+    ObjectFactory factory;
+    factory.SetTypeId(m_pmSearchType);
+    factory.Set("CodebookType", TypeIdValue(NrCbTypeOneSp::GetTypeId()));
+    factory.Set("TrackingMode", BooleanValue(tracking));
+    factory.Set("TrackingMaxCapacityDrop", DoubleValue(0.0));
+    factory.Set("TrackingFullSearchPeriod", TimeValue(fullSearchPeriod));
+    auto pmSearch = factory.Create<NrPmSearchFull>();
+    pmSearch->SetAmc(amcFactory.Create<NrAmc>());
+    pmSearch->SetGnbParams(true, 2, 1);
+    pmSearch->SetUeParams(2);
+    pmSearch->InitCodebooks();
+    return pmSearch;
+}
+
+NrMimoSignal
+NrPmSearchTrackingTestCase::CreateSignal(double gain) const
+{
+    const size_t nRxPorts = 2;
+    const size_t nTxPorts = 4;
+    const size_t nRbs = 12;
+
+    NrMimoSignal signal;
+    signal.m_chanMat = ComplexMatrixArray(nRxPorts, nTxPorts, nRbs);
+    signal.m_covMat = NrCovMat{ComplexMatrixArray(nRxPorts, nRxPorts, nRbs)};
+    for (size_t iRb = 0; iRb < nRbs; ++iRb)
+    {
+        for (size_t i = 0; i < nRxPorts; ++i)
+        {
+            for (size_t j = 0; j < nTxPorts; ++j)
+            {
+                signal.m_chanMat(i, j, iRb) = gain * NrTestChannelValue(i, j, iRb);
+            }
+            signal.m_covMat(i, i, iRb) = 0.1;
+        }
+    }
+    return signal;
+}
+
+void
+NrPmSearchTrackingTestCase::CheckSamePmi(const PmCqiInfo& actual,
+                                         const PmCqiInfo& expected,
+                                         const std::string& desc)
+{
+    NS_TEST_ASSERT_MSG_EQ(+actual.m_rank, +expected.m_rank, "Different rank, " << desc);
+    NS_TEST_ASSERT_MSG_EQ(actual.m_wbPmi, expected.m_wbPmi, "Different WB PMI, " << desc);
+    NS_TEST_ASSERT_MSG_EQ((actual.m_sbPmis == expected.m_sbPmis),
+                          true,
+                          "Different SB PMIs, " << desc);
+}
+
+void
+NrPmSearchTrackingTestCase::DoRun()
+{
+    auto fullSearch = CreatePmSearch(false, MilliSeconds(100));
+    auto tracking = CreatePmSearch(true, MilliSeconds(100));
+    auto noPeriod = CreatePmSearch(true, Seconds(0));
+    auto updateWb = NrPmSearch::PmiUpdate(true, true);
+
+    // The first update is always an exhaustive search
+    auto signal = CreateSignal(1.0);
+    auto expected = fullSearch->CreateCqiFeedbackMimo(signal, updateWb);
+    CheckSamePmi(tracking->CreateCqiFeedbackMimo(signal, updateWb), expected, "first update");
+    NS_TEST_ASSERT_MSG_EQ(tracking->GetTrackingHits(), 0, "No tracking in the first update");
+
+    // The channel does not change, the previous PMI is found by tracking
+    for (uint64_t i = 1; i <= 3; ++i)
+    {
+        CheckSamePmi(tracking->CreateCqiFeedbackMimo(signal, updateWb),
+                     expected,
+                     "static channel");
+        NS_TEST_ASSERT_MSG_EQ(tracking->GetTrackingHits(), i, "Tracking update not used");
+        NS_TEST_ASSERT_MSG_EQ(tracking->GetTrackingFallbacks(), 0, "Unexpected fallback");
+    }
+
+    // The capacity drops, which triggers the exhaustive search
+    signal = CreateSignal(0.5);
+    expected = fullSearch->CreateCqiFeedbackMimo(signal, updateWb);
+    CheckSamePmi(tracking->CreateCqiFeedbackMimo(signal, updateWb), expected, "capacity drop");
+    NS_TEST_ASSERT_MSG_EQ(tracking->GetTrackingHits(), 3, "Tracking update used after a drop");
+    NS_TEST_ASSERT_MSG_EQ(tracking->GetTrackingFallbacks(), 1, "No fallback after a drop");
+
+    // The reference is the capacity of the exhaustive search, not the one of the last tracking
+    // update: a lower capacity than the previous update is accepted if it is still above it
+    tracking->CreateCqiFeedbackMimo(CreateSignal(0.6), updateWb);
+    tracking->CreateCqiFeedbackMimo(CreateSignal(0.55), updateWb);
+    NS_TEST_ASSERT_MSG_EQ(tracking->GetTrackingHits(), 5, "Tracking update compared to the last");
+    NS_TEST_ASSERT_MSG_EQ(tracking->GetTrackingFallbacks(), 1, "Reference moved by tracking");
+
+    // Without full search period, the exhaustive search is always done
+    for (int i = 0; i < 3; ++i)
+    {
+        noPeriod->CreateCqiFeedbackMimo(signal, updateWb);
+    }
+    NS_TEST_ASSERT_MSG_EQ(noPeriod->GetTrackingHits(), 0, "Tracking with expired period");
+    NS_TEST_ASSERT_MSG_EQ(noPeriod->GetTrackingFallbacks(), 0, "Fallback with expired period");
+}
+
+/**
+ * @brief Test suite for the tracking mode of the PMI search
+ */
+class NrTestPmSearchTracking : public TestSuite
+{
+  public:
+    NrTestPmSearchTracking()
+        : TestSuite("nr-test-pm-search-tracking", Type::UNIT)
+    {
+        AddTestCase(new NrPmSearchTrackingTestCase("ns3::NrPmSearchFull"), Duration::QUICK);
+        AddTestCase(new NrPmSearchTrackingTestCase("ns3::NrPmSearchFast"), Duration::QUICK);
+    }
+};
+
+static NrTestPmSearchTracking NrTestPmSearchTrackingTestSuite; //!< Nr test suite
+
+} // namespace ns3
@@ -0,0 +1,134 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/nr-rbg-mask.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <random>
+
+/**
+ * @file nr-test-rbg-mask.cc
+ * @ingroup test
+ *
+ * @brief Unit test of NrRbgMask. Random masks of several sizes, fitting in the inline storage or
+ * not, are compared against std::vector<bool>: the conversion, the count, the search of the set
+ * RBGs, the word-wise operations between masks and the resize.
+ */
+namespace ns3
+{
+
+/**
+ * @brief Testcase that compares NrRbgMask with std::vector<bool>
+ */
+class NrRbgMaskTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case for one mask size
+     * @param size the number of RBGs
+     */
+    NrRbgMaskTestCase(size_t size)
+        : TestCase("NrRbgMask with " + std::to_string(size) + " RBGs"),
+          m_size(size)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    size_t m_size; //!< Number of RBGs
+};
+
+void
+NrRbgMaskTestCase::DoRun()
+{
+    std::mt19937 rng(m_size);
+    for (size_t iter = 0; iter < 50; ++iter)
+    {
+        std::vector<bool> a(m_size);
+        std::vector<bool> b(m_size);
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            a[i] = rng() % 3 == 0;
+            b[i] = rng() % 2 == 0;
+        }
+        NrRbgMask maskA(a);
+        NrRbgMask maskB(b);
+
+        NS_TEST_ASSERT_MSG_EQ(maskA.size(), m_size, "Wrong size");
+        NS_TEST_ASSERT_MSG_EQ((maskA.ToVector() == a), true, "Wrong conversion");
+        NS_TEST_ASSERT_MSG_EQ(maskA.Count(),
+                              static_cast<size_t>(std::count(a.begin(), a.end(), true)),
+                              "Wrong count");
+        NS_TEST_ASSERT_MSG_EQ(std::equal(maskA.begin(), maskA.end(), a.begin(), a.end()),
+                              true,
+                              "Wrong iteration");
+
+        auto pos = maskA.FindFirst();
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            if (a[i])
+            {
+                NS_TEST_ASSERT_MSG_EQ(pos, i, "Wrong position of the set RBG");
+                pos = maskA.FindNext(pos);
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(pos, NrRbgMask::NPOS, "Unexpected set RBG");
+
+        auto andMask = maskA;
+        andMask &= maskB;
+        auto orMask = maskA;
+        orMask |= maskB;
+        auto andNotMask = maskA;
+        andNotMask.AndNot(maskB);
+        bool intersects = false;
+        bool isSubset = true;
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(andMask[i], (a[i] && b[i]), "Wrong AND at " << i);
+            NS_TEST_ASSERT_MSG_EQ(orMask[i], (a[i] || b[i]), "Wrong OR at " << i);
+            NS_TEST_ASSERT_MSG_EQ(andNotMask[i], (a[i] && !b[i]), "Wrong AND NOT at " << i);
+            intersects |= a[i] && b[i];
+            isSubset &= !a[i] || b[i];
+        }
+        NS_TEST_ASSERT_MSG_EQ(maskA.Intersects(maskB), intersects, "Wrong intersection");
+        NS_TEST_ASSERT_MSG_EQ(maskA.IsSubsetOf(maskB), isSubset, "Wrong subset");
+        NS_TEST_ASSERT_MSG_EQ(andMask.IsSubsetOf(maskA), true, "AND is not a subset");
+
+        const size_t newSize = rng() % (2 * m_size + 1);
+        const bool value = rng() % 2;
+        maskA.resize(newSize, value);
+        a.resize(newSize, value);
+        NS_TEST_ASSERT_MSG_EQ((maskA == NrRbgMask(a)), true, "Wrong resize to " << newSize);
+        NS_TEST_ASSERT_MSG_EQ(maskA.Count(),
+                              static_cast<size_t>(std::count(a.begin(), a.end(), true)),
+                              "Wrong count after resize to " << newSize);
+    }
+
+    NrRbgMask full(m_size, true);
+    NS_TEST_ASSERT_MSG_EQ(full.Count(), m_size, "Wrong count of a full mask");
+    full.SetAll(false);
+    NS_TEST_ASSERT_MSG_EQ(full.None(), true, "Cleared mask has set RBGs");
+}
+
+/**
+ * @brief Test suite for NrRbgMask
+ */
+class NrTestRbgMask : public TestSuite
+{
+  public:
+    NrTestRbgMask()
+        : TestSuite("nr-test-rbg-mask", Type::UNIT)
+    {
+        for (size_t size : {0, 1, 17, 64, 65, 275, 320, 700})
+        {
+            AddTestCase(new NrRbgMaskTestCase(size), Duration::QUICK);
+        }
+    }
+};
+
+static NrTestRbgMask NrTestRbgMaskTestSuite; //!< Nr test suite
+
+} // namespace ns3
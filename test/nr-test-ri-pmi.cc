@@ -444,12 +444,8 @@ class TestRiPmiSystem : public TestSuite
         AddTestCase(new RiPmiTestCase( 20,      "Sasaoka",  0.0, "ns3::NrPmSearchSasaoka", 3.1, 23.0), Duration::QUICK);
         AddTestCase(new RiPmiTestCase(500,      "Sasaoka",  0.0,    "ns3::NrPmSearchFast", 3.1, 15.0), Duration::QUICK);
         AddTestCase(new RiPmiTestCase(500,      "Sasaoka",  0.0, "ns3::NrPmSearchSasaoka", 3.1, 15.0), Duration::QUICK);
-#ifdef PMI_MALEKI
-        // Maleki's PMI test is enabled via a conditional compilation flag due to external
-        // dependencies such as Pybind11+Pyttb presence
         AddTestCase(new RiPmiTestCase( 20,             "",  0.0,  "ns3::NrPmSearchMaleki", 2.6, 27.0), Duration::QUICK);
         AddTestCase(new RiPmiTestCase(500,             "",  0.0,  "ns3::NrPmSearchMaleki", 2.2, 27.0), Duration::QUICK);
-#endif
         // clang-format on
     }
 };
@@ -204,7 +204,7 @@ NrTestMacSchedulerHarqRrReshape::DoRun()
             scheduler->DoCschedUeConfigReq(ueConf);
         }
         const bool isDl = true;
-        std::vector<bool> bitmask(10, true);
+        NrRbgMask bitmask(10, true);
         auto startingSymbol = m_startingSymbol;
         auto numSymbols = m_numSymbols;
         auto reshapedDcisTdma =
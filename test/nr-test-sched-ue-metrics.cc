@@ -0,0 +1,523 @@
+// Copyright (c) 2025 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/nr-mac-sched-sap.h"
+#include "ns3/nr-mac-scheduler-ofdma-pf.h"
+#include "ns3/nr-mac-scheduler-ofdma-qos.h"
+#include "ns3/nr-mac-scheduler-tdma-pf.h"
+#include "ns3/nr-mac-scheduler-tdma-qos.h"
+#include "ns3/nr-mac-scheduler-ue-info-metrics.h"
+#include "ns3/nr-mac-scheduler-ue-metric-store.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <tuple>
+
+/**
+ * @file nr-test-sched-ue-metrics.cc
+ * @ingroup test
+ *
+ * @brief Test of the batched update of the UE throughput, at two levels.
+ *
+ * NrMacSchedulerUeMetricStore: two stores are given the same random TBS over many iterations;
+ * one updates the average throughput UE by UE, the other with one sweep over the UEs that did
+ * not get resources. The throughputs must be exactly the same. The test also checks the reuse
+ * of the entries of removed UEs and the cached PF metric.
+ *
+ * Schedulers: two instances of the same PF or QoS scheduler assign the RBGs of several slots
+ * to more UEs than RBGs. The first one updates the UEs that did not get the resources with
+ * NrMacSchedulerUeInfoMetrics::UpdateDlTputs (NrMacSchedulerTdma::UsesBatchedMetrics returns
+ * true), the second one calls NotAssignedDlResources for each UE. The RBGs, the TBS and the
+ * average throughput of each UE must be exactly the same. The OFDMA schedulers must update the
+ * UEs both without the UE that got the resources and without any exception (assignedRnti equal
+ * to 0). A subclass of the schedulers must not use the batched update unless it asks for it.
+ */
+namespace ns3
+{
+
+/**
+ * @brief Testcase that compares the per-UE and the batched update of the metric store
+ */
+class NrSchedUeMetricStoreTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case
+     * @param numUes the number of UEs
+     */
+    NrSchedUeMetricStoreTestCase(uint32_t numUes)
+        : TestCase("UE metric store with " + std::to_string(numUes) + " UEs"),
+          m_numUes(numUes)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    uint32_t m_numUes; //!< Number of UEs
+};
+
+void
+NrSchedUeMetricStoreTestCase::DoRun()
+{
+    NrMacSchedulerUeMetricStore perUe;
+    NrMacSchedulerUeMetricStore batched;
+    std::vector<uint32_t> ues;
+    for (uint32_t i = 0; i < m_numUes; ++i)
+    {
+        ues.push_back(perUe.AddUe());
+        NS_TEST_ASSERT_MSG_EQ(batched.AddUe(), ues.back(), "Different indexes");
+    }
+
+    perUe.RemoveUe(ues.front());
+    NS_TEST_ASSERT_MSG_EQ(perUe.AddUe(), ues.front(), "The entry of a removed UE is not reused");
+    NS_TEST_ASSERT_MSG_EQ(perUe.GetSize(), m_numUes, "The store grew when reusing an entry");
+
+    std::mt19937 rng(m_numUes);
+    for (uint32_t iter = 0; iter < 200; ++iter)
+    {
+        const uint32_t numSym = 1 + rng() % 14;
+        const double timeWindow = 1 + rng() % 200;
+        std::vector<uint32_t> notAssigned;
+        for (const auto idx : ues)
+        {
+            if (rng() % 4 == 0)
+            {
+                continue;
+            }
+            const uint32_t tbSize = rng() % 100000;
+            for (auto store : {&perUe, &batched})
+            {
+                store->m_dl.m_lastAvgTput[idx] = store->m_dl.m_avgTput[idx];
+                store->m_dl.m_tbSize[idx] = tbSize;
+            }
+            notAssigned.push_back(idx);
+        }
+
+        for (const auto idx : notAssigned)
+        {
+            NrMacSchedulerUeMetricStore::UpdateAvgTput(perUe.m_dl, idx, numSym, timeWindow);
+        }
+        NrMacSchedulerUeMetricStore::UpdateAvgTput(batched.m_dl, notAssigned, numSym, timeWindow);
+
+        for (const auto idx : ues)
+        {
+            NS_TEST_ASSERT_MSG_EQ(batched.m_dl.m_currTput[idx],
+                                  perUe.m_dl.m_currTput[idx],
+                                  "Different current throughput of UE " << idx);
+            NS_TEST_ASSERT_MSG_EQ(batched.m_dl.m_avgTput[idx],
+                                  perUe.m_dl.m_avgTput[idx],
+                                  "Different average throughput of UE " << idx);
+        }
+    }
+
+    for (const double alpha : {0.0, 0.5, 1.0})
+    {
+        const uint32_t idx = ues.back();
+        NrMacSchedulerUeMetricStore::SetPotentialTput(perUe.m_dl, idx, 0.0, alpha);
+        NS_TEST_ASSERT_MSG_EQ(perUe.m_dl.m_fairPotentialTput[idx],
+                              std::pow(0.0, alpha),
+                              "Wrong fair potential throughput for alpha " << alpha);
+        NrMacSchedulerUeMetricStore::SetPotentialTput(perUe.m_dl, idx, 1234.5, alpha);
+        NS_TEST_ASSERT_MSG_EQ(NrMacSchedulerUeMetricStore::GetPfMetric(perUe.m_dl, idx),
+                              std::pow(1234.5, alpha) / std::max(1E-9, perUe.m_dl.m_avgTput[idx]),
+                              "Wrong PF metric for alpha " << alpha);
+    }
+}
+
+/**
+ * @brief CSCHED SAP user that ignores the confirmations of the schedulers
+ */
+class TestCschedSapUserUeMetrics : public NrMacCschedSapUser
+{
+  public:
+    TestCschedSapUserUeMetrics()
+        : NrMacCschedSapUser()
+    {
+    }
+
+    void CschedCellConfigCnf(
+        [[maybe_unused]] const struct CschedCellConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigCnf(
+        [[maybe_unused]] const struct CschedUeConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcConfigCnf(
+        [[maybe_unused]] const struct CschedLcConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcReleaseCnf(
+        [[maybe_unused]] const struct CschedLcReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeReleaseCnf(
+        [[maybe_unused]] const struct CschedUeReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigUpdateInd(
+        [[maybe_unused]] const struct CschedUeConfigUpdateIndParameters& params) override
+    {
+    }
+
+    void CschedCellConfigUpdateInd(
+        [[maybe_unused]] const struct CschedCellConfigUpdateIndParameters& params) override
+    {
+    }
+};
+
+/**
+ * @brief SCHED SAP user that gives the schedulers a fixed cell configuration
+ */
+class TestSchedSapUserUeMetrics : public NrMacSchedSapUser
+{
+  public:
+    TestSchedSapUserUeMetrics()
+        : NrMacSchedSapUser()
+    {
+    }
+
+    void SchedConfigInd([[maybe_unused]] const struct SchedConfigIndParameters& params) override
+    {
+    }
+
+    // For the rest, setup some hard-coded values; for the moment, there is
+    // no need to have real values here.
+    Ptr<const SpectrumModel> GetSpectrumModel() const override
+    {
+        return nullptr;
+    }
+
+    uint32_t GetNumRbPerRbg() const override
+    {
+        return 1;
+    }
+
+    uint8_t GetNumHarqProcess() const override
+    {
+        return 20;
+    }
+
+    uint16_t GetBwpId() const override
+    {
+        return 0;
+    }
+
+    uint16_t GetCellId() const override
+    {
+        return 0;
+    }
+
+    uint32_t GetSymbolsPerSlot() const override
+    {
+        return 14;
+    }
+
+    Time GetSlotPeriod() const override
+    {
+        return MilliSeconds(1);
+    }
+
+    void BuildRarList([[maybe_unused]] SlotAllocInfo& allocInfo) override
+    {
+    }
+};
+
+/**
+ * @brief A PF or QoS scheduler that counts the updates of the UEs without resources, and
+ * optionally does them UE by UE instead of with the metric store
+ */
+template <class T>
+class NrTestUeMetricsScheduler : public T
+{
+  public:
+    bool m_perUe{false};                    //!< Whether the UEs are updated one by one
+    mutable uint32_t m_skipUpdates{0};      //!< Number of updates without the assigned UE
+    mutable uint32_t m_allUeUpdates{0};     //!< Number of updates of all the UEs
+    mutable uint32_t m_notAssignedCalls{0}; //!< Number of calls to NotAssignedDlResources
+
+    /// UE representations created by the scheduler, by RNTI
+    mutable std::map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>> m_ues;
+
+    /**
+     * @brief Assign the DL RBGs of one slot to the UEs with data, in the order of their RNTI
+     * @param symAvail the number of available symbols
+     */
+    void AssignDlRbgs(uint32_t symAvail)
+    {
+        NrMacSchedulerNs3::ActiveUeMap activeDl;
+        for (const auto& [rnti, ue] : m_ues)
+        {
+            uint32_t totBuffer = 0;
+            for (const auto& [lcgId, lcg] : ue->m_dlLCG)
+            {
+                totBuffer += lcg->GetTotalSize();
+            }
+            if (totBuffer > 0)
+            {
+                activeDl[ue->m_beamId].emplace_back(ue, totBuffer);
+            }
+        }
+        this->AssignDLRBG(symAvail, activeDl);
+    }
+
+    /**
+     * @brief Get the value of UsesBatchedMetrics of the scheduler this test scheduler derives
+     * from
+     * @return T::UsesBatchedMetrics
+     */
+    bool BaseUsesBatchedMetrics() const
+    {
+        return T::UsesBatchedMetrics();
+    }
+
+  protected:
+    std::shared_ptr<NrMacSchedulerUeInfo> CreateUeRepresentation(
+        const NrMacCschedSapProvider::CschedUeConfigReqParameters& params) const override
+    {
+        auto ue = T::CreateUeRepresentation(params);
+        m_ues[params.m_rnti] = ue;
+        return ue;
+    }
+
+    bool UsesBatchedMetrics() const override
+    {
+        return !m_perUe;
+    }
+
+    void NotAssignedDlResourcesToUes(
+        const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector,
+        uint16_t assignedRnti,
+        const NrMacSchedulerNs3::FTResources& notAssigned,
+        const NrMacSchedulerNs3::FTResources& totalAssigned) const override
+    {
+        ++(assignedRnti == 0 ? m_allUeUpdates : m_skipUpdates);
+        T::NotAssignedDlResourcesToUes(ueVector, assignedRnti, notAssigned, totalAssigned);
+    }
+
+    void NotAssignedDlResources(const NrMacSchedulerNs3::UePtrAndBufferReq& ue,
+                                const NrMacSchedulerNs3::FTResources& notAssigned,
+                                const NrMacSchedulerNs3::FTResources& totalAssigned) const override
+    {
+        ++m_notAssignedCalls;
+        T::NotAssignedDlResources(ue, notAssigned, totalAssigned);
+    }
+};
+
+/**
+ * @brief Testcase that compares the batched and the per-UE update in a scheduler
+ */
+class NrSchedUeMetricsTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test case
+     * @param schedulerType the scheduler, one of OfdmaPF, OfdmaQos, TdmaPF and TdmaQos
+     */
+    NrSchedUeMetricsTestCase(const std::string& schedulerType)
+        : TestCase("Batched UE throughput update with the " + schedulerType + " scheduler"),
+          m_schedulerType(schedulerType)
+    {
+    }
+
+  private:
+    /// RBGs, TBS and average throughput of each UE, by RNTI
+    using Allocation = std::map<uint16_t, std::tuple<std::vector<uint16_t>, uint32_t, double>>;
+
+    void DoRun() override;
+
+    /**
+     * @brief Run the batched and the per-UE instances of a scheduler and compare them
+     * @param isOfdma whether the scheduler is OFDMA, which also updates all the UEs
+     */
+    template <class T>
+    void Compare(bool isOfdma);
+
+    /**
+     * @brief Configure the cell and the UEs of a scheduler
+     * @param sched the scheduler
+     */
+    void Configure(const Ptr<NrMacSchedulerNs3>& sched);
+
+    /**
+     * @brief Assign the RBGs of one slot to the UEs
+     * @param sched the scheduler
+     * @return the RBGs, the TBS and the average throughput of each UE
+     */
+    template <class T>
+    Allocation Schedule(const Ptr<NrTestUeMetricsScheduler<T>>& sched);
+
+    std::string m_schedulerType;                //!< The scheduler
+    TestCschedSapUserUeMetrics m_cschedSapUser; //!< CSCHED SAP user of the schedulers
+    TestSchedSapUserUeMetrics m_schedSapUser;   //!< SCHED SAP user of the schedulers
+
+    static constexpr uint16_t NUM_UES = 16; //!< Number of UEs, more than the RBGs
+    static constexpr uint16_t NUM_RBG = 10; //!< Number of RBGs
+};
+
+void
+NrSchedUeMetricsTestCase::Configure(const Ptr<NrMacSchedulerNs3>& sched)
+{
+    sched->SetMacCschedSapUser(&m_cschedSapUser);
+    sched->SetMacSchedSapUser(&m_schedSapUser);
+    sched->InstallDlAmc(CreateObject<NrAmc>());
+
+    NrMacCschedSapProvider::CschedCellConfigReqParameters cellConfig{};
+    cellConfig.m_dlBandwidth = NUM_RBG;
+    cellConfig.m_ulBandwidth = NUM_RBG;
+    sched->DoCschedCellConfigReq(cellConfig);
+
+    for (uint16_t rnti = 1; rnti <= NUM_UES; ++rnti)
+    {
+        NrMacCschedSapProvider::CschedUeConfigReqParameters ueConfig;
+        ueConfig.m_rnti = rnti;
+        ueConfig.m_beamId = BeamId(rnti % 2, 120.0);
+        sched->DoCschedUeConfigReq(ueConfig);
+
+        // One LC per UE, with different priorities for the QoS scheduler
+        NrMacCschedSapProvider::CschedLcConfigReqParameters lcConfig;
+        nr::LogicalChannelConfigListElement_s lc;
+        lcConfig.m_rnti = rnti;
+        lcConfig.m_reconfigureFlag = false;
+        lc.m_direction = nr::LogicalChannelConfigListElement_s::Direction_e::DIR_BOTH;
+        lc.m_qosBearerType = nr::LogicalChannelConfigListElement_s::QosBearerType_e::QBT_NON_GBR;
+        lc.m_fiveQi = 6 + rnti % 4;
+        lc.m_logicalChannelGroup = 1;
+        lc.m_logicalChannelIdentity = 1;
+        lcConfig.m_logicalChannelConfigList.emplace_back(lc);
+        sched->DoCschedLcConfigReq(lcConfig);
+
+        NrMacSchedSapProvider::SchedDlRlcBufferReqParameters buffer{};
+        buffer.m_rnti = rnti;
+        buffer.m_logicalChannelIdentity = 1;
+        buffer.m_rlcTransmissionQueueSize = 100000;
+        sched->DoSchedDlRlcBufferReq(buffer);
+
+        // Different channel qualities, so that some UEs get a too small TBS
+        DlCqiInfo cqiInfo;
+        cqiInfo.m_rnti = rnti;
+        cqiInfo.m_wbCqi = 1 + (rnti * 7) % 15;
+        cqiInfo.m_sbCqis = std::vector<uint8_t>(NUM_RBG, cqiInfo.m_wbCqi);
+        NrMacSchedSapProvider::SchedDlCqiInfoReqParameters cqi{};
+        cqi.m_cqiList.push_back(cqiInfo);
+        sched->DoSchedDlCqiInfoReq(cqi);
+    }
+}
+
+template <class T>
+NrSchedUeMetricsTestCase::Allocation
+NrSchedUeMetricsTestCase::Schedule(const Ptr<NrTestUeMetricsScheduler<T>>& sched)
+{
+    sched->AssignDlRbgs(12);
+
+    Allocation result;
+    for (const auto& [rnti, ue] : sched->m_ues)
+    {
+        auto ueMetrics = std::dynamic_pointer_cast<NrMacSchedulerUeInfoMetrics>(ue);
+        NS_ASSERT(ueMetrics);
+        result[rnti] = {ue->m_dlRBG, ue->m_dlTbSize, ueMetrics->GetAvgTputDl()};
+        ue->ResetDlSchedInfo();
+    }
+    return result;
+}
+
+template <class T>
+void
+NrSchedUeMetricsTestCase::Compare(bool isOfdma)
+{
+    auto batched = CreateObject<NrTestUeMetricsScheduler<T>>();
+    auto perUe = CreateObject<NrTestUeMetricsScheduler<T>>();
+    perUe->m_perUe = true;
+    Configure(batched);
+    Configure(perUe);
+
+    for (uint32_t slot = 0; slot < 20; ++slot)
+    {
+        const auto expected = Schedule(perUe);
+        const auto actual = Schedule(batched);
+        for (const auto& [rnti, values] : expected)
+        {
+            const auto& [rbg, tbSize, avgTput] = actual.at(rnti);
+            NS_TEST_ASSERT_MSG_EQ((rbg == std::get<0>(values)),
+                                  true,
+                                  "Different RBGs of UE " << rnti << " in slot " << slot);
+            NS_TEST_ASSERT_MSG_EQ(tbSize,
+                                  std::get<1>(values),
+                                  "Different TBS of UE " << rnti << " in slot " << slot);
+            NS_TEST_ASSERT_MSG_EQ(avgTput,
+                                  std::get<2>(values),
+                                  "Different average throughput of UE " << rnti << " in slot "
+                                                                        << slot);
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_GT(batched->m_skipUpdates, 0, "No update without the assigned UE");
+    NS_TEST_ASSERT_MSG_EQ(batched->m_skipUpdates, perUe->m_skipUpdates, "Different updates");
+    NS_TEST_ASSERT_MSG_EQ(batched->m_allUeUpdates, perUe->m_allUeUpdates, "Different updates");
+    NS_TEST_ASSERT_MSG_EQ(batched->m_notAssignedCalls, 0, "Per-UE update in the batched scheduler");
+    NS_TEST_ASSERT_MSG_GT(perUe->m_notAssignedCalls, 0, "No per-UE update");
+    NS_TEST_ASSERT_MSG_EQ(batched->BaseUsesBatchedMetrics(),
+                          false,
+                          "A subclass of the scheduler bypasses its NotAssignedDlResources");
+    if (isOfdma)
+    {
+        NS_TEST_ASSERT_MSG_GT(batched->m_allUeUpdates, 0, "No update of all the UEs");
+    }
+}
+
+void
+NrSchedUeMetricsTestCase::DoRun()
+{
+    if (m_schedulerType == "OfdmaPF")
+    {
+        Compare<NrMacSchedulerOfdmaPF>(true);
+    }
+    else if (m_schedulerType == "OfdmaQos")
+    {
+        Compare<NrMacSchedulerOfdmaQos>(true);
+    }
+    else if (m_schedulerType == "TdmaPF")
+    {
+        Compare<NrMacSchedulerTdmaPF>(false);
+    }
+    else
+    {
+        NS_ASSERT(m_schedulerType == "TdmaQos");
+        Compare<NrMacSchedulerTdmaQos>(false);
+    }
+}
+
+/**
+ * @brief Test suite for the batched update of the UE throughput, in the metric store and in
+ * the schedulers
+ */
+class NrTestSchedUeMetrics : public TestSuite
+{
+  public:
+    NrTestSchedUeMetrics()
+        : TestSuite("nr-test-sched-ue-metrics", Type::UNIT)
+    {
+        for (uint32_t numUes : {1, 10, 100})
+        {
+            AddTestCase(new NrSchedUeMetricStoreTestCase(numUes), Duration::QUICK);
+        }
+        for (const auto& schedulerType : {"OfdmaPF", "OfdmaQos", "TdmaPF", "TdmaQos"})
+        {
+            AddTestCase(new NrSchedUeMetricsTestCase(schedulerType), Duration::QUICK);
+        }
+    }
+};
+
+static NrTestSchedUeMetrics NrTestSchedUeMetricsTestSuite; //!< Nr test suite
+
+} // namespace ns3